@@ -23,6 +23,7 @@ interface MuxSessionOptions {
   maxIdle?: number | string,
   maxQueue?: number,
   maxMessages?: number,
+  minSessions?: number,
 }
 
 interface MuxOptions extends MuxSessionOptions {
@@ -33,6 +34,7 @@ interface MuxHTTPOptions extends MuxOptions {
   bufferSize?: number | string,
   maxHeaderSize?: number | string,
   version?: number | string | (() => number | string),
+  shared?: boolean,
 }
 
 interface CertificateOptions {
@@ -531,9 +533,36 @@ interface Configuration {
    * - **INPUT** - _Data_ stream to decode Dubbo messages from.
    * - **OUTPUT** - Dubbo _Messages_ decoded from the input _Data_ stream.
    *
+   * With option _lazy_, only the leading strings of a Hessian2 request body are decoded
+   * into the message head as _dubboVersion_, _service_, _version_, _method_ and _parameterTypes_,
+   * while the body is output as it is. Such a body is buffered up in whole, so a request
+   * with a body larger than _maxBodySize_ (16MB by default) ends the stream with a protocol error.
+   *
+   * @param options Options including _lazy_ and _maxBodySize_.
+   * @returns The same _Configuration_ object.
+   */
+  decodeDubbo(
+    options?: {
+      lazy?: boolean,
+      maxBodySize?: number | string,
+    }
+  ): Configuration;
+
+  /**
+   * Appends a _decodeGRPC_ filter to the current pipeline layout.
+   *
+   * A _decodeGRPC_ filter splits the body of an HTTP message into length-prefixed [gRPC](https://grpc.io/) messages.
+   * Each gRPC message is output as soon as it arrives, with a head of `{ compressed }`.
+   * Messages flagged as compressed are decompressed according to the _grpc-encoding_ header (_gzip_ or _deflate_).
+   * When the HTTP message ends, a standalone _MessageEnd_ is output whose tail is `{ status, message }`
+   * if _grpc-status_ was found in the trailers, or _null_ otherwise.
+   *
+   * - **INPUT** - HTTP _Message_ carrying a gRPC stream.
+   * - **OUTPUT** - gRPC _Messages_ followed by a standalone _MessageEnd_.
+   *
    * @returns The same _Configuration_ object.
    */
-  decodeDubbo(): Configuration;
+  decodeGRPC(): Configuration;
 
   /**
    * Appends a _decodeHTTPRequest_ filter to the current pipeline layout.
@@ -598,9 +627,17 @@ interface Configuration {
    * - **INPUT** - _Data_ stream to decode Thrift messages from.
    * - **OUTPUT** - Thrift _Messages_ decoded from the input _Data_ stream.
    *
+   * With option _lazy_, only the message header is decoded and given as the head of _MessageStart_,
+   * while the body is output as it is without being decoded into fields.
+   *
+   * @param options Options including _lazy_.
    * @returns The same _Configuration_ object.
    */
-  decodeThrift(): Configuration;
+  decodeThrift(
+    options?: {
+      lazy?: boolean,
+    }
+  ): Configuration;
 
   /**
    * Appends a _decodeWebSocket_ filter to the current pipeline layout.
@@ -610,9 +647,18 @@ interface Configuration {
    * - **INPUT** - _Data_ stream to decode WebSocket messages from.
    * - **OUTPUT** - WebSocket _Messages_ decoded from the input _Data_ stream.
    *
+   * @param options Options including:
+   *   - _deflate_ - (optional) Enables the _permessage-deflate_ extension (RFC 7692).
+   *       Can be a boolean, the negotiated _Sec-WebSocket-Extensions_ header value from which
+   *       context takeover settings are taken, or a function that returns either of them.
+   *       Defaults to false.
    * @returns The same _Configuration_ object.
    */
-  decodeWebSocket(): Configuration;
+  decodeWebSocket(
+    options?: {
+      deflate?: boolean | string | (() => boolean | string),
+    }
+  ): Configuration;
 
   /**
    * Appends a _decompress_ filter to the current pipeline layout.
@@ -755,6 +801,23 @@ interface Configuration {
    */
   encodeDubbo(): Configuration;
 
+  /**
+   * Appends an _encodeGRPC_ filter to the current pipeline layout.
+   *
+   * An _encodeGRPC_ filter encodes [gRPC](https://grpc.io/) messages into the body of a single HTTP message.
+   * Messages with `compressed: true` in their heads are compressed according to the _grpc-encoding_ header
+   * in the HTTP head (_gzip_ or _deflate_). A standalone _MessageEnd_ ends the HTTP message,
+   * turning a tail of `{ status, message }` into _grpc-status_ and _grpc-message_ trailers.
+   *
+   * - **INPUT** - gRPC _Messages_ followed by a standalone _MessageEnd_.
+   * - **OUTPUT** - HTTP _Message_ carrying the gRPC stream.
+   *
+   * @param head HTTP message head or a function that returns it.
+   *   Defaults to a response head with _content-type_ of _application/grpc_.
+   * @returns The same _Configuration_ object.
+   */
+  encodeGRPC(head?: object | (() => object)): Configuration;
+
   /**
    * Appends an _encodeHTTPRequest_ filter to the current pipeline layout.
    *
@@ -820,6 +883,9 @@ interface Configuration {
    * - **INPUT** - Thrift _Messages_ to encode.
    * - **OUTPUT** - Encoded _Data_ stream from the input Thrift messages.
    *
+   * A message without a tail payload is encoded from its head as output by a lazy _decodeThrift_,
+   * with its body passed through as it is.
+   *
    * @returns The same _Configuration_ object.
    */
   encodeThrift(): Configuration;
@@ -832,9 +898,18 @@ interface Configuration {
    * - **INPUT** - WebSocket _Messages_ to encode.
    * - **OUTPUT** - Encoded _Data_ stream from the input WebSocket messages.
    *
+   * @param options Options including:
+   *   - _deflate_ - (optional) Compresses data messages with the _permessage-deflate_ extension (RFC 7692).
+   *       Can be a boolean, the negotiated _Sec-WebSocket-Extensions_ header value from which
+   *       context takeover and window size settings are taken, or a function that returns either of them.
+   *       Defaults to false.
    * @returns The same _Configuration_ object.
    */
-  encodeWebSocket(): Configuration;
+  encodeWebSocket(
+    options?: {
+      deflate?: boolean | string | (() => boolean | string),
+    }
+  ): Configuration;
 
   /**
    * Appends an _exec_ filter to the current pipeline layout.
@@ -1019,6 +1094,7 @@ interface Configuration {
    *       Defaults is _60 seconds_.
    *   - _maxQueue_ - Maximum number of messages allowed to run concurrently in one sub-pipeline.
    *   - _maxMessages_ - Maximum number of messages allowed to run accumulatively in one sub-pipeline.
+   *   - _minSessions_ - Minimum number of sub-pipelines to keep open for each key, started ahead of time.
    * @returns The same _Configuration_ object.
    */
   mux(
@@ -1036,6 +1112,7 @@ interface Configuration {
    *       Defaults is _60 seconds_.
    *   - _maxQueue_ - Maximum number of messages allowed to run concurrently in one sub-pipeline.
    *   - _maxMessages_ - Maximum number of messages allowed to run accumulatively in one sub-pipeline.
+   *   - _minSessions_ - Minimum number of sub-pipelines to keep open for each key, started ahead of time.
    * @returns The same _Configuration_ object.
    */
   mux(
@@ -1062,7 +1139,10 @@ interface Configuration {
    *   - _bufferSize_ - Maximum body size above which a message should be transferred in chunks.
    *       Can be a number in bytes or a string with a unit suffix such as `'k'`, `'m'`, `'g'` and `'t'`.
    *       Default is _16KB_.
+   *   - _minSessions_ - Minimum number of sub-pipelines to keep open for each key, started ahead of time.
    *   - _version_ - Number `1` for HTTP/1 or number `2` for HTTP/2. Can also be a function that returns `1` or `2`.
+   *   - _shared_ - If `true`, HTTP/2 sessions can be shared by the same _muxHTTP_ filter in all worker threads
+   *       when the session key is a string or a number. Defaults to `false`.
    * @returns The same _Configuration_ object.
    */
   muxHTTP(
@@ -1083,13 +1163,43 @@ interface Configuration {
    *   - _bufferSize_ - Maximum body size above which a message should be transferred in chunks.
    *       Can be a number in bytes or a string with a unit suffix such as `'k'`, `'m'`, `'g'` and `'t'`.
    *       Default is _16KB_.
+   *   - _minSessions_ - Minimum number of sub-pipelines to keep open for each key, started ahead of time.
    *   - _version_ - Number `1` for HTTP/1 or number `2` for HTTP/2. Can also be a function that returns `1` or `2`.
+   *   - _shared_ - If `true`, HTTP/2 sessions can be shared by the same _muxHTTP_ filter in all worker threads
+   *       when the session key is a string or a number. Defaults to `false`.
    * @returns The same _Configuration_ object.
    */
   muxHTTP(
     options?: MuxHTTPOptions | (() => MuxHTTPOptions),
   ): Configuration;
 
+  /**
+   * Appends a _muxRESP_ filter to the current pipeline layout.
+   *
+   * A _muxRESP_ filter sends Redis commands to the nodes of a Redis Cluster,
+   * routing each command by the hash slot of its key. Within a worker thread, all clients
+   * share one sub-pipeline per node, and commands are pipelined on it. The slot map is loaded
+   * with `CLUSTER SLOTS`, and `MOVED` and `ASK` redirections are followed automatically.
+   *
+   * - **INPUT** - RESP command _Messages_ from _decodeRESP_.
+   * - **OUTPUT** - RESP reply _Messages_ for _encodeRESP_, in the same order as the commands.
+   * - **SUB-INPUT** - RESP command _Messages_ to send to one node.
+   * - **SUB-OUTPUT** - RESP reply _Messages_ received from that node.
+   *
+   * Each sub-pipeline is started with the node address `"host:port"` as its argument.
+   *
+   * @param nodes Address of a seed node, or an array of them.
+   * @param options Options including:
+   *   - _maxRedirects_ - Maximum number of redirections followed for one command. Defaults to `5`.
+   * @returns The same _Configuration_ object.
+   */
+  muxRESP(
+    nodes: string | string[],
+    options?: {
+      maxRedirects?: number,
+    }
+  ): Configuration;
+
   /**
    * Appends a _pack_ filter to the current pipeline layout.
    *
@@ -0,0 +1,64 @@
+/**
+ * Table of IP address blocks with longest-prefix-match lookups.
+ */
+interface IPMap {
+
+  /**
+   * Number of address blocks in the table.
+   */
+  readonly size: number;
+
+  /**
+   * Replaces all address blocks in the table at once.
+   *
+   * @param entries An array of _[cidr, value]_ pairs, an array of address blocks
+   *   (each with the value _true_), or an object with CIDR strings as keys.
+   *   An address block can be a CIDR string or a _Netmask_ object.
+   * @returns The same _IPMap_ object.
+   */
+  load(entries: [string | Netmask, any][] | (string | Netmask)[] | { [cidr: string]: any }): IPMap;
+
+  /**
+   * Adds an address block or changes its value.
+   *
+   * @param cidr A string in CIDR notation or a _Netmask_ object.
+   * @param value The value associated with the address block.
+   * @returns The same _IPMap_ object.
+   */
+  set(cidr: string | Netmask, value: any): IPMap;
+
+  /**
+   * Removes an address block.
+   *
+   * @param cidr A string in CIDR notation or a _Netmask_ object.
+   * @returns A boolean indicating if the address block was in the table.
+   */
+  delete(cidr: string | Netmask): boolean;
+
+  /**
+   * Removes all address blocks.
+   */
+  clear(): void;
+
+  /**
+   * Finds the most specific address block containing an address.
+   *
+   * @param ip A string containing an IP address, an _IP_ object, or an _Inbound_ object for its remote address.
+   *   The remote address of an _Inbound_ is looked up as IPv4 if it is an IPv4-mapped IPv6 address.
+   * @returns The value of the longest matching address block, or _undefined_ if none matches.
+   */
+  find(ip: string | object | Inbound): any;
+}
+
+interface IPMapConstructor {
+
+  /**
+   * Creates an instance of _IPMap_.
+   *
+   * @param entries Initial address blocks in any of the forms accepted by _load()_.
+   * @returns An _IPMap_ object.
+   */
+  new(entries?: [string | Netmask, any][] | (string | Netmask)[] | { [cidr: string]: any }): IPMap;
+}
+
+declare var IPMap: IPMapConstructor;
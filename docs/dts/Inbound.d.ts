@@ -6,4 +6,5 @@ interface Inbound {
   remotePort: number;
   destinationAddress: string;
   destinationPort: number;
+  incomingCPU: number;
 }
@@ -1,5 +1,44 @@
+/**
+ * Pre-compiled encoder for objects of a fixed shape.
+ */
+interface JSONTemplate {
+
+  /**
+   * Serializes an object in JSON format using the keys of the template.
+   *
+   * @param obj An object to serialize. Keys not in the template are left out.
+   * @returns A string after serialization.
+   */
+  stringify(obj: object): string;
+
+  /**
+   * Serializes an object in JSON format using the keys of the template.
+   *
+   * @param obj An object to serialize. Keys not in the template are left out.
+   * @returns A _Data_ object after serialization.
+   */
+  encode(obj: object): Data;
+}
+
+interface JSONTemplateConstructor {
+
+  /**
+   * Creates an instance of _JSON.Template_.
+   *
+   * @param shape A sample object whose keys, in order, make up the template.
+   *   Values that are objects give the shapes of nested objects.
+   * @returns A _JSON.Template_ object.
+   */
+  new(shape: object): JSONTemplate;
+}
+
 interface JSON {
 
+  /**
+   * Constructor of pre-compiled encoders for objects of a fixed shape.
+   */
+  Template: JSONTemplateConstructor;
+
   /**
    * Deserializes a value from JSON format.
    *
@@ -24,6 +24,16 @@ interface Message {
    * Value representation of the message body after decoding.
    */
   payload?: any;
+
+  /**
+   * Marks the message as constant so that encoders can reuse its encoded head.
+   *
+   * Modifying the head of a frozen message afterwards is detected by
+   * the encoders, which then encode it again.
+   *
+   * @returns The same _Message_ object.
+   */
+  freeze(): Message;
 }
 
 interface MessageConstructor {
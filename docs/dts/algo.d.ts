@@ -148,6 +148,74 @@ interface URLRouterConstructor {
   new(routes: { [path: string]: any }): URLRouter;
 }
 
+/**
+ * MQTT topic filter matching with shared subscriptions and retained messages.
+ *
+ * Instances created with the same name share one trie across all worker threads.
+ * Lookups run on an immutable snapshot, so they never wait for updates in progress.
+ */
+interface TopicTrie {
+
+  /**
+   * Number of subscriptions.
+   */
+  readonly size: number;
+
+  /**
+   * Adds a subscription or changes its value.
+   *
+   * @param filter A topic filter that can contain `+` and `#` wildcards,
+   *   optionally prefixed with `$share/<group>/` for a shared subscription.
+   * @param key A string identifying the subscriber, usually the client ID.
+   * @param value The value returned by _match()_ for this subscription. Defaults to _key_.
+   */
+  subscribe(filter: string, key: string, value?: any): void;
+
+  /**
+   * Removes a subscription.
+   *
+   * @param filter The topic filter used when subscribing.
+   * @param key The subscriber key used when subscribing.
+   * @returns A boolean indicating if the subscription existed.
+   */
+  unsubscribe(filter: string, key: string): boolean;
+
+  /**
+   * Sets or clears the retained message of a topic.
+   *
+   * @param topic A topic name without wildcards.
+   * @param message The retained message, or `null` to clear it.
+   */
+  retain(topic: string, message: any): void;
+
+  /**
+   * Finds the subscriptions a topic is delivered to.
+   *
+   * @param topic A topic name.
+   * @returns An array of subscription values, with one member picked in turn from each shared subscription.
+   */
+  match(topic: string): any[];
+
+  /**
+   * Finds the retained messages for a new subscription.
+   *
+   * @param filter A topic filter. Shared subscriptions get no retained messages.
+   * @returns An array of retained messages whose topics match the filter.
+   */
+  retained(filter: string): any[];
+}
+
+interface TopicTrieConstructor {
+
+  /**
+   * Creates an instance of _TopicTrie_.
+   *
+   * @param name Name of the trie to share across threads. A private trie is created if absent.
+   * @returns A _TopicTrie_ object.
+   */
+  new(name?: string): TopicTrie;
+}
+
 /**
  * Load-balancer base class.
  */
@@ -325,6 +393,7 @@ interface Algo {
   Cache: CacheConstructor;
   Quota: QuotaConstructor;
   URLRouter: URLRouterConstructor;
+  TopicTrie: TopicTrieConstructor;
   HashingLoadBalancer: HashingLoadBalancerConstructor;
   RoundRobinLoadBalancer: RoundRobinLoadBalancerConstructor;
   LeastWorkLoadBalancer: LeastWorkLoadBalancerConstructor;
@@ -312,6 +312,38 @@ interface JWKConstructor {
   new(json: object): JWK;
 }
 
+/**
+ * JSON Web Key Set.
+ */
+interface JWKS {
+
+  /**
+   * Number of keys in the set.
+   */
+  readonly size: number;
+
+  /**
+   * Looks up a key by its ID.
+   *
+   * @param kid A string containing the key ID.
+   * @returns A _JWK_ object with the specified _kid_, or _null_ if not found.
+   */
+  get(kid: string): JWK | null;
+}
+
+interface JWKSConstructor {
+
+  /**
+   * Creates an instance of _JWKS_.
+   *
+   * Keys of unsupported types in the set are skipped.
+   *
+   * @param json An object with a _keys_ array as in a JWKS document, or an array of JWK objects.
+   * @returns A _JWKS_ object with all keys indexed by their _kid_.
+   */
+  new(json: object | object[]): JWKS;
+}
+
 /**
  * JSON Web Token.
  */
@@ -335,10 +367,15 @@ interface JWT {
   /**
    * Verifies the token.
    *
-   * @param key A _JWK_ object or a _PublicKey_ object containing the public key used in verification.
+   * Successful verifications are cached per thread until the token's _exp_,
+   * or for 60 seconds if it has none, so verifying the same token again
+   * with the same key is a lookup.
+   *
+   * @param key A _JWK_ object or a _PublicKey_ object containing the public key used in verification,
+   *   or a _JWKS_ object from which the key is selected by the _kid_ in the token header.
    * @returns A boolean value indicating whether the JWT is verified successfully.
    */
-  verify(key: JWK | PublicKey): boolean;
+  verify(key: JWK | JWKS | PublicKey): boolean;
 }
 
 interface JWTConstructor {
@@ -364,6 +401,7 @@ interface Crypto {
   Sign: SignConstructor,
   Verify: VerifyConstructor,
   JWK: JWKConstructor,
+  JWKS: JWKSConstructor,
   JWT: JWTConstructor,
 }
 
@@ -38,6 +38,7 @@
 #include "listener.hpp"
 #include "worker-thread.hpp"
 #include "module.hpp"
+#include "profiler.hpp"
 #include "status.hpp"
 #include "graph.hpp"
 #include "compressor.hpp"
@@ -245,6 +246,7 @@ auto AdminService::handle(Context *ctx, Message *req) -> pjs::Object* {
   static const std::string prefix_api_v1_metrics("/api/v1/metrics/");
   static const std::string prefix_api_v1_log("/api/v1/log/");
   static const std::string prefix_admin("/admin/");
+  static const std::string prefix_profile("/profile?");
   static const std::string text_html("text/html");
 
   thread_local static pjs::ConstStr s_accept("accept");
@@ -337,6 +339,14 @@ auto AdminService::handle(Context *ctx, Message *req) -> pjs::Object* {
         return m_response_method_not_allowed;
       }
 
+    // GET /profile
+    } else if (path == "/profile" || utils::starts_with(path, prefix_profile)) {
+      if (method == "GET") {
+        return profile_GET(path.substr(std::min(path.length(), prefix_profile.length())));
+      } else {
+        return m_response_method_not_allowed;
+      }
+
     // GET|POST /options
     } else if (path == "/options") {
       if (method == "GET") {
@@ -616,6 +626,8 @@ Message* AdminService::dump_GET(const std::string &path) {
         status.dump_inbound(db);
       } else if (item == "outbound") {
         status.dump_outbound(db);
+      } else if (item == "threads") {
+        status.dump_threads(db);
       } else {
         db.push("Unknown dump item: ");
         db.push(item);
@@ -723,6 +735,73 @@ Message* AdminService::metrics_GET(pjs::Object *headers) {
   );
 }
 
+auto AdminService::profile_GET(const std::string &query) -> pjs::Object* {
+  if (!Profiler::supported()) {
+    return response(501, "Profiling is not supported on this platform");
+  }
+
+  double seconds = 10;
+  int frequency = 99;
+  std::string format("folded");
+
+  for (const auto &param : utils::split(query, '&')) {
+    auto p = param.find('=');
+    auto k = param.substr(0, p);
+    auto v = p == std::string::npos ? std::string() : param.substr(p + 1);
+    if (k == "seconds") {
+      seconds = std::atof(v.c_str());
+      if (seconds <= 0 || seconds > Profiler::MAX_DURATION) {
+        return response(400, "Invalid seconds, must be within (0, " + std::to_string(Profiler::MAX_DURATION) + "]");
+      }
+    } else if (k == "hz") {
+      frequency = std::atoi(v.c_str());
+      if (frequency <= 0 || frequency > Profiler::MAX_FREQUENCY) {
+        return response(400, "Invalid hz, must be within (0, " + std::to_string(Profiler::MAX_FREQUENCY) + "]");
+      }
+    } else if (k == "format") {
+      if (v != "folded" && v != "pprof") {
+        return response(400, "Invalid format, must be 'folded' or 'pprof'");
+      }
+      format = v;
+    }
+  }
+
+  auto promise = pjs::Promise::make();
+  auto settler = pjs::Promise::Settler::make(promise);
+  settler->retain();
+
+  auto started = WorkerManager::get().profile(
+    frequency, seconds,
+    [=](Profiler::Profile &profile) {
+      InputContext ic;
+      Data buf;
+      if (format == "pprof") {
+        profile.to_pprof(buf);
+        settler->resolve(
+          Message::make(
+            response_head(200, {
+              { "content-type", "application/octet-stream" },
+              { "content-disposition", "attachment; filename=\"profile.pb.gz\"" },
+            }),
+            Data::make(buf)
+          )
+        );
+      } else {
+        profile.to_folded(buf);
+        settler->resolve(response(buf));
+      }
+      settler->release();
+    }
+  );
+
+  if (!started) {
+    settler->release();
+    return response(409, "Another profiling session is in progress");
+  }
+
+  return promise;
+}
+
 Message* AdminService::options_GET() {
   return Message::make(
     m_response_head_text,
@@ -1428,7 +1507,7 @@ void AdminService::change_program(const std::string &path, bool reload) {
   }
 
   if (reload) {
-    WorkerManager::get().reload();
+    WorkerManager::get().reload(true);
     return;
   }
 
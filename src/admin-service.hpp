@@ -211,6 +211,7 @@ private:
   Message* log_GET();
   Message* log_GET(const std::string &path);
   Message* metrics_GET(pjs::Object *headers);
+  auto profile_GET(const std::string &query) -> pjs::Object*;
   Message* options_GET();
   Message* options_POST(Data *data);
 
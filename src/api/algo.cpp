@@ -633,6 +633,437 @@ auto SharedMap::Map::sub(pjs::Str::CharData *key, double value) -> double {
   return v.n();
 }
 
+//
+// TopicTrie
+//
+
+TopicTrie::TopicTrie(pjs::Str *name)
+  : m_trie(name ? Trie::get(name->str()) : new Trie)
+{
+}
+
+auto TopicTrie::size() -> size_t {
+  return m_trie->size();
+}
+
+void TopicTrie::subscribe(pjs::Str *filter, pjs::Str *key, const pjs::Value &value) {
+  pjs::SharedValue sv(value);
+  m_trie->subscribe(filter->str(), key->str(), sv);
+}
+
+bool TopicTrie::unsubscribe(pjs::Str *filter, pjs::Str *key) {
+  return m_trie->unsubscribe(filter->str(), key->str());
+}
+
+void TopicTrie::retain_message(pjs::Str *topic, const pjs::Value &value) {
+  if (value.is_nullish()) {
+    m_trie->retain_message(topic->str(), nullptr);
+  } else {
+    pjs::SharedValue sv(value);
+    m_trie->retain_message(topic->str(), &sv);
+  }
+}
+
+auto TopicTrie::match(pjs::Str *topic) -> pjs::Array* {
+  auto a = pjs::Array::make();
+  auto root = m_trie->subscriptions();
+  if (!root) return a;
+
+  std::vector<std::string> levels;
+  std::vector<const Subscriber*> subscribers;
+  std::vector<const Group*> groups;
+  split(topic->str(), levels);
+  match(root, levels, 0, subscribers, groups);
+
+  pjs::Value v;
+  for (const auto *s : subscribers) {
+    s->value.to_value(v);
+    a->push(v);
+  }
+  // One turn per match, so that every group moves on to its next
+  // member no matter how many groups a topic matches
+  auto turn = groups.empty() ? 0 : m_trie->pick();
+  for (const auto *g : groups) {
+    const auto &s = g->subscribers[turn % g->subscribers.size()];
+    s.value.to_value(v);
+    a->push(v);
+  }
+  return a;
+}
+
+auto TopicTrie::retained(pjs::Str *filter) -> pjs::Array* {
+  std::string group;
+  std::vector<std::string> levels;
+  parse_filter(filter->str(), group, levels);
+  auto a = pjs::Array::make();
+  if (group.empty()) {
+    if (auto root = m_trie->messages()) {
+      find_messages(root, levels, 0, a);
+    }
+  }
+  return a;
+}
+
+void TopicTrie::split(const std::string &topic, std::vector<std::string> &levels) {
+  size_t i = 0;
+  for (;;) {
+    auto j = topic.find('/', i);
+    if (j == std::string::npos) {
+      levels.push_back(topic.substr(i));
+      break;
+    }
+    levels.push_back(topic.substr(i, j - i));
+    i = j + 1;
+  }
+}
+
+void TopicTrie::parse_filter(const std::string &filter, std::string &group, std::vector<std::string> &levels) {
+  static const std::string s_share("$share/");
+  if (filter.empty()) throw std::runtime_error("empty topic filter");
+  if (!filter.compare(0, s_share.length(), s_share)) {
+    auto i = filter.find('/', s_share.length());
+    if (i == std::string::npos || i + 1 == filter.length()) {
+      throw std::runtime_error("missing topic filter in shared subscription: " + filter);
+    }
+    group = filter.substr(s_share.length(), i - s_share.length());
+    if (group.empty() || group.find_first_of("+#") != std::string::npos) {
+      throw std::runtime_error("invalid share name in shared subscription: " + filter);
+    }
+    split(filter.substr(i + 1), levels);
+  } else {
+    split(filter, levels);
+  }
+  for (size_t i = 0; i < levels.size(); i++) {
+    const auto &l = levels[i];
+    if (l.find_first_of("+#") == std::string::npos) continue;
+    if (l == "+") continue;
+    if (l == "#" && i + 1 == levels.size()) continue;
+    throw std::runtime_error("invalid wildcard in topic filter: " + filter);
+  }
+}
+
+void TopicTrie::match(
+  Node *node,
+  const std::vector<std::string> &levels, size_t i,
+  std::vector<const Subscriber*> &subscribers,
+  std::vector<const Group*> &groups
+) {
+  // Topics starting with '$' are not matched by a leading wildcard
+  bool is_system = (i == 0 && !levels[0].empty() && levels[0][0] == '$');
+  if (auto subs = node->subscriptions.get()) {
+    if (!is_system) {
+      for (const auto &s : subs->subscribers_multi) subscribers.push_back(&s);
+      for (const auto &g : subs->groups_multi) groups.push_back(&g);
+    }
+    if (i == levels.size()) {
+      for (const auto &s : subs->subscribers) subscribers.push_back(&s);
+      for (const auto &g : subs->groups) groups.push_back(&g);
+    }
+  }
+  if (i == levels.size()) return;
+  if (auto child = node->child(levels[i])) match(child, levels, i + 1, subscribers, groups);
+  if (!is_system && node->any_child) match(node->any_child, levels, i + 1, subscribers, groups);
+}
+
+void TopicTrie::find_messages(Node *node, const std::vector<std::string> &levels, size_t i, pjs::Array *messages) {
+  if (i == levels.size()) {
+    if (node->has_message) {
+      pjs::Value v;
+      node->message.to_value(v);
+      messages->push(v);
+    }
+    return;
+  }
+  const auto &l = levels[i];
+  if (l == "#") {
+    all_messages(node, i == 0, messages);
+  } else if (l == "+") {
+    if (!node->children) return;
+    for (const auto &p : node->children->map) {
+      if (i == 0 && !p.first.empty() && p.first[0] == '$') continue;
+      find_messages(p.second, levels, i + 1, messages);
+    }
+  } else if (auto child = node->child(l)) {
+    find_messages(child, levels, i + 1, messages);
+  }
+}
+
+void TopicTrie::all_messages(Node *node, bool is_root, pjs::Array *messages) {
+  if (node->has_message) {
+    pjs::Value v;
+    node->message.to_value(v);
+    messages->push(v);
+  }
+  if (!node->children) return;
+  for (const auto &p : node->children->map) {
+    if (is_root && !p.first.empty() && p.first[0] == '$') continue;
+    all_messages(p.second, false, messages);
+  }
+}
+
+//
+// TopicTrie::Node
+//
+
+bool TopicTrie::Node::Subscriptions::empty() const {
+  return (
+    subscribers.empty() && subscribers_multi.empty() &&
+    groups.empty() && groups_multi.empty()
+  );
+}
+
+auto TopicTrie::Node::clone() const -> Node* {
+  auto n = new Node;
+  n->children = children;
+  n->any_child = any_child;
+  n->subscriptions = subscriptions;
+  n->message = message;
+  n->has_message = has_message;
+  return n;
+}
+
+auto TopicTrie::Node::child(const std::string &name) const -> Node* {
+  if (!children) return nullptr;
+  auto i = children->map.find(name);
+  return i == children->map.end() ? nullptr : i->second.get();
+}
+
+void TopicTrie::Node::set_child(const std::string &name, Node *node) {
+  auto c = new Children;
+  if (children) c->map = children->map;
+  c->map[name] = node;
+  children = c;
+}
+
+void TopicTrie::Node::erase_child(const std::string &name) {
+  if (!children) return;
+  if (children->map.size() == 1) {
+    children = nullptr;
+  } else {
+    auto c = new Children;
+    c->map = children->map;
+    c->map.erase(name);
+    children = c;
+  }
+}
+
+auto TopicTrie::Node::writable_subscriptions() -> Subscriptions* {
+  auto s = new Subscriptions;
+  if (auto old = subscriptions.get()) {
+    s->subscribers = old->subscribers;
+    s->subscribers_multi = old->subscribers_multi;
+    s->groups = old->groups;
+    s->groups_multi = old->groups_multi;
+  }
+  subscriptions = s;
+  return s;
+}
+
+bool TopicTrie::Node::empty() const {
+  return (
+    !children && !any_child && !has_message &&
+    (!subscriptions || subscriptions->empty())
+  );
+}
+
+//
+// TopicTrie::Trie
+//
+
+std::map<std::string, TopicTrie::Trie*> TopicTrie::Trie::m_tries;
+std::mutex TopicTrie::Trie::m_tries_mutex;
+
+auto TopicTrie::Trie::get(const std::string &name) -> Trie* {
+  std::lock_guard<std::mutex> lock(m_tries_mutex);
+  auto &p = m_tries[name];
+  if (!p) {
+    p = new Trie;
+    p->retain();
+  }
+  return p;
+}
+
+auto TopicTrie::Trie::size() -> size_t {
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+  return m_size;
+}
+
+void TopicTrie::Trie::subscribe(const std::string &filter, const std::string &key, const pjs::SharedValue &value) {
+  std::string group;
+  std::vector<std::string> levels;
+  parse_filter(filter, group, levels);
+  bool multi = (levels.back() == "#");
+  if (multi) levels.pop_back();
+
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+
+  // Copy the path down to the subscription node
+  pjs::Ref<Node> root(m_subscriptions ? m_subscriptions->clone() : new Node);
+  auto node = root.get();
+  for (const auto &l : levels) {
+    if (l == "+") {
+      node->any_child = node->any_child ? node->any_child->clone() : new Node;
+      node = node->any_child;
+    } else {
+      auto child = node->child(l);
+      child = child ? child->clone() : new Node;
+      node->set_child(l, child);
+      node = child;
+    }
+  }
+
+  auto subs = node->writable_subscriptions();
+  auto list = multi ? &subs->subscribers_multi : &subs->subscribers;
+  if (!group.empty()) {
+    auto &groups = multi ? subs->groups_multi : subs->groups;
+    auto g = std::find_if(groups.begin(), groups.end(), [&](const Group &g) { return g.name == group; });
+    if (g == groups.end()) {
+      groups.emplace_back();
+      groups.back().name = group;
+      g = groups.end() - 1;
+    }
+    list = &g->subscribers;
+  }
+
+  auto s = std::find_if(list->begin(), list->end(), [&](const Subscriber &s) { return s.key == key; });
+  if (s == list->end()) {
+    list->push_back({ key, value });
+    m_size++;
+  } else {
+    s->value = value;
+  }
+
+  std::lock_guard<std::mutex> lock_root(m_root_mutex);
+  m_subscriptions = root;
+}
+
+bool TopicTrie::Trie::unsubscribe(const std::string &filter, const std::string &key) {
+  std::string group;
+  std::vector<std::string> levels;
+  parse_filter(filter, group, levels);
+  bool multi = (levels.back() == "#");
+  if (multi) levels.pop_back();
+
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+
+  auto find = [&](Node::Subscriptions *subs) -> std::vector<Subscriber>* {
+    if (!subs) return nullptr;
+    if (group.empty()) return multi ? &subs->subscribers_multi : &subs->subscribers;
+    auto &groups = multi ? subs->groups_multi : subs->groups;
+    for (auto &g : groups) if (g.name == group) return &g.subscribers;
+    return nullptr;
+  };
+
+  auto has_key = [&](std::vector<Subscriber> *list) {
+    return list && std::any_of(list->begin(), list->end(), [&](const Subscriber &s) { return s.key == key; });
+  };
+
+  // Look it up before copying anything
+  auto node = m_subscriptions.get();
+  if (!node) return false;
+  for (const auto &l : levels) {
+    node = (l == "+" ? node->any_child.get() : node->child(l));
+    if (!node) return false;
+  }
+  if (!has_key(find(node->subscriptions))) return false;
+
+  pjs::Ref<Node> root(m_subscriptions->clone());
+  std::vector<Node*> path;
+  path.push_back(root);
+  for (const auto &l : levels) {
+    auto parent = path.back();
+    if (l == "+") {
+      parent->any_child = parent->any_child->clone();
+      path.push_back(parent->any_child);
+    } else {
+      auto child = parent->child(l)->clone();
+      parent->set_child(l, child);
+      path.push_back(child);
+    }
+  }
+
+  node = path.back();
+  auto subs = node->writable_subscriptions();
+  auto list = find(subs);
+  list->erase(std::find_if(list->begin(), list->end(), [&](const Subscriber &s) { return s.key == key; }));
+  if (list->empty() && !group.empty()) {
+    auto &groups = multi ? subs->groups_multi : subs->groups;
+    groups.erase(std::find_if(groups.begin(), groups.end(), [&](const Group &g) { return g.name == group; }));
+  }
+  if (subs->empty()) node->subscriptions = nullptr;
+  m_size--;
+
+  // Prune nodes left empty
+  for (auto i = levels.size(); i > 0 && path[i]->empty(); i--) {
+    const auto &l = levels[i-1];
+    if (l == "+") {
+      path[i-1]->any_child = nullptr;
+    } else {
+      path[i-1]->erase_child(l);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock_root(m_root_mutex);
+  m_subscriptions = root;
+  return true;
+}
+
+void TopicTrie::Trie::retain_message(const std::string &topic, const pjs::SharedValue *value) {
+  if (topic.empty() || topic.find_first_of("+#") != std::string::npos) {
+    throw std::runtime_error("invalid topic name: " + topic);
+  }
+
+  std::vector<std::string> levels;
+  split(topic, levels);
+
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+
+  if (!value) {
+    auto node = m_messages.get();
+    for (const auto &l : levels) {
+      if (!node) return;
+      node = node->child(l);
+    }
+    if (!node || !node->has_message) return;
+  }
+
+  pjs::Ref<Node> root(m_messages ? m_messages->clone() : new Node);
+  std::vector<Node*> path;
+  path.push_back(root);
+  for (const auto &l : levels) {
+    auto parent = path.back();
+    auto child = parent->child(l);
+    child = child ? child->clone() : new Node;
+    parent->set_child(l, child);
+    path.push_back(child);
+  }
+
+  auto node = path.back();
+  if (value) {
+    node->message = *value;
+    node->has_message = true;
+  } else {
+    node->message = pjs::SharedValue();
+    node->has_message = false;
+    for (auto i = levels.size(); i > 0 && path[i]->empty(); i--) {
+      path[i-1]->erase_child(levels[i-1]);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock_root(m_root_mutex);
+  m_messages = root;
+}
+
+auto TopicTrie::Trie::subscriptions() -> pjs::Ref<Node> {
+  std::lock_guard<std::mutex> lock(m_root_mutex);
+  return m_subscriptions;
+}
+
+auto TopicTrie::Trie::messages() -> pjs::Ref<Node> {
+  std::lock_guard<std::mutex> lock(m_root_mutex);
+  return m_messages;
+}
+
 //
 // URLRouter
 //
@@ -1751,6 +2182,74 @@ template<> void ClassDef<Constructor<SharedMap>>::init() {
   ctor();
 }
 
+//
+// TopicTrie
+//
+
+template<> void ClassDef<TopicTrie>::init() {
+  ctor([](Context &ctx) -> Object * {
+    Str *name = nullptr;
+    if (!ctx.arguments(0, &name)) return nullptr;
+    return TopicTrie::make(name);
+  });
+
+  accessor("size", [](Object *obj, Value &ret) { ret.set((int)obj->as<TopicTrie>()->size()); });
+
+  method("subscribe", [](Context &ctx, Object *obj, Value &ret) {
+    Str *filter, *key;
+    Value value;
+    if (!ctx.arguments(2, &filter, &key, &value)) return;
+    if (ctx.argc() < 3) value.set(key);
+    try {
+      obj->as<TopicTrie>()->subscribe(filter, key, value);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  method("unsubscribe", [](Context &ctx, Object *obj, Value &ret) {
+    Str *filter, *key;
+    if (!ctx.arguments(2, &filter, &key)) return;
+    try {
+      ret.set(obj->as<TopicTrie>()->unsubscribe(filter, key));
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  method("retain", [](Context &ctx, Object *obj, Value &ret) {
+    Str *topic;
+    Value value;
+    if (!ctx.arguments(1, &topic, &value)) return;
+    try {
+      obj->as<TopicTrie>()->retain_message(topic, value);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  method("match", [](Context &ctx, Object *obj, Value &ret) {
+    Str *topic;
+    if (!ctx.arguments(1, &topic)) return;
+    ret.set(obj->as<TopicTrie>()->match(topic));
+  });
+
+  method("retained", [](Context &ctx, Object *obj, Value &ret) {
+    Str *filter;
+    if (!ctx.arguments(1, &filter)) return;
+    try {
+      ret.set(obj->as<TopicTrie>()->retained(filter));
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+}
+
+template<> void ClassDef<Constructor<TopicTrie>>::init() {
+  super<Function>();
+  ctor();
+}
+
 //
 // URLRouter
 //
@@ -2079,6 +2578,7 @@ template<> void ClassDef<Algo>::init() {
   variable("Cache", class_of<Constructor<Cache>>());
   variable("Quota", class_of<Constructor<Quota>>());
   variable("SharedMap", class_of<Constructor<SharedMap>>());
+  variable("TopicTrie", class_of<Constructor<TopicTrie>>());
   variable("URLRouter", class_of<Constructor<URLRouter>>());
   variable("LoadBalancer", class_of<Constructor<LoadBalancer>>());
   variable("HashingLoadBalancer", class_of<Constructor<HashingLoadBalancer>>());
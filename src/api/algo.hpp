@@ -38,6 +38,7 @@
 #include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace pipy {
 namespace algo {
@@ -305,6 +306,113 @@ private:
   friend class pjs::ObjectTemplate<ResourcePool>;
 };
 
+//
+// TopicTrie
+//
+
+class TopicTrie : public pjs::ObjectTemplate<TopicTrie> {
+public:
+  auto size() -> size_t;
+  void subscribe(pjs::Str *filter, pjs::Str *key, const pjs::Value &value);
+  bool unsubscribe(pjs::Str *filter, pjs::Str *key);
+  void retain_message(pjs::Str *topic, const pjs::Value &value);
+  auto match(pjs::Str *topic) -> pjs::Array*;
+  auto retained(pjs::Str *filter) -> pjs::Array*;
+
+private:
+  TopicTrie(pjs::Str *name = nullptr);
+
+  struct Subscriber {
+    std::string key;
+    pjs::SharedValue value;
+  };
+
+  struct Group {
+    std::string name;
+    std::vector<Subscriber> subscribers;
+  };
+
+  //
+  // TopicTrie::Node
+  //
+  // Nodes are never modified once published. Writers copy
+  // the nodes along the path they change and swap in a new root.
+  // The children map and the subscriber lists of a node are held
+  // in separately shared parts, so a copied node shares them with
+  // the original until the writer changes one of them. A write still
+  // copies the children map of every node on its path, that is, one
+  // pointer per sibling of each level it goes through.
+  //
+
+  class Node : public pjs::RefCountMT<Node> {
+  public:
+    struct Children : public pjs::RefCountMT<Children> {
+      std::unordered_map<std::string, pjs::Ref<Node>> map;
+    };
+
+    struct Subscriptions : public pjs::RefCountMT<Subscriptions> {
+      std::vector<Subscriber> subscribers;
+      std::vector<Subscriber> subscribers_multi;
+      std::vector<Group> groups;
+      std::vector<Group> groups_multi;
+      bool empty() const;
+    };
+
+    pjs::Ref<Children> children;
+    pjs::Ref<Node> any_child;
+    pjs::Ref<Subscriptions> subscriptions;
+    pjs::SharedValue message;
+    bool has_message = false;
+
+    auto clone() const -> Node*;
+    auto child(const std::string &name) const -> Node*;
+    void set_child(const std::string &name, Node *node);
+    void erase_child(const std::string &name);
+    auto writable_subscriptions() -> Subscriptions*;
+    bool empty() const;
+  };
+
+  //
+  // TopicTrie::Trie
+  //
+
+  class Trie : public pjs::RefCountMT<Trie> {
+  public:
+    Trie() : m_pick(0) {}
+
+    static auto get(const std::string &name) -> Trie*;
+
+    auto size() -> size_t;
+    void subscribe(const std::string &filter, const std::string &key, const pjs::SharedValue &value);
+    bool unsubscribe(const std::string &filter, const std::string &key);
+    void retain_message(const std::string &topic, const pjs::SharedValue *value);
+    auto subscriptions() -> pjs::Ref<Node>;
+    auto messages() -> pjs::Ref<Node>;
+    auto pick() -> size_t { return m_pick.fetch_add(1, std::memory_order_relaxed); }
+
+  private:
+    pjs::Ref<Node> m_subscriptions;
+    pjs::Ref<Node> m_messages;
+    size_t m_size = 0;
+    std::mutex m_write_mutex;
+    std::mutex m_root_mutex;
+    std::atomic<size_t> m_pick;
+
+    static std::map<std::string, Trie*> m_tries;
+    static std::mutex m_tries_mutex;
+  };
+
+  pjs::Ref<Trie> m_trie;
+
+  static void split(const std::string &topic, std::vector<std::string> &levels);
+  static void parse_filter(const std::string &filter, std::string &group, std::vector<std::string> &levels);
+  static void match(Node *node, const std::vector<std::string> &levels, size_t i, std::vector<const Subscriber*> &subscribers, std::vector<const Group*> &groups);
+  static void find_messages(Node *node, const std::vector<std::string> &levels, size_t i, pjs::Array *messages);
+  static void all_messages(Node *node, bool is_root, pjs::Array *messages);
+
+  friend class pjs::ObjectTemplate<TopicTrie>;
+};
+
 //
 // URLRouter
 //
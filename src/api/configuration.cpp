@@ -52,6 +52,7 @@
 #include "filters/exec.hpp"
 #include "filters/fcgi.hpp"
 #include "filters/fork.hpp"
+#include "filters/grpc.hpp"
 #include "filters/http.hpp"
 #include "filters/insert.hpp"
 #include "filters/link.hpp"
@@ -182,8 +183,12 @@ void FilterConfigurator::decode_bgp(pjs::Object *options) {
   append_filter(new bgp::Decoder(options));
 }
 
-void FilterConfigurator::decode_dubbo() {
-  append_filter(new dubbo::Decoder());
+void FilterConfigurator::decode_dubbo(pjs::Object *options) {
+  append_filter(new dubbo::Decoder(options));
+}
+
+void FilterConfigurator::decode_grpc() {
+  append_filter(new grpc::Decoder());
 }
 
 void FilterConfigurator::decode_http_request(pjs::Function *handler) {
@@ -210,12 +215,12 @@ void FilterConfigurator::decode_resp() {
   append_filter(new resp::Decoder());
 }
 
-void FilterConfigurator::decode_thrift() {
-  append_filter(new thrift::Decoder());
+void FilterConfigurator::decode_thrift(pjs::Object *options) {
+  append_filter(new thrift::Decoder(options));
 }
 
-void FilterConfigurator::decode_websocket() {
-  append_filter(new websocket::Decoder());
+void FilterConfigurator::decode_websocket(pjs::Object *options) {
+  append_filter(new websocket::Decoder(options));
 }
 
 void FilterConfigurator::decompress(const pjs::Value &algorithm) {
@@ -266,6 +271,10 @@ void FilterConfigurator::encode_dubbo() {
   append_filter(new dubbo::Encoder());
 }
 
+void FilterConfigurator::encode_grpc(const pjs::Value &head) {
+  append_filter(new grpc::Encoder(head));
+}
+
 void FilterConfigurator::encode_http_request(pjs::Object *options, pjs::Function *handler) {
   append_filter(new http::RequestEncoder(options, handler));
 }
@@ -290,8 +299,8 @@ void FilterConfigurator::encode_thrift() {
   append_filter(new thrift::Encoder());
 }
 
-void FilterConfigurator::encode_websocket() {
-  append_filter(new websocket::Encoder());
+void FilterConfigurator::encode_websocket(pjs::Object *options) {
+  append_filter(new websocket::Encoder(options));
 }
 
 void FilterConfigurator::exec(const pjs::Value &command, pjs::Object *options) {
@@ -370,6 +379,10 @@ void FilterConfigurator::mux_http(pjs::Function *session_selector, pjs::Object *
   }
 }
 
+void FilterConfigurator::mux_resp(const std::vector<std::string> &nodes, pjs::Object *options) {
+  require_sub_pipeline(append_filter(new resp::Mux(nodes, options)));
+}
+
 void FilterConfigurator::pack(int batch_size, pjs::Object *options) {
   append_filter(new Pack(batch_size, options));
 }
@@ -1327,7 +1340,20 @@ template<> void ClassDef<FilterConfigurator>::init() {
   method("decodeDubbo", [](Context &ctx, Object *thiz, Value &result) {
     auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
     try {
-      config->decode_dubbo();
+      Object *options = nullptr;
+      if (!ctx.arguments(0, &options)) return;
+      config->decode_dubbo(options);
+      result.set(thiz);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  // FilterConfigurator.decodeGRPC
+  method("decodeGRPC", [](Context &ctx, Object *thiz, Value &result) {
+    auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
+    try {
+      config->decode_grpc();
       result.set(thiz);
     } catch (std::runtime_error &err) {
       ctx.error(err);
@@ -1408,7 +1434,9 @@ template<> void ClassDef<FilterConfigurator>::init() {
   method("decodeThrift", [](Context &ctx, Object *thiz, Value &result) {
     auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
     try {
-      config->decode_thrift();
+      Object *options = nullptr;
+      if (!ctx.arguments(0, &options)) return;
+      config->decode_thrift(options);
       result.set(thiz);
     } catch (std::runtime_error &err) {
       ctx.error(err);
@@ -1419,7 +1447,9 @@ template<> void ClassDef<FilterConfigurator>::init() {
   method("decodeWebSocket", [](Context &ctx, Object *thiz, Value &result) {
     auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
     try {
-      config->decode_websocket();
+      Object *options = nullptr;
+      if (!ctx.arguments(0, &options)) return;
+      config->decode_websocket(options);
       result.set(thiz);
     } catch (std::runtime_error &err) {
       ctx.error(err);
@@ -1603,6 +1633,19 @@ template<> void ClassDef<FilterConfigurator>::init() {
     }
   });
 
+  // FilterConfigurator.encodeGRPC
+  method("encodeGRPC", [](Context &ctx, Object *thiz, Value &result) {
+    auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
+    Value head;
+    if (!ctx.arguments(0, &head)) return;
+    try {
+      config->encode_grpc(head);
+      result.set(thiz);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
   // FilterConfigurator.encodeHTTPRequest
   method("encodeHTTPRequest", [](Context &ctx, Object *thiz, Value &result) {
     auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
@@ -1687,7 +1730,9 @@ template<> void ClassDef<FilterConfigurator>::init() {
   method("encodeWebSocket", [](Context &ctx, Object *thiz, Value &result) {
     auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
     try {
-      config->encode_websocket();
+      Object *options = nullptr;
+      if (!ctx.arguments(0, &options)) return;
+      config->encode_websocket(options);
       result.set(thiz);
     } catch (std::runtime_error &err) {
       ctx.error(err);
@@ -2019,6 +2064,35 @@ template<> void ClassDef<FilterConfigurator>::init() {
     }
   });
 
+  // FilterConfigurator.muxRESP
+  method("muxRESP", [](Context &ctx, Object *thiz, Value &result) {
+    auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
+    try {
+      Str *node;
+      Array *nodes;
+      Object *options = nullptr;
+      std::vector<std::string> list;
+      if (ctx.try_arguments(1, &node, &options)) {
+        list.push_back(node->str());
+      } else if (ctx.try_arguments(1, &nodes, &options)) {
+        nodes->iterate_all(
+          [&](Value &v, int) {
+            auto *s = v.to_string();
+            list.push_back(s->str());
+            s->release();
+          }
+        );
+      } else {
+        ctx.error_argument_type(0, "a string or an array");
+        return;
+      }
+      config->mux_resp(list, options);
+      result.set(thiz);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
   // FilterConfigurator.pack
   method("pack", [](Context &ctx, Object *thiz, Value &result) {
     auto config = thiz->as<FilterConfigurator>()->trace_location(ctx);
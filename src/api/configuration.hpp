@@ -71,15 +71,16 @@ public:
   void connect_socks(const pjs::Value &address);
   void connect_tls(pjs::Object *options);
   void decode_bgp(pjs::Object *options);
-  void decode_dubbo();
+  void decode_dubbo(pjs::Object *options);
+  void decode_grpc();
   void decode_http_request(pjs::Function *handler);
   void decode_http_response(pjs::Function *handler);
   void decode_mqtt();
   void decode_multipart();
   void decode_netlink();
   void decode_resp();
-  void decode_thrift();
-  void decode_websocket();
+  void decode_thrift(pjs::Object *options);
+  void decode_websocket(pjs::Object *options);
   void decompress(const pjs::Value &algorithm);
   void decompress_http();
   void deframe(pjs::Object *states);
@@ -92,13 +93,14 @@ public:
   void dump(const pjs::Value &tag);
   void encode_bgp(pjs::Object *options);
   void encode_dubbo();
+  void encode_grpc(const pjs::Value &head);
   void encode_http_request(pjs::Object *options, pjs::Function *handler);
   void encode_http_response(pjs::Object *options, pjs::Function *handler);
   void encode_mqtt();
   void encode_netlink();
   void encode_resp();
   void encode_thrift();
-  void encode_websocket();
+  void encode_websocket(pjs::Object *options);
   void exec(const pjs::Value &command, pjs::Object *options);
   void fork(const pjs::Value &init_arg);
   void handle_body(pjs::Function *callback, pjs::Object *options);
@@ -113,6 +115,7 @@ public:
   void mux(pjs::Function *session_selector, pjs::Object *options);
   void mux_fcgi(pjs::Function *session_selector, pjs::Object *options);
   void mux_http(pjs::Function *session_selector, pjs::Object *options);
+  void mux_resp(const std::vector<std::string> &nodes, pjs::Object *options);
   void pack(int batch_size, pjs::Object *options);
   void print();
   void produce(const pjs::Value &producer);
@@ -36,9 +36,11 @@
 #include <openssl/hmac.h>
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
+#include <openssl/sha.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 
+#include <atomic>
 #include <stdexcept>
 
 namespace pipy {
@@ -1026,9 +1028,15 @@ bool Verify::verify(PublicKey *key, pjs::Str *signature, Data::Encoding enc, con
 // JWK
 //
 
-JWK::JWK(pjs::Object *json) {
-  pjs::Value kty, crv, n, e, x, y;
+static std::atomic<uint64_t> s_jwk_id(0);
+
+JWK::JWK(pjs::Object *json)
+  : m_id(++s_jwk_id)
+{
+  pjs::Value kid, kty, crv, n, e, x, y;
+  json->get("kid", kid);
   json->get("kty", kty);
+  if (kid.is_string()) m_kid = kid.s();
   if (!kty.is_string()) throw std::runtime_error("missing \"kty\"");
   if (kty.s()->str() == "RSA") {
     json->get("n", n);
@@ -1080,16 +1088,82 @@ JWK::JWK(pjs::Object *json) {
 }
 
 JWK::~JWK() {
+  if (m_pkey_ctx) {
+    EVP_PKEY_CTX_free(m_pkey_ctx);
+  }
+  if (m_md_ctx) {
+    EVP_MD_CTX_free(m_md_ctx);
+  }
   if (m_pkey) {
     EVP_PKEY_free(m_pkey);
   }
 }
 
+auto JWK::pkey_ctx(const EVP_MD *md) -> EVP_PKEY_CTX* {
+  if (!m_pkey) return nullptr;
+  if (m_pkey_ctx && m_pkey_ctx_md == md) return m_pkey_ctx;
+  if (!m_pkey_ctx) m_pkey_ctx = EVP_PKEY_CTX_new(m_pkey, nullptr);
+  EVP_PKEY_verify_init(m_pkey_ctx);
+  EVP_PKEY_CTX_set_rsa_padding(m_pkey_ctx, RSA_PKCS1_PADDING);
+  EVP_PKEY_CTX_set_signature_md(m_pkey_ctx, md);
+  m_pkey_ctx_md = md;
+  return m_pkey_ctx;
+}
+
+auto JWK::md_ctx() -> EVP_MD_CTX* {
+  if (!m_md_ctx) m_md_ctx = EVP_MD_CTX_new();
+  return m_md_ctx;
+}
+
+//
+// JWKS
+//
+
+JWKS::JWKS(pjs::Object *json) {
+  pjs::Value keys;
+  if (json->is_array()) {
+    keys.set(json);
+  } else {
+    json->get("keys", keys);
+    if (!keys.is_array()) throw std::runtime_error("missing \"keys\"");
+  }
+  keys.as<pjs::Array>()->iterate_all(
+    [this](pjs::Value &v, int) {
+      if (v.is_object() && v.o()) add(v.o());
+    }
+  );
+}
+
+auto JWKS::get(pjs::Str *kid) const -> JWK* {
+  auto i = m_keys.find(kid ? kid->str() : std::string());
+  if (i == m_keys.end()) return nullptr;
+  return i->second;
+}
+
+void JWKS::add(pjs::Object *json) {
+  pjs::Ref<JWK> key;
+
+  // Skip keys of unsupported types rather than failing the whole set
+  try {
+    key = JWK::make(json);
+  } catch (std::runtime_error &) {
+    return;
+  }
+
+  if (!key->is_valid()) return;
+  auto kid = key->kid();
+  m_keys[kid ? kid->str() : std::string()] = key;
+}
+
 //
 // JWT
 //
 
-JWT::JWT(pjs::Str *token) {
+thread_local JWT::Cache JWT::s_cache;
+
+JWT::JWT(pjs::Str *token)
+  : m_token(token)
+{
   auto segs = utils::split(token->str(), '.');
   if (segs.size() != 3) return;
 
@@ -1119,6 +1193,10 @@ JWT::JWT(pjs::Str *token) {
   if (int(algorithm) < 0) return;
   m_algorithm = algorithm;
 
+  pjs::Value exp;
+  m_payload.o()->get("exp", exp);
+  if (exp.is_number()) m_expiration = exp.n();
+
   switch (algorithm) {
     case Algorithm::ES256:
     case Algorithm::ES384:
@@ -1155,7 +1233,29 @@ bool JWT::verify(pjs::Str *key) {
 
 bool JWT::verify(JWK *key) {
   if (!key || !key->is_valid()) return false;
-  return verify(key->pkey());
+  if (!m_is_valid) return false;
+  // JWKs are told apart by their unique IDs, prefixed so as not to
+  // collide with the digests of keys given as strings or Data
+  std::string cache_key(1 + sizeof(uint64_t), 'J');
+  auto id = key->id();
+  std::memcpy(&cache_key[1], &id, sizeof(id));
+  if (s_cache.find(m_token->str(), cache_key)) return true;
+
+  auto md = get_md();
+  if (!md) return false;
+
+  auto pctx = key->pkey_ctx(md);
+  if (!pctx || !verify(pctx, key->md_ctx(), md)) return false;
+
+  s_cache.add(m_token->str(), cache_key, m_expiration);
+  return true;
+}
+
+bool JWT::verify(JWKS *keys) {
+  if (!keys || !m_is_valid) return false;
+  pjs::Value kid;
+  m_header.o()->get("kid", kid);
+  return verify(keys->get(kid.is_string() ? kid.s() : nullptr));
 }
 
 bool JWT::verify(PublicKey *key) {
@@ -1180,6 +1280,18 @@ auto JWT::get_md() -> const EVP_MD* {
 bool JWT::verify(const char *key, int key_len) {
   if (!m_is_valid) return false;
 
+  // Keys given as strings or Data are told apart by the SHA-256 digest
+  // of their content, so that a different key never hits the cache
+  std::string cache_key(1 + SHA256_DIGEST_LENGTH, 'K');
+  SHA256((const unsigned char *)key, key_len, (unsigned char *)&cache_key[1]);
+  if (s_cache.find(m_token->str(), cache_key)) return true;
+  if (!verify_key(key, key_len)) return false;
+
+  s_cache.add(m_token->str(), cache_key, m_expiration);
+  return true;
+}
+
+bool JWT::verify_key(const char *key, int key_len) {
   if (m_algorithm == Algorithm::HS256 ||
       m_algorithm == Algorithm::HS384 ||
       m_algorithm == Algorithm::HS512
@@ -1222,30 +1334,36 @@ bool JWT::verify(EVP_PKEY *pkey) {
   auto md = get_md();
   if (!md) return false;
 
+  auto mdctx = EVP_MD_CTX_new();
+  auto pctx = EVP_PKEY_CTX_new(pkey, nullptr);
+  EVP_PKEY_verify_init(pctx);
+  EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PADDING);
+  EVP_PKEY_CTX_set_signature_md(pctx, md);
+
+  auto result = verify(pctx, mdctx, md);
+
+  EVP_PKEY_CTX_free(pctx);
+  EVP_MD_CTX_free(mdctx);
+
+  return result;
+}
+
+bool JWT::verify(EVP_PKEY_CTX *pctx, EVP_MD_CTX *mdctx, const EVP_MD *md) {
   unsigned char hash[EVP_MAX_MD_SIZE];
   unsigned int hash_size;
 
-  auto mdctx = EVP_MD_CTX_new();
   EVP_DigestInit_ex(mdctx, md, nullptr);
   EVP_DigestUpdate(mdctx, m_header_str.c_str(), m_header_str.length());
   EVP_DigestUpdate(mdctx, ".", 1);
   EVP_DigestUpdate(mdctx, m_payload_str.c_str(), m_payload_str.length());
   EVP_DigestFinal_ex(mdctx, hash, &hash_size);
 
-  auto pctx = EVP_PKEY_CTX_new(pkey, nullptr);
-  EVP_PKEY_verify_init(pctx);
-  EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PADDING);
-  EVP_PKEY_CTX_set_signature_md(pctx, md);
-
   auto result = EVP_PKEY_verify(
     pctx,
     (unsigned char *)m_signature.c_str(),
     m_signature.length(),
     hash, hash_size);
 
-  EVP_PKEY_CTX_free(pctx);
-  EVP_MD_CTX_free(mdctx);
-
   return result == 1;
 }
 
@@ -1290,6 +1408,46 @@ int JWT::jose2der(char *out, const char *inp, int len) {
   return i;
 }
 
+//
+// JWT::Cache
+//
+
+static const size_t JWT_CACHE_SIZE = 10000;
+static const double JWT_CACHE_TTL = 60; // for tokens without "exp"
+
+bool JWT::Cache::find(const std::string &token, const std::string &key) {
+  auto i = m_entries.find(token);
+  if (i == m_entries.end()) return false;
+  auto &e = i->second;
+  if (e.key != key) return false;
+  if (e.expiration <= utils::now() / 1000) {
+    m_entries.erase(i);
+    return false;
+  }
+  return true;
+}
+
+void JWT::Cache::add(const std::string &token, const std::string &key, double expiration) {
+  auto now = utils::now() / 1000;
+  if (expiration <= 0) expiration = now + JWT_CACHE_TTL;
+  if (m_entries.size() >= JWT_CACHE_SIZE && !m_entries.count(token)) {
+    for (auto i = m_entries.begin(); i != m_entries.end(); ) {
+      auto &e = i->second;
+      if (e.expiration <= now) {
+        i = m_entries.erase(i);
+      } else {
+        i++;
+      }
+    }
+    if (m_entries.size() >= JWT_CACHE_SIZE) {
+      m_entries.clear();
+    }
+  }
+  auto &e = m_entries[token];
+  e.key = key;
+  e.expiration = expiration;
+}
+
 } // namespace crypto
 } // namespace pipy
 
@@ -1822,6 +1980,36 @@ template<> void ClassDef<Constructor<JWK>>::init() {
   ctor();
 }
 
+//
+// JWKS
+//
+
+template<> void ClassDef<JWKS>::init() {
+  ctor([](Context &ctx) -> Object* {
+    Object *json;
+    if (!ctx.check<Object>(0, json)) return nullptr;
+    try {
+      return JWKS::make(json);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+      return nullptr;
+    }
+  });
+
+  accessor("size", [](Object *obj, Value &ret) { ret.set(int(obj->as<JWKS>()->size())); });
+
+  method("get", [](Context &ctx, Object *obj, Value &ret) {
+    Str *kid;
+    if (!ctx.arguments(1, &kid)) return;
+    ret.set(obj->as<JWKS>()->get(kid));
+  });
+}
+
+template<> void ClassDef<Constructor<JWKS>>::init() {
+  super<Function>();
+  ctor();
+}
+
 //
 // JWT
 //
@@ -1853,10 +2041,12 @@ template<> void ClassDef<JWT>::init() {
     pipy::Data *data = nullptr;
     Str *str = nullptr;
     JWK *jwk = nullptr;
+    JWKS *jwks = nullptr;
     PublicKey *pkey = nullptr;
     if ((ctx.try_arguments(1, &data) && data) ||
         ctx.try_arguments(1, &str) ||
         ctx.try_arguments(1, &jwk) ||
+        ctx.try_arguments(1, &jwks) ||
         ctx.try_arguments(1, &pkey)
     ) {
       try {
@@ -1866,6 +2056,8 @@ template<> void ClassDef<JWT>::init() {
           ret.set(obj->as<JWT>()->verify(str));
         } else if (jwk) {
           ret.set(obj->as<JWT>()->verify(jwk));
+        } else if (jwks) {
+          ret.set(obj->as<JWT>()->verify(jwks));
         } else if (pkey) {
           ret.set(obj->as<JWT>()->verify(pkey));
         }
@@ -1901,6 +2093,7 @@ template<> void ClassDef<Crypto>::init() {
   variable("Verify", class_of<Constructor<Verify>>());
   variable("JWT", class_of<Constructor<JWT>>());
   variable("JWK", class_of<Constructor<JWK>>());
+  variable("JWKS", class_of<Constructor<JWKS>>());
 }
 
 } // namespace pjs
@@ -32,6 +32,8 @@
 
 #include <openssl/evp.h>
 
+#include <unordered_map>
+
 namespace pipy {
 namespace crypto {
 
@@ -325,17 +327,47 @@ private:
 class JWK : public pjs::ObjectTemplate<JWK> {
 public:
   bool is_valid() const { return m_pkey; }
+  auto id() const -> uint64_t { return m_id; }
+  auto kid() const -> pjs::Str* { return m_kid; }
   auto pkey() const -> EVP_PKEY* { return m_pkey; }
 
+  // Contexts kept for reuse across verifications with this key
+  auto pkey_ctx(const EVP_MD *md) -> EVP_PKEY_CTX*;
+  auto md_ctx() -> EVP_MD_CTX*;
+
 private:
   JWK(pjs::Object *json);
   ~JWK();
 
+  uint64_t m_id;
+  pjs::Ref<pjs::Str> m_kid;
   EVP_PKEY* m_pkey = nullptr;
+  EVP_PKEY_CTX* m_pkey_ctx = nullptr;
+  EVP_MD_CTX* m_md_ctx = nullptr;
+  const EVP_MD* m_pkey_ctx_md = nullptr;
 
   friend class pjs::ObjectTemplate<JWK>;
 };
 
+//
+// JWKS
+//
+
+class JWKS : public pjs::ObjectTemplate<JWKS> {
+public:
+  auto size() const -> size_t { return m_keys.size(); }
+  auto get(pjs::Str *kid) const -> JWK*;
+
+private:
+  JWKS(pjs::Object *json);
+
+  std::unordered_map<std::string, pjs::Ref<JWK>> m_keys;
+
+  void add(pjs::Object *json);
+
+  friend class pjs::ObjectTemplate<JWKS>;
+};
+
 //
 // JWT
 //
@@ -361,14 +393,41 @@ public:
   bool verify(Data *key);
   bool verify(pjs::Str *key);
   bool verify(JWK *key);
+  bool verify(JWKS *keys);
   bool verify(PublicKey *key);
 
 private:
   JWT(pjs::Str *token);
   ~JWT();
 
+  //
+  // JWT::Cache
+  //
+  // Tokens that passed verification, along with the key they were
+  // verified with, kept until their "exp" for each thread, or for
+  // a fixed TTL if they have no "exp"
+  //
+
+  class Cache {
+  public:
+    bool find(const std::string &token, const std::string &key);
+    void add(const std::string &token, const std::string &key, double expiration);
+
+  private:
+    struct Entry {
+      std::string key;
+      double expiration;
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+  };
+
+  thread_local static Cache s_cache;
+
   bool m_is_valid = false;
   Algorithm m_algorithm = Algorithm::HS256;
+  pjs::Ref<pjs::Str> m_token;
+  double m_expiration = 0;
   pjs::Value m_header;
   pjs::Value m_payload;
   std::string m_header_str;
@@ -378,7 +437,9 @@ private:
 
   auto get_md() -> const EVP_MD*;
   bool verify(const char *key, int key_len);
+  bool verify_key(const char *key, int key_len);
   bool verify(EVP_PKEY *pkey);
+  bool verify(EVP_PKEY_CTX *pctx, EVP_MD_CTX *mdctx, const EVP_MD *md);
   int jose2der(char *out, const char *inp, int len);
 
   friend class pjs::ObjectTemplate<JWT>;
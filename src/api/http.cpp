@@ -157,6 +157,102 @@ auto ResponseHead::error_to_status(StreamEnd::Error err, int &status) -> pjs::St
   }
 }
 
+//
+// EncodedHead
+//
+
+auto EncodedHead::get(MessageStart *start) -> EncodedHead* {
+  if (!start->is_frozen()) return nullptr;
+  if (auto obj = start->cache()) {
+    if (obj->is<EncodedHead>()) {
+      auto eh = obj->as<EncodedHead>();
+      if (eh->is_modified()) eh->invalidate();
+      return eh;
+    }
+  }
+  auto eh = EncodedHead::make(start->head());
+  start->cache(eh);
+  return eh;
+}
+
+//
+// Flattens the head down to header values into a list of keys and
+// values, with an empty value closing each object or array
+//
+
+static void snapshot_object(pjs::Object *obj, std::vector<pjs::Value> &values, int depth) {
+  auto push = [&](const pjs::Value &v) {
+    values.push_back(v);
+    if (depth < 2 && v.is_object() && v.o()) {
+      snapshot_object(v.o(), values, depth + 1);
+    }
+  };
+  if (obj->is_array()) {
+    obj->as<pjs::Array>()->iterate_all([&](pjs::Value &v, int) { push(v); });
+  } else {
+    obj->iterate_all([&](pjs::Str *k, pjs::Value &v) { values.push_back(k); push(v); });
+  }
+  values.push_back(pjs::Value::empty);
+}
+
+void EncodedHead::snapshot() {
+  m_snapshot.clear();
+  if (m_head) snapshot_object(m_head, m_snapshot, 0);
+}
+
+//
+// Walks the head in the same order as snapshot_object() and
+// stops at the first value that is not identical to the snapshot
+//
+
+static bool compare_object(pjs::Object *obj, const std::vector<pjs::Value> &values, size_t &i, int depth) {
+  auto check = [&](const pjs::Value &v, int depth) {
+    if (i >= values.size() || !pjs::Value::is_identical(values[i++], v)) return false;
+    if (depth >= 0 && depth < 2 && v.is_object() && v.o()) {
+      return compare_object(v.o(), values, i, depth + 1);
+    }
+    return true;
+  };
+  bool same = true;
+  if (obj->is_array()) {
+    obj->as<pjs::Array>()->iterate_while([&](pjs::Value &v, int) { return (same = check(v, depth)); });
+  } else {
+    same = obj->iterate_while([&](pjs::Str *k, pjs::Value &v) { return check(k, -1) && check(v, depth); });
+  }
+  return same && check(pjs::Value::empty, -1);
+}
+
+bool EncodedHead::is_modified() {
+  if (!m_head) return false;
+  size_t i = 0;
+  return !compare_object(m_head, m_snapshot, i, 0);
+}
+
+void EncodedHead::invalidate() {
+  m_request_head = nullptr;
+  m_response_head = nullptr;
+  for (auto *blocks : { m_http1, m_http2 }) {
+    for (int i = 0; i < 2; i++) {
+      auto &b = blocks[i];
+      b.data.clear();
+      b.header_connection = nullptr;
+      b.header_upgrade = nullptr;
+      b.encoded = false;
+    }
+  }
+  snapshot();
+}
+
+auto EncodedHead::request_head() -> RequestHead* {
+  if (!m_request_head) m_request_head = pjs::coerce<RequestHead>(m_head);
+  return m_request_head;
+}
+
+auto EncodedHead::response_head() -> ResponseHead* {
+  if (!m_response_head) m_response_head = pjs::coerce<ResponseHead>(m_head);
+  return m_response_head;
+}
+
 //
 // Match
 //
@@ -912,6 +1008,9 @@ template<> void ClassDef<ResponseHead>::init() {
   field<Ref<Str>>("statusText", [](ResponseHead *obj) { return &obj->statusText; });
 }
 
+template<> void ClassDef<EncodedHead>::init() {
+}
+
 template<> void ClassDef<Match>::init() {
   super<Function>();
   ctor([](Context &ctx) -> Object* {
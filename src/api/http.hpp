@@ -88,6 +88,49 @@ public:
   static auto error_to_status(StreamEnd::Error err, int &status) -> pjs::Str*;
 };
 
+//
+// EncodedHead
+//
+// Wire format of a frozen message head as encoded by HTTP/1 and HTTP/2
+// encoders, cached along with the MessageStart of the frozen message.
+// Scripts can still modify a frozen head, so the values it had when
+// encoded are kept and compared by identity before every reuse. Any
+// change drops the encoded forms to have them encoded again.
+//
+
+class EncodedHead : public pjs::ObjectTemplate<EncodedHead> {
+public:
+  static auto get(MessageStart *start) -> EncodedHead*;
+
+  struct Block {
+    Data data;
+    pjs::Ref<pjs::Str> header_connection;
+    pjs::Ref<pjs::Str> header_upgrade;
+    bool encoded = false;
+  };
+
+  auto request_head() -> RequestHead*;
+  auto response_head() -> ResponseHead*;
+  auto http1(bool is_response) -> Block& { return m_http1[is_response]; }
+  auto http2(bool is_response) -> Block& { return m_http2[is_response]; }
+
+private:
+  EncodedHead(pjs::Object *head) : m_head(head) { snapshot(); }
+
+  pjs::Ref<pjs::Object> m_head;
+  pjs::Ref<RequestHead> m_request_head;
+  pjs::Ref<ResponseHead> m_response_head;
+  Block m_http1[2];
+  Block m_http2[2];
+  std::vector<pjs::Value> m_snapshot;
+
+  void snapshot();
+  bool is_modified();
+  void invalidate();
+
+  friend class pjs::ObjectTemplate<EncodedHead>;
+};
+
 //
 // Match
 //
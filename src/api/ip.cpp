@@ -24,8 +24,10 @@
  */
 
 #include "ip.hpp"
+#include "inbound.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace pipy {
@@ -435,6 +437,311 @@ void IPMask::init_mask() {
   }
 }
 
+//
+// IPMap
+//
+
+IPMap::Prefix::Prefix(IPMask *mask) {
+  std::memset(bytes, 0, sizeof(bytes));
+  mask->base_data().to_bytes(bytes);
+  length = mask->bitmask();
+  is_v6 = mask->base_data().is_v6();
+}
+
+IPMap::Prefix::Prefix(const Prefix &p, int len) {
+  std::memset(bytes, 0, sizeof(bytes));
+  std::memcpy(bytes, p.bytes, len >> 3);
+  if (len & 7) bytes[len >> 3] = p.bytes[len >> 3] & (0xff << (8 - (len & 7)));
+  length = len;
+  is_v6 = p.is_v6;
+}
+
+bool IPMap::Prefix::operator<(const Prefix &r) const {
+  if (is_v6 != r.is_v6) return r.is_v6;
+  if (length != r.length) return length < r.length;
+  return std::memcmp(bytes, r.bytes, sizeof(bytes)) < 0;
+}
+
+template<int BITS, int WIDTH>
+inline auto IPMap::Table<BITS, WIDTH>::index(const uint8_t *bytes, int level) -> int {
+  auto bit = level * BITS;
+  return (bytes[bit >> 3] >> (8 - BITS - (bit & 7))) & (FANOUT - 1);
+}
+
+template<int BITS, int WIDTH>
+void IPMap::Table<BITS, WIDTH>::insert(const uint8_t *bytes, int length, uint32_t value) {
+  size_t node = 0;
+  int level = 0;
+  while (length > (level + 1) * BITS) {
+    node = child(node * FANOUT + index(bytes, level));
+    level++;
+  }
+  auto bits = length - level * BITS;
+  auto first = index(bytes, level) & ~((FANOUT >> bits) - 1);
+  auto count = FANOUT >> bits;
+  for (int i = 0; i < count; i++) {
+    assign(node * FANOUT + first + i, value, length);
+  }
+}
+
+template<int BITS, int WIDTH>
+void IPMap::Table<BITS, WIDTH>::erase(const uint8_t *bytes, int length, uint32_t value, int parent_length) {
+  size_t path[LEVELS];
+  size_t node = 0;
+  int level = 0;
+  while (length > (level + 1) * BITS) {
+    auto i = node * FANOUT + index(bytes, level);
+    auto c = m_slots[i].child;
+    if (!c) return;
+    path[level++] = i;
+    node = c;
+  }
+  auto bits = length - level * BITS;
+  auto first = index(bytes, level) & ~((FANOUT >> bits) - 1);
+  auto count = FANOUT >> bits;
+  for (int i = 0; i < count; i++) {
+    reset(node * FANOUT + first + i, length, value, parent_length);
+  }
+  while (level > 0) collapse(path[--level]);
+}
+
+template<int BITS, int WIDTH>
+auto IPMap::Table<BITS, WIDTH>::lookup(const uint8_t *bytes) const -> uint32_t {
+  size_t node = 0;
+  uint32_t value = 0;
+  for (int level = 0; level < LEVELS; level++) {
+    const auto &slot = m_slots[node * FANOUT + index(bytes, level)];
+    value = slot.value;
+    if (!slot.child) break;
+    node = slot.child;
+  }
+  return value;
+}
+
+//
+// A new child node starts out with what its parent slot carries.
+// Nodes are recycled after they collapse back into their parent slots.
+//
+
+template<int BITS, int WIDTH>
+auto IPMap::Table<BITS, WIDTH>::child(size_t i) -> uint32_t {
+  if (auto c = m_slots[i].child) return c;
+  Slot inherited;
+  inherited.value = m_slots[i].value;
+  inherited.length = m_slots[i].length;
+  uint32_t c;
+  if (m_free_nodes.empty()) {
+    c = m_slots.size() / FANOUT;
+    m_slots.resize(m_slots.size() + FANOUT, inherited);
+  } else {
+    c = m_free_nodes.back();
+    m_free_nodes.pop_back();
+    std::fill(m_slots.begin() + c * FANOUT, m_slots.begin() + (c + 1) * FANOUT, inherited);
+  }
+  m_slots[i].child = c;
+  return c;
+}
+
+//
+// A slot is only taken over by a prefix at least as long as the one
+// it already has. Slots in a child node are never covered by a shorter
+// prefix than their parent slot, so the walk stops where it fails.
+//
+
+template<int BITS, int WIDTH>
+void IPMap::Table<BITS, WIDTH>::assign(size_t i, uint32_t value, int length) {
+  auto &slot = m_slots[i];
+  if (slot.length > length) return;
+  slot.value = value;
+  slot.length = length;
+  if (auto c = slot.child) {
+    for (int j = 0; j < FANOUT; j++) {
+      assign(c * FANOUT + j, value, length);
+    }
+  }
+}
+
+//
+// Slots still holding the removed prefix go back to the next shorter
+// prefix covering them. No other prefix of the same length can overlap.
+//
+
+template<int BITS, int WIDTH>
+void IPMap::Table<BITS, WIDTH>::reset(size_t i, int length, uint32_t value, int parent_length) {
+  auto &slot = m_slots[i];
+  if (slot.length != length) return;
+  slot.value = value;
+  slot.length = parent_length;
+  if (auto c = slot.child) {
+    for (int j = 0; j < FANOUT; j++) {
+      reset(c * FANOUT + j, length, value, parent_length);
+    }
+    collapse(i);
+  }
+}
+
+template<int BITS, int WIDTH>
+void IPMap::Table<BITS, WIDTH>::collapse(size_t i) {
+  auto &slot = m_slots[i];
+  auto c = slot.child;
+  if (!c) return;
+  for (int j = 0; j < FANOUT; j++) {
+    const auto &s = m_slots[c * FANOUT + j];
+    if (s.child || s.value != slot.value || s.length != slot.length) return;
+  }
+  slot.child = 0;
+  m_free_nodes.push_back(c);
+}
+
+static auto ip_map_key(const pjs::Value &key) -> IPMask* {
+  if (key.is<IPMask>()) return key.as<IPMask>();
+  auto s = key.to_string();
+  try {
+    auto mask = IPMask::make(s);
+    s->release();
+    return mask;
+  } catch (std::runtime_error &) {
+    s->release();
+    throw;
+  }
+}
+
+void IPMap::load(pjs::Object *entries) {
+  std::map<Prefix, pjs::Value> prefixes;
+  if (entries) {
+    auto add = [&](const pjs::Value &k, const pjs::Value &v) {
+      pjs::Ref<IPMask> mask(ip_map_key(k));
+      prefixes[Prefix(mask)] = v;
+    };
+    if (entries->is_array()) {
+      entries->as<pjs::Array>()->iterate_all(
+        [&](pjs::Value &v, int) {
+          if (v.is_array()) {
+            pjs::Value key, val;
+            v.as<pjs::Array>()->get(0, key);
+            v.as<pjs::Array>()->get(1, val);
+            add(key, val);
+          } else {
+            add(v, true);
+          }
+        }
+      );
+    } else {
+      entries->iterate_all(
+        [&](pjs::Str *k, pjs::Value &v) {
+          add(k, v);
+        }
+      );
+    }
+  }
+  clear();
+  for (const auto &p : prefixes) {
+    auto v = alloc_value(p.second);
+    m_prefixes[p.first] = v;
+    insert(p.first, v);
+  }
+}
+
+void IPMap::set(IPMask *mask, const pjs::Value &value) {
+  Prefix k(mask);
+  auto i = m_prefixes.find(k);
+  if (i != m_prefixes.end()) {
+    m_values[i->second - 1] = value;
+  } else {
+    auto v = alloc_value(value);
+    m_prefixes[k] = v;
+    insert(k, v);
+  }
+}
+
+bool IPMap::erase(IPMask *mask) {
+  Prefix k(mask);
+  auto i = m_prefixes.find(k);
+  if (i == m_prefixes.end()) return false;
+  auto v = i->second;
+  m_prefixes.erase(i);
+  remove(k);
+  m_values[v - 1] = pjs::Value::undefined;
+  m_free_values.push_back(v);
+  return true;
+}
+
+void IPMap::clear() {
+  m_prefixes.clear();
+  m_values.clear();
+  m_free_values.clear();
+  m_table_v4 = Table<8, 32>();
+  m_table_v6 = Table<4, 128>();
+}
+
+bool IPMap::find(const uint8_t *bytes, bool is_v6, pjs::Value &value) {
+  auto i = is_v6 ? m_table_v6.lookup(bytes) : m_table_v4.lookup(bytes);
+  if (!i) return false;
+  value = m_values[i - 1];
+  return true;
+}
+
+bool IPMap::find(const IPAddressData &ip, pjs::Value &value) {
+  uint8_t bytes[16];
+  ip.to_bytes(bytes);
+  return find(bytes, ip.is_v6(), value);
+}
+
+bool IPMap::find(const char *addr, pjs::Value &value) {
+  uint8_t bytes[16];
+  if (utils::get_ip_v4(addr, bytes)) return find(bytes, false, value);
+  if (utils::get_ip_v6(addr, bytes)) return find(bytes, true, value);
+  return false;
+}
+
+//
+// Values are referred to by 1-based indices in the tables,
+// where 0 means no match. Indices of removed prefixes are reused.
+//
+
+auto IPMap::alloc_value(const pjs::Value &value) -> uint32_t {
+  if (!m_free_values.empty()) {
+    auto v = m_free_values.back();
+    m_free_values.pop_back();
+    m_values[v - 1] = value;
+    return v;
+  }
+  if (m_values.size() >= (1 << 24) - 1) throw std::runtime_error("too many entries in IPMap");
+  m_values.push_back(value);
+  return m_values.size();
+}
+
+void IPMap::insert(const Prefix &prefix, uint32_t value) {
+  if (prefix.is_v6) {
+    m_table_v6.insert(prefix.bytes, prefix.length, value);
+  } else {
+    m_table_v4.insert(prefix.bytes, prefix.length, value);
+  }
+}
+
+//
+// Slots of a removed prefix fall back to the longest remaining prefix
+// that covers it, looked up by masking it down one bit at a time.
+//
+
+void IPMap::remove(const Prefix &prefix) {
+  uint32_t parent = 0;
+  int parent_length = 0;
+  for (int len = prefix.length - 1; len >= 0; len--) {
+    auto i = m_prefixes.find(Prefix(prefix, len));
+    if (i != m_prefixes.end()) {
+      parent = i->second;
+      parent_length = len;
+      break;
+    }
+  }
+  if (prefix.is_v6) {
+    m_table_v6.erase(prefix.bytes, prefix.length, parent, parent_length);
+  } else {
+    m_table_v4.erase(prefix.bytes, prefix.length, parent, parent_length);
+  }
+}
+
 //
 // IPEndpoint
 //
@@ -594,6 +901,87 @@ template<> void ClassDef<Constructor<IPMask>>::init() {
   ctor();
 }
 
+//
+// IPMap
+//
+
+template<> void ClassDef<IPMap>::init() {
+  ctor([](Context &ctx) -> Object* {
+    Object *entries = nullptr;
+    if (!ctx.arguments(0, &entries)) return nullptr;
+    try {
+      return IPMap::make(entries);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+      return nullptr;
+    }
+  });
+
+  accessor("size", [](Object *obj, Value &ret) { ret.set((int)obj->as<IPMap>()->size()); });
+
+  method("load", [](Context &ctx, Object *obj, Value &ret) {
+    Object *entries = nullptr;
+    if (!ctx.arguments(0, &entries)) return;
+    try {
+      obj->as<IPMap>()->load(entries);
+      ret.set(obj);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  method("set", [](Context &ctx, Object *obj, Value &ret) {
+    Value key, val;
+    if (!ctx.arguments(1, &key, &val)) return;
+    try {
+      Ref<IPMask> mask(ip_map_key(key));
+      obj->as<IPMap>()->set(mask, val);
+      ret.set(obj);
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  method("delete", [](Context &ctx, Object *obj, Value &ret) {
+    Value key;
+    if (!ctx.arguments(1, &key)) return;
+    try {
+      Ref<IPMask> mask(ip_map_key(key));
+      ret.set(obj->as<IPMap>()->erase(mask));
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+    }
+  });
+
+  method("clear", [](Context &ctx, Object *obj, Value &ret) {
+    obj->as<IPMap>()->clear();
+  });
+
+  method("find", [](Context &ctx, Object *obj, Value &ret) {
+    Str *str;
+    IP *ip;
+    Inbound *inbound;
+    if (ctx.get(0, str)) {
+      obj->as<IPMap>()->find(str->c_str(), ret);
+    } else if (ctx.get(0, ip)) {
+      obj->as<IPMap>()->find(ip->data(), ret);
+    } else if (ctx.get(0, inbound)) {
+      uint8_t bytes[16];
+      switch (inbound->remote_ip(bytes)) {
+        case 4: obj->as<IPMap>()->find(bytes, false, ret); break;
+        case 6: obj->as<IPMap>()->find(bytes, true, ret); break;
+      }
+    } else {
+      ctx.error_argument_type(0, "a string, an IP or an Inbound");
+    }
+  });
+}
+
+template<> void ClassDef<Constructor<IPMap>>::init() {
+  super<Function>();
+  ctor();
+}
+
 //
 // IPEndpoint
 //
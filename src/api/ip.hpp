@@ -28,6 +28,9 @@
 
 #include "pjs/pjs.hpp"
 
+#include <map>
+#include <vector>
+
 namespace pipy {
 
 //
@@ -97,6 +100,7 @@ public:
   auto version() const -> int { return m_ip_full.is_v6() ? 6 : 4; }
   auto ip() -> pjs::Str* { return m_ip_full.to_string(); }
   auto bitmask() const -> int { return m_bitmask; }
+  auto base_data() const -> const IPAddressData& { return m_ip_base; }
   auto base() -> pjs::Str* { return m_ip_base.to_string(); }
   auto mask() -> pjs::Str* { return m_ip_mask.to_string(); }
   auto hostmask() -> pjs::Str*;
@@ -139,6 +143,88 @@ private:
   friend class pjs::ObjectTemplate<IPMask>;
 };
 
+//
+// IPMap
+//
+
+class IPMap : public pjs::ObjectTemplate<IPMap> {
+public:
+  auto size() const -> size_t { return m_prefixes.size(); }
+  void load(pjs::Object *entries);
+  void set(IPMask *mask, const pjs::Value &value);
+  bool erase(IPMask *mask);
+  void clear();
+  bool find(const uint8_t *bytes, bool is_v6, pjs::Value &value);
+  bool find(const IPAddressData &ip, pjs::Value &value);
+  bool find(const char *addr, pjs::Value &value);
+
+private:
+  IPMap() {}
+  IPMap(pjs::Object *entries) { load(entries); }
+
+  struct Prefix {
+    uint8_t bytes[16];
+    int length;
+    bool is_v6;
+    Prefix(IPMask *mask);
+    Prefix(const Prefix &p, int len);
+    bool operator<(const Prefix &r) const;
+  };
+
+  //
+  // IPMap::Table
+  //
+  // A multibit trie with BITS-bit strides. Prefixes are expanded to the
+  // stride and every slot carries the value and length of the longest
+  // prefix covering it, so a lookup just keeps the last slot it passes
+  // through. Knowing the length of that prefix, a slot can be updated
+  // in place when a prefix is added or removed.
+  //
+
+  template<int BITS, int WIDTH>
+  class Table {
+  public:
+    Table() : m_slots(FANOUT) {}
+    void insert(const uint8_t *bytes, int length, uint32_t value);
+    void erase(const uint8_t *bytes, int length, uint32_t value, int parent_length);
+    auto lookup(const uint8_t *bytes) const -> uint32_t;
+
+  private:
+    enum {
+      FANOUT = 1 << BITS,
+      LEVELS = WIDTH / BITS,
+    };
+
+    struct Slot {
+      uint32_t value : 24;
+      uint32_t length : 8;
+      uint32_t child;
+      Slot() : value(0), length(0), child(0) {}
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free_nodes;
+
+    static auto index(const uint8_t *bytes, int level) -> int;
+    auto child(size_t i) -> uint32_t;
+    void assign(size_t i, uint32_t value, int length);
+    void reset(size_t i, int length, uint32_t value, int parent_length);
+    void collapse(size_t i);
+  };
+
+  std::map<Prefix, uint32_t> m_prefixes;
+  std::vector<pjs::Value> m_values;
+  std::vector<uint32_t> m_free_values;
+  Table<8, 32> m_table_v4;
+  Table<4, 128> m_table_v6;
+
+  auto alloc_value(const pjs::Value &value) -> uint32_t;
+  void insert(const Prefix &prefix, uint32_t value);
+  void remove(const Prefix &prefix);
+
+  friend class pjs::ObjectTemplate<IPMap>;
+};
+
 //
 // IPEndpoint
 //
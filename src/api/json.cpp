@@ -25,9 +25,14 @@
 
 #include "json.hpp"
 #include "utils.hpp"
-#include "yajl/yajl_parse.h"
 
-#include <stack>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace pjs {
 
@@ -40,6 +45,8 @@ using namespace pipy;
 template<> void ClassDef<JSON>::init() {
   ctor();
 
+  variable("Template", class_of<Constructor<JSON::Template>>());
+
   method("parse", [](Context &ctx, Object *obj, Value &ret) {
     Str *str;
     Function *reviver = nullptr;
@@ -133,90 +140,493 @@ template<> void ClassDef<JSON>::init() {
   });
 }
 
+//
+// JSON::Template
+//
+
+template<> void ClassDef<JSON::Template>::init() {
+  ctor([](Context &ctx) -> Object* {
+    Object *shape;
+    if (!ctx.arguments(1, &shape)) return nullptr;
+    return JSON::Template::make(shape);
+  });
+
+  method("stringify", [](Context &ctx, Object *obj, Value &ret) {
+    Object *o;
+    if (!ctx.arguments(1, &o)) return;
+    ret.set(obj->as<JSON::Template>()->stringify(o));
+  });
+
+  method("encode", [](Context &ctx, Object *obj, Value &ret) {
+    Object *o;
+    if (!ctx.arguments(1, &o)) return;
+    auto *data = pipy::Data::make();
+    obj->as<JSON::Template>()->encode(o, *data);
+    ret.set(data);
+  });
+}
+
+template<> void ClassDef<Constructor<JSON::Template>>::init() {
+  super<Function>();
+  ctor();
+}
+
 } // namespace pjs
 
 namespace pipy {
 
 static Data::Producer s_dp("JSON");
 
+//
+// Returns the first quote, backslash or control character in [p, e),
+// 16 bytes at a time where SSE2 is available, 8 bytes at a time otherwise.
+//
+
+static auto find_special(const char *p, const char *e) -> const char* {
+#ifdef __SSE2__
+  const auto quote = _mm_set1_epi8('"');
+  const auto slash = _mm_set1_epi8('\\');
+  const auto ctrl = _mm_set1_epi8(0x1f);
+  while (e - p >= 16) {
+    auto v = _mm_loadu_si128((const __m128i*)p);
+    auto m = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, slash)),
+      _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl), ctrl)
+    );
+    if (auto bits = _mm_movemask_epi8(m)) return p + __builtin_ctz(bits);
+    p += 16;
+  }
+#else
+  const uint64_t ones = 0x0101010101010101ull;
+  const uint64_t high = 0x8080808080808080ull;
+  while (e - p >= 8) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    auto q = v ^ (ones * '"');
+    auto s = v ^ (ones * '\\');
+    auto m = ((q - ones) & ~q) | ((s - ones) & ~s) | ((v - ones * 0x20) & ~v);
+    if (m & high) break;
+    p += 8;
+  }
+#endif
+  while (p < e) {
+    auto c = (unsigned char)*p;
+    if (c == '"' || c == '\\' || c < 0x20) break;
+    p++;
+  }
+  return p;
+}
+
 //
 // JSONVisitor
 //
+// Reads JSON text straight out of the chunks of a Data (or a string)
+// without copying. Strings and keys that fall entirely in one chunk and
+// carry no escapes are handed over to the visitor in place. Only tokens
+// straddling a chunk boundary or containing escapes go through a buffer.
+//
 
 class JSONVisitor {
 public:
-  JSONVisitor(JSON::Visitor *visitor) : m_parser(yajl_alloc(&s_callbacks, nullptr, visitor)) {}
-  ~JSONVisitor() { yajl_free(m_parser); }
+  JSONVisitor(JSON::Visitor *visitor) : m_visitor(visitor) {}
 
   bool visit(const std::string &str, std::string &err) {
-    if (yajl_status_ok == yajl_parse(m_parser, (const unsigned char*)str.c_str(), str.length()) &&
-        yajl_status_ok == yajl_complete_parse(m_parser)
-    ) return true;
-    get_error(0, err);
-    return false;
+    m_spans.clear();
+    m_spans.emplace_back(str.c_str(), str.length());
+    return read(err);
   }
 
   bool visit(const Data &data, std::string &err) {
-    size_t pos = 0;
+    m_spans.clear();
     for (const auto c : data.chunks()) {
       auto ptr = std::get<0>(c);
       auto len = std::get<1>(c);
-      auto ret = yajl_parse(m_parser, (const unsigned char*)ptr, len);
-      if (ret != yajl_status_ok) {
-        get_error(pos, err);
-        return false;
-      }
-      pos += len;
-    }
-    if (yajl_status_ok != yajl_complete_parse(m_parser)) {
-      get_error(pos, err);
-      return false;
+      if (len > 0) m_spans.emplace_back(ptr, len);
     }
-    return true;
+    return read(err);
   }
 
 private:
-  yajl_handle m_parser;
+  JSON::Visitor* m_visitor;
+  std::vector<std::pair<const char*, size_t>> m_spans;
+  std::vector<char> m_stack;
+  std::string m_buffer;
+  size_t m_span = 0;
+  size_t m_base = 0;
+  const char* m_begin = nullptr;
+  const char* m_ptr = nullptr;
+  const char* m_end = nullptr;
+  const char* m_error = nullptr;
+  uint32_t m_surrogate = 0;
 
-  void get_error(size_t base_position, std::string &err) {
-    auto err_str = yajl_get_error(m_parser, false, nullptr, 0);
+  bool read(std::string &err) {
+    m_stack.clear();
+    m_span = 0;
+    m_base = 0;
+    m_error = nullptr;
+    if (m_spans.empty()) {
+      m_begin = m_ptr = m_end = nullptr;
+    } else {
+      m_begin = m_ptr = m_spans[0].first;
+      m_end = m_ptr + m_spans[0].second;
+    }
+    if (read_text()) return true;
     char str_buf[1000];
     std::snprintf(
       str_buf, sizeof(str_buf),
       "In JSON at position %d: %s",
-      int(base_position + yajl_get_bytes_consumed(m_parser)),
-      err_str
+      int(position()), m_error
     );
     err.assign(str_buf);
-    yajl_free_error(m_parser, err_str);
+    return false;
+  }
+
+  auto position() const -> size_t {
+    return m_base + (m_ptr - m_begin);
   }
 
-  static yajl_callbacks s_callbacks;
+  bool fail(const char *msg) {
+    m_error = msg;
+    return false;
+  }
 
-  static int yajl_null(void *ctx) { static_cast<JSON::Visitor*>(ctx)->null(); return 1; }
-  static int yajl_boolean(void *ctx, int val) { static_cast<JSON::Visitor*>(ctx)->boolean(val); return 1; }
-  static int yajl_integer(void *ctx, long long val) { static_cast<JSON::Visitor*>(ctx)->integer(val); return 1; }
-  static int yajl_double(void *ctx, double val) { static_cast<JSON::Visitor*>(ctx)->number(val); return 1; }
-  static int yajl_string(void *ctx, const unsigned char *val, size_t len) { static_cast<JSON::Visitor*>(ctx)->string((const char *)val, len); return 1; }
-  static int yajl_start_map(void *ctx) { static_cast<JSON::Visitor*>(ctx)->map_start(); return 1; }
-  static int yajl_map_key(void *ctx, const unsigned char *key, size_t len) { static_cast<JSON::Visitor*>(ctx)->map_key((const char *)key, len); return 1; }
-  static int yajl_end_map(void *ctx) { static_cast<JSON::Visitor*>(ctx)->map_end(); return 1; }
-  static int yajl_start_array(void *ctx) { static_cast<JSON::Visitor*>(ctx)->array_start(); return 1; }
-  static int yajl_end_array(void *ctx) { static_cast<JSON::Visitor*>(ctx)->array_end(); return 1; }
-};
+  bool next_span() {
+    if (m_span + 1 >= m_spans.size()) return false;
+    m_base += m_end - m_begin;
+    const auto &s = m_spans[++m_span];
+    m_begin = m_ptr = s.first;
+    m_end = m_ptr + s.second;
+    return true;
+  }
+
+  bool peek(char &c) {
+    if (m_ptr == m_end && !next_span()) return false;
+    c = *m_ptr;
+    return true;
+  }
+
+  bool get(char &c) {
+    if (m_ptr == m_end && !next_span()) return false;
+    c = *m_ptr++;
+    return true;
+  }
 
-yajl_callbacks JSONVisitor::s_callbacks = {
-  &JSONVisitor::yajl_null,
-  &JSONVisitor::yajl_boolean,
-  &JSONVisitor::yajl_integer,
-  &JSONVisitor::yajl_double,
-  nullptr,
-  &JSONVisitor::yajl_string,
-  &JSONVisitor::yajl_start_map,
-  &JSONVisitor::yajl_map_key,
-  &JSONVisitor::yajl_end_map,
-  &JSONVisitor::yajl_start_array,
-  &JSONVisitor::yajl_end_array,
+  bool skip_space() {
+    for (;;) {
+      while (m_ptr < m_end) {
+        switch (*m_ptr) {
+          case ' ': case '\t': case '\r': case '\n': m_ptr++; break;
+          default: return true;
+        }
+      }
+      if (!next_span()) return false;
+    }
+  }
+
+  bool read_text() {
+    if (!skip_space()) return fail("premature EOF");
+    if (!read_value()) return false;
+    if (skip_space()) return fail("trailing garbage");
+    return true;
+  }
+
+  bool read_value() {
+    for (;;) {
+      if (!skip_space()) return fail("premature EOF");
+      switch (*m_ptr) {
+        case '{':
+          m_ptr++;
+          m_visitor->map_start();
+          if (!skip_space()) return fail("premature EOF");
+          if (*m_ptr == '}') {
+            m_ptr++;
+            m_visitor->map_end();
+            break;
+          }
+          m_stack.push_back('{');
+          if (!read_key()) return false;
+          continue;
+        case '[':
+          m_ptr++;
+          m_visitor->array_start();
+          if (!skip_space()) return fail("premature EOF");
+          if (*m_ptr == ']') {
+            m_ptr++;
+            m_visitor->array_end();
+            break;
+          }
+          m_stack.push_back('[');
+          continue;
+        case '"':
+          if (!read_string(false)) return false;
+          break;
+        case 't':
+          if (!read_literal("true")) return false;
+          m_visitor->boolean(true);
+          break;
+        case 'f':
+          if (!read_literal("false")) return false;
+          m_visitor->boolean(false);
+          break;
+        case 'n':
+          if (!read_literal("null")) return false;
+          m_visitor->null();
+          break;
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+          if (!read_number()) return false;
+          break;
+        default: return fail("invalid char in json text");
+      }
+
+      for (;;) {
+        if (m_stack.empty()) return true;
+        if (!skip_space()) return fail("premature EOF");
+        auto c = *m_ptr++;
+        if (m_stack.back() == '{') {
+          if (c == ',') {
+            if (!read_key()) return false;
+            break;
+          } else if (c == '}') {
+            m_stack.pop_back();
+            m_visitor->map_end();
+          } else {
+            m_ptr--;
+            return fail("after key and value, inside map, I expect ',' or '}'");
+          }
+        } else {
+          if (c == ',') {
+            break;
+          } else if (c == ']') {
+            m_stack.pop_back();
+            m_visitor->array_end();
+          } else {
+            m_ptr--;
+            return fail("after array element, I expect ',' or ']'");
+          }
+        }
+      }
+    }
+  }
+
+  bool read_key() {
+    if (!skip_space()) return fail("premature EOF");
+    if (*m_ptr != '"') return fail("invalid object key (must be a string)");
+    if (!read_string(true)) return false;
+    if (!skip_space()) return fail("premature EOF");
+    if (*m_ptr != ':') return fail("object key and value must be separated by a colon (':')");
+    m_ptr++;
+    return true;
+  }
+
+  bool read_literal(const char *s) {
+    while (*s) {
+      char c;
+      if (!get(c)) return fail("premature EOF");
+      if (c != *s++) {
+        m_ptr--;
+        return fail("invalid string in json text");
+      }
+    }
+    return true;
+  }
+
+  bool read_number() {
+    auto &buf = m_buffer;
+    buf.clear();
+    char c;
+    peek(c);
+    if (c == '-') {
+      buf += c; m_ptr++;
+      if (!peek(c)) return fail("premature EOF");
+    }
+    if (c == '0') {
+      buf += c; m_ptr++;
+    } else if ('1' <= c && c <= '9') {
+      do { buf += c; m_ptr++; } while (peek(c) && '0' <= c && c <= '9');
+    } else {
+      return fail("malformed number, a digit is required after the minus sign");
+    }
+    bool is_integer = true;
+    if (peek(c) && c == '.') {
+      is_integer = false;
+      buf += c; m_ptr++;
+      if (!peek(c) || c < '0' || '9' < c) return fail("malformed number, a digit is required after the decimal point");
+      do { buf += c; m_ptr++; } while (peek(c) && '0' <= c && c <= '9');
+    }
+    if (peek(c) && (c == 'e' || c == 'E')) {
+      is_integer = false;
+      buf += c; m_ptr++;
+      if (peek(c) && (c == '+' || c == '-')) { buf += c; m_ptr++; }
+      if (!peek(c) || c < '0' || '9' < c) return fail("malformed number, a digit is required after the exponent");
+      do { buf += c; m_ptr++; } while (peek(c) && '0' <= c && c <= '9');
+    }
+
+    if (is_integer) {
+      if (buf.length() <= 18) {
+        int64_t n = 0;
+        for (size_t i = (buf[0] == '-' ? 1 : 0); i < buf.length(); i++) n = n * 10 + (buf[i] - '0');
+        m_visitor->integer(buf[0] == '-' ? -n : n);
+        return true;
+      }
+      errno = 0;
+      auto n = std::strtoll(buf.c_str(), nullptr, 10);
+      if (errno != ERANGE) {
+        m_visitor->integer(n);
+        return true;
+      }
+    }
+    m_visitor->number(std::strtod(buf.c_str(), nullptr));
+    return true;
+  }
+
+  bool read_string(bool is_key) {
+    auto &buf = m_buffer;
+    bool buffered = false;
+    m_surrogate = 0;
+    m_ptr++;
+    for (;;) {
+      auto p = find_special(m_ptr, m_end);
+      if (p < m_end && *p == '"' && !buffered) {
+        auto s = m_ptr;
+        auto n = p - m_ptr;
+        if (!is_utf8(s, n)) return fail("invalid bytes in UTF8 string");
+        m_ptr = p + 1;
+        if (is_key) m_visitor->map_key(s, n); else m_visitor->string(s, n);
+        return true;
+      }
+      if (!buffered) {
+        buf.clear();
+        buffered = true;
+      }
+      if (p > m_ptr) {
+        flush_surrogate();
+        buf.append(m_ptr, p);
+        m_ptr = p;
+      }
+      if (p == m_end) {
+        if (!next_span()) return fail("premature EOF");
+        continue;
+      }
+      auto c = *m_ptr;
+      if (c == '"') {
+        flush_surrogate();
+        if (!is_utf8(buf.c_str(), buf.length())) return fail("invalid bytes in UTF8 string");
+        m_ptr++;
+        if (is_key) m_visitor->map_key(buf.c_str(), buf.length()); else m_visitor->string(buf.c_str(), buf.length());
+        return true;
+      }
+      if (c != '\\') return fail("invalid character inside string");
+      m_ptr++;
+      if (!read_escape()) return false;
+    }
+  }
+
+  //
+  // Escaped surrogate pairs are joined into one code point while unpaired
+  // halves become '?', same as yajl
+  //
+
+  bool read_escape() {
+    auto &buf = m_buffer;
+    char c;
+    if (!get(c)) return fail("premature EOF");
+    if (c != 'u') flush_surrogate();
+    switch (c) {
+      case '"': buf += '"'; break;
+      case '\\': buf += '\\'; break;
+      case '/': buf += '/'; break;
+      case 'b': buf += '\b'; break;
+      case 'f': buf += '\f'; break;
+      case 'n': buf += '\n'; break;
+      case 'r': buf += '\r'; break;
+      case 't': buf += '\t'; break;
+      case 'u': {
+        uint32_t code;
+        if (!read_hex4(code)) return false;
+        if (0xd800 <= code && code <= 0xdbff) {
+          flush_surrogate();
+          m_surrogate = code;
+          return true;
+        } else if (0xdc00 <= code && code <= 0xdfff) {
+          if (!m_surrogate) {
+            buf += '?';
+            return true;
+          }
+          code = 0x10000 + (((m_surrogate & 0x3ff) << 10) | (code & 0x3ff));
+          m_surrogate = 0;
+        } else {
+          flush_surrogate();
+        }
+        char utf8[4];
+        auto n = pjs::Utf8Decoder::encode(code, utf8, sizeof(utf8));
+        buf.append(utf8, n);
+        break;
+      }
+      default:
+        m_ptr--;
+        return fail("inside a JSON string, an invalid escape was found");
+    }
+    return true;
+  }
+
+  void flush_surrogate() {
+    if (m_surrogate) {
+      m_buffer += '?';
+      m_surrogate = 0;
+    }
+  }
+
+  bool read_hex4(uint32_t &code) {
+    code = 0;
+    for (int i = 0; i < 4; i++) {
+      char c;
+      if (!get(c)) return fail("premature EOF");
+      int d;
+      if ('0' <= c && c <= '9') d = c - '0';
+      else if ('a' <= c && c <= 'f') d = c - 'a' + 10;
+      else if ('A' <= c && c <= 'F') d = c - 'A' + 10;
+      else { m_ptr--; return fail("invalid (non-hex) character occurs after '\\u' inside string"); }
+      code = (code << 4) | d;
+    }
+    return true;
+  }
+
+  //
+  // Validates UTF-8 the way yajl did, skipping ASCII runs quickly
+  //
+
+  static bool is_utf8(const char *str, size_t len) {
+    auto p = (const unsigned char *)str;
+    auto e = p + len;
+    while (p < e) {
+#ifdef __SSE2__
+      while (e - p >= 16 && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p))) p += 16;
+      if (p == e) break;
+#endif
+      auto c = *p++;
+      if (c < 0x80) continue;
+      int n;
+      uint32_t code;
+      if ((c & 0xe0) == 0xc0) { n = 1; code = c & 0x1f; }
+      else if ((c & 0xf0) == 0xe0) { n = 2; code = c & 0x0f; }
+      else if ((c & 0xf8) == 0xf0) { n = 3; code = c & 0x07; }
+      else return false;
+      if (e - p < n) return false;
+      for (int i = 0; i < n; i++) {
+        auto c = *p++;
+        if ((c & 0xc0) != 0x80) return false;
+        code = (code << 6) | (c & 0x3f);
+      }
+      switch (n) {
+        case 1: if (code < 0x80) return false; break;
+        case 2: if (code < 0x800 || (0xd800 <= code && code <= 0xdfff)) return false; break;
+        case 3: if (code < 0x10000 || code > 0x10ffff) return false; break;
+      }
+    }
+    return true;
+  }
 };
 
 //
@@ -265,7 +675,7 @@ private:
   void boolean(bool b) { value(b); }
   void integer(int64_t i) { value(double(i)); }
   void number(double n) { value(n); }
-  void string(const char *s, size_t len) { value(std::string(s, len)); }
+  void string(const char *s, size_t len) { value(pjs::Value(s, len)); }
 
   void map_start() {
     if (!m_aborted) {
@@ -343,6 +753,287 @@ private:
   }
 };
 
+//
+// JSONEncoder
+//
+// Writes straight into a Data::Builder. Runs of string bytes that need
+// no escaping are found by find_special() and pushed in one go.
+//
+
+class JSONEncoder {
+public:
+  JSONEncoder(
+    Data::Builder &db,
+    const std::function<bool(pjs::Object*, const pjs::Value&, pjs::Value&)> &replacer,
+    int space
+  ) : m_db(db)
+    , m_replacer(replacer)
+    , m_space(space < 0 ? 0 : space > 10 ? 10 : space) {}
+
+  bool encode(const pjs::Value &val) {
+    pjs::Value v(val);
+    if (m_replacer && !m_replacer(nullptr, pjs::Value::undefined, v)) return false;
+    return write(v, 0);
+  }
+
+  bool encode(JSON::Template *tpl, pjs::Object *obj) {
+    if (!obj) {
+      m_db.push(s_null);
+      return true;
+    }
+    return write(tpl, obj);
+  }
+
+  void write_string(const char *str, size_t len) {
+    static const char s_hex[] = "0123456789abcdef";
+    static const char s_escapes[32] = {
+      'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+      'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    };
+    auto p = str, e = str + len;
+    m_db.push('"');
+    while (p < e) {
+      auto q = find_special(p, e);
+      if (q > p) m_db.push(p, q - p);
+      if (q == e) break;
+      auto c = (unsigned char)*q;
+      auto x = c < 0x20 ? s_escapes[c] : char(c);
+      if (x == 'u') {
+        char buf[6] = { '\\', 'u', '0', '0', s_hex[c >> 4], s_hex[c & 15] };
+        m_db.push(buf, sizeof(buf));
+      } else {
+        m_db.push('\\');
+        m_db.push(x);
+      }
+      p = q + 1;
+    }
+    m_db.push('"');
+  }
+
+  void write_number(double n) {
+    static const char s_digits[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+
+    if (std::isnan(n) || std::isinf(n)) {
+      m_db.push(s_null);
+
+    // Integers are the usual case (status codes, sizes, timestamps) and
+    // are written digit pairs at a time, giving the same text as below
+    } else if (std::abs(n) < 1e15 && n == std::trunc(n) && !(n == 0 && std::signbit(n))) {
+      char buf[24];
+      auto p = buf + sizeof(buf);
+      auto i = int64_t(n);
+      auto u = uint64_t(i < 0 ? -i : i);
+      while (u >= 100) {
+        auto d = (u % 100) * 2; u /= 100;
+        *--p = s_digits[d + 1];
+        *--p = s_digits[d];
+      }
+      if (u >= 10) {
+        auto d = u * 2;
+        *--p = s_digits[d + 1];
+        *--p = s_digits[d];
+      } else {
+        *--p = '0' + u;
+      }
+      if (i < 0) *--p = '-';
+      m_db.push(p, buf + sizeof(buf) - p);
+
+    } else {
+      char buf[100];
+      auto l = pjs::Number::to_string(buf, sizeof(buf), n);
+      m_db.push(buf, l);
+    }
+  }
+
+private:
+  Data::Builder& m_db;
+  const std::function<bool(pjs::Object*, const pjs::Value&, pjs::Value&)> &m_replacer;
+  int m_space;
+  int m_level = 0;
+  pjs::Object* m_objs[100];
+
+  static const std::string s_null;
+  static const std::string s_true;
+  static const std::string s_false;
+
+  bool enter(pjs::Object *o) {
+    if (m_level == sizeof(m_objs) / sizeof(m_objs[0])) return false;
+    for (int i = 0; i < m_level; i++) {
+      if (m_objs[i] == o) return false;
+    }
+    m_objs[m_level++] = o;
+    return true;
+  }
+
+  void indent(int n) {
+    m_db.push(uint8_t(' '), n);
+  }
+
+  bool write(const pjs::Value &v, int l) {
+    if (v.is_undefined() || v.is_null()) {
+      m_db.push(s_null);
+    } else if (v.is_boolean()) {
+      m_db.push(v.b() ? s_true : s_false);
+    } else if (v.is_number()) {
+      write_number(v.n());
+    } else if (v.is_string()) {
+      auto s = v.s();
+      write_string(s->c_str(), s->size());
+    } else if (v.is_object()) {
+      auto o = v.o();
+      if (!enter(o)) {
+        m_db.push(s_null);
+        return true;
+      }
+      if (o->is_array()) {
+        if (!write_array(o->as<pjs::Array>(), l)) return false;
+      } else {
+        if (!write_object(o, l)) return false;
+      }
+      m_level--;
+    }
+    return true;
+  }
+
+  bool write_array(pjs::Array *a, int l) {
+    bool first = true;
+    m_db.push('[');
+    if (m_space) m_db.push('\n');
+    auto n = a->iterate_while([&](pjs::Value &v, int i) -> bool {
+      pjs::Value v2(v);
+      if (m_replacer && !m_replacer(a, i, v2)) return false;
+      if (v2.is_undefined() || v2.is_function()) v2 = pjs::Value::null;
+      if (first) {
+        first = false;
+      } else {
+        m_db.push(',');
+        if (m_space) m_db.push('\n');
+      }
+      if (m_space) indent(m_space * l + m_space);
+      return write(v2, l + 1);
+    });
+    if (n < a->length()) return false;
+    if (m_space) {
+      m_db.push('\n');
+      indent(m_space * l);
+    }
+    m_db.push(']');
+    return true;
+  }
+
+  bool write_object(pjs::Object *o, int l) {
+    bool first = true;
+    m_db.push('{');
+    if (m_space) m_db.push('\n');
+    auto done = o->iterate_while([&](pjs::Str *k, pjs::Value &v) {
+      pjs::Value v2(v);
+      if (m_replacer && !m_replacer(o, k, v2)) return false;
+      if (v2.is_undefined() || v2.is_function()) return true;
+      if (first) {
+        first = false;
+      } else {
+        m_db.push(',');
+        if (m_space) m_db.push('\n');
+      }
+      if (m_space) indent(m_space * l + m_space);
+      write_string(k->c_str(), k->size());
+      m_db.push(':');
+      if (m_space) m_db.push(' ');
+      return write(v2, l + 1);
+    });
+    if (!done) return false;
+    if (m_space) {
+      m_db.push('\n');
+      indent(m_space * l);
+    }
+    m_db.push('}');
+    return true;
+  }
+
+  bool write(JSON::Template *tpl, pjs::Object *obj) {
+    if (!enter(obj)) {
+      m_db.push(s_null);
+      return true;
+    }
+    bool first = true;
+    m_db.push('{');
+    for (auto &k : tpl->m_keys) {
+      pjs::Value v;
+      k.cache.get(obj, v);
+      if (v.is_undefined() || v.is_function()) continue;
+      if (first) {
+        m_db.push(k.prefix.c_str() + 1, k.prefix.length() - 1);
+        first = false;
+      } else {
+        m_db.push(k.prefix);
+      }
+      if (k.shape && v.is_object() && v.o() && !v.o()->is_array()) {
+        if (!write(k.shape.get(), v.o())) return false;
+      } else {
+        if (!write(v, 0)) return false;
+      }
+    }
+    m_db.push('}');
+    m_level--;
+    return true;
+  }
+};
+
+const std::string JSONEncoder::s_null("null");
+const std::string JSONEncoder::s_true("true");
+const std::string JSONEncoder::s_false("false");
+
+//
+// JSON::Template
+//
+
+JSON::Template::Template(pjs::Object *shape, int depth) {
+  static const std::function<bool(pjs::Object*, const pjs::Value&, pjs::Value&)> s_no_replacer;
+  if (!shape) return;
+  shape->iterate_all([&](pjs::Str *k, pjs::Value &v) {
+    if (v.is_function()) return;
+    Data buf;
+    Data::Builder db(buf, &s_dp);
+    JSONEncoder enc(db, s_no_replacer, 0);
+    db.push(',');
+    enc.write_string(k->c_str(), k->size());
+    db.push(':');
+    db.flush();
+    m_keys.emplace_back();
+    auto &key = m_keys.back();
+    key.cache = pjs::PropertyCache(k);
+    key.prefix = buf.to_string();
+    if (v.is_object() && v.o() && !v.o()->is_array() && depth < 100) {
+      key.shape = Template::make(v.o(), depth + 1);
+    }
+  });
+}
+
+void JSON::Template::encode(pjs::Object *obj, Data &data) {
+  Data::Builder db(data, &s_dp);
+  encode(obj, db);
+  db.flush();
+}
+
+void JSON::Template::encode(pjs::Object *obj, Data::Builder &db) {
+  static const std::function<bool(pjs::Object*, const pjs::Value&, pjs::Value&)> s_no_replacer;
+  JSONEncoder enc(db, s_no_replacer, 0);
+  enc.encode(this, obj);
+}
+
+auto JSON::Template::stringify(pjs::Object *obj) -> std::string {
+  Data data;
+  encode(obj, data);
+  return data.to_string();
+}
+
+//
+// JSON
+//
+
 bool JSON::visit(const std::string &str, Visitor *visitor) {
   std::string err;
   JSONVisitor v(visitor);
@@ -433,126 +1124,8 @@ bool JSON::encode(
   int space,
   Data::Builder &db
 ) {
-  static const std::string s_null("null");
-  static const std::string s_true("true");
-  static const std::string s_false("false");
-
-  if (space < 0) space = 0;
-  if (space > 10) space = 10;
-
-  pjs::Value v(val);
-  std::function<bool(pjs::Value&, int)> write;
-
-  if (replacer && !replacer(nullptr, pjs::Value::undefined, v)) {
-    return false;
-  }
-
-  pjs::Object* objs[100];
-  int obj_level = 0;
-
-  auto push_indent = [&](int n) {
-    for (int i = 0; i < n; i++) {
-      db.push(' ');
-    }
-  };
-
-  write = [&](pjs::Value &v, int l) -> bool {
-    if (v.is_undefined() || v.is_null()) {
-      db.push(s_null);
-    } else if (v.is_boolean()) {
-      db.push(v.b() ? s_true : s_false);
-    } else if (v.is_number()) {
-      auto n = v.n();
-      if (std::isnan(n) || std::isinf(n)) {
-        db.push(s_null);
-      } else {
-        char buf[100];
-        auto l = pjs::Number::to_string(buf, sizeof(buf), n);
-        db.push(buf, l);
-      }
-    } else if (v.is_string()) {
-      db.push('"');
-      utils::escape(
-        v.s()->str(),
-        [&](char c) { db.push(c); }
-      );
-      db.push('"');
-    } else if (v.is_object()) {
-      if (obj_level == sizeof(objs) / sizeof(objs[0])) {
-        db.push(s_null);
-        return true;
-      }
-      auto o = v.o();
-      for (int i = 0; i < obj_level; i++) {
-        if (objs[i] == o) {
-          db.push(s_null);
-          return true;
-        }
-      }
-      objs[obj_level++] = o;
-      if (o->is_array()) {
-        bool first = true;
-        db.push('[');
-        if (space) db.push('\n');
-        auto a = v.as<pjs::Array>();
-        auto n = a->iterate_while([&](pjs::Value &v, int i) -> bool {
-          pjs::Value v2(v);
-          if (replacer && !replacer(a, i, v2)) return false;
-          if (v2.is_undefined() || v2.is_function()) v2 = pjs::Value::null;
-          if (first) {
-            first = false;
-          } else {
-            db.push(',');
-            if (space) db.push('\n');
-          }
-          if (space) push_indent(space * l + space);
-          return write(v2, l + 1);
-        });
-        if (n < a->length()) return false;
-        if (space) {
-          db.push('\n');
-          push_indent(space * l);
-        }
-        db.push(']');
-      } else {
-        bool first = true;
-        db.push('{');
-        if (space) db.push('\n');
-        auto done = o->iterate_while([&](pjs::Str *k, pjs::Value &v) {
-          pjs::Value v2(v);
-          if (replacer && !replacer(o, k, v2)) return false;
-          if (v2.is_undefined() || v2.is_function()) return true;
-          if (first) {
-            first = false;
-          } else {
-            db.push(',');
-            if (space) db.push('\n');
-          }
-          if (space) push_indent(space * l + space);
-          db.push('"');
-          utils::escape(
-            k->str(),
-            [&](char c) { db.push(c); }
-          );
-          db.push('"');
-          db.push(':');
-          if (space) db.push(' ');
-          return write(v2, l + 1);
-        });
-        if (!done) return false;
-        if (space) {
-          db.push('\n');
-          push_indent(space * l);
-        }
-        db.push('}');
-      }
-      obj_level--;
-    }
-    return true;
-  };
-
-  auto ret = write(v, 0);
-  return ret;
+  JSONEncoder encoder(db, replacer, space);
+  return encoder.encode(val);
 }
 
 } // namespace pipy
@@ -30,9 +30,12 @@
 #include "data.hpp"
 
 #include <functional>
+#include <vector>
 
 namespace pipy {
 
+class JSONEncoder;
+
 //
 // JSON
 //
@@ -59,6 +62,34 @@ public:
     virtual void error(const std::string &err) {}
   };
 
+  //
+  // JSON::Template
+  //
+  // Encodes objects of a fixed shape by looking up a pre-compiled list of
+  // keys with pre-escaped names, instead of iterating over each object.
+  //
+
+  class Template : public pjs::ObjectTemplate<Template> {
+  public:
+    void encode(pjs::Object *obj, Data &data);
+    void encode(pjs::Object *obj, Data::Builder &db);
+    auto stringify(pjs::Object *obj) -> std::string;
+
+  private:
+    Template(pjs::Object *shape, int depth = 0);
+
+    struct Key {
+      pjs::PropertyCache cache;
+      std::string prefix;
+      pjs::Ref<Template> shape;
+    };
+
+    std::vector<Key> m_keys;
+
+    friend class pjs::ObjectTemplate<Template>;
+    friend class ::pipy::JSONEncoder;
+  };
+
   static bool visit(const std::string &str, Visitor *visitor);
   static bool visit(const std::string &str, Visitor *visitor, std::string &err);
   static bool visit(const Data &data, Visitor *visitor);
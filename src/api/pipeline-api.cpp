@@ -42,6 +42,7 @@
 #include "filters/exec.hpp"
 #include "filters/fcgi.hpp"
 #include "filters/fork.hpp"
+#include "filters/grpc.hpp"
 #include "filters/http.hpp"
 #include "filters/insert.hpp"
 #include "filters/loop.hpp"
@@ -87,6 +88,7 @@ auto PipelineDesigner::make_pipeline_layout(pjs::Context &ctx, pjs::Function *bu
     pjs::Value arg(pd), ret;
     (*builder)(ctx, 1, &arg, ret);
     pd->close();
+    pl->compile();
   } catch (std::runtime_error &err) {
     ctx.error(err);
   }
@@ -194,8 +196,12 @@ void PipelineDesigner::decode_bgp(pjs::Object *options) {
   append_filter(new bgp::Decoder(options));
 }
 
-void PipelineDesigner::decode_dubbo() {
-  append_filter(new dubbo::Decoder());
+void PipelineDesigner::decode_dubbo(pjs::Object *options) {
+  append_filter(new dubbo::Decoder(options));
+}
+
+void PipelineDesigner::decode_grpc() {
+  append_filter(new grpc::Decoder());
 }
 
 void PipelineDesigner::decode_http_request(pjs::Function *handler) {
@@ -222,12 +228,12 @@ void PipelineDesigner::decode_resp() {
   append_filter(new resp::Decoder());
 }
 
-void PipelineDesigner::decode_thrift() {
-  append_filter(new thrift::Decoder());
+void PipelineDesigner::decode_thrift(pjs::Object *options) {
+  append_filter(new thrift::Decoder(options));
 }
 
-void PipelineDesigner::decode_websocket() {
-  append_filter(new websocket::Decoder());
+void PipelineDesigner::decode_websocket(pjs::Object *options) {
+  append_filter(new websocket::Decoder(options));
 }
 
 void PipelineDesigner::decompress(const pjs::Value &algorithm) {
@@ -274,6 +280,10 @@ void PipelineDesigner::encode_dubbo() {
   append_filter(new dubbo::Encoder());
 }
 
+void PipelineDesigner::encode_grpc(const pjs::Value &head) {
+  append_filter(new grpc::Encoder(head));
+}
+
 void PipelineDesigner::encode_http_request(pjs::Object *options, pjs::Function *handler) {
   append_filter(new http::RequestEncoder(options, handler));
 }
@@ -298,8 +308,8 @@ void PipelineDesigner::encode_thrift() {
   append_filter(new thrift::Encoder());
 }
 
-void PipelineDesigner::encode_websocket() {
-  append_filter(new websocket::Encoder());
+void PipelineDesigner::encode_websocket(pjs::Object *options) {
+  append_filter(new websocket::Encoder(options));
 }
 
 void PipelineDesigner::exec(const pjs::Value &command, pjs::Object *options) {
@@ -370,6 +380,10 @@ void PipelineDesigner::mux_http(pjs::Function *session_selector, pjs::Object *op
   }
 }
 
+void PipelineDesigner::mux_resp(const std::vector<std::string> &nodes, pjs::Object *options) {
+  require_sub_pipeline(append_filter(new resp::Mux(nodes, options)));
+}
+
 void PipelineDesigner::read(const pjs::Value &filename, pjs::Object *options) {
   append_filter(new Read(filename, options));
 }
@@ -784,7 +798,14 @@ template<> void ClassDef<PipelineDesigner>::init() {
 
   // PipelineDesigner.decodeDubbo
   filter("decodeDubbo", [](Context &ctx, PipelineDesigner *obj) {
-    obj->decode_dubbo();
+    Object *options = nullptr;
+    if (!ctx.arguments(0, &options)) return;
+    obj->decode_dubbo(options);
+  });
+
+  // PipelineDesigner.decodeGRPC
+  filter("decodeGRPC", [](Context &ctx, PipelineDesigner *obj) {
+    obj->decode_grpc();
   });
 
   // PipelineDesigner.decodeHTTPRequest
@@ -823,12 +844,16 @@ template<> void ClassDef<PipelineDesigner>::init() {
 
   // PipelineDesigner.decodeThrift
   filter("decodeThrift", [](Context &ctx, PipelineDesigner *obj) {
-    obj->decode_thrift();
+    Object *options = nullptr;
+    if (!ctx.arguments(0, &options)) return;
+    obj->decode_thrift(options);
   });
 
   // PipelineDesigner.decodeWebSocket
   filter("decodeWebSocket", [](Context &ctx, PipelineDesigner *obj) {
-    obj->decode_websocket();
+    Object *options = nullptr;
+    if (!ctx.arguments(0, &options)) return;
+    obj->decode_websocket(options);
   });
 
   // PipelineDesigner.decompress
@@ -900,6 +925,13 @@ template<> void ClassDef<PipelineDesigner>::init() {
     obj->encode_dubbo();
   });
 
+  // PipelineDesigner.encodeGRPC
+  filter("encodeGRPC", [](Context &ctx, PipelineDesigner *obj) {
+    Value head;
+    if (!ctx.arguments(0, &head)) return;
+    obj->encode_grpc(head);
+  });
+
   // PipelineDesigner.encodeHTTPRequest
   filter("encodeHTTPRequest", [](Context &ctx, PipelineDesigner *obj) {
     Object *options = nullptr;
@@ -946,7 +978,9 @@ template<> void ClassDef<PipelineDesigner>::init() {
 
   // PipelineDesigner.encodeWebSocket
   filter("encodeWebSocket", [](Context &ctx, PipelineDesigner *obj) {
-    obj->encode_websocket();
+    Object *options = nullptr;
+    if (!ctx.arguments(0, &options)) return;
+    obj->encode_websocket(options);
   });
 
   // PipelineDesigner.exec
@@ -1105,6 +1139,29 @@ template<> void ClassDef<PipelineDesigner>::init() {
     }
   });
 
+  // PipelineDesigner.muxRESP
+  filter("muxRESP", [](Context &ctx, PipelineDesigner *obj) {
+    Str *node;
+    Array *nodes;
+    Object *options = nullptr;
+    std::vector<std::string> list;
+    if (ctx.try_arguments(1, &node, &options)) {
+      list.push_back(node->str());
+    } else if (ctx.try_arguments(1, &nodes, &options)) {
+      nodes->iterate_all(
+        [&](Value &v, int) {
+          auto *s = v.to_string();
+          list.push_back(s->str());
+          s->release();
+        }
+      );
+    } else {
+      ctx.error_argument_type(0, "a string or an array");
+      return;
+    }
+    obj->mux_resp(list, options);
+  });
+
   // PipelineDesigner.pipe
   filter("pipe", [](Context &ctx, PipelineDesigner *obj) {
     Value target;
@@ -818,7 +818,7 @@ template<> void ClassDef<Pipy>::init() {
         Codebase::current()->sync(
           true, [](bool ok) {
             if (ok) {
-              WorkerManager::get().reload();
+              WorkerManager::get().reload(true);
             }
           }
         );
@@ -25,7 +25,11 @@
 
 #include "protobuf.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
+#include <stdexcept>
 
 namespace pipy {
 
@@ -610,6 +614,958 @@ auto Protobuf::Message::encode_sint(int64_t n) -> uint64_t {
   return (n << 1) ^ (n >> 63);
 }
 
+//
+// Protobuf::Schema::Parser
+//
+
+class Protobuf::Schema::Parser {
+public:
+  Parser(const std::string &source, std::list<TypeDef> &defs, std::set<std::string> &enums)
+    : m_source(source)
+    , m_defs(defs)
+    , m_enums(enums) {}
+
+  void parse() {
+    for (;;) {
+      auto t = next();
+      if (t.empty()) break;
+      if (t == "syntax") {
+        expect("=");
+        m_proto3 = (unquote(next()) == "proto3");
+        expect(";");
+      } else if (t == "package") {
+        m_package = name();
+        expect(";");
+      } else if (t == "import" || t == "option" || t == "edition") {
+        skip_statement();
+      } else if (t == "message") {
+        parse_message(m_package);
+      } else if (t == "enum") {
+        parse_enum(m_package);
+      } else if (t == "service" || t == "extend") {
+        skip_block();
+      } else if (t != ";") {
+        error("unexpected '" + t + "'");
+      }
+    }
+  }
+
+private:
+  const std::string &m_source;
+  std::list<TypeDef> &m_defs;
+  std::set<std::string> &m_enums;
+  std::string m_package;
+  std::string m_peek;
+  size_t m_ptr = 0;
+  int m_line = 1;
+  bool m_proto3 = false;
+
+  static bool is_word(char c) {
+    return std::isalnum(c) || c == '_' || c == '.' || c == '-' || c == '+';
+  }
+
+  static auto join(const std::string &scope, const std::string &name) -> std::string {
+    return scope.empty() ? name : scope + '.' + name;
+  }
+
+  static auto unquote(const std::string &s) -> std::string {
+    if (s.length() >= 2 && (s[0] == '"' || s[0] == '\'')) return s.substr(1, s.length() - 2);
+    return s;
+  }
+
+  auto read() -> std::string {
+    auto &s = m_source;
+    auto &p = m_ptr;
+    auto n = s.length();
+    for (;;) {
+      while (p < n && std::isspace(s[p])) if (s[p++] == '\n') m_line++;
+      if (p + 1 < n && s[p] == '/' && s[p+1] == '/') {
+        while (p < n && s[p] != '\n') p++;
+      } else if (p + 1 < n && s[p] == '/' && s[p+1] == '*') {
+        p += 2;
+        while (p + 1 < n && !(s[p] == '*' && s[p+1] == '/')) if (s[p++] == '\n') m_line++;
+        p += 2;
+      } else {
+        break;
+      }
+    }
+    if (p >= n) return std::string();
+    auto start = p;
+    auto c = s[p];
+    if (c == '"' || c == '\'') {
+      for (p++; p < n && s[p] != c; p++) if (s[p] == '\\') p++;
+      if (p++ >= n) error("unterminated string");
+    } else if (is_word(c)) {
+      while (p < n && is_word(s[p])) p++;
+    } else {
+      p++;
+    }
+    return s.substr(start, p - start);
+  }
+
+  auto next() -> std::string {
+    if (!m_peek.empty()) return std::move(m_peek);
+    return read();
+  }
+
+  auto peek() -> const std::string& {
+    if (m_peek.empty()) m_peek = read();
+    return m_peek;
+  }
+
+  void expect(const char *token) {
+    auto t = next();
+    if (t != token) error(std::string("expected '") + token + "' but got '" + t + "'");
+  }
+
+  auto name() -> std::string {
+    auto t = next();
+    if (t.empty() || !is_word(t[0])) error("expected a name but got '" + t + "'");
+    return t;
+  }
+
+  auto number() -> int {
+    auto t = next();
+    char *end = nullptr;
+    auto n = std::strtol(t.c_str(), &end, 0);
+    if (t.empty() || *end || n < 1 || n > 0x1fffffff) error("invalid field number '" + t + "'");
+    return n;
+  }
+
+  void skip_statement() {
+    int depth = 0;
+    for (;;) {
+      auto t = next();
+      if (t.empty()) error("unexpected end of file");
+      if (t == "{") depth++;
+      else if (t == "}") depth--;
+      else if (t == ";" && depth <= 0) break;
+    }
+  }
+
+  void skip_block() {
+    for (;;) {
+      auto t = next();
+      if (t.empty()) error("unexpected end of file");
+      if (t == "{") break;
+    }
+    for (int depth = 1; depth > 0;) {
+      auto t = next();
+      if (t.empty()) error("unexpected end of file");
+      if (t == "{") depth++;
+      else if (t == "}") depth--;
+    }
+  }
+
+  void parse_message(const std::string &scope) {
+    auto full_name = join(scope, name());
+    m_defs.emplace_back();
+    auto &def = m_defs.back();
+    def.name = full_name;
+    def.proto3 = m_proto3;
+    expect("{");
+    for (;;) {
+      auto t = next();
+      if (t.empty()) error("unexpected end of file");
+      if (t == "}") break;
+      if (t == ";") continue;
+      if (t == "message") {
+        parse_message(full_name);
+      } else if (t == "enum") {
+        parse_enum(full_name);
+      } else if (t == "option" || t == "reserved" || t == "extensions") {
+        skip_statement();
+      } else if (t == "extend") {
+        skip_block();
+      } else if (t == "oneof") {
+        name();
+        expect("{");
+        for (;;) {
+          auto t = next();
+          if (t.empty()) error("unexpected end of file");
+          if (t == "}") break;
+          if (t == ";") continue;
+          if (t == "option") skip_statement();
+          else parse_field(def, t, true);
+        }
+      } else if (t == "map" && peek() == "<") {
+        parse_map(def);
+      } else {
+        parse_field(def, t, false);
+      }
+    }
+  }
+
+  void parse_field(TypeDef &def, const std::string &first, bool in_oneof) {
+    FieldDef f;
+    auto type = first;
+    if (first == "repeated") { f.repeated = true; type = name(); }
+    else if (first == "optional") { f.optional = true; type = name(); }
+    else if (first == "required") { type = name(); }
+    if (type == "group") error("groups are not supported");
+    f.type_name = type;
+    f.name = name();
+    expect("=");
+    f.number = number();
+    if (in_oneof) f.optional = true;
+    if (peek() == "[") parse_options(f);
+    expect(";");
+    def.fields.push_back(std::move(f));
+  }
+
+  void parse_map(TypeDef &def) {
+    expect("<");
+    auto key_type = name();
+    expect(",");
+    auto value_type = name();
+    expect(">");
+    FieldDef f;
+    f.name = name();
+    f.repeated = true;
+    expect("=");
+    f.number = number();
+    if (peek() == "[") parse_options(f);
+    expect(";");
+
+    std::string entry_name;
+    bool upper = true;
+    for (auto c : f.name) {
+      if (c == '_') { upper = true; continue; }
+      entry_name += upper ? std::toupper(c) : c;
+      upper = false;
+    }
+    entry_name = def.name + '.' + entry_name + "Entry";
+
+    TypeDef entry;
+    entry.name = entry_name;
+    entry.fields.resize(2);
+    entry.fields[0].name = "key";
+    entry.fields[0].number = 1;
+    entry.fields[0].type_name = key_type;
+    entry.fields[1].name = "value";
+    entry.fields[1].number = 2;
+    entry.fields[1].type_name = value_type;
+    m_defs.push_back(std::move(entry));
+
+    f.type_name = '.' + entry_name;
+    def.fields.push_back(std::move(f));
+  }
+
+  void parse_options(FieldDef &f) {
+    expect("[");
+    for (;;) {
+      auto t = next();
+      if (t.empty()) error("unexpected end of file");
+      if (t == "]") break;
+      if (t == "packed") {
+        expect("=");
+        f.packed = (next() == "true" ? 1 : 0);
+      }
+    }
+  }
+
+  void parse_enum(const std::string &scope) {
+    m_enums.insert(join(scope, name()));
+    skip_block();
+  }
+
+  void error(const std::string &msg) {
+    throw std::runtime_error("protobuf schema: " + msg + " at line " + std::to_string(m_line));
+  }
+};
+
+//
+// Protobuf::Schema::Type
+//
+
+auto Protobuf::Schema::Type::find(int number) const -> int {
+  if (number >= 0 && number < m_direct_index.size()) return m_direct_index[number];
+  auto i = m_index.find(number);
+  if (i == m_index.end()) return -1;
+  return i->second;
+}
+
+//
+// Protobuf::Schema
+//
+
+Protobuf::Schema::Schema(pjs::Str *source) {
+  std::list<TypeDef> defs;
+  std::set<std::string> enums;
+  Parser parser(source->str(), defs, enums);
+  parser.parse();
+  compile(defs, enums);
+}
+
+Protobuf::Schema::Schema(const Data &descriptor_set) {
+  std::list<TypeDef> defs;
+  std::set<std::string> enums;
+  pjs::Ref<Message> file_set = Message::make();
+  if (!file_set->deserialize(descriptor_set)) {
+    throw std::runtime_error("protobuf schema: invalid FileDescriptorSet");
+  }
+  for_each_message(file_set, 1, [&](Message *file) {
+    auto package = get_string(file, 2);
+    auto proto3 = (get_string(file, 12) == "proto3");
+    for_each_message(file, 5, [&](Message *e) {
+      auto name = get_string(e, 1);
+      enums.insert(package.empty() ? name : package + '.' + name);
+    });
+    for_each_message(file, 4, [&](Message *m) {
+      load_descriptor(m, package, proto3, defs, enums);
+    });
+  });
+  compile(defs, enums);
+}
+
+Protobuf::Schema::~Schema() {
+}
+
+auto Protobuf::Schema::type(const std::string &name) const -> Type* {
+  auto i = m_types.find(name[0] == '.' ? name.substr(1) : name);
+  if (i == m_types.end()) return nullptr;
+  return i->second.get();
+}
+
+auto Protobuf::Schema::decode(Type *type, const Data &data) -> Instance* {
+  auto inst = new Instance(this, type, data);
+  type->m_class->init(inst);
+  if (!inst->parse()) {
+    inst->retain();
+    inst->release();
+    return nullptr;
+  }
+  return inst;
+}
+
+void Protobuf::Schema::encode(Type *type, pjs::Object *obj, Data &data) {
+  Data::Builder db(data, &s_dp);
+  if (obj->is_instance_of<Instance>() && obj->as<Instance>()->schema_type() == type) {
+    obj->as<Instance>()->serialize(db);
+  } else {
+    encode_object(db, type, obj);
+  }
+  db.flush();
+}
+
+void Protobuf::Schema::load_descriptor(Message *msg, const std::string &scope, bool proto3, std::list<TypeDef> &defs, std::set<std::string> &enums) {
+  auto name = get_string(msg, 1);
+  if (!scope.empty()) name = scope + '.' + name;
+  defs.emplace_back();
+  auto &def = defs.back();
+  def.name = name;
+  def.proto3 = proto3;
+  for_each_message(msg, 2, [&](Message *f) {
+    FieldDef fd;
+    fd.name = get_string(f, 1);
+    fd.number = get_int(f, 3);
+    fd.repeated = (get_int(f, 4) == 3);
+    fd.type = get_int(f, 5);
+    fd.type_name = get_string(f, 6);
+    fd.optional = (get_int(f, 17) || f->get_tail_record(9));
+    for_each_message(f, 8, [&](Message *opt) {
+      if (opt->get_tail_record(2)) fd.packed = get_int(opt, 2) ? 1 : 0;
+    });
+    def.fields.push_back(std::move(fd));
+  });
+  for_each_message(msg, 3, [&](Message *m) { load_descriptor(m, name, proto3, defs, enums); });
+  for_each_message(msg, 4, [&](Message *e) { enums.insert(name + '.' + get_string(e, 1)); });
+}
+
+void Protobuf::Schema::compile(std::list<TypeDef> &defs, const std::set<std::string> &enums) {
+  for (const auto &def : defs) {
+    auto &type = m_types[def.name];
+    if (type) throw std::runtime_error("protobuf schema: duplicated message type " + def.name);
+    type.reset(new Type);
+    type->m_name = def.name;
+  }
+
+  auto resolve = [&](const std::string &name, std::string scope) -> std::string {
+    if (name[0] == '.') return name.substr(1);
+    for (;;) {
+      auto full_name = scope.empty() ? name : scope + '.' + name;
+      if (m_types.count(full_name) || enums.count(full_name)) return full_name;
+      if (scope.empty()) return std::string();
+      auto p = scope.rfind('.');
+      scope = (p == std::string::npos ? std::string() : scope.substr(0, p));
+    }
+  };
+
+  static const std::map<std::string, FieldType> s_scalar_types = {
+    { "double"  , FieldType::DOUBLE   },
+    { "float"   , FieldType::FLOAT    },
+    { "int64"   , FieldType::INT64    },
+    { "uint64"  , FieldType::UINT64   },
+    { "int32"   , FieldType::INT32    },
+    { "fixed64" , FieldType::FIXED64  },
+    { "fixed32" , FieldType::FIXED32  },
+    { "bool"    , FieldType::BOOL     },
+    { "string"  , FieldType::STRING   },
+    { "bytes"   , FieldType::BYTES    },
+    { "uint32"  , FieldType::UINT32   },
+    { "sfixed32", FieldType::SFIXED32 },
+    { "sfixed64", FieldType::SFIXED64 },
+    { "sint32"  , FieldType::SINT32   },
+    { "sint64"  , FieldType::SINT64   },
+  };
+
+  for (const auto &def : defs) {
+    auto *type = m_types[def.name].get();
+    auto &fields = type->m_fields;
+    for (const auto &fd : def.fields) {
+      Field f;
+      f.name = pjs::Str::make(fd.name);
+      f.number = fd.number;
+      f.repeated = fd.repeated;
+      f.type = FieldType(fd.type);
+
+      if (f.type == FieldType::NONE) {
+        auto i = s_scalar_types.find(fd.type_name);
+        if (i != s_scalar_types.end()) f.type = i->second;
+      }
+
+      if (f.type == FieldType::NONE || f.type == FieldType::MESSAGE || f.type == FieldType::ENUM) {
+        auto name = resolve(fd.type_name, def.name);
+        auto i = m_types.find(name);
+        if (i != m_types.end()) {
+          f.type = FieldType::MESSAGE;
+          f.message_type = i->second.get();
+        } else if (enums.count(name)) {
+          f.type = FieldType::ENUM;
+        } else {
+          throw std::runtime_error(
+            "protobuf schema: unknown type " + fd.type_name +
+            " for field " + fd.name + " in " + def.name
+          );
+        }
+      }
+
+      switch (f.type) {
+        case FieldType::DOUBLE:
+        case FieldType::FIXED64:
+        case FieldType::SFIXED64:
+          f.wire_type = WireType::I64;
+          break;
+        case FieldType::FLOAT:
+        case FieldType::FIXED32:
+        case FieldType::SFIXED32:
+          f.wire_type = WireType::I32;
+          break;
+        case FieldType::STRING:
+        case FieldType::BYTES:
+        case FieldType::MESSAGE:
+          f.wire_type = WireType::LEN;
+          break;
+        case FieldType::GROUP:
+          throw std::runtime_error("protobuf schema: groups are not supported in " + def.name);
+        default:
+          f.wire_type = WireType::VARINT;
+          break;
+      }
+
+      f.packed = (
+        f.repeated && f.wire_type != WireType::LEN &&
+        (fd.packed > 0 || (fd.packed < 0 && def.proto3))
+      );
+
+      f.presence = !(
+        def.proto3 && !f.repeated && !fd.optional &&
+        f.type != FieldType::MESSAGE
+      );
+
+      fields.push_back(std::move(f));
+    }
+
+    std::sort(
+      fields.begin(), fields.end(),
+      [](const Field &a, const Field &b) { return a.number < b.number; }
+    );
+
+    for (int i = 1; i < fields.size(); i++) {
+      if (fields[i-1].number == fields[i].number) {
+        throw std::runtime_error(
+          "protobuf schema: duplicated field number " +
+          std::to_string(fields[i].number) + " in " + def.name
+        );
+      }
+    }
+
+    std::list<pjs::Field*> accessors;
+    for (int i = 0; i < fields.size(); i++) {
+      auto n = fields[i].number;
+      if (n < Type::MAX_DIRECT_INDEX) {
+        if (n >= type->m_direct_index.size()) type->m_direct_index.resize(n + 1, -1);
+        type->m_direct_index[n] = i;
+      } else {
+        type->m_index[n] = i;
+      }
+      accessors.push_back(
+        pjs::Accessor::make(
+          fields[i].name->str(),
+          [=](pjs::Object *obj, pjs::Value &val) { obj->as<Instance>()->get_field(i, val); },
+          [=](pjs::Object *obj, const pjs::Value &val) { obj->as<Instance>()->set_field(i, val); },
+          pjs::Field::Enumerable | pjs::Field::Writable
+        )
+      );
+    }
+
+    type->m_class = pjs::Class::make(
+      "Protobuf:" + def.name,
+      pjs::class_of<Instance>(),
+      accessors
+    );
+  }
+}
+
+void Protobuf::Schema::for_each_message(Message *msg, int field, const std::function<void(Message*)> &cb) {
+  for (auto *r = msg->get_all_records(field); r; r = r->next()) {
+    if (r->type() != WireType::LEN) continue;
+    pjs::Ref<Message> m = Message::make();
+    if (!m->deserialize(r->data())) {
+      throw std::runtime_error("protobuf schema: invalid FileDescriptorSet");
+    }
+    cb(m);
+  }
+}
+
+auto Protobuf::Schema::get_string(Message *msg, int field) -> std::string {
+  auto r = msg->get_tail_record(field);
+  if (!r || r->type() != WireType::LEN) return std::string();
+  return r->data().to_string();
+}
+
+auto Protobuf::Schema::get_int(Message *msg, int field) -> int {
+  auto r = msg->get_tail_record(field);
+  if (!r || r->type() != WireType::VARINT) return 0;
+  return (int)r->bits();
+}
+
+static auto to_int64(double n) -> int64_t {
+  if (std::isnan(n)) return 0;
+  if (n >= 9223372036854775807.0) return std::numeric_limits<int64_t>::max();
+  if (n <= -9223372036854775808.0) return std::numeric_limits<int64_t>::min();
+  return (int64_t)n;
+}
+
+static auto to_uint64(double n) -> uint64_t {
+  if (n < 0) return (uint64_t)to_int64(n);
+  if (n >= 18446744073709551615.0) return std::numeric_limits<uint64_t>::max();
+  if (n > 0) return (uint64_t)n;
+  return 0;
+}
+
+// Short byte ranges are copied while longer ones share the original chunks
+static void splice(Data::Builder &db, const Data &data) {
+  if (data.size() >= 256) {
+    db.push(Data(data));
+  } else {
+    db.push(data);
+  }
+}
+
+void Protobuf::Schema::encode_object(Data::Builder &db, Type *type, pjs::Object *obj) {
+  for (const auto &f : type->m_fields) {
+    pjs::Value v;
+    obj->get(f.name, v);
+    encode_field(db, f, v);
+  }
+}
+
+void Protobuf::Schema::encode_field(Data::Builder &db, const Field &field, const pjs::Value &value) {
+  if (value.is_nullish()) return;
+
+  if (field.repeated) {
+    if (!value.is_array()) return;
+    auto *a = value.as<pjs::Array>();
+    if (field.packed) {
+      if (!a->length()) return;
+      Data buf;
+      Data::Builder pb(buf, &s_dp);
+      a->iterate_all([&](pjs::Value &v, int) { encode_scalar(pb, field, v); });
+      pb.flush();
+      Message::write_varint(db, ((uint64_t)field.number << 3) | 2);
+      Message::write_varint(db, buf.size());
+      db.push(std::move(buf));
+    } else {
+      a->iterate_all([&](pjs::Value &v, int) { if (!v.is_nullish()) encode_value(db, field, v); });
+    }
+    return;
+  }
+
+  if (!field.presence) {
+    switch (field.type) {
+      case FieldType::STRING: if (value.is_string() && !value.s()->size()) return; break;
+      case FieldType::BYTES: if (value.is<Data>() && value.as<Data>()->empty()) return; break;
+      case FieldType::BOOL: if (!value.to_boolean()) return; break;
+      default: if (value.to_number() == 0) return; break;
+    }
+  }
+
+  encode_value(db, field, value);
+}
+
+void Protobuf::Schema::encode_value(Data::Builder &db, const Field &field, const pjs::Value &value) {
+  switch (field.wire_type) {
+    case WireType::VARINT:
+      Message::write_varint(db, (uint64_t)field.number << 3);
+      encode_scalar(db, field, value);
+      break;
+    case WireType::I64:
+      Message::write_varint(db, ((uint64_t)field.number << 3) | 1);
+      encode_scalar(db, field, value);
+      break;
+    case WireType::I32:
+      Message::write_varint(db, ((uint64_t)field.number << 3) | 5);
+      encode_scalar(db, field, value);
+      break;
+    case WireType::LEN:
+      Message::write_varint(db, ((uint64_t)field.number << 3) | 2);
+      if (field.type == FieldType::MESSAGE) {
+        encode_message(db, field, value.is_object() ? value.o() : nullptr);
+      } else if (field.type == FieldType::BYTES && value.is<Data>()) {
+        auto *data = value.as<Data>();
+        Message::write_varint(db, data->size());
+        splice(db, *data);
+      } else {
+        auto *s = value.to_string();
+        Message::write_varint(db, s->size());
+        db.push(s->str());
+        s->release();
+      }
+      break;
+    default: break;
+  }
+}
+
+void Protobuf::Schema::encode_scalar(Data::Builder &db, const Field &field, const pjs::Value &value) {
+  auto n = value.to_number();
+  switch (field.type) {
+    case FieldType::DOUBLE: {
+      double d = n;
+      uint64_t bits;
+      std::memcpy(&bits, &d, sizeof(bits));
+      Message::write_uint64(db, bits);
+      break;
+    }
+    case FieldType::FLOAT: {
+      float f = n;
+      uint32_t bits;
+      std::memcpy(&bits, &f, sizeof(bits));
+      Message::write_uint32(db, bits);
+      break;
+    }
+    case FieldType::INT64: Message::write_varint(db, to_int64(n)); break;
+    case FieldType::UINT64: Message::write_varint(db, to_uint64(n)); break;
+    case FieldType::INT32:
+    case FieldType::ENUM: Message::write_varint(db, (int64_t)(int32_t)to_int64(n)); break;
+    case FieldType::UINT32: Message::write_varint(db, (uint32_t)to_uint64(n)); break;
+    case FieldType::FIXED64:
+    case FieldType::SFIXED64: Message::write_uint64(db, to_uint64(n)); break;
+    case FieldType::FIXED32:
+    case FieldType::SFIXED32: Message::write_uint32(db, (uint32_t)to_uint64(n)); break;
+    case FieldType::BOOL: Message::write_varint(db, value.to_boolean() ? 1 : 0); break;
+    case FieldType::SINT32: Message::write_varint(db, Message::encode_sint((int32_t)to_int64(n))); break;
+    case FieldType::SINT64: Message::write_varint(db, Message::encode_sint(to_int64(n))); break;
+    default: break;
+  }
+}
+
+void Protobuf::Schema::encode_message(Data::Builder &db, const Field &field, pjs::Object *obj) {
+  auto type = field.message_type;
+  if (obj && obj->is_instance_of<Instance>()) {
+    auto inst = obj->as<Instance>();
+    if (inst->schema_type() == type && !inst->is_modified()) {
+      Message::write_varint(db, inst->m_raw.size());
+      splice(db, inst->m_raw);
+      return;
+    }
+  }
+  Data buf;
+  Data::Builder mb(buf, &s_dp);
+  if (obj) {
+    if (obj->is_instance_of<Instance>() && obj->as<Instance>()->schema_type() == type) {
+      obj->as<Instance>()->serialize(mb);
+    } else {
+      encode_object(mb, type, obj);
+    }
+  }
+  mb.flush();
+  Message::write_varint(db, buf.size());
+  db.push(std::move(buf));
+}
+
+bool Protobuf::Schema::decode_scalar(Data::Reader &r, const Field &field, pjs::Value &value) {
+  uint64_t n;
+  switch (field.wire_type) {
+    case WireType::VARINT: if (!Message::read_varint(r, n)) return false; break;
+    case WireType::I64: if (!Message::read_uint64(r, n)) return false; break;
+    case WireType::I32: {
+      uint32_t i;
+      if (!Message::read_uint32(r, i)) return false;
+      n = i;
+      break;
+    }
+    default: return false;
+  }
+  switch (field.type) {
+    case FieldType::DOUBLE: {
+      double d;
+      std::memcpy(&d, &n, sizeof(d));
+      value.set(d);
+      break;
+    }
+    case FieldType::FLOAT: {
+      uint32_t bits = n;
+      float f;
+      std::memcpy(&f, &bits, sizeof(f));
+      value.set(f);
+      break;
+    }
+    case FieldType::INT64:
+    case FieldType::SFIXED64: value.set((double)(int64_t)n); break;
+    case FieldType::UINT64:
+    case FieldType::FIXED64: value.set((double)n); break;
+    case FieldType::INT32:
+    case FieldType::SFIXED32:
+    case FieldType::ENUM: value.set((int)(int32_t)n); break;
+    case FieldType::UINT32:
+    case FieldType::FIXED32: value.set((double)(uint32_t)n); break;
+    case FieldType::BOOL: value.set(n != 0); break;
+    case FieldType::SINT32: value.set((int)Message::decode_sint((uint32_t)n)); break;
+    case FieldType::SINT64: value.set((double)Message::decode_sint(n)); break;
+    default: return false;
+  }
+  return true;
+}
+
+//
+// Protobuf::Instance
+//
+
+Protobuf::Instance::Instance(Schema *schema, Schema::Type *type, const Data &data)
+  : m_schema(schema)
+  , m_type(type)
+  , m_raw(data)
+{
+}
+
+Protobuf::Instance::~Instance() {
+  if (m_values) m_values->free();
+  if (m_snapshots) m_snapshots->free();
+}
+
+// Sub-messages are only parsed when accessed, so a malformed one
+// is not found by Schema::decode(). It reads as null from its parent,
+// and all of its fields read as null as well.
+void Protobuf::Instance::get_field(int i, pjs::Value &val) {
+  if (!parse()) {
+    val = pjs::Value::null;
+    return;
+  }
+  auto &f = m_type->fields()[i];
+  auto &v = m_values->at(i);
+  if (f.repeated) {
+    if (!v.is_array()) v.set(pjs::Array::make());
+    if (!m_modified) snapshot(i); // elements can be changed in place
+    val = v;
+  } else if (v.is_undefined() && !f.presence) {
+    switch (f.type) {
+      case Schema::FieldType::STRING: val.set(pjs::Str::empty); break;
+      case Schema::FieldType::BYTES: val.set(Data::make()); break;
+      case Schema::FieldType::BOOL: val.set(false); break;
+      default: val.set(0); break;
+    }
+  } else if (f.type == Schema::FieldType::MESSAGE && v.is_instance_of<Instance>() && !v.as<Instance>()->parse()) {
+    val = pjs::Value::null;
+  } else {
+    val = v;
+  }
+}
+
+void Protobuf::Instance::set_field(int i, const pjs::Value &val) {
+  parse();
+  m_values->at(i) = val;
+  m_modified = true;
+}
+
+// Keeps a copy of the elements of a repeated field as they were
+// when first handed out, so that changes made in place can be told
+void Protobuf::Instance::snapshot(int i) {
+  if (!m_snapshots) m_snapshots = pjs::PooledArray<pjs::Value>::make(m_type->fields().size());
+  auto &s = m_snapshots->at(i);
+  if (s.is_array()) return;
+  auto a = m_values->at(i).as<pjs::Array>();
+  auto n = a->length();
+  auto copy = pjs::Array::make(n);
+  for (int j = 0; j < n; j++) {
+    pjs::Value v;
+    a->get(j, v);
+    copy->set(j, v);
+  }
+  s.set(copy);
+}
+
+// Only the fields at this level are decoded. Sub-messages are
+// wrapped around their byte ranges and decoded on first access.
+bool Protobuf::Instance::parse() {
+  if (m_values) return !m_malformed;
+
+  auto &fields = m_type->fields();
+  m_values = pjs::PooledArray<pjs::Value>::make(fields.size());
+
+  auto array_at = [this](int i) -> pjs::Array* {
+    auto &v = m_values->at(i);
+    if (!v.is_array()) v.set(pjs::Array::make());
+    return v.as<pjs::Array>();
+  };
+
+  Data::Reader r(m_raw);
+  Data::Builder db(m_unknown, &s_dp);
+
+  auto read_len = [&](Data &out) -> bool {
+    uint64_t len;
+    if (!Message::read_varint(r, len)) return false;
+    if (len > std::numeric_limits<int>::max()) return false;
+    return r.read(len, out) == len;
+  };
+
+  auto read_field = [&]() -> bool {
+    uint64_t tag;
+    if (!Message::read_varint(r, tag)) return false;
+    auto wire = tag & 7;
+    auto i = (tag >> 3) <= std::numeric_limits<int>::max() ? m_type->find(tag >> 3) : -1;
+
+    if (i >= 0) {
+      auto &f = fields[i];
+      if (wire == 2 && f.wire_type != WireType::LEN) {
+        Data packed;
+        if (!f.repeated || !read_len(packed)) return false;
+        auto *a = array_at(i);
+        Data::Reader pr(packed);
+        while (!pr.eof()) {
+          pjs::Value v;
+          if (!Schema::decode_scalar(pr, f, v)) return false;
+          a->push(v);
+        }
+        return true;
+      }
+
+      static const int s_wire_codes[] = { -1, 0, 5, 1, 2 };
+      if (wire == s_wire_codes[int(f.wire_type)]) {
+        pjs::Value v;
+        if (f.wire_type == WireType::LEN) {
+          Data data;
+          if (!read_len(data)) return false;
+          switch (f.type) {
+            case Schema::FieldType::STRING: v.set(pjs::Str::make(data.to_string())); break;
+            case Schema::FieldType::BYTES: v.set(Data::make(std::move(data))); break;
+            default: {
+              auto *inst = new Instance(m_schema, f.message_type, data);
+              f.message_type->m_class->init(inst);
+              v.set(inst);
+              break;
+            }
+          }
+        } else if (!Schema::decode_scalar(r, f, v)) {
+          return false;
+        }
+        if (f.repeated) {
+          array_at(i)->push(v);
+        } else {
+          m_values->at(i) = v;
+        }
+        return true;
+      }
+    }
+
+    // Unknown fields are kept as they are for re-encoding
+    Message::write_varint(db, tag);
+    switch (wire) {
+      case 0: {
+        uint64_t n;
+        if (!Message::read_varint(r, n)) return false;
+        Message::write_varint(db, n);
+        return true;
+      }
+      case 1: {
+        uint8_t buf[8];
+        if (r.read(8, buf) < 8) return false;
+        db.push(buf, 8);
+        return true;
+      }
+      case 2: {
+        Data data;
+        if (!read_len(data)) return false;
+        Message::write_varint(db, data.size());
+        db.push(data);
+        return true;
+      }
+      case 5: {
+        uint8_t buf[4];
+        if (r.read(4, buf) < 4) return false;
+        db.push(buf, 4);
+        return true;
+      }
+      default: return false;
+    }
+  };
+
+  bool ok = true;
+  while (!r.eof()) {
+    if (!read_field()) {
+      ok = false;
+      break;
+    }
+  }
+
+  db.flush();
+  m_malformed = !ok;
+  return ok;
+}
+
+bool Protobuf::Instance::is_modified() const {
+  if (!m_values) return false;
+  if (m_modified) return true;
+  auto &fields = m_type->fields();
+  auto is_modified_message = [](const pjs::Value &v) {
+    return v.is_object() && v.o() && v.o()->is_instance_of<Instance>() && v.as<Instance>()->is_modified();
+  };
+  for (size_t i = 0; i < fields.size(); i++) {
+    auto &f = fields[i];
+    auto &v = m_values->at(i);
+    if (f.repeated) {
+      if (!m_snapshots || !m_snapshots->at(i).is_array()) continue;
+      auto a = v.as<pjs::Array>();
+      auto b = m_snapshots->at(i).as<pjs::Array>();
+      if (a->length() != b->length()) return true;
+      for (int j = 0, n = a->length(); j < n; j++) {
+        pjs::Value x, y;
+        a->get(j, x);
+        b->get(j, y);
+        if (!pjs::Value::is_identical(x, y)) return true;
+        if (f.type == Schema::FieldType::MESSAGE && is_modified_message(x)) return true;
+      }
+    } else if (f.type == Schema::FieldType::MESSAGE) {
+      if (is_modified_message(v)) return true;
+    }
+  }
+  return false;
+}
+
+// Messages that have not been modified are copied from their
+// original bytes rather than encoded field by field
+void Protobuf::Instance::serialize(Data::Builder &db) {
+  if (!is_modified()) {
+    splice(db, m_raw);
+    return;
+  }
+  auto &fields = m_type->fields();
+  for (size_t i = 0; i < fields.size(); i++) {
+    Schema::encode_field(db, fields[i], m_values->at(i));
+  }
+  splice(db, m_unknown);
+}
+
 } // namespace pipy
 
 namespace pjs {
@@ -624,6 +1580,7 @@ template<> void ClassDef<Protobuf>::init() {
   ctor();
 
   variable("Message", class_of<Constructor<Protobuf::Message>>());
+  variable("Schema", class_of<Constructor<Protobuf::Schema>>());
 
   method("decode", [](Context &ctx, Object *obj, Value &ret) {
     pipy::Data *data;
@@ -1098,4 +2055,60 @@ template<> void ClassDef<Constructor<Protobuf::Message>>::init() {
   ctor();
 }
 
+//
+// Protobuf::Schema
+//
+
+template<> void ClassDef<Protobuf::Schema>::init() {
+  ctor([](Context &ctx) -> Object* {
+    Str *source;
+    pipy::Data *data;
+    try {
+      if (ctx.get(0, source)) return Protobuf::Schema::make(source);
+      if (ctx.get(0, data) && data) return Protobuf::Schema::make(*data);
+      ctx.error_argument_type(0, "a string or a Data");
+      return nullptr;
+    } catch (std::runtime_error &err) {
+      ctx.error(err);
+      return nullptr;
+    }
+  });
+
+  method("decode", [](Context &ctx, Object *obj, Value &ret) {
+    Str *name;
+    pipy::Data *data;
+    if (!ctx.arguments(2, &name, &data)) return;
+    auto schema = obj->as<Protobuf::Schema>();
+    auto type = schema->type(name->str());
+    if (!type) return ctx.error("unknown message type " + name->str());
+    if (!data) { ret = Value::null; return; }
+    ret.set(schema->decode(type, *data));
+  });
+
+  method("encode", [](Context &ctx, Object *obj, Value &ret) {
+    Str *name;
+    Object *msg;
+    if (!ctx.arguments(2, &name, &msg)) return;
+    auto schema = obj->as<Protobuf::Schema>();
+    auto type = schema->type(name->str());
+    if (!type) return ctx.error("unknown message type " + name->str());
+    if (!msg) { ret = Value::null; return; }
+    pipy::Data data;
+    schema->encode(type, msg, data);
+    ret.set(pipy::Data::make(std::move(data)));
+  });
+}
+
+template<> void ClassDef<Constructor<Protobuf::Schema>>::init() {
+  super<Function>();
+  ctor();
+}
+
+//
+// Protobuf::Instance
+//
+
+template<> void ClassDef<Protobuf::Instance>::init() {
+}
+
 } // namespace pjs
@@ -28,6 +28,13 @@
 
 #include "data.hpp"
 
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
 namespace pipy {
 
 //
@@ -44,6 +51,9 @@ public:
     LEN,
   };
 
+  class Schema;
+  class Instance;
+
   //
   // Protobuf::Message
   //
@@ -286,6 +296,150 @@ public:
 
     friend class pjs::ObjectTemplate<Message>;
     friend class Protobuf;
+    friend class Schema;
+    friend class Instance;
+  };
+
+  //
+  // Protobuf::Schema
+  //
+
+  class Schema : public pjs::ObjectTemplate<Schema> {
+  public:
+    enum class FieldType {
+      NONE     = 0,
+      DOUBLE   = 1,
+      FLOAT    = 2,
+      INT64    = 3,
+      UINT64   = 4,
+      INT32    = 5,
+      FIXED64  = 6,
+      FIXED32  = 7,
+      BOOL     = 8,
+      STRING   = 9,
+      GROUP    = 10,
+      MESSAGE  = 11,
+      BYTES    = 12,
+      UINT32   = 13,
+      ENUM     = 14,
+      SFIXED32 = 15,
+      SFIXED64 = 16,
+      SINT32   = 17,
+      SINT64   = 18,
+    };
+
+    class Type;
+
+    struct Field {
+      pjs::Ref<pjs::Str> name;
+      int number = 0;
+      FieldType type = FieldType::NONE;
+      WireType wire_type = WireType::NONE;
+      Type* message_type = nullptr;
+      bool repeated = false;
+      bool packed = false;
+      bool presence = true;
+    };
+
+    //
+    // Protobuf::Schema::Type
+    //
+
+    class Type {
+    public:
+      auto name() const -> const std::string& { return m_name; }
+      auto fields() const -> const std::vector<Field>& { return m_fields; }
+      auto find(int number) const -> int;
+
+    private:
+      enum { MAX_DIRECT_INDEX = 256 };
+
+      std::string m_name;
+      std::vector<Field> m_fields;
+      std::vector<int> m_direct_index;
+      std::map<int, int> m_index;
+      pjs::Ref<pjs::Class> m_class;
+
+      friend class Schema;
+      friend class Instance;
+    };
+
+    auto type(const std::string &name) const -> Type*;
+    auto decode(Type *type, const Data &data) -> Instance*;
+    void encode(Type *type, pjs::Object *obj, Data &data);
+
+  private:
+    Schema(pjs::Str *source);
+    Schema(const Data &descriptor_set);
+    ~Schema();
+
+    struct FieldDef {
+      std::string name;
+      std::string type_name;
+      int number = 0;
+      int type = 0;
+      bool repeated = false;
+      bool optional = false;
+      int packed = -1;
+    };
+
+    struct TypeDef {
+      std::string name;
+      bool proto3 = false;
+      std::vector<FieldDef> fields;
+    };
+
+    class Parser;
+
+    std::map<std::string, std::unique_ptr<Type>> m_types;
+
+    void load_descriptor(Message *msg, const std::string &scope, bool proto3, std::list<TypeDef> &defs, std::set<std::string> &enums);
+    void compile(std::list<TypeDef> &defs, const std::set<std::string> &enums);
+
+    static void for_each_message(Message *msg, int field, const std::function<void(Message*)> &cb);
+    static auto get_string(Message *msg, int field) -> std::string;
+    static auto get_int(Message *msg, int field) -> int;
+    static void encode_object(Data::Builder &db, Type *type, pjs::Object *obj);
+    static void encode_field(Data::Builder &db, const Field &field, const pjs::Value &value);
+    static void encode_value(Data::Builder &db, const Field &field, const pjs::Value &value);
+    static void encode_scalar(Data::Builder &db, const Field &field, const pjs::Value &value);
+    static void encode_message(Data::Builder &db, const Field &field, pjs::Object *obj);
+    static bool decode_scalar(Data::Reader &r, const Field &field, pjs::Value &value);
+
+    friend class pjs::ObjectTemplate<Schema>;
+    friend class Instance;
+  };
+
+  //
+  // Protobuf::Instance
+  //
+
+  class Instance : public pjs::ObjectTemplate<Instance> {
+  public:
+    auto schema_type() const -> Schema::Type* { return m_type; }
+    void get_field(int i, pjs::Value &val);
+    void set_field(int i, const pjs::Value &val);
+
+  private:
+    Instance(Schema *schema, Schema::Type *type, const Data &data);
+    ~Instance();
+
+    pjs::Ref<Schema> m_schema;
+    Schema::Type* m_type;
+    Data m_raw;
+    Data m_unknown;
+    pjs::PooledArray<pjs::Value>* m_values = nullptr;
+    pjs::PooledArray<pjs::Value>* m_snapshots = nullptr;
+    bool m_modified = false;
+    bool m_malformed = false;
+
+    void snapshot(int i);
+    bool parse();
+    bool is_modified() const;
+    void serialize(Data::Builder &db);
+
+    friend class pjs::ObjectTemplate<Instance>;
+    friend class Schema;
   };
 
   static auto decode(const Data &data) -> Message*;
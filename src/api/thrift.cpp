@@ -143,6 +143,78 @@ void Thrift::encode(pjs::Object *msg, Data &data) {
   db.flush();
 }
 
+static void write_varint(Data::Builder &db, uint64_t i) {
+  do {
+    char c = i & 0x7f;
+    i >>= 7;
+    if (!i) db.push(c); else db.push(c | 0x80);
+  } while (i);
+}
+
+static bool write_message_head(Thrift::Message *msg, Data::Builder &db) {
+  switch (msg->protocol.get()) {
+    case Thrift::Protocol::binary:
+      db.push(0x80);
+      db.push(0x01);
+      db.push(0x00);
+      db.push(int(msg->type));
+      if (auto s = msg->name.get()) {
+        int len = s->size();
+        db.push(0xff & (len >> 24));
+        db.push(0xff & (len >> 16));
+        db.push(0xff & (len >>  8));
+        db.push(0xff & (len >>  0));
+        db.push(s->str());
+      } else {
+        db.push(0);
+        db.push(0);
+        db.push(0);
+        db.push(0);
+      }
+      db.push(0xff & (msg->seqID >> 24));
+      db.push(0xff & (msg->seqID >> 16));
+      db.push(0xff & (msg->seqID >>  8));
+      db.push(0xff & (msg->seqID >>  0));
+      return true;
+
+    case Thrift::Protocol::compact:
+      db.push(0x82);
+      db.push(0x01 | (int(msg->type) << 5));
+      write_varint(db, uint32_t(msg->seqID));
+      write_varint(db, uint32_t(msg->name ? msg->name->size() : 0));
+      if (auto s = msg->name.get()) db.push(s->str());
+      return true;
+
+    case Thrift::Protocol::old:
+      if (auto s = msg->name.get()) {
+        int len = s->size();
+        db.push(0xff & (len >> 24));
+        db.push(0xff & (len >> 16));
+        db.push(0xff & (len >>  8));
+        db.push(0xff & (len >>  0));
+        db.push(s->str());
+      } else {
+        db.push(0);
+        db.push(0);
+        db.push(0);
+        db.push(0);
+      }
+      db.push(int(msg->type));
+      db.push(0xff & (msg->seqID >> 24));
+      db.push(0xff & (msg->seqID >> 16));
+      db.push(0xff & (msg->seqID >>  8));
+      db.push(0xff & (msg->seqID >>  0));
+      return true;
+  }
+  return false;
+}
+
+void Thrift::encode(Message *head, const Data &body, Data &data) {
+  Data::Builder db(data, &s_dp);
+  if (write_message_head(head, db)) db.push(body);
+  db.flush();
+}
+
 void Thrift::encode(pjs::Object *msg, Data::Builder &db) {
   static struct { int binary_code, compact_code; }
   s_type_codes[] = {
@@ -183,11 +255,7 @@ void Thrift::encode(pjs::Object *msg, Data::Builder &db) {
   };
 
   auto write_varint = [&](uint64_t i) {
-    do {
-      char c = i & 0x7f;
-      i >>= 7;
-      if (!i) db.push(c); else db.push(c | 0x80);
-    } while (i);
+    pipy::write_varint(db, i);
   };
 
   std::function<void(Protocol, Type, const pjs::Value &)> write_value;
@@ -381,66 +449,8 @@ void Thrift::encode(pjs::Object *msg, Data::Builder &db) {
 
   auto write_message = [&](pjs::Object *obj) {
     pjs::Ref<Message> msg = pjs::coerce<Message>(obj);
-    auto protocol = msg->protocol.get();
-
-    switch (protocol) {
-      case Protocol::binary:
-        db.push(0x80);
-        db.push(0x01);
-        db.push(0x00);
-        db.push(int(msg->type));
-        if (auto s = msg->name.get()) {
-          int len = s->size();
-          db.push(0xff & (len >> 24));
-          db.push(0xff & (len >> 16));
-          db.push(0xff & (len >>  8));
-          db.push(0xff & (len >>  0));
-          db.push(s->str());
-        } else {
-          db.push(0);
-          db.push(0);
-          db.push(0);
-          db.push(0);
-        }
-        db.push(0xff & (msg->seqID >> 24));
-        db.push(0xff & (msg->seqID >> 16));
-        db.push(0xff & (msg->seqID >>  8));
-        db.push(0xff & (msg->seqID >>  0));
-        break;
-
-      case Protocol::compact:
-        db.push(0x82);
-        db.push(0x01 | (int(msg->type) << 5));
-        write_varint(uint32_t(msg->seqID));
-        write_varint(uint32_t(msg->name ? msg->name->size() : 0));
-        if (auto s = msg->name.get()) db.push(s->str());
-        break;
-
-      case Protocol::old:
-        if (auto s = msg->name.get()) {
-          int len = s->size();
-          db.push(0xff & (len >> 24));
-          db.push(0xff & (len >> 16));
-          db.push(0xff & (len >>  8));
-          db.push(0xff & (len >>  0));
-          db.push(s->str());
-        } else {
-          db.push(0);
-          db.push(0);
-          db.push(0);
-          db.push(0);
-        }
-        db.push(int(msg->type));
-        db.push(0xff & (msg->seqID >> 24));
-        db.push(0xff & (msg->seqID >> 16));
-        db.push(0xff & (msg->seqID >>  8));
-        db.push(0xff & (msg->seqID >>  0));
-        break;
-
-      default: return;
-    }
-
-    write_value(protocol, Type::STRUCT, msg->fields.get());
+    if (!write_message_head(msg, db)) return;
+    write_value(msg->protocol.get(), Type::STRUCT, msg->fields.get());
   };
 
   if (msg->is_array()) {
@@ -460,14 +470,16 @@ void Thrift::encode(pjs::Object *msg, Data::Builder &db) {
 // Thrift::Parser
 //
 
-Thrift::Parser::Parser()
+Thrift::Parser::Parser(bool lazy)
   : m_read_data(Data::make())
+  , m_lazy(lazy)
 {
 }
 
 void Thrift::Parser::reset() {
   Deframer::reset();
-  Deframer::pass_all(true);
+  Deframer::pass_all(!m_lazy);
+  m_var_int_bits = 0;
   while (auto *s = m_stack) {
     m_stack = s->back;
     delete s;
@@ -520,10 +532,10 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
         }
         case Protocol::old: {
           int32_t len = (
-            ((int32_t)m_read_buf[4] << 24) |
-            ((int32_t)m_read_buf[5] << 16) |
-            ((int32_t)m_read_buf[6] <<  8) |
-            ((int32_t)m_read_buf[7] <<  0)
+            ((int32_t)m_read_buf[0] << 24) |
+            ((int32_t)m_read_buf[1] << 16) |
+            ((int32_t)m_read_buf[2] <<  8) |
+            ((int32_t)m_read_buf[3] <<  0)
           );
           if (len < 0) return ERROR;
           m_read_data = Data::make();
@@ -550,7 +562,7 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
       switch (m_protocol) {
         case Protocol::binary: Deframer::read(4, m_read_buf); return SEQ_ID;
         case Protocol::old: return MESSAGE_TYPE;
-        case Protocol::compact: return push_struct();
+        case Protocol::compact: return message_body();
       }
       return ERROR;
 
@@ -572,7 +584,7 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
           ((int32_t)m_read_buf[2] <<  8) |
           ((int32_t)m_read_buf[3] <<  0)
         );
-        return push_struct();
+        return message_body();
       }
 
     case STRUCT_FIELD_TYPE:
@@ -651,7 +663,9 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
     case VALUE_I64:
       if (m_protocol == Protocol::compact) {
         if (var_int(c)) return VALUE_I64;
-        set_value(pjs::Int::make(pjs::Int::Type::i64, zigzag_to_int(m_var_int)));
+        if (m_lazy) skip_value(); else set_value(pjs::Int::make(pjs::Int::Type::i64, zigzag_to_int(m_var_int)));
+      } else if (m_lazy) {
+        skip_value();
       } else {
         set_value(pjs::Int::make(pjs::Int::Type::i64,
           ((int64_t)m_read_buf[0] << 56) |
@@ -695,25 +709,34 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
       return set_value_end();
 
     case VALUE_UUID:
-      set_value(pjs::Str::make(utils::make_uuid(m_read_buf)));
+      if (m_lazy) skip_value(); else set_value(pjs::Str::make(utils::make_uuid(m_read_buf)));
       return set_value_end();
 
-    case BINARY_SIZE:
+    case BINARY_SIZE: {
+      int n;
       if (m_protocol == Protocol::compact) {
         if (var_int(c)) return BINARY_SIZE;
-        m_read_data = Data::make();
-        Deframer::read(m_var_int, m_read_data);
+        n = m_var_int;
       } else {
-        int n = (
+        n = (
           ((int32_t)m_read_buf[0] << 24) |
           ((int32_t)m_read_buf[1] << 16) |
           ((int32_t)m_read_buf[2] <<  8) |
           ((int32_t)m_read_buf[3] <<  0)
         );
+      }
+      if (m_lazy) {
+        if (n <= 0) {
+          skip_value();
+          return set_value_end();
+        }
+        Deframer::pass(n);
+      } else {
         m_read_data = Data::make();
         Deframer::read(n, m_read_data);
       }
       return BINARY_DATA;
+    }
 
     case LIST_HEAD:
       if (m_protocol == Protocol::compact) {
@@ -759,7 +782,7 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
       if (m_protocol == Protocol::compact) {
         if (var_int(c)) return MAP_HEAD;
         if (m_var_int == 0) {
-          set_value(Map::make());
+          if (m_lazy) skip_value(); else set_value(Map::make());
           return set_value_end();
         }
         return MAP_TYPE;
@@ -782,6 +805,10 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
       );
 
     case BINARY_DATA:
+      if (m_lazy) {
+        skip_value();
+        return set_value_end();
+      }
       try {
         set_value(m_read_data->to_string(Data::Encoding::utf8));
       } catch (std::runtime_error &err) {
@@ -794,8 +821,14 @@ auto Thrift::Parser::on_state(int state, int c) -> int {
 }
 
 bool Thrift::Parser::var_int(int c) {
-  m_var_int = (m_var_int << 7) | (c & 0x7f);
-  return (c & 0x80);
+  if (!m_var_int_bits) m_var_int = 0;
+  m_var_int |= uint64_t(c & 0x7f) << m_var_int_bits;
+  if (c & 0x80) {
+    m_var_int_bits += 7;
+    return true;
+  }
+  m_var_int_bits = 0;
+  return false;
 }
 
 auto Thrift::Parser::zigzag_to_int(uint32_t i) -> int32_t {
@@ -922,12 +955,15 @@ auto Thrift::Parser::set_value_end() -> State {
       return set_value_start();
     }
   } else {
-    Deframer::need_flush();
-    return START;
+    return message_done();
   }
 }
 
 void Thrift::Parser::set_value(const pjs::Value &v) {
+  if (m_lazy) {
+    skip_value();
+    return;
+  }
   if (auto l = m_stack) {
     auto &i = l->index;
     switch (l->kind) {
@@ -962,8 +998,14 @@ void Thrift::Parser::set_value(const pjs::Value &v) {
   }
 }
 
+void Thrift::Parser::skip_value() {
+  if (auto l = m_stack) {
+    if (l->kind != Level::STRUCT) l->index++;
+  }
+}
+
 auto Thrift::Parser::push_struct() -> State {
-  auto obj = pjs::Array::make();
+  auto obj = m_lazy ? nullptr : pjs::Array::make();
   set_value(obj);
   auto l = new Level;
   l->back = m_stack;
@@ -980,10 +1022,15 @@ auto Thrift::Parser::push_list(int code, bool is_set, int size) -> State {
   int read_size;
   set_value_type(code, type, state, read_size);
   if (state == ERROR) return state;
-  auto *obj = List::make();
-  obj->elementType = type;
-  obj->elements = pjs::Array::make();
-  set_value(obj);
+  List *obj = nullptr;
+  if (!m_lazy) {
+    obj = List::make();
+    obj->elementType = type;
+    obj->elements = pjs::Array::make();
+    set_value(obj);
+  } else {
+    skip_value();
+  }
   if (size <= 0) return set_value_end();
   auto l = new Level;
   l->back = m_stack;
@@ -1006,11 +1053,16 @@ auto Thrift::Parser::push_map(int code_k, int code_v, int size) -> State {
   int read_size_k, read_size_v;
   set_value_type(code_k, type_k, state_k, read_size_k);
   set_value_type(code_v, type_v, state_v, read_size_v);
-  auto obj = Map::make();
-  obj->keyType = type_k;
-  obj->valueType = type_v;
-  obj->pairs = pjs::Array::make();
-  set_value(obj);
+  Map *obj = nullptr;
+  if (!m_lazy) {
+    obj = Map::make();
+    obj->keyType = type_k;
+    obj->valueType = type_v;
+    obj->pairs = pjs::Array::make();
+    set_value(obj);
+  } else {
+    skip_value();
+  }
   if (size <= 0) return set_value_end();
   auto l = new Level;
   l->back = m_stack;
@@ -1033,17 +1085,34 @@ auto Thrift::Parser::pop() -> State {
     auto *l = m_stack;
     m_stack = l->back;
     delete l;
-    if (!m_stack) {
-      Deframer::need_flush();
-      return START;
-    }
+    if (!m_stack) return message_done();
     if (m_stack->kind == Level::STRUCT) return STRUCT_FIELD_TYPE;
   } while (m_stack->index >= m_stack->size);
   return set_value_start();
 }
 
+//
+// In lazy mode, only the message header is decoded and reported
+// via on_message_head(), and the body is walked through without
+// building any values, passing on only the bytes of the body
+//
+
+auto Thrift::Parser::message_body() -> State {
+  if (m_lazy) {
+    on_message_head(m_message);
+    Deframer::pass_all(true);
+  }
+  return push_struct();
+}
+
+auto Thrift::Parser::message_done() -> State {
+  Deframer::need_flush();
+  if (m_lazy) Deframer::pass_all(false);
+  return START;
+}
+
 void Thrift::Parser::start() {
-  if (!m_stack && !m_message) {
+  if (!m_lazy && !m_stack && !m_message) {
     on_message_start();
   }
 }
@@ -40,9 +40,12 @@ class Data;
 
 class Thrift : public pjs::ObjectTemplate<Thrift> {
 public:
+  class Message;
+
   static auto decode(const Data &data) -> pjs::Array*;
   static void encode(pjs::Object *msg, Data &data);
   static void encode(pjs::Object *mag, Data::Builder &db);
+  static void encode(Message *head, const Data &body, Data &data);
 
   //
   // Thrift::Protocol
@@ -141,13 +144,14 @@ public:
 
   class Parser : protected Deframer {
   public:
-    Parser();
+    Parser(bool lazy = false);
 
     void reset();
     void parse(Data &data);
 
   protected:
     virtual void on_message_start() {}
+    virtual void on_message_head(Message *msg) {}
     virtual void on_message_end(Message *msg) = 0;
 
   private:
@@ -203,9 +207,11 @@ public:
     Protocol m_protocol;
     Level* m_stack = nullptr;
     uint64_t m_var_int = 0;
+    int m_var_int_bits = 0;
     int m_element_type_code = 0;
     Type m_field_type;
     bool m_field_bool = false;
+    bool m_lazy;
 
     virtual auto on_state(int state, int c) -> int override;
 
@@ -219,10 +225,13 @@ public:
     auto set_value_start() -> State;
     auto set_value_end() -> State;
     void set_value(const pjs::Value &v);
+    void skip_value();
     auto push_struct() -> State;
     auto push_list(int code, bool is_set, int size) -> State;
     auto push_map(int code_k, int code_v, int size) -> State;
     auto pop() -> State;
+    auto message_body() -> State;
+    auto message_done() -> State;
 
     void start();
     void end();
@@ -25,6 +25,8 @@
 
 #include "buffer.hpp"
 
+#include <chrono>
+
 namespace pipy {
 
 //
@@ -32,6 +34,13 @@ namespace pipy {
 //
 
 thread_local List<BufferStats> BufferStats::s_all;
+bool BufferStats::s_timing = false;
+
+void BufferStats::update() {
+  auto t = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  if (size > 0) queued_time += size * (t - m_time);
+  m_time = t;
+}
 
 //
 // DataBuffer::Options
@@ -48,28 +57,28 @@ DataBuffer::Options::Options(pjs::Object *options) {
 //
 
 void DataBuffer::clear() {
-  if (m_stats) m_stats->size -= m_buffer.size();
+  if (m_stats) m_stats->dequeue(m_buffer.size());
   m_buffer.clear();
 }
 
 void DataBuffer::push(const Data &data) {
   if (data.empty()) return;
-  if (m_stats) m_stats->size += data.size();
+  if (m_stats) m_stats->enqueue(data.size());
   m_buffer.push(data);
   if (m_options.bufferLimit >= 0 && m_buffer.size() > m_options.bufferLimit) {
     auto n = m_buffer.size() - m_options.bufferLimit;
-    if (m_stats) m_stats->size -= n;
+    if (m_stats) m_stats->dequeue(n);
     m_buffer.pop(n);
   }
 }
 
 auto DataBuffer::flush() -> Data* {
-  if (m_stats) m_stats->size -= m_buffer.size();
+  if (m_stats) m_stats->dequeue(m_buffer.size());
   return Data::make(std::move(m_buffer));
 }
 
 void DataBuffer::flush(Data &out) {
-  if (m_stats) m_stats->size -= m_buffer.size();
+  if (m_stats) m_stats->dequeue(m_buffer.size());
   out.push(std::move(m_buffer));
 }
 
@@ -44,9 +44,26 @@ struct BufferStats : public List<BufferStats>::Item {
   std::string name;
   size_t size = 0;
 
+  // Only counted with timing on: dividing the two gives the average
+  // time in seconds a byte stays in the buffer
+  uint64_t queued_size = 0;
+  double queued_time = 0;
+
   BufferStats() { s_all.push(this); }
   ~BufferStats() { s_all.remove(this); }
 
+  static void set_timing(bool b) { s_timing = b; }
+
+  void enqueue(size_t n) {
+    if (s_timing) { update(); queued_size += n; }
+    size += n;
+  }
+
+  void dequeue(size_t n) {
+    if (s_timing) update();
+    size -= n;
+  }
+
   static void for_each(const std::function<void(BufferStats*)> &callback) {
     for (auto i = s_all.head(); i; i = i->next()) {
       callback(i);
@@ -54,7 +71,12 @@ struct BufferStats : public List<BufferStats>::Item {
   }
 
 private:
+  double m_time = 0;
+
+  void update();
+
   thread_local static List<BufferStats> s_all;
+  static bool s_timing;
 };
 
 //
@@ -88,7 +110,7 @@ public:
     m_events.push(e);
     if (m_stats) {
       if (auto data = e->as<Data>()) {
-        m_stats->size += data->size();
+        m_stats->enqueue(data->size());
       }
     }
   }
@@ -100,7 +122,7 @@ public:
     e->m_in_buffer = false;
     if (m_stats) {
       if (auto data = e->as<Data>()) {
-        m_stats->size -= data->size();
+        m_stats->dequeue(data->size());
       }
     }
     return e;
@@ -113,7 +135,7 @@ public:
     m_events.unshift(e);
     if (m_stats) {
       if (auto data = e->as<Data>()) {
-        m_stats->size += data->size();
+        m_stats->enqueue(data->size());
       }
     }
   }
@@ -131,7 +153,7 @@ public:
       e->m_in_buffer = false;
       if (m_stats) {
         if (auto data = e->as<Data>()) {
-          m_stats->size -= data->size();
+          m_stats->dequeue(data->size());
         }
       }
       input->input(e);
@@ -146,7 +168,7 @@ public:
       e->m_in_buffer = false;
       if (m_stats) {
         if (auto data = e->as<Data>()) {
-          m_stats->size -= data->size();
+          m_stats->dequeue(data->size());
         }
       }
       out(e);
@@ -160,7 +182,7 @@ public:
       e->m_in_buffer = false;
       if (m_stats) {
         if (auto data = e->as<Data>()) {
-          m_stats->size -= data->size();
+          m_stats->dequeue(data->size());
         }
       }
       auto ret = out(e);
@@ -176,7 +198,7 @@ public:
       e->m_in_buffer = false;
       if (m_stats) {
         if (auto data = e->as<Data>()) {
-          m_stats->size -= data->size();
+          m_stats->dequeue(data->size());
         }
       }
       e->release();
@@ -46,6 +46,43 @@ static const pjs::Ref<pjs::Str> s_etag(pjs::Str::make("etag"));
 static const pjs::Ref<pjs::Str> s_date(pjs::Str::make("last-modified"));
 
 Codebase* Codebase::s_current = nullptr;
+thread_local Codebase::Dependencies* Codebase::s_recording = nullptr;
+
+//
+// Codebase::Dependencies
+//
+
+bool Codebase::Dependencies::changed() const {
+  auto codebase = Codebase::current();
+  if (!codebase || codebase->entry() != m_entry) return true;
+  for (const auto &p : m_digests) {
+    auto sd = codebase->get(p.first);
+    auto d = digest(sd);
+    if (sd) sd->release();
+    if (d != p.second) return true;
+  }
+  return false;
+}
+
+void Codebase::Dependencies::add(const std::string &path, SharedData *data) {
+  m_digests[path] = digest(data);
+}
+
+auto Codebase::Dependencies::digest(SharedData *data) -> uint64_t {
+  if (!data) return 0;
+  uint64_t h = 0xcbf29ce484222325ull;
+  Data buf;
+  data->to_data(buf);
+  buf.to_chunks(
+    [&](const uint8_t *ptr, int len) {
+      for (int i = 0; i < len; i++) {
+        h ^= ptr[i];
+        h *= 0x100000001b3ull;
+      }
+    }
+  );
+  return h | 1; // never 0, which stands for a missing file
+}
 
 //
 // CodebaseFromRoot
@@ -144,10 +181,14 @@ auto CodebaseFromRoot::list(const std::string &path) -> std::list<std::string> {
 auto CodebaseFromRoot::get(const std::string &path) -> SharedData* {
   std::lock_guard<std::mutex> lock(m_mutex);
   std::string local_path;
+  SharedData *data;
   if (auto codebase = find_mount(path, local_path)) {
-    return codebase->get(local_path);
+    data = codebase->get(local_path);
+  } else {
+    data = m_root->get(path);
   }
-  return m_root->get(path);
+  recorded(path, data);
+  return data;
 }
 
 void CodebaseFromRoot::set(const std::string &path, SharedData *data) {
@@ -32,6 +32,8 @@
 #include <mutex>
 #include <functional>
 #include <list>
+#include <map>
+#include <string>
 
 namespace pipy {
 
@@ -86,8 +88,38 @@ public:
     friend class Codebase;
   };
 
+  //
+  // Codebase::Dependencies
+  //
+
+  class Dependencies {
+  public:
+    void clear() { m_entry.clear(); m_digests.clear(); }
+    auto size() const -> size_t { return m_digests.size(); }
+    bool changed() const;
+
+  private:
+    std::string m_entry;
+    std::map<std::string, uint64_t> m_digests;
+
+    void add(const std::string &path, SharedData *data);
+
+    static auto digest(SharedData *data) -> uint64_t;
+
+    friend class Codebase;
+  };
+
   static auto current() -> Codebase* { return s_current; }
 
+  // Records what is read from the current codebase on the calling thread
+  static void record(Dependencies *deps) {
+    if (deps) {
+      deps->clear();
+      if (s_current) deps->m_entry = s_current->entry();
+    }
+    s_recording = deps;
+  }
+
   static Codebase* from_root(Codebase *root);
   static Codebase* from_fs(const std::string &path);
   static Codebase* from_fs(const std::string &path, const std::string &script);
@@ -123,8 +155,13 @@ protected:
 
   auto normalize_path(const std::string &path) -> std::string;
 
+  static void recorded(const std::string &path, SharedData *data) {
+    if (s_recording) s_recording->add(path, data);
+  }
+
 private:
   static Codebase* s_current;
+  thread_local static Dependencies* s_recording;
 };
 
 } // namespace pipy
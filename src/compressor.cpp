@@ -43,20 +43,22 @@ static Data::Producer s_dp_brotli("brotli");
 
 class Inflate : public pjs::Pooled<Inflate>, public Decompressor {
 public:
-  Inflate(const std::function<void(Data&)> &out, bool gzip)
+  Inflate(const std::function<void(Data&)> &out, int window_bits)
     : m_out(out)
+    , m_raw(window_bits < 0)
   {
     m_zs.zalloc = Z_NULL;
     m_zs.zfree = Z_NULL;
     m_zs.opaque = Z_NULL;
     m_zs.next_in = Z_NULL;
     m_zs.avail_in = 0;
-    inflateInit2(&m_zs, gzip ? 16 + MAX_WBITS : MAX_WBITS);
+    inflateInit2(&m_zs, window_bits);
   }
 
 private:
   const std::function<void(Data&)> m_out;
   z_stream m_zs;
+  bool m_raw;
   bool m_done = false;
 
   ~Inflate() {
@@ -73,16 +75,23 @@ private:
     for (const auto chk : data.chunks()) {
       m_zs.next_in = (const unsigned char *)std::get<0>(chk);
       m_zs.avail_in = std::get<1>(chk);
-      do {
+      for (;;) {
         m_zs.next_out = buf;
         m_zs.avail_out = sizeof(buf);
         auto ret = ::inflate(&m_zs, Z_NO_FLUSH);
         if (auto size = sizeof(buf) - m_zs.avail_out) {
           db.push(buf, size);
         }
-        if (ret == Z_STREAM_END) { m_done = true; break; }
-        if (ret != Z_OK && ret != Z_BUF_ERROR) return false;
-      } while (m_zs.avail_out == 0);
+        if (ret == Z_STREAM_END) {
+          // A raw stream carries on with a new one after a final block
+          if (!m_raw) { m_done = true; break; }
+          inflateReset(&m_zs);
+        } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+          return false;
+        } else if (m_zs.avail_out > 0) {
+          break;
+        }
+      }
       if (m_done) break;
     }
 
@@ -193,8 +202,9 @@ public:
     gzip,
   };
 
-  Deflate(const Output &out, bool gzip)
+  Deflate(const Output &out, int window_bits)
     : m_out(out)
+    , m_raw(window_bits < 0)
   {
     m_zs.zalloc = Z_NULL;
     m_zs.zfree = Z_NULL;
@@ -206,7 +216,7 @@ public:
       &m_zs,
       Z_DEFAULT_COMPRESSION,
       Z_DEFLATED,
-      gzip ? 16 + MAX_WBITS : MAX_WBITS,
+      window_bits,
       8,
       Z_DEFAULT_STRATEGY
     );
@@ -215,6 +225,7 @@ public:
 private:
   Output m_out;
   z_stream m_zs;
+  bool m_raw;
 
   ~Deflate(){
     deflateEnd(&m_zs);
@@ -256,7 +267,8 @@ private:
     do {
       m_zs.next_out = buf;
       m_zs.avail_out = sizeof(buf);
-      auto ret = ::deflate(&m_zs, flush ? Z_FINISH : Z_NO_FLUSH);
+      // Raw streams are flushed to a byte boundary but never finished
+      auto ret = ::deflate(&m_zs, flush ? (m_raw ? Z_SYNC_FLUSH : Z_FINISH) : Z_NO_FLUSH);
       if (ret == Z_STREAM_ERROR) return false;
       if (auto size = sizeof(buf) - m_zs.avail_out) db.push(buf, size);
     } while (m_zs.avail_out == 0);
@@ -273,11 +285,15 @@ Data::Producer Deflate::s_dp("Compress (defalte)");
 //
 
 Decompressor* Decompressor::inflate(const std::function<void(Data&)> &out) {
-  return new Inflate(out, false);
+  return new Inflate(out, MAX_WBITS);
+}
+
+Decompressor* Decompressor::inflate_raw(const std::function<void(Data&)> &out, int window_bits) {
+  return new Inflate(out, -window_bits);
 }
 
 Decompressor* Decompressor::gzip(const std::function<void(Data&)> &out) {
-  return new Inflate(out, true);
+  return new Inflate(out, 16 + MAX_WBITS);
 }
 
 Decompressor* Decompressor::brotli(const std::function<void(Data&)> &out) {
@@ -289,11 +305,16 @@ Decompressor* Decompressor::brotli(const std::function<void(Data&)> &out) {
 //
 
 Compressor *Compressor::deflate(const Output &out) {
-  return new Deflate(out, false);
+  return new Deflate(out, MAX_WBITS);
+}
+
+Compressor *Compressor::deflate_raw(const Output &out, int window_bits) {
+  // zlib cannot deflate with a 256-byte window
+  return new Deflate(out, -std::max(window_bits, 9));
 }
 
 Compressor *Compressor::gzip(const Output &out) {
-  return new Deflate(out, true);
+  return new Deflate(out, 16 + MAX_WBITS);
 }
 
 } // namespace pipy
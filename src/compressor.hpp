@@ -42,6 +42,7 @@ public:
   typedef std::function<void(Data&)> Output;
 
   static Decompressor* inflate(const Output &out);
+  static Decompressor* inflate_raw(const Output &out, int window_bits = 15);
   static Decompressor* gzip(const Output &out);
   static Decompressor* brotli(const Output &out);
 
@@ -61,6 +62,7 @@ public:
   typedef std::function<void(Data&)> Output;
 
   static Compressor* deflate(const Output &out);
+  static Compressor* deflate_raw(const Output &out, int window_bits = 15);
   static Compressor* gzip(const Output &out);
 
   virtual bool input(const Data &data, bool flush) = 0;
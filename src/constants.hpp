@@ -29,6 +29,9 @@
 namespace pipy {
 
 const size_t DATA_CHUNK_SIZE = 0x4000;
+const size_t DATA_CHUNK_MAX_SIZE = 0x10000;
+const size_t DATA_CHUNK_CLASSES = 5;
+const size_t DATA_CHUNK_CLASS_SIZES[DATA_CHUNK_CLASSES] = { 0x100, 0x400, 0x1000, DATA_CHUNK_SIZE, DATA_CHUNK_MAX_SIZE };
 const size_t RECEIVE_BUFFER_SIZE = 0x4000;
 
 } // namespace pipy
@@ -41,11 +41,28 @@ auto Data::Producer::producer_list_mutex() -> std::mutex& {
   return s_mutex;
 }
 
+auto Data::Chunk::pool(int size_class) -> pjs::Pool& {
+  struct Pools {
+    pjs::PooledClass* classes[DATA_CHUNK_CLASSES];
+    Pools() {
+      for (int i = 0; i < DATA_CHUNK_CLASSES; i++) {
+        auto size = DATA_CHUNK_CLASS_SIZES[i];
+        auto name = "pipy::Data::Chunk[" + std::to_string(size) + ']';
+        classes[i] = new pjs::PooledClass(name.c_str(), sizeof(Chunk) + size);
+      }
+    }
+    ~Pools() {
+      for (auto *c : classes) delete c;
+    }
+  };
+  thread_local static Pools s_pools;
+  return s_pools.classes[size_class]->pool();
+}
+
 void Data::pack(const Data &data, Producer *producer, double vacancy) {
   assert_same_thread(*this);
   if (&data == this) return;
   if (!producer) producer = &s_unknown_producer;
-  auto occupancy = DATA_CHUNK_SIZE - int(DATA_CHUNK_SIZE * vacancy);
   for (auto view = data.m_head; view; view = view->next) {
     auto tail = m_tail;
     if (!tail) {
@@ -54,17 +71,19 @@ void Data::pack(const Data &data, Producer *producer, double vacancy) {
     }
     auto tail_offset = tail->offset;
     auto tail_length = tail->length;
-    if (tail_length < occupancy || view->length + tail_length <= DATA_CHUNK_SIZE) {
-      if (tail_offset > 0 || tail->chunk->retain_count > 1) {
-        tail = tail->clone(producer);
+    auto tail_size = std::max(tail->chunk->size(), int(DATA_CHUNK_SIZE));
+    auto occupancy = tail_size - int(tail_size * vacancy);
+    if (tail_length < occupancy || view->length + tail_length <= tail_size) {
+      if (tail_offset > 0 || tail->chunk->retain_count > 1 || tail->chunk->size() < tail_size) {
+        tail = tail->clone(producer, tail_size);
         delete pop_view();
         push_view(tail);
       }
-      auto tail_room = DATA_CHUNK_SIZE - tail_length;
+      auto tail_room = tail_size - tail_length;
       auto length = std::min(view->length, int(tail_room));
       std::memcpy(
-        tail->chunk->data + tail_length,
-        view->chunk->data + view->offset,
+        tail->chunk->data() + tail_length,
+        view->chunk->data() + view->offset,
         length
       );
       tail->length += length;
@@ -84,6 +103,22 @@ void Data::pack(const Data &data, Producer *producer, double vacancy) {
   }
 }
 
+void Data::compact(Producer *producer) {
+  assert_same_thread(*this);
+  if (!m_head || m_size > DATA_CHUNK_SIZE) return;
+  int footprint = 0;
+  for (auto view = m_head; view; view = view->next) {
+    footprint += view->chunk->size();
+  }
+  if (footprint <= DATA_CHUNK_CLASS_SIZES[Chunk::size_class_of(m_size)]) return;
+  auto compacted = new View(Chunk::make(producer, m_size), 0, 0);
+  for (auto view = m_head; view; view = view->next) {
+    compacted->push(view->chunk->data() + view->offset, view->length);
+  }
+  clear();
+  push_view(compacted);
+}
+
 auto Data::to_string(Encoding encoding) const -> std::string {
   assert_same_thread(*this);
   switch (encoding) {
@@ -119,38 +154,77 @@ auto Data::to_string(Encoding encoding) const -> std::string {
       return str;
     }
     case Encoding::hex: {
-      std::string str;
-      utils::HexEncoder encoder([&](char c) { str += c; });
+      std::string str(size() * 2, '\0');
+      auto *out = &str[0];
       for (const auto c : chunks()) {
-        auto ptr = std::get<0>(c);
-        auto len = std::get<1>(c);
-        for (int i = 0; i < len; i++) encoder.input(ptr[i]);
+        out += utils::encode_hex(out, std::get<0>(c), std::get<1>(c));
       }
       return str;
     }
-    case Encoding::base64: {
-      std::string str;
-      utils::Base64Encoder encoder([&](char c) { str += c; });
+    case Encoding::base64:
+    case Encoding::base64url: {
+      bool url = (encoding == Encoding::base64url);
+      auto encode = url ? utils::encode_base64url : utils::encode_base64;
+      std::string str((size() + 2) / 3 * 4, '\0');
+      auto *out = &str[0];
+      uint8_t carry[3];
+      int carry_size = 0;
       for (const auto c : chunks()) {
         auto ptr = std::get<0>(c);
         auto len = std::get<1>(c);
-        for (int i = 0; i < len; i++) encoder.input(ptr[i]);
+        if (carry_size > 0) {
+          while (carry_size < 3 && len > 0) {
+            carry[carry_size++] = *ptr++;
+            len--;
+          }
+          if (carry_size < 3) continue;
+          out += encode(out, carry, 3);
+          carry_size = 0;
+        }
+        auto n = len / 3 * 3;
+        out += encode(out, ptr, n);
+        while (n < len) carry[carry_size++] = ptr[n++];
       }
-      encoder.flush();
+      out += encode(out, carry, carry_size);
+      str.resize(out - &str[0]);
       return str;
     }
+    default: return to_string();
+  }
+}
+
+void Data::push_decoded(const std::string &str, Encoding encoding, Producer *producer) {
+  static const int BLOCK_SIZE = 4096;
+  uint8_t buf[BLOCK_SIZE];
+  auto len = int(str.length());
+  auto *inp = str.c_str();
+  switch (encoding) {
+    case Encoding::hex: {
+      if (len % 2) throw std::runtime_error("incomplete hex string");
+      for (int i = 0; i < len; i += BLOCK_SIZE * 2) {
+        auto n = utils::decode_hex(buf, inp + i, std::min(len - i, BLOCK_SIZE * 2));
+        if (n < 0) throw std::runtime_error("invalid hex encoding");
+        push(buf, n, producer);
+      }
+      break;
+    }
+    case Encoding::base64:
     case Encoding::base64url: {
-      std::string str;
-      utils::Base64UrlEncoder encoder([&](char c) { str += c; });
-      for (const auto c : chunks()) {
-        auto ptr = std::get<0>(c);
-        auto len = std::get<1>(c);
-        for (int i = 0; i < len; i++) encoder.input(ptr[i]);
+      bool url = (encoding == Encoding::base64url);
+      if (!url && len % 4) throw std::runtime_error("incomplete Base64 string");
+      auto decode = url ? utils::decode_base64url : utils::decode_base64;
+      for (int i = 0; i < len; i += BLOCK_SIZE / 3 * 4) {
+        auto block = std::min(len - i, BLOCK_SIZE / 3 * 4);
+        auto last = (i + block == len);
+        // Padding is only allowed at the very end
+        if (!last && inp[i + block - 1] == '=') throw std::runtime_error("invalid Base64 encoding");
+        auto n = decode(buf, inp + i, block);
+        if (n < 0) throw std::runtime_error("invalid Base64 encoding");
+        push(buf, n, producer);
       }
-      encoder.flush();
-      return str;
+      break;
     }
-    default: return to_string();
+    default: push(str, producer); break;
   }
 }
 
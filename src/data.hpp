@@ -81,13 +81,26 @@ public:
       }
     }
 
-    Producer(const std::string &name) : m_name(name), m_count(0) {
+    Producer(const std::string &name) : m_name(name) {
+      for (auto &n : m_counts) n.store(0, std::memory_order_relaxed);
       std::lock_guard<std::mutex> lock(producer_list_mutex());
       s_all_producers.push(this);
     }
 
     auto name() const -> const std::string& { return m_name; }
-    auto count() const -> size_t { return m_count.load(std::memory_order_relaxed); }
+    auto count(int size_class) const -> size_t { return m_counts[size_class].load(std::memory_order_relaxed); }
+
+    auto count() const -> size_t {
+      size_t n = 0;
+      for (int i = 0; i < DATA_CHUNK_CLASSES; i++) n += count(i);
+      return n;
+    }
+
+    auto size() const -> size_t {
+      size_t n = 0;
+      for (int i = 0; i < DATA_CHUNK_CLASSES; i++) n += count(i) * DATA_CHUNK_CLASS_SIZES[i];
+      return n;
+    }
 
     Data* make(int size) { return Data::make(size, this); }
     Data* make(int size, int value) { return Data::make(size, value, this); }
@@ -107,12 +120,12 @@ public:
 
   private:
     std::string m_name;
-    std::atomic<size_t> m_count;
+    std::atomic<size_t> m_counts[DATA_CHUNK_CLASSES];
 
     static auto producer_list_mutex() -> std::mutex&;
 
-    void increase() { m_count.fetch_add(1, std::memory_order_relaxed); }
-    void decrease() { m_count.fetch_sub(1, std::memory_order_relaxed); }
+    void increase(int size_class) { m_counts[size_class].fetch_add(1, std::memory_order_relaxed); }
+    void decrease(int size_class) { m_counts[size_class].fetch_sub(1, std::memory_order_relaxed); }
 
     static List<Producer> s_all_producers;
 
@@ -128,10 +141,10 @@ public:
     Builder(Data &data, Producer *producer = nullptr)
       : m_data(data)
       , m_producer(producer)
-      , m_chunk(new Chunk(producer)) {}
+      , m_chunk(Chunk::make(producer, DATA_CHUNK_CLASS_SIZES[0])) {}
 
     ~Builder() {
-      delete m_chunk;
+      m_chunk->free();
     }
 
     int size() const {
@@ -145,17 +158,15 @@ public:
 
     void flush() {
       if (m_ptr > 0) {
-        m_data.push_view(new View(m_chunk, 0, m_ptr));
-        m_chunk = new Chunk(m_producer);
-        m_ptr = 0;
+        renew();
       }
     }
 
     void push(char c) {
-      m_chunk->data[m_ptr++] = c;
+      m_chunk->data()[m_ptr++] = c;
       m_size++;
-      if (m_ptr >= sizeof(m_chunk->data)) {
-        flush();
+      if (m_ptr >= m_chunk->size()) {
+        renew();
       }
     }
 
@@ -167,15 +178,13 @@ public:
       auto &p = m_ptr;
       m_size += n;
       while (n > 0) {
-        int l = sizeof(m_chunk->data) - p;
+        int l = m_chunk->size() - p;
         if (l > n) l = n;
-        std::memset(m_chunk->data + p, c, l);
+        std::memset(m_chunk->data() + p, c, l);
         p += l;
         n -= l;
-        if (p >= sizeof(m_chunk->data)) {
-          m_data.push_view(new View(m_chunk, 0, p));
-          m_chunk = new Chunk(m_producer);
-          p = 0;
+        if (p >= m_chunk->size()) {
+          renew();
         }
       }
     }
@@ -188,16 +197,14 @@ public:
       auto &p = m_ptr;
       m_size += n;
       while (n > 0) {
-        int l = sizeof(m_chunk->data) - p;
+        int l = m_chunk->size() - p;
         if (l > n) l = n;
-        std::memcpy(m_chunk->data + p, s, l);
+        std::memcpy(m_chunk->data() + p, s, l);
         s += l;
         p += l;
         n -= l;
-        if (p >= sizeof(m_chunk->data)) {
-          m_data.push_view(new View(m_chunk, 0, p));
-          m_chunk = new Chunk(m_producer);
-          p = 0;
+        if (p >= m_chunk->size()) {
+          renew();
         }
       }
     }
@@ -234,6 +241,16 @@ public:
     Chunk* m_chunk;
     int m_ptr = 0;
     int m_size = 0;
+
+    // Output starts in the smallest chunks and steps up one size
+    // class every time a chunk fills up, until DATA_CHUNK_SIZE
+    void renew() {
+      auto size = m_chunk->size();
+      m_data.push_view(new View(m_chunk, 0, m_ptr));
+      if (m_ptr >= size && size < DATA_CHUNK_SIZE) size++;
+      m_chunk = Chunk::make(m_producer, size);
+      m_ptr = 0;
+    }
   };
 
   //
@@ -256,7 +273,7 @@ public:
     int get() {
       auto v = m_view;
       if (!v) return -1;
-      uint8_t c = v->chunk->data[v->offset + m_offset];
+      uint8_t c = v->chunk->data()[v->offset + m_offset];
       if (++m_offset >= v->length) {
         m_view = v->next;
         m_offset = 0;
@@ -294,13 +311,13 @@ public:
         auto a = v->length - m_offset;
         auto b = n - i;
         if (a <= b) {
-          std::memcpy(p, v->chunk->data + v->offset + m_offset, a);
+          std::memcpy(p, v->chunk->data() + v->offset + m_offset, a);
           p += a;
           i += a;
           m_view = v->next;
           m_offset = 0;
         } else {
-          std::memcpy(p, v->chunk->data + v->offset + m_offset, b);
+          std::memcpy(p, v->chunk->data() + v->offset + m_offset, b);
           p += b;
           i += b;
           m_offset += b;
@@ -360,21 +377,46 @@ private:
   // Data::Chunk
   //
 
-  struct Chunk : public Pooled<Chunk> {
+  struct Chunk {
     std::atomic<int> retain_count;
-    char data[DATA_CHUNK_SIZE];
 
-    Chunk(Producer *producer)
-      : retain_count(0)
-      , m_producer(producer ? producer : Producer::unknown()) { m_producer->increase(); }
-    ~Chunk() { m_producer->decrease(); }
+    static auto make(Producer *producer, int size) -> Chunk* {
+      auto size_class = size_class_of(size);
+      return new (pool(size_class).alloc()) Chunk(producer, size_class);
+    }
 
-    auto size() const -> int { return sizeof(data); }
+    static int size_class_of(int size) {
+      for (int i = 0; i < DATA_CHUNK_CLASSES - 1; i++) {
+        if (size <= DATA_CHUNK_CLASS_SIZES[i]) return i;
+      }
+      return DATA_CHUNK_CLASSES - 1;
+    }
+
+    auto size() const -> int { return m_size; }
+    auto data() -> char* { return reinterpret_cast<char*>(this + 1); } // bytes follow the header in the same pooled block
     void retain() { retain_count.fetch_add(1, std::memory_order_relaxed); }
-    void release() { if (retain_count.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this; }
+    void release() { if (retain_count.fetch_sub(1, std::memory_order_acq_rel) == 1) free(); }
+
+    void free() {
+      auto &p = pool(m_class);
+      this->~Chunk();
+      p.free(this);
+    }
 
   private:
     Producer* m_producer;
+    int m_size;
+    int m_class;
+
+    Chunk(Producer *producer, int size_class)
+      : retain_count(0)
+      , m_producer(producer ? producer : Producer::unknown())
+      , m_size(DATA_CHUNK_CLASS_SIZES[size_class])
+      , m_class(size_class) { m_producer->increase(size_class); }
+
+    ~Chunk() { m_producer->decrease(m_class); }
+
+    static auto pool(int size_class) -> pjs::Pool&;
   };
 
   //
@@ -412,7 +454,7 @@ private:
       int tail = offset + length;
       int room = std::min(chunk->size() - tail, n);
       if (room > 0) {
-        std::memcpy(chunk->data + tail, p, room);
+        std::memcpy(chunk->data() + tail, p, room);
         length += room;
         return room;
       } else {
@@ -432,10 +474,10 @@ private:
       return view;
     }
 
-    View* clone(Producer *producer) {
+    View* clone(Producer *producer, int size) {
       if (!producer) producer = &s_unknown_producer;
-      auto new_chunk = new Chunk(producer);
-      std::memcpy(new_chunk->data, chunk->data + offset, length);
+      auto new_chunk = Chunk::make(producer, std::max(size, length));
+      std::memcpy(new_chunk->data(), chunk->data() + offset, length);
       return new View(new_chunk, 0, length);
     }
   };
@@ -476,7 +518,7 @@ public:
       }
 
       auto operator*() const -> std::tuple<char*, int> {
-        return std::make_tuple(m_p->chunk->data + m_p->offset, m_p->length);
+        return std::make_tuple(m_p->chunk->data() + m_p->offset, m_p->length);
       }
     };
 
@@ -501,7 +543,7 @@ public:
   {
     if (!producer) producer = &s_unknown_producer;
     while (size > 0) {
-      auto chunk = new Chunk(producer);
+      auto chunk = Chunk::make(producer, size);
       auto length = std::min(size, chunk->size());
       push_view(new View(chunk, 0, length));
       size -= length;
@@ -515,9 +557,9 @@ public:
   {
     if (!producer) producer = &s_unknown_producer;
     while (size > 0) {
-      auto chunk = new Chunk(producer);
+      auto chunk = Chunk::make(producer, size);
       auto length = std::min(size, chunk->size());
-      std::memset(chunk->data, value, length);
+      std::memset(chunk->data(), value, length);
       push_view(new View(chunk, 0, length));
       size -= length;
     }
@@ -552,45 +594,11 @@ public:
         db.flush();
         break;
       }
-      case Encoding::hex: {
-        if (str.length() % 2) throw std::runtime_error("incomplete hex string");
-        Builder db(*this, producer);
-        utils::HexDecoder decoder([&](uint8_t b) { db.push(b); });
-        for (auto c : str) {
-          if (!decoder.input(c)) {
-            throw std::runtime_error("invalid hex encoding");
-          }
-        }
-        db.flush();
-        break;
-      }
-      case Encoding::base64: {
-        if (str.length() % 4) throw std::runtime_error("incomplete Base64 string");
-        Builder db(*this, producer);
-        utils::Base64Decoder decoder([&](uint8_t b) { db.push(b); });
-        for (auto c : str) {
-          if (!decoder.input(c)) {
-            throw std::runtime_error("invalid Base64 encoding");
-          }
-        }
-        if (!decoder.complete()) throw std::runtime_error("incomplete Base64 encoding");
-        db.flush();
+      case Encoding::hex:
+      case Encoding::base64:
+      case Encoding::base64url:
+        push_decoded(str, encoding, producer);
         break;
-      }
-      case Encoding::base64url: {
-        Builder db(*this, producer);
-        utils::Base64UrlDecoder decoder([&](uint8_t b) { db.push(b); });
-        for (auto c : str) {
-          if (!decoder.input(c)) {
-            throw std::runtime_error("invalid Base64 encoding");
-          }
-        }
-        if (!decoder.flush()) {
-          throw std::runtime_error("invalid Base64 encoding");
-        }
-        db.flush();
-        break;
-      }
     }
   }
 
@@ -723,7 +731,7 @@ public:
       }
     }
     while (n > 0) {
-      auto view = new View(new Chunk(producer), 0, 0);
+      auto view = new View(Chunk::make(producer, chunk_size_for(n)), 0, 0);
       auto added = view->push(p, n);
       p += added;
       n -= added;
@@ -742,23 +750,23 @@ public:
       if (chunk->retain_count == 1) {
         int end = tail->offset + tail->length;
         if (end < chunk->size()) {
-          chunk->data[end] = ch;
+          chunk->data()[end] = ch;
           tail->length++;
           m_size++;
           return;
         }
       }
     }
-    auto chunk = new Chunk(producer ? producer : &s_unknown_producer);
+    auto chunk = Chunk::make(producer, chunk_size_for(1));
     auto view = new View(chunk, 0, 1);
-    chunk->data[0] = ch;
+    chunk->data()[0] = ch;
     push_view(view);
   }
 
   void scan(const std::function<bool(int)> &f) {
     assert_same_thread(*this);
     for (auto view = m_head; view; view = view->next) {
-      auto data = view->chunk->data;
+      auto data = view->chunk->data();
       auto size = view->length;
       auto head = view->offset;
       for (int i = 0; i < size; ++i) if (!f(data[head + i])) return;
@@ -816,7 +824,7 @@ public:
     auto i = 0;
     while (auto view = m_head) {
       if (n <= 0) break;
-      auto p = view->chunk->data + view->offset;
+      auto p = view->chunk->data() + view->offset;
       auto l = view->length;
       if (l <= n) {
         std::memcpy(out + i, p, l);
@@ -853,7 +861,7 @@ public:
     assert_same_thread(*this);
     assert_same_thread(out);
     while (auto view = m_head) {
-      auto data = view->chunk->data;
+      auto data = view->chunk->data();
       auto size = view->length;
       auto head = view->offset;
       auto n = 0;
@@ -879,7 +887,7 @@ public:
     assert_same_thread(*this);
     assert_same_thread(out);
     while (auto view = m_head) {
-      auto data = view->chunk->data;
+      auto data = view->chunk->data();
       auto size = view->length;
       auto head = view->offset;
       auto n = 0;
@@ -904,7 +912,7 @@ public:
     assert_same_thread(*this);
     assert_same_thread(out);
     while (auto view = m_head) {
-      auto data = view->chunk->data;
+      auto data = view->chunk->data();
       auto size = view->length;
       auto head = view->offset;
       auto n = 0;
@@ -927,18 +935,45 @@ public:
   }
 
   void pack(const Data &data, Producer *producer, double vacancy = 0.5);
+  void compact(Producer *producer);
 
   void to_chunks(const std::function<void(const uint8_t*, int)> &cb) const {
     assert_same_thread(*this);
     for (auto view = m_head; view; view = view->next) {
-      cb((uint8_t*)view->chunk->data + view->offset, view->length);
+      cb((uint8_t*)view->chunk->data() + view->offset, view->length);
+    }
+  }
+
+  //
+  // Rewrites the content chunk by chunk. The callback gets the current bytes
+  // and where to put the new ones, which is the same memory when this Data
+  // is the only holder of the chunk. Shared chunks are swapped for new ones
+  // the callback fills in, so they are never copied before being rewritten.
+  //
+
+  void rewrite(Producer *producer, const std::function<void(uint8_t*, const uint8_t*, int)> &cb) {
+    assert_same_thread(*this);
+    for (auto view = m_head; view; view = view->next) {
+      auto chunk = view->chunk;
+      auto src = (uint8_t*)chunk->data() + view->offset;
+      if (chunk->retain_count == 1) {
+        cb(src, src, view->length);
+      } else {
+        if (!producer) producer = &s_unknown_producer;
+        auto new_chunk = Chunk::make(producer, view->length);
+        new_chunk->retain();
+        cb((uint8_t*)new_chunk->data(), src, view->length);
+        chunk->release();
+        view->chunk = new_chunk;
+        view->offset = 0;
+      }
     }
   }
 
   void to_bytes(const std::function<bool(uint8_t)>& cb) const {
     assert_same_thread(*this);
     for (auto view = m_head; view; view = view->next) {
-      auto p = (uint8_t*)view->chunk->data + view->offset;
+      auto p = (uint8_t*)view->chunk->data() + view->offset;
       auto n = view->length;
       for (int i = 0; i < n; i++) {
         if (!cb(p[i])) return;
@@ -951,7 +986,7 @@ public:
     auto p = buf;
     for (auto view = m_head; view; view = view->next) {
       auto length = view->length;
-      std::memcpy(p, view->chunk->data + view->offset, length);
+      std::memcpy(p, view->chunk->data() + view->offset, length);
       p += length;
     }
   }
@@ -962,7 +997,7 @@ public:
     for (auto view = m_head; view && len > 0; view = view->next) {
       auto length = view->length;
       auto n = length < len ? length : len;
-      std::memcpy(ptr, view->chunk->data + view->offset, n);
+      std::memcpy(ptr, view->chunk->data() + view->offset, n);
       len -= n;
       ptr += n;
     }
@@ -983,7 +1018,7 @@ public:
     for (auto view = m_head; n > 0 && view; view = view->next) {
       auto length = view->length;
       if (length > n) length = n;
-      str.replace(i, length, view->chunk->data + view->offset, length);
+      str.replace(i, length, view->chunk->data() + view->offset, length);
       i += length;
       n -= length;
     }
@@ -997,6 +1032,18 @@ private:
   View*  m_tail;
   int    m_size;
 
+  // Small buffers get small chunks, growing geometrically with the
+  // total size up to DATA_CHUNK_SIZE, beyond which only bulk appends
+  // take the largest size class
+  int chunk_size_for(int n) const {
+    auto total = m_size + n;
+    if (total <= DATA_CHUNK_SIZE) return total;
+    if (n < DATA_CHUNK_MAX_SIZE) return DATA_CHUNK_SIZE;
+    return DATA_CHUNK_MAX_SIZE;
+  }
+
+  void push_decoded(const std::string &str, Encoding encoding, Producer *producer);
+
   void push_view(View *view) {
     auto size = view->length;
     if (auto tail = m_tail) {
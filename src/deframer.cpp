@@ -110,26 +110,38 @@ void Deframer::deframe(Data &data) {
       auto state = m_state;
       bool passing = m_passing;
       m_need_flush = false;
-      Data read_in;
-      data.shift_to(
-        [&](int c) -> bool {
-          if (m_read_buffer) {
-            m_read_buffer[m_read_pointer++] = c;
-            if (m_read_pointer >= m_read_length) {
-              m_read_length = 0;
-              m_read_buffer = nullptr;
-              state = on_state(state, -1);
-            }
-          } else {
-            state = on_state(state, (uint8_t)c);
+      auto chunk = *data.chunks().begin();
+      auto ptr = (const uint8_t *)std::get<0>(chunk);
+      auto len = (size_t)std::get<1>(chunk);
+      size_t i = 0;
+      while (i < len) {
+        if (m_read_buffer) {
+          auto n = std::min(m_read_length - m_read_pointer, len - i);
+          std::memcpy(m_read_buffer + m_read_pointer, ptr + i, n);
+          m_read_pointer += n;
+          i += n;
+          if (m_read_pointer >= m_read_length) {
+            m_read_length = 0;
+            m_read_buffer = nullptr;
+            state = on_state(state, -1);
           }
-          return state < 0 || m_need_flush ||
-            (m_read_length > 0 && !m_read_buffer) ||
-            (m_passing != passing);
-        },
-        read_in
-      );
-      if (passing) m_output_buffer.push(read_in);
+        } else if (auto n = on_span(state, ptr + i, len - i)) {
+          i += n;
+        } else {
+          state = on_state(state, ptr[i++]);
+        }
+        if (state < 0 || m_need_flush ||
+          (m_read_length > 0 && !m_read_buffer) ||
+          (m_passing != passing)
+        ) break;
+      }
+      if (passing) {
+        Data read_in;
+        data.shift(i, read_in);
+        m_output_buffer.push(read_in);
+      } else {
+        data.shift(i);
+      }
       if (m_need_flush) flush();
       m_state = state;
     }
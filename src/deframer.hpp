@@ -50,6 +50,16 @@ protected:
   virtual auto on_state(int state, int c) -> int = 0;
   virtual void on_pass(Data &data) {}
 
+  //
+  // Optional bulk path tried before on_state() with all bytes left in the
+  // current chunk. A handler consumes what it can from the front of the
+  // span, updates the state as on_state() would, and returns the number
+  // of bytes consumed. Returning 0 hands the next byte to on_state(), which
+  // is also how spans broken across chunk boundaries get handled.
+  //
+
+  virtual auto on_span(int &state, const uint8_t *ptr, size_t len) -> size_t { return 0; }
+
 private:
   int m_state = 0;
   bool m_passing = false;
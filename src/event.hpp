@@ -109,16 +109,31 @@ public:
 
   auto head() const -> pjs::Object* { return m_head; }
 
+  //
+  // Frozen messages output the same head object every time, so encoders
+  // can keep its encoded forms along with the event. The head itself
+  // is not locked, so encoders must check it for changes before reuse
+  //
+
+  bool is_frozen() const { return m_frozen; }
+  auto cache() const -> pjs::Object* { return m_cache; }
+  void cache(pjs::Object *obj) { m_cache = obj; }
+
 private:
   MessageStart() {}
 
-  MessageStart(pjs::Object *head)
-    : m_head(head) {}
+  MessageStart(pjs::Object *head, bool frozen = false)
+    : m_head(head)
+    , m_frozen(frozen) {}
 
   MessageStart(const MessageStart &r)
-    : m_head(r.m_head) {}
+    : m_head(r.m_head)
+    , m_cache(r.m_cache)
+    , m_frozen(r.m_frozen) {}
 
   pjs::Ref<pjs::Object> m_head;
+  pjs::Ref<pjs::Object> m_cache;
+  bool m_frozen = false;
 
   friend class pjs::ObjectTemplate<MessageStart, Event>;
 };
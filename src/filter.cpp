@@ -30,19 +30,92 @@
 #include "message.hpp"
 #include "log.hpp"
 
+#include <chrono>
 #include <cstdarg>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 namespace pipy {
 
+//
+// Cheap timestamps for measuring filters
+//
+
+static inline auto ticks() -> uint64_t {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t t;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+#else
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+static uint64_t s_ticks_origin = 0;
+static std::chrono::steady_clock::time_point s_clock_origin;
+
+// Calibrated against the steady clock over the whole time metrics are on
+static auto ticks_to_seconds(uint64_t n) -> double {
+  auto t = ticks() - s_ticks_origin;
+  auto d = std::chrono::duration<double>(std::chrono::steady_clock::now() - s_clock_origin).count();
+  return t > 0 ? n * d / t : 0;
+}
+
+thread_local static uint64_t s_cascade_count = 0;
+thread_local static uint64_t s_nested_ticks = 0;
+thread_local static bool s_timing = false;
+
+auto Filter::Stats::cpu_time() const -> double {
+  if (!timed_events) return 0;
+  return ticks_to_seconds(timed_ticks) * events / timed_events;
+}
+
+//
+// Filter
+//
+
+thread_local Filter* Filter::s_current = nullptr;
+std::atomic<int> Filter::s_tracking(0);
+int Filter::s_sampling_interval = 0;
+
+//
+// The current filter is only kept track of while filter metrics are on
+// or a profiling session on any thread needs it. Filters entered before
+// that leave it alone, so it always points to a filter still inside
+// on_event() or is null.
+//
+
+void Filter::track_current(bool enabled) {
+  s_tracking.fetch_add(enabled ? 1 : -1, std::memory_order_relaxed);
+}
+
+void Filter::set_metrics(int sampling_interval) {
+  if ((sampling_interval > 0) != (s_sampling_interval > 0)) {
+    track_current(sampling_interval > 0);
+  }
+  s_sampling_interval = sampling_interval;
+  s_ticks_origin = ticks();
+  s_clock_origin = std::chrono::steady_clock::now();
+  BufferStats::set_timing(sampling_interval > 0);
+}
+
 Filter::Filter()
   : m_subs(std::make_shared<std::vector<Sub>>())
   , m_buffer_stats(std::make_shared<BufferStats>())
+  , m_stats(s_sampling_interval > 0 ? std::make_shared<Stats>() : nullptr)
 {
 }
 
 Filter::Filter(const Filter &r)
   : m_subs(r.m_subs)
   , m_buffer_stats(r.m_buffer_stats)
+  , m_stats(r.m_stats)
   , m_location(r.m_location)
 {
 }
@@ -202,7 +275,51 @@ auto Filter::sub_pipeline(
 
 void Filter::on_event(Event *evt) {
   Pipeline::auto_release(m_pipeline);
+  if (!s_tracking.load(std::memory_order_relaxed)) {
+    process(evt);
+    return;
+  }
+  auto caller = s_current;
+  s_current = this;
+  if (m_stats) {
+    process_with_stats(evt, caller);
+  } else {
+    process(evt);
+  }
+  s_current = caller;
+}
+
+//
+// Filters downstream are called from within process(), so the time
+// they take is subtracted to leave only what this filter spends
+//
+
+void Filter::process_with_stats(Event *evt, Filter *caller) {
+  auto s = m_stats.get();
+  s->events++;
+  if (auto data = evt->as<Data>()) {
+    s->bytes += data->size();
+  } else if (evt->is<MessageStart>()) {
+    s->messages++;
+  }
+
+  if (!caller) {
+    s_timing = (++s_cascade_count % s_sampling_interval == 0);
+  }
+
+  if (!s_timing) {
+    process(evt);
+    return;
+  }
+
+  auto nested = s_nested_ticks;
+  s_nested_ticks = 0;
+  auto t0 = ticks();
   process(evt);
+  auto t = ticks() - t0;
+  s->timed_events++;
+  s->timed_ticks += t > s_nested_ticks ? t - s_nested_ticks : 0;
+  s_nested_ticks = nested + t;
 }
 
 void Filter::output(Message *msg) {
@@ -31,6 +31,7 @@
 #include "list.hpp"
 #include "pipeline.hpp"
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -81,12 +82,38 @@ public:
     OutType out_type = OUTPUT_FROM_SELF;
   };
 
+  //
+  // Filter::Stats
+  //
+  // Only kept when enabled by --filter-metrics and shared by all clones
+  // of the same filter in a pipeline layout. CPU time is measured on one
+  // in every N event cascades, a cascade being everything that happens
+  // from a filter being entered by no other filter till it returns.
+  //
+
+  struct Stats {
+    uint64_t events = 0;
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t timed_events = 0;
+    uint64_t timed_ticks = 0;
+    pjs::Ref<pjs::Str> label;
+
+    auto cpu_time() const -> double;
+  };
+
   virtual ~Filter() {}
 
+  static auto current() -> Filter* { return s_current; }
+  static void track_current(bool enabled);
+  static void set_metrics(int sampling_interval);
+  static bool metrics_enabled() { return s_sampling_interval > 0; }
+
   auto module_legacy() const -> ModuleBase*;
   auto context() const -> Context*;
   auto location() const -> const pjs::Location& { return m_location; }
   auto buffer_stats() const -> std::shared_ptr<BufferStats> { return m_buffer_stats; }
+  auto stats() const -> Stats* { return m_stats.get(); }
 
   void set_location(const pjs::Location &loc);
   void add_sub_pipeline(PipelineLayout *layout);
@@ -116,6 +143,8 @@ public:
   virtual void dump(Dump &d);
 
   auto pipeline() const -> Pipeline* { return m_pipeline; }
+  auto pipeline_layout() const -> PipelineLayout* { return m_pipeline_layout; }
+  auto index() const -> int { return m_index; }
   void output(Message *msg);
   void output(Message *msg, EventTarget::Input *input);
   bool output(pjs::Object *obj);
@@ -144,12 +173,19 @@ private:
 
   std::shared_ptr<std::vector<Sub>> m_subs;
   std::shared_ptr<BufferStats> m_buffer_stats;
+  std::shared_ptr<Stats> m_stats;
 
   PipelineLayout* m_pipeline_layout = nullptr;
   Pipeline* m_pipeline = nullptr;
   pjs::Location m_location;
+  int m_index = -1;
 
   virtual void on_event(Event *evt) override;
+  void process_with_stats(Event *evt, Filter *caller);
+
+  thread_local static Filter* s_current;
+  static std::atomic<int> s_tracking;
+  static int s_sampling_interval;
 
   friend class Pipeline;
   friend class PipelineLayout;
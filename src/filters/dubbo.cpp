@@ -30,6 +30,19 @@ namespace dubbo {
 
 static Data::Producer s_dp("Dubbo");
 
+//
+// Options
+//
+
+Options::Options(pjs::Object *options) {
+  Value(options, "lazy")
+    .get(lazy)
+    .check_nullable();
+  Value(options, "maxBodySize")
+    .get_binary_size(max_body_size)
+    .check_nullable();
+}
+
 //
 // Decoder
 //
@@ -38,8 +51,14 @@ Decoder::Decoder()
 {
 }
 
+Decoder::Decoder(const Options &options)
+  : m_options(options)
+{
+}
+
 Decoder::Decoder(const Decoder &r)
-  : Decoder()
+  : Filter(r)
+  , m_options(r.m_options)
 {
 }
 
@@ -59,6 +78,8 @@ auto Decoder::clone() -> Filter* {
 void Decoder::reset() {
   Filter::reset();
   Deframer::reset();
+  m_message_head = nullptr;
+  m_body = nullptr;
 }
 
 void Decoder::process(Event *evt) {
@@ -101,19 +122,47 @@ auto Decoder::on_state(int state, int c) -> int {
         ((uint64_t)m_head[10] << 8)|
         ((uint64_t)m_head[11] << 0)
       );
-      Filter::output(MessageStart::make(mh));
-      Deframer::pass(
+      auto len = (
         ((uint32_t)m_head[12] << 24)|
         ((uint32_t)m_head[13] << 16)|
         ((uint32_t)m_head[14] <<  8)|
         ((uint32_t)m_head[15] <<  0)
       );
+
+      // In lazy mode, a Hessian2 request body is read in as a whole
+      // (without copying) so that the invocation can be attached to
+      // MessageStart, while the body itself is passed on untouched
+      if (m_options.lazy && mh->isRequest && !mh->isEvent && mh->serializationType == 2 && len > 0) {
+        if (len > m_options.max_body_size) {
+          pjs::Ref<MessageHead> ref(mh);
+          Filter::output(StreamEnd::make(StreamEnd::PROTOCOL_ERROR));
+          return -1;
+        }
+        m_message_head = mh;
+        m_body = Data::make();
+        Deframer::read(len, m_body.get());
+        return BODY_LAZY;
+      }
+
+      Filter::output(MessageStart::make(mh));
+      Deframer::pass(len);
       return BODY;
     }
     case BODY: {
       Filter::output(MessageEnd::make());
       return START;
     }
+    case BODY_LAZY: {
+      pjs::Ref<MessageHead> mh(m_message_head);
+      m_message_head = nullptr;
+      pjs::Ref<Data> body(m_body);
+      m_body = nullptr;
+      read_invocation(mh, *body);
+      Filter::output(MessageStart::make(mh));
+      Filter::output(body);
+      Filter::output(MessageEnd::make());
+      return START;
+    }
     default: return -1;
   }
 }
@@ -122,6 +171,63 @@ void Decoder::on_pass(Data &data) {
   Filter::output(Data::make(std::move(data)));
 }
 
+//
+// Reads the leading strings of a Hessian2 encoded invocation:
+//   dubbo version, service path, service version, method name, parameter types
+//
+// Arguments and attachments that follow are left in the body as they are.
+//
+
+void Decoder::read_invocation(MessageHead *head, const Data &body) {
+  Data::Reader r(body);
+
+  auto read_string = [&](pjs::Ref<pjs::Str> &str) -> bool {
+    auto b = r.get();
+    if (b == 'N') return true;
+    std::string s;
+    for (;;) {
+      int len;
+      bool final = true;
+      if (0x00 <= b && b <= 0x1f) {
+        len = b;
+      } else if (0x30 <= b && b <= 0x33) {
+        auto c = r.get(); if (c < 0) return false;
+        len = ((b - 0x30) << 8) | c;
+      } else if (b == 'S' || b == 'R') {
+        auto h = r.get(); if (h < 0) return false;
+        auto l = r.get(); if (l < 0) return false;
+        len = (h << 8) | l;
+        final = (b == 'S');
+      } else {
+        return false;
+      }
+      // Lengths are counted in UTF-16 code units
+      for (int i = 0; i < len; i++) {
+        auto c = r.get(); if (c < 0) return false;
+        s.push_back(c);
+        int n = 0;
+        if ((c & 0xe0) == 0xc0) n = 1; else
+        if ((c & 0xf0) == 0xe0) n = 2; else
+        if ((c & 0xf8) == 0xf0) { n = 3; i++; }
+        while (n-- > 0) {
+          auto c = r.get(); if (c < 0) return false;
+          s.push_back(c);
+        }
+      }
+      if (final) break;
+      b = r.get();
+    }
+    str = pjs::Str::make(s);
+    return true;
+  };
+
+  read_string(head->dubboVersion) &&
+  read_string(head->service) &&
+  read_string(head->version) &&
+  read_string(head->method) &&
+  read_string(head->parameterTypes);
+}
+
 //
 // Encoder
 //
@@ -131,6 +237,7 @@ Encoder::Encoder()
 }
 
 Encoder::Encoder(const Encoder &r)
+  : Filter(r)
 {
 }
 
@@ -228,6 +335,11 @@ template<> void ClassDef<MessageHead>::init() {
   field<bool>("isEvent", [](MessageHead *obj) { return &obj->isEvent; });
   field<int>("serializationType", [](MessageHead *obj) { return &obj->serializationType; });
   field<int>("status", [](MessageHead *obj) { return &obj->status; });
+  field<pjs::Ref<pjs::Str>>("dubboVersion", [](MessageHead *obj) { return &obj->dubboVersion; });
+  field<pjs::Ref<pjs::Str>>("service", [](MessageHead *obj) { return &obj->service; });
+  field<pjs::Ref<pjs::Str>>("version", [](MessageHead *obj) { return &obj->version; });
+  field<pjs::Ref<pjs::Str>>("method", [](MessageHead *obj) { return &obj->method; });
+  field<pjs::Ref<pjs::Str>>("parameterTypes", [](MessageHead *obj) { return &obj->parameterTypes; });
 }
 
 } // namespace pjs
@@ -29,6 +29,7 @@
 #include "filter.hpp"
 #include "data.hpp"
 #include "deframer.hpp"
+#include "options.hpp"
 
 namespace pipy {
 namespace dubbo {
@@ -45,6 +46,22 @@ public:
   bool isEvent = false;
   int serializationType = 0;
   int status = 0;
+  pjs::Ref<pjs::Str> dubboVersion;
+  pjs::Ref<pjs::Str> service;
+  pjs::Ref<pjs::Str> version;
+  pjs::Ref<pjs::Str> method;
+  pjs::Ref<pjs::Str> parameterTypes;
+};
+
+//
+// Options
+//
+
+struct Options : public pipy::Options {
+  bool lazy = false;
+  size_t max_body_size = 0x1000000;
+  Options() {}
+  Options(pjs::Object *options);
 };
 
 //
@@ -54,6 +71,7 @@ public:
 class Decoder : public Filter, public Deframer {
 public:
   Decoder();
+  Decoder(const Options &options);
 
 private:
   Decoder(const Decoder &r);
@@ -69,9 +87,15 @@ private:
     START,
     HEAD,
     BODY,
+    BODY_LAZY,
   };
 
+  Options m_options;
   uint8_t m_head[16];
+  pjs::Ref<MessageHead> m_message_head;
+  pjs::Ref<Data> m_body;
+
+  static void read_invocation(MessageHead *head, const Data &body);
 
   virtual auto on_state(int state, int c) -> int override;
   virtual void on_pass(Data &data) override;
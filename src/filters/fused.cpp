@@ -0,0 +1,305 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fused.hpp"
+#include "on-event.hpp"
+#include "replace-event.hpp"
+#include "context.hpp"
+#include "message.hpp"
+#include "log.hpp"
+
+namespace pipy {
+
+//
+// Fused
+//
+
+bool Fused::s_enabled = true;
+
+bool Fused::fusible(Filter *filter) {
+  return (
+    dynamic_cast<OnEvent*>(filter) ||
+    dynamic_cast<ReplaceEvent*>(filter)
+  );
+}
+
+void Fused::compile(std::list<std::unique_ptr<Filter>> &filters, const std::function<void(Filter*)> &setup) {
+  auto i = filters.begin();
+  while (i != filters.end()) {
+    std::vector<Filter*> run;
+    auto j = i;
+    while (j != filters.end() && fusible(j->get())) run.push_back((j++)->get());
+    if (run.size() > 1) {
+      auto f = new Fused(run);
+      setup(f);
+      i = filters.erase(i, j);
+      filters.emplace(i, f);
+    } else {
+      i = (j == i ? std::next(j) : j);
+    }
+  }
+}
+
+Fused::Fused(const std::vector<Filter*> &filters)
+  : m_stages(std::make_shared<std::vector<Stage>>())
+{
+  for (auto *f : filters) {
+    Dump d; f->dump(d);
+    m_stages->emplace_back();
+    auto &s = m_stages->back();
+    if (auto *h = dynamic_cast<OnEvent*>(f)) {
+      s.type = h->type();
+      s.replacing = false;
+      s.callback = h->handler();
+    } else if (auto *r = dynamic_cast<ReplaceEvent*>(f)) {
+      s.type = r->type();
+      s.replacing = true;
+      s.callback = r->handler();
+      s.replacement = r->replacement();
+    }
+    s.location = f->location();
+    s.name = d.name;
+    s.buffer_stats = f->buffer_stats();
+  }
+  Filter::set_location(m_stages->front().location);
+}
+
+Fused::Fused(const Fused &r)
+  : Filter(r)
+  , m_stages(r.m_stages)
+{
+  auto n = m_stages->size();
+  m_states.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    m_states.emplace_back(new State(this, i, m_stages->at(i).buffer_stats));
+  }
+}
+
+Fused::~Fused()
+{
+}
+
+void Fused::dump(Dump &d) {
+  Filter::dump(d);
+  d.name = "fused(";
+  for (size_t i = 0; i < m_stages->size(); i++) {
+    if (i > 0) d.name += ", ";
+    d.name += m_stages->at(i).name;
+  }
+  d.name += ')';
+}
+
+auto Fused::clone() -> Filter* {
+  return new Fused(*this);
+}
+
+void Fused::reset() {
+  Filter::reset();
+  for (auto &s : m_states) {
+    if (s->promise_callback) {
+      s->promise_callback->close();
+      s->promise_callback = nullptr;
+    }
+    s->deferred_event = nullptr;
+    s->event_buffer.clear();
+    s->counter = 0;
+    s->waiting = false;
+  }
+}
+
+void Fused::process(Event *evt) {
+  input(0, evt);
+}
+
+//
+// Each stage below does what Handle, OnEvent, Replace and ReplaceEvent
+// do for a single filter, with "output" meaning input to the next stage
+//
+
+void Fused::input(int i, Event *evt) {
+  pjs::Ref<Event> ref(evt);
+  auto n = int(m_states.size());
+
+  // Walk through passing and handling stages without recursion
+  // as long as none of them starts waiting on a promise
+  while (i < n) {
+    auto &st = *m_states[i];
+    if (st.waiting) {
+      st.event_buffer.push(evt);
+      return;
+    }
+    const auto &s = (*m_stages)[i];
+    if (int(s.type) < 0 || evt->type() == s.type) {
+      if (s.replacing) {
+        handle(i, evt);
+        return;
+      }
+      if (!callback(i, evt)) return;
+      if (st.waiting) {
+        st.deferred_event = evt;
+        return;
+      }
+    }
+    i++;
+  }
+
+  Filter::output(evt);
+}
+
+void Fused::handle(int i, Event *evt) {
+  const auto &s = m_stages->at(i);
+  if (int(s.type) >= 0 && evt->type() != s.type) {
+    pass(i, evt);
+  } else if (!s.replacing) {
+    if (callback(i, evt)) defer(i, evt);
+  } else if (!s.replacement) {
+    return;
+  } else if (!s.replacement->is_function()) {
+    if (!output_to(i, s.replacement)) {
+      error(i, "replacement is not an event or Message or an array of those");
+    }
+  } else {
+    callback(i, evt);
+  }
+}
+
+void Fused::pass(int i, Event *evt) {
+  auto &st = *m_states[i];
+  if (st.waiting) {
+    st.event_buffer.push(evt);
+  } else {
+    input(i + 1, evt);
+  }
+}
+
+void Fused::defer(int i, Event *evt) {
+  auto &st = *m_states[i];
+  if (st.waiting) {
+    st.deferred_event = evt;
+  } else {
+    input(i + 1, evt);
+  }
+}
+
+bool Fused::callback(int i, Event *evt) {
+  auto &st = *m_states[i];
+  pjs::Value args[2], result;
+  args[0] = evt;
+  args[1].set(st.counter++);
+  auto c = context();
+  (*m_stages->at(i).callback)(*c, 2, args, result);
+  if (!c->ok()) {
+    Log::pjs_error(c->error());
+    error(i, pjs::Error::make(c->error()));
+    c->reset();
+    return false;
+  }
+  if (result.is_promise()) {
+    auto cb = PromiseCallback::make(this, i);
+    result.as<pjs::Promise>()->then(nullptr, cb->resolved(), cb->rejected());
+    st.promise_callback = cb;
+    st.waiting = true;
+    return true;
+  } else {
+    return on_callback_return(i, result);
+  }
+}
+
+bool Fused::on_callback_return(int i, const pjs::Value &result) {
+  auto &st = *m_states[i];
+  if (m_stages->at(i).replacing && !result.is_undefined()) {
+    if (!result.is_object() || !output_to(i, result.o())) {
+      error(i, "Promise was not fulfilled with an event or Message or an array of those");
+      return false;
+    }
+  }
+  st.waiting = false;
+  if (st.deferred_event) {
+    pjs::Ref<Event> evt(st.deferred_event);
+    st.deferred_event = nullptr;
+    input(i + 1, evt);
+  }
+  if (!st.event_buffer.empty()) {
+    st.event_buffer.flush_until([this, i](Event *evt) {
+      handle(i, evt);
+      return m_states[i]->waiting;
+    });
+  }
+  return true;
+}
+
+bool Fused::output_to(int i, pjs::Object *obj) {
+  auto next = i + 1;
+  if (next < int(m_states.size())) {
+    return Filter::output(obj, m_states[next]->input());
+  } else {
+    return Filter::output(obj);
+  }
+}
+
+void Fused::error(int i, pjs::Error *err) {
+  input(i + 1, StreamEnd::make(err));
+}
+
+void Fused::error(int i, const char *msg) {
+  const auto &s = m_stages->at(i);
+  char loc[1000], buf[2000];
+  Log::format_location(loc, sizeof(loc), s.location, s.name.c_str());
+  auto len = std::snprintf(buf, sizeof(buf), "%s: %s", loc, msg);
+  Log::error("%s", buf);
+  error(i, pjs::Error::make(pjs::Str::make(buf, len)));
+}
+
+//
+// Fused::PromiseCallback
+//
+
+void Fused::PromiseCallback::on_resolved(const pjs::Value &value) {
+  if (m_filter) {
+    m_filter->on_callback_return(m_stage, value);
+  }
+}
+
+void Fused::PromiseCallback::on_rejected(const pjs::Value &error) {
+  if (m_filter) {
+    if (error.is_error()) {
+      m_filter->error(m_stage, error.as<pjs::Error>());
+    } else {
+      m_filter->input(m_stage + 1, StreamEnd::make(error));
+    }
+  }
+}
+
+} // namespace pipy
+
+namespace pjs {
+
+using namespace pipy;
+
+template<> void ClassDef<Fused::PromiseCallback>::init() {
+  super<Promise::Callback>();
+}
+
+} // namespace pjs
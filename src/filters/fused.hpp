@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FUSED_HPP
+#define FUSED_HPP
+
+#include "filter.hpp"
+#include "buffer.hpp"
+
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace pipy {
+
+//
+// Fused
+//
+// Runs of adjacent handleXXX() and replaceXXX() filters get replaced with
+// one of these when a pipeline layout is bound. Each event is dispatched to
+// the callbacks in order without going through a filter per callback, while
+// every callback still waits on its own returned promises like it did as a
+// separate filter.
+//
+
+class Fused : public Filter {
+public:
+  static void set_enabled(bool enabled) { s_enabled = enabled; }
+  static bool enabled() { return s_enabled; }
+  static bool fusible(Filter *filter);
+  static void compile(std::list<std::unique_ptr<Filter>> &filters, const std::function<void(Filter*)> &setup);
+
+  //
+  // Fused::PromiseCallback
+  //
+
+  class PromiseCallback : public pjs::ObjectTemplate<PromiseCallback, pjs::Promise::Callback> {
+    PromiseCallback(Fused *filter, int stage) : m_filter(filter), m_stage(stage) {}
+    virtual void on_resolved(const pjs::Value &value) override;
+    virtual void on_rejected(const pjs::Value &error) override;
+    friend class pjs::ObjectTemplate<PromiseCallback, pjs::Promise::Callback>;
+    Fused* m_filter;
+    int m_stage;
+  public:
+    void close() { m_filter = nullptr; }
+  };
+
+private:
+  static bool s_enabled;
+
+  Fused(const std::vector<Filter*> &filters);
+  Fused(const Fused &r);
+  ~Fused();
+
+  virtual auto clone() -> Filter* override;
+  virtual void reset() override;
+  virtual void process(Event *evt) override;
+  virtual void dump(Dump &d) override;
+
+  //
+  // Fused::Stage
+  //
+
+  struct Stage {
+    Event::Type type;
+    bool replacing;
+    pjs::Ref<pjs::Function> callback;
+    pjs::Ref<pjs::Object> replacement;
+    pjs::Location location;
+    std::string name;
+    std::shared_ptr<BufferStats> buffer_stats;
+  };
+
+  //
+  // Fused::State
+  //
+
+  struct State : public EventTarget {
+    State(Fused *f, int i, std::shared_ptr<BufferStats> stats)
+      : filter(f), index(i), event_buffer(stats) {}
+    Fused* filter;
+    int index;
+    pjs::Ref<PromiseCallback> promise_callback;
+    pjs::Ref<Event> deferred_event;
+    EventBuffer event_buffer;
+    int counter = 0;
+    bool waiting = false;
+    virtual void on_event(Event *evt) override { filter->input(index, evt); }
+  };
+
+  std::shared_ptr<std::vector<Stage>> m_stages;
+  std::vector<std::unique_ptr<State>> m_states;
+
+  void input(int i, Event *evt);
+  void handle(int i, Event *evt);
+  void pass(int i, Event *evt);
+  void defer(int i, Event *evt);
+  bool callback(int i, Event *evt);
+  bool on_callback_return(int i, const pjs::Value &result);
+  bool output_to(int i, pjs::Object *obj);
+  void error(int i, pjs::Error *err);
+  void error(int i, const char *msg);
+};
+
+} // namespace pipy
+
+#endif // FUSED_HPP
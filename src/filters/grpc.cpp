@@ -0,0 +1,392 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "grpc.hpp"
+#include "compressor.hpp"
+#include "api/http.hpp"
+#include "utils.hpp"
+
+namespace pipy {
+namespace grpc {
+
+//  0                   1                   2                   3
+//  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+// +-+-+-+-+-+-+-+-+-----------------------------------------------+
+// |   Flags   |C|              Message length (32)                 :
+// +-+-+-+-+-+-+-+-+-----------------------------------------------+
+// : (continued)   |             Message ...                       :
+// +---------------+-----------------------------------------------+
+
+thread_local static const pjs::ConstStr s_grpc_encoding("grpc-encoding");
+thread_local static const pjs::ConstStr s_grpc_status("grpc-status");
+thread_local static const pjs::ConstStr s_grpc_message("grpc-message");
+thread_local static const pjs::ConstStr s_content_type("content-type");
+thread_local static const pjs::ConstStr s_application_grpc("application/grpc");
+thread_local static const pjs::ConstStr s_identity("identity");
+thread_local static const pjs::ConstStr s_gzip("gzip");
+thread_local static const pjs::ConstStr s_deflate("deflate");
+
+static Data::Producer s_dp("gRPC");
+
+static auto header_of(pjs::Object *headers, pjs::Str *name) -> pjs::Str* {
+  pjs::Value v;
+  if (headers && headers->get(name, v) && v.is_string()) return v.s();
+  return nullptr;
+}
+
+static auto status_of(pjs::Object *headers) -> MessageTail* {
+  pjs::Value v;
+  if (!headers || !headers->get(s_grpc_status, v)) return nullptr;
+  auto tail = MessageTail::make();
+  tail->status = v.is_string() ? std::atoi(v.s()->c_str()) : v.to_int32();
+  if (auto msg = header_of(headers, s_grpc_message)) {
+    tail->message = pjs::Str::make(utils::decode_uri(msg->str()));
+  }
+  return tail;
+}
+
+//
+// Decoder
+//
+
+Decoder::Decoder()
+{
+}
+
+Decoder::Decoder(const Decoder &r)
+  : Filter(r)
+{
+}
+
+Decoder::~Decoder()
+{
+  if (m_decompressor) m_decompressor->finalize();
+}
+
+void Decoder::dump(Dump &d) {
+  Filter::dump(d);
+  d.name = "decodeGRPC";
+}
+
+auto Decoder::clone() -> Filter* {
+  return new Decoder(*this);
+}
+
+void Decoder::reset() {
+  Filter::reset();
+  Deframer::reset();
+  if (m_decompressor) {
+    m_decompressor->finalize();
+    m_decompressor = nullptr;
+  }
+  m_prefix_size = 0;
+  m_status = nullptr;
+  m_http_started = false;
+  m_error = false;
+}
+
+void Decoder::process(Event *evt) {
+  if (auto start = evt->as<MessageStart>()) {
+    if (!m_http_started) {
+      pjs::Ref<http::MessageHead> head = pjs::coerce<http::MessageHead>(start->head());
+      auto headers = head->headers.get();
+      auto encoding = header_of(headers, s_grpc_encoding);
+      if (!encoding || encoding == s_identity) m_encoding = Encoding::IDENTITY;
+      else if (encoding == s_gzip) m_encoding = Encoding::GZIP;
+      else if (encoding == s_deflate) m_encoding = Encoding::DEFLATE;
+      else m_encoding = Encoding::UNKNOWN;
+      m_status = status_of(headers); // trailers-only response
+      m_prefix_size = 0;
+      m_http_started = true;
+      Deframer::reset(PREFIX);
+    }
+
+  } else if (auto data = evt->as<Data>()) {
+    if (m_http_started && !m_error) {
+      Deframer::deframe(*data);
+    }
+
+  } else if (auto end = evt->as<MessageEnd>()) {
+    if (m_http_started) {
+      http_end(end->tail());
+    }
+
+  } else if (evt->is<StreamEnd>()) {
+    if (m_decompressor) {
+      m_decompressor->finalize();
+      m_decompressor = nullptr;
+    }
+    m_http_started = false;
+    if (!m_error) Filter::output(evt);
+    m_error = false;
+  }
+}
+
+auto Decoder::on_state(int state, int c) -> int {
+  if (m_error) return ERROR;
+  switch (state) {
+  case PREFIX:
+    m_prefix[m_prefix_size++] = c;
+    if (m_prefix_size < sizeof(m_prefix)) return PREFIX;
+    m_prefix_size = 0;
+    return message_start();
+  case PAYLOAD:
+    message_end();
+    return PREFIX;
+  }
+  return state;
+}
+
+void Decoder::on_pass(Data &data) {
+  if (m_error) return;
+  if (m_decompressor) {
+    if (!m_decompressor->input(data)) {
+      protocol_error();
+    }
+  } else {
+    Filter::output(Data::make(std::move(data)));
+  }
+}
+
+auto Decoder::message_start() -> State {
+  auto compressed = bool(m_prefix[0] & 1);
+  auto size = (
+    ((uint32_t)m_prefix[1] << 24)|
+    ((uint32_t)m_prefix[2] << 16)|
+    ((uint32_t)m_prefix[3] << 8 )|
+    ((uint32_t)m_prefix[4] << 0 )
+  );
+
+  if (compressed) {
+    auto out = [this](Data &data) { decompressor_output(data); };
+    switch (m_encoding) {
+      case Encoding::GZIP: m_decompressor = Decompressor::gzip(out); break;
+      case Encoding::DEFLATE: m_decompressor = Decompressor::inflate(out); break;
+      default:
+        Filter::error(StreamEnd::PROTOCOL_ERROR);
+        return ERROR;
+    }
+  }
+
+  auto head = MessageHead::make();
+  head->compressed = compressed;
+  Filter::output(MessageStart::make(head));
+
+  if (size > 0) {
+    Deframer::pass(size);
+    return PAYLOAD;
+  } else {
+    message_end();
+    return PREFIX;
+  }
+}
+
+void Decoder::message_end() {
+  if (m_decompressor) {
+    m_decompressor->finalize();
+    m_decompressor = nullptr;
+  }
+  Filter::output(MessageEnd::make());
+}
+
+void Decoder::http_end(pjs::Object *tail) {
+  m_http_started = false;
+  auto state = Deframer::state();
+  if (state == ERROR) return;
+  if (state == PAYLOAD || m_prefix_size > 0) {
+    Filter::error(StreamEnd::PROTOCOL_ERROR);
+    return;
+  }
+  if (tail) {
+    pjs::Ref<http::MessageTail> t = pjs::coerce<http::MessageTail>(tail);
+    if (auto status = status_of(t->headers)) m_status = status;
+  }
+  Filter::output(MessageEnd::make(m_status.get()));
+  m_status = nullptr;
+}
+
+void Decoder::decompressor_output(Data &data) {
+  Filter::output(Data::make(std::move(data)));
+}
+
+void Decoder::protocol_error() {
+  m_error = true;
+  Filter::error(StreamEnd::PROTOCOL_ERROR);
+}
+
+//
+// Encoder
+//
+
+Encoder::Encoder(const pjs::Value &head)
+  : m_head(head)
+{
+}
+
+Encoder::Encoder(const Encoder &r)
+  : Filter(r)
+  , m_head(r.m_head)
+{
+}
+
+Encoder::~Encoder()
+{
+}
+
+void Encoder::dump(Dump &d) {
+  Filter::dump(d);
+  d.name = "encodeGRPC";
+}
+
+auto Encoder::clone() -> Filter* {
+  return new Encoder(*this);
+}
+
+void Encoder::reset() {
+  Filter::reset();
+  m_buffer.clear();
+  m_http_started = false;
+  m_message_started = false;
+}
+
+void Encoder::process(Event *evt) {
+  if (auto start = evt->as<MessageStart>()) {
+    if (!m_message_started) {
+      if (!m_http_started && !http_start()) return;
+      pjs::Ref<MessageHead> head = pjs::coerce<MessageHead>(start->head());
+      m_compressed = head->compressed && m_encoding != Encoding::IDENTITY;
+      m_message_started = true;
+    }
+
+  } else if (auto data = evt->as<Data>()) {
+    if (m_message_started) {
+      m_buffer.push(*data);
+    }
+
+  } else if (auto end = evt->as<MessageEnd>()) {
+    if (m_message_started) {
+      message_end();
+    } else {
+      if (!m_http_started && !http_start()) return;
+      pjs::Ref<http::MessageTail> tail;
+      if (auto t = end->tail()) {
+        pjs::Ref<MessageTail> status = pjs::coerce<MessageTail>(t);
+        auto headers = pjs::Object::make();
+        headers->set(s_grpc_status, pjs::Str::make(status->status));
+        if (auto msg = status->message.get()) {
+          headers->set(s_grpc_message, pjs::Str::make(utils::encode_uri(msg->str())));
+        }
+        tail = http::MessageTail::make();
+        tail->headers = headers;
+      }
+      m_http_started = false;
+      Filter::output(MessageEnd::make(tail));
+    }
+
+  } else if (evt->is<StreamEnd>()) {
+    m_buffer.clear();
+    m_http_started = false;
+    m_message_started = false;
+    Filter::output(evt);
+  }
+}
+
+bool Encoder::http_start() {
+  pjs::Value head;
+  if (!Filter::eval(m_head, head)) return false;
+
+  pjs::Ref<http::MessageHead> msg_head;
+  if (head.is_object() && head.o()) {
+    msg_head = pjs::coerce<http::MessageHead>(head.o());
+  } else if (head.is_nullish()) {
+    msg_head = http::ResponseHead::make();
+  } else {
+    Filter::error("head is not an object");
+    return false;
+  }
+
+  if (!msg_head->headers) {
+    auto headers = pjs::Object::make();
+    headers->set(s_content_type, s_application_grpc.get());
+    msg_head->headers = headers;
+  }
+
+  auto encoding = header_of(msg_head->headers, s_grpc_encoding);
+  if (encoding == s_gzip) m_encoding = Encoding::GZIP;
+  else if (encoding == s_deflate) m_encoding = Encoding::DEFLATE;
+  else m_encoding = Encoding::IDENTITY;
+
+  m_http_started = true;
+  Filter::output(MessageStart::make(msg_head));
+  return true;
+}
+
+void Encoder::message_end() {
+  Data payload;
+  if (m_compressed) {
+    auto out = [&](Data &data) { payload.push(std::move(data)); };
+    auto compressor = (
+      m_encoding == Encoding::GZIP
+        ? Compressor::gzip(out)
+        : Compressor::deflate(out)
+    );
+    compressor->input(m_buffer, true);
+    compressor->finalize();
+    m_buffer.clear();
+  } else {
+    payload.push(std::move(m_buffer));
+  }
+
+  auto size = payload.size();
+  uint8_t prefix[5];
+  prefix[0] = m_compressed ? 1 : 0;
+  prefix[1] = size >> 24;
+  prefix[2] = size >> 16;
+  prefix[3] = size >> 8;
+  prefix[4] = size >> 0;
+
+  auto output = s_dp.make(prefix, sizeof(prefix));
+  output->push(std::move(payload));
+  m_message_started = false;
+  Filter::output(output);
+}
+
+} // namespace grpc
+} // namespace pipy
+
+namespace pjs {
+
+using namespace pipy::grpc;
+
+template<> void ClassDef<MessageHead>::init() {
+  field<bool>("compressed", [](MessageHead *obj) { return &obj->compressed; });
+}
+
+template<> void ClassDef<MessageTail>::init() {
+  field<int>("status", [](MessageTail *obj) { return &obj->status; });
+  field<pjs::Ref<pjs::Str>>("message", [](MessageTail *obj) { return &obj->message; });
+}
+
+} // namespace pjs
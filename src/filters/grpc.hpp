@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRPC_HPP
+#define GRPC_HPP
+
+#include "filter.hpp"
+#include "deframer.hpp"
+#include "data.hpp"
+
+namespace pipy {
+
+class Compressor;
+class Decompressor;
+
+namespace grpc {
+
+//
+// MessageHead
+//
+
+class MessageHead : public pjs::ObjectTemplate<MessageHead> {
+public:
+  bool compressed = false;
+};
+
+//
+// MessageTail
+//
+
+class MessageTail : public pjs::ObjectTemplate<MessageTail> {
+public:
+  int status = 0;
+  pjs::Ref<pjs::Str> message;
+};
+
+//
+// Decoder
+//
+
+class Decoder : public Filter, public Deframer {
+public:
+  Decoder();
+
+private:
+  Decoder(const Decoder &r);
+  ~Decoder();
+
+  virtual auto clone() -> Filter* override;
+  virtual void reset() override;
+  virtual void process(Event *evt) override;
+  virtual void dump(Dump &d) override;
+
+private:
+  enum State {
+    ERROR = -1,
+    PREFIX = 0,
+    PAYLOAD,
+  };
+
+  enum class Encoding {
+    IDENTITY,
+    GZIP,
+    DEFLATE,
+    UNKNOWN,
+  };
+
+  uint8_t m_prefix[5];
+  size_t m_prefix_size = 0;
+  Encoding m_encoding = Encoding::IDENTITY;
+  Decompressor* m_decompressor = nullptr;
+  pjs::Ref<MessageTail> m_status;
+  bool m_http_started = false;
+  bool m_error = false;
+
+  virtual auto on_state(int state, int c) -> int override;
+  virtual void on_pass(Data &data) override;
+
+  auto message_start() -> State;
+  void message_end();
+  void http_end(pjs::Object *tail);
+  void decompressor_output(Data &data);
+  void protocol_error();
+};
+
+//
+// Encoder
+//
+
+class Encoder : public Filter {
+public:
+  Encoder(const pjs::Value &head);
+
+private:
+  Encoder(const Encoder &r);
+  ~Encoder();
+
+  virtual auto clone() -> Filter* override;
+  virtual void reset() override;
+  virtual void process(Event *evt) override;
+  virtual void dump(Dump &d) override;
+
+private:
+  enum class Encoding {
+    IDENTITY,
+    GZIP,
+    DEFLATE,
+  };
+
+  pjs::Value m_head;
+  Encoding m_encoding = Encoding::IDENTITY;
+  Data m_buffer;
+  bool m_http_started = false;
+  bool m_message_started = false;
+  bool m_compressed = false;
+
+  bool http_start();
+  void message_end();
+};
+
+} // namespace grpc
+} // namespace pipy
+
+#endif // GRPC_HPP
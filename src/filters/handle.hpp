@@ -53,6 +53,8 @@ public:
 
   Handle(pjs::Function *callback);
 
+  auto handler() const -> pjs::Function* { return m_callback; }
+
 protected:
   Handle(const Handle &r);
   ~Handle();
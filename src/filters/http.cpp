@@ -730,8 +730,13 @@ void Encoder::on_event(Event *evt) {
       m_chunked = false;
       m_buffer.clear();
 
+      m_encoded_head = EncodedHead::get(start);
+
       if (m_is_response) {
-        auto head = pjs::coerce<ResponseHead>(start->head());
+        auto head = (m_encoded_head
+          ? m_encoded_head->response_head()
+          : pjs::coerce<ResponseHead>(start->head())
+        );
         auto protocol = head->protocol.get();
         if (!protocol || !protocol->length()) protocol = s_http_1_1;
         m_head = head;
@@ -748,7 +753,10 @@ void Encoder::on_event(Event *evt) {
         }
 
       } else {
-        auto head = pjs::coerce<RequestHead>(start->head());
+        auto head = (m_encoded_head
+          ? m_encoded_head->request_head()
+          : pjs::coerce<RequestHead>(start->head())
+        );
         auto protocol = head->protocol.get();
         auto method = head->method.get();
         auto path = head->path.get();
@@ -792,11 +800,13 @@ void Encoder::on_event(Event *evt) {
 
     m_buffer.clear();
     m_head = nullptr;
+    m_encoded_head = nullptr;
 
   } else if (evt->is<StreamEnd>()) {
     output(evt);
     m_buffer.clear();
     m_head = nullptr;
+    m_encoded_head = nullptr;
   }
 }
 
@@ -804,8 +814,86 @@ void Encoder::output_head() {
   auto buffer = Data::make();
   bool no_content_length = false;
 
+  // Heads of frozen messages are encoded only once, except for HEAD
+  // where the content-length header is kept as is
+  if (m_encoded_head && m_method != s_HEAD) {
+    auto &b = m_encoded_head->http1(m_is_response);
+    if (!b.encoded) {
+      encode_head(b.data, no_content_length);
+      b.header_connection = m_header_connection;
+      b.header_upgrade = m_header_upgrade;
+      b.encoded = true;
+    } else {
+      m_header_connection = b.header_connection;
+      m_header_upgrade = b.header_upgrade;
+    }
+    buffer->push(b.data);
+  } else {
+    encode_head(*buffer, no_content_length);
+  }
+
+  if (m_is_response) {
+    auto status = m_status_code;
+    if (
+      (status < 200 || status == 204) ||
+      (m_responded_tunnel_type != TunnelType::NONE)
+    ) {
+      no_content_length = true;
+    }
+  } else {
+    auto head = m_head->as<RequestHead>();
+    auto req = new RequestQueue::Request;
+    req->head = head;
+    req->is_final = head->is_final(m_header_connection);
+    req->tunnel_type = head->tunnel_type(m_header_upgrade);
+    on_encode_request(req);
+  }
+
   Data::Builder db(*buffer, &s_dp);
 
+  if (!no_content_length) {
+    if (m_chunked) {
+      static const std::string str("transfer-encoding: chunked\r\n");
+      db.push(str);
+    } else if (
+      m_content_length > 0 ||
+      m_is_response ||
+      m_method == s_POST ||
+      m_method == s_PUT ||
+      m_method == s_PATCH
+    ) {
+      char str[100];
+      auto len = utils::to_string(str, sizeof(str), m_content_length);
+      db.push(s_content_length.get()->str());
+      db.push(": ", 2);
+      db.push(str, len);
+      db.push("\r\n", 2);
+    }
+  }
+
+  if (m_is_final) {
+    static const std::string str("connection: close\r\n");
+    db.push(str);
+  } else if (m_header_connection) {
+    static const std::string str("connection: ");
+    db.push(str);
+    db.push(m_header_connection->str());
+    db.push("\r\n");
+  } else {
+    static const std::string str("connection: keep-alive\r\n");
+    db.push(str);
+  }
+
+  db.push("\r\n");
+  db.flush();
+
+  output(MessageStart::make(m_head));
+  output(buffer);
+}
+
+void Encoder::encode_head(Data &buf, bool &no_content_length) {
+  Data::Builder db(buf, &s_dp);
+
   if (m_is_response) {
     auto head = m_head->as<ResponseHead>();
     char str[100];
@@ -826,14 +914,6 @@ void Encoder::output_head() {
       }
     }
 
-    auto status = m_status_code;
-    if (
-      (status < 200 || status == 204) ||
-      (m_responded_tunnel_type != TunnelType::NONE)
-    ) {
-      no_content_length = true;
-    }
-
   } else {
     db.push(m_method->str());
     db.push(' ');
@@ -895,53 +975,7 @@ void Encoder::output_head() {
     );
   }
 
-  if (!m_is_response) {
-    auto head = m_head->as<RequestHead>();
-    auto req = new RequestQueue::Request;
-    req->head = head;
-    req->is_final = head->is_final(m_header_connection);
-    req->tunnel_type = head->tunnel_type(m_header_upgrade);
-    on_encode_request(req);
-  }
-
-  if (!no_content_length) {
-    if (m_chunked) {
-      static const std::string str("transfer-encoding: chunked\r\n");
-      db.push(str);
-    } else if (
-      m_content_length > 0 ||
-      m_is_response ||
-      m_method == s_POST ||
-      m_method == s_PUT ||
-      m_method == s_PATCH
-    ) {
-      char str[100];
-      auto len = utils::to_string(str, sizeof(str), m_content_length);
-      db.push(s_content_length.get()->str());
-      db.push(": ", 2);
-      db.push(str, len);
-      db.push("\r\n", 2);
-    }
-  }
-
-  if (m_is_final) {
-    static const std::string str("connection: close\r\n");
-    db.push(str);
-  } else if (m_header_connection) {
-    static const std::string str("connection: ");
-    db.push(str);
-    db.push(m_header_connection->str());
-    db.push("\r\n");
-  } else {
-    static const std::string str("connection: keep-alive\r\n");
-    db.push(str);
-  }
-
-  db.push("\r\n");
   db.flush();
-
-  output(MessageStart::make(m_head));
-  output(buffer);
 }
 
 void Encoder::output_chunk(const Data &data) {
@@ -1440,6 +1474,9 @@ Mux::Options::Options(pjs::Object *options)
   Value(options, "ping")
     .get(ping_f)
     .check_nullable();
+  Value(options, "shared")
+    .get(shared)
+    .check_nullable();
 }
 
 //
@@ -1491,6 +1528,14 @@ auto Mux::clone() -> Filter* {
   return new Mux(*this);
 }
 
+void Mux::reset() {
+  MuxBase::reset();
+  if (auto s = m_shared_stream) {
+    s->close();
+    m_shared_stream = nullptr;
+  }
+}
+
 auto Mux::on_mux_new_pool(pjs::Object *options) -> MuxSessionPool* {
   if (options) {
     try {
@@ -1505,6 +1550,50 @@ auto Mux::on_mux_new_pool(pjs::Object *options) -> MuxSessionPool* {
   }
 }
 
+bool Mux::on_mux_redirect(const pjs::Value &key) {
+  if (!m_options.shared) return false;
+  std::string k;
+  if (!shared_session_key(key, k)) return false;
+  auto ss = SharedSession::select(k);
+  if (!ss) return false;
+  if (ss->net() == &Net::current()) {
+    ss->close_stream();
+    ss->release();
+    return false;
+  }
+  m_shared_stream = SharedStream::make(ss, Filter::output());
+  ss->release();
+  return true;
+}
+
+void Mux::on_mux_redirect(Event *evt) {
+  if (auto s = m_shared_stream) {
+    s->input(evt);
+  }
+}
+
+//
+// Sessions are only shared among clones of the same muxHTTP filter
+// and only under keys that mean the same in every thread
+//
+
+bool Mux::shared_session_key(const pjs::Value &key, std::string &out) {
+  if (!key.is_string() && !key.is_number()) return false;
+  const auto &loc = Filter::location();
+  if (loc.source) out += loc.source->filename;
+  out += ':';
+  out += std::to_string(loc.line);
+  out += ':';
+  out += std::to_string(loc.column);
+  out += '\n';
+  if (key.is_string()) {
+    out += key.s()->str();
+  } else {
+    out += key.to_string()->str();
+  }
+  return true;
+}
+
 auto Mux::verify_http_version(int version) -> int {
   if (version == 1 || version == 2) return version;
   Filter::error("invalid HTTP version number");
@@ -1543,6 +1632,7 @@ Mux::Session::~Session() {
   if (m_ping_promise_cb) {
     m_ping_promise_cb->discard();
   }
+  unpublish();
 }
 
 void Mux::Session::mux_session_open(MuxSource *source) {
@@ -1555,6 +1645,7 @@ void Mux::Session::mux_session_open(MuxSource *source) {
 
 auto Mux::Session::mux_session_open_stream(MuxSource *source) -> EventFunction* {
   if (m_http2) {
+    if (auto ss = m_shared_session.get()) ss->open_stream();
     return http2::Client::stream();
   } else {
     return MuxQueue::stream(source);
@@ -1563,13 +1654,48 @@ auto Mux::Session::mux_session_open_stream(MuxSource *source) -> EventFunction*
 
 void Mux::Session::mux_session_close_stream(EventFunction *stream) {
   if (m_http2) {
+    if (auto ss = m_shared_session.get()) ss->close_stream();
     http2::Client::close(stream);
   } else {
     MuxQueue::close(stream);
   }
 }
 
+auto Mux::Session::mux_session_capacity() -> int {
+  if (m_http2) {
+    auto n = http2::Client::peer_settings().max_concurrent_streams;
+    if (auto ss = m_shared_session.get()) ss->capacity(n);
+    return n;
+  } else {
+    return 0;
+  }
+}
+
+//
+// An HTTP/2 session sends out its preface and SETTINGS right away,
+// so the connection is fully set up before the first stream comes.
+//
+
+void Mux::Session::mux_session_prewarm() {
+  if (m_http2) {
+    http2::Client::preface();
+  } else {
+    MuxSession::mux_session_prewarm();
+  }
+}
+
+auto Mux::Session::open_shared_stream() -> EventFunction* {
+  MuxSession::share();
+  return http2::Client::stream();
+}
+
+void Mux::Session::close_shared_stream(EventFunction *stream) {
+  http2::Client::close(stream);
+  MuxSession::unshare();
+}
+
 void Mux::Session::mux_session_close() {
+  unpublish();
   if (m_http2) {
     if (m_ping_promise_cb) {
       m_ping_promise_cb->discard();
@@ -1674,6 +1800,9 @@ bool Mux::Session::select_protocol(Mux *mux, const pjs::Value &version) {
       m_ping_context = mux->context();
       schedule_ping();
     }
+    if (m_options.shared) {
+      publish(mux);
+    }
     return true;
   default:
     break;
@@ -1682,6 +1811,23 @@ bool Mux::Session::select_protocol(Mux *mux, const pjs::Value &version) {
   return false;
 }
 
+void Mux::Session::publish(Mux *mux) {
+  if (m_shared_session) return;
+  auto pool = MuxSession::pool();
+  if (!pool) return;
+  std::string key;
+  if (!mux->shared_session_key(pool->key(), key)) return;
+  m_shared_session = SharedSession::make(key, this);
+  m_shared_session->capacity(http2::Client::peer_settings().max_concurrent_streams);
+}
+
+void Mux::Session::unpublish() {
+  if (auto ss = m_shared_session.get()) {
+    ss->close();
+    m_shared_session = nullptr;
+  }
+}
+
 void Mux::Session::schedule_ping(Data *ack) {
   pjs::Value arg(ack), ret;
   (*m_options.ping_f)(*m_ping_context, 1, &arg, ret);
@@ -1700,6 +1846,144 @@ void Mux::Session::schedule_ping(Data *ack) {
   }
 }
 
+//
+// Mux::SharedSession
+//
+
+std::mutex Mux::SharedSession::s_mutex;
+std::unordered_map<std::string, std::vector<Mux::SharedSession*>> Mux::SharedSession::s_sessions;
+
+auto Mux::SharedSession::make(const std::string &key, Session *session) -> SharedSession* {
+  auto ss = new SharedSession(key, session);
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_sessions[key].push_back(ss->retain());
+  return ss;
+}
+
+//
+// Picks the least loaded session with room for one more stream
+// and counts that stream in before returning it retained
+//
+
+auto Mux::SharedSession::select(const std::string &key) -> SharedSession* {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  auto i = s_sessions.find(key);
+  if (i == s_sessions.end()) return nullptr;
+  SharedSession *best = nullptr;
+  int min = std::numeric_limits<int>::max();
+  for (auto *ss : i->second) {
+    auto n = ss->m_streams.load(std::memory_order_relaxed);
+    auto capacity = ss->m_capacity.load(std::memory_order_relaxed);
+    if (capacity > 0 && n >= capacity) continue;
+    if (n < min) {
+      best = ss;
+      min = n;
+    }
+  }
+  if (best) {
+    best->open_stream();
+    best->retain();
+  }
+  return best;
+}
+
+void Mux::SharedSession::close() {
+  m_session = nullptr;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  auto i = s_sessions.find(m_key);
+  if (i != s_sessions.end()) {
+    auto &list = i->second;
+    for (auto p = list.begin(); p != list.end(); p++) {
+      if (*p == this) {
+        list.erase(p);
+        release();
+        break;
+      }
+    }
+    if (list.empty()) s_sessions.erase(i);
+  }
+}
+
+//
+// Mux::SharedStream
+//
+
+Mux::SharedStream::SharedStream(SharedSession *shared_session, EventTarget::Input *output)
+  : m_input_net(shared_session->net())
+  , m_output_net(&Net::current())
+  , m_shared_session(shared_session)
+  , m_output(output)
+{
+  retain();
+  m_input_net->io_context().post(OpenHandler(this));
+}
+
+void Mux::SharedStream::input(Event *evt) {
+  retain();
+  m_input_net->io_context().post(InputHandler(this, SharedEvent::make(evt)));
+}
+
+void Mux::SharedStream::close() {
+  m_output = nullptr;
+  m_input_net->io_context().post(CloseHandler(this));
+}
+
+void Mux::SharedStream::on_event(Event *evt) {
+  retain();
+  m_output_net->io_context().post(OutputHandler(this, SharedEvent::make(evt)));
+}
+
+void Mux::SharedStream::on_open() {
+  InputContext ic;
+  if (auto session = m_shared_session->session()) {
+    m_session = session;
+    m_stream = session->open_shared_stream();
+    m_stream->chain(EventTarget::input());
+  } else {
+    pjs::Ref<StreamEnd> eos(StreamEnd::make(StreamEnd::CONNECTION_ABORTED));
+    on_event(eos);
+  }
+}
+
+void Mux::SharedStream::on_close() {
+  if (auto s = m_stream) {
+    InputContext ic;
+    s->chain(nullptr);
+    m_session->close_shared_stream(s);
+    m_stream = nullptr;
+  }
+  m_session = nullptr;
+  m_shared_session->close_stream();
+  EventTarget::close();
+  release();
+}
+
+void Mux::SharedStream::on_input(SharedEvent *se) {
+  if (auto evt = se->to_event()) {
+    if (auto s = m_stream) {
+      InputContext ic;
+      s->input()->input(evt);
+    } else {
+      evt->retain();
+      evt->release();
+    }
+  }
+  release();
+}
+
+void Mux::SharedStream::on_output(SharedEvent *se) {
+  if (auto evt = se->to_event()) {
+    if (m_output) {
+      InputContext ic;
+      m_output->input(evt);
+    } else {
+      evt->retain();
+      evt->release();
+    }
+  }
+  release();
+}
+
 //
 // Server
 //
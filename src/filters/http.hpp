@@ -32,8 +32,12 @@
 #include "list.hpp"
 #include "api/http.hpp"
 #include "http2.hpp"
+#include "net.hpp"
 #include "options.hpp"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace pipy {
 namespace http {
 
@@ -152,6 +156,7 @@ protected:
 private:
   DataBuffer m_buffer;
   pjs::Ref<MessageHead> m_head;
+  pjs::Ref<EncodedHead> m_encoded_head;
   pjs::Ref<pjs::Str> m_protocol;
   pjs::Ref<pjs::Str> m_method;
   pjs::Ref<pjs::Str> m_path;
@@ -169,6 +174,7 @@ private:
   virtual void on_event(Event *evt) override;
 
   void output_head();
+  void encode_head(Data &buf, bool &no_content_length);
   void output_chunk(const Data &data);
   void output_end(Event *evt);
 };
@@ -346,10 +352,14 @@ public:
     pjs::Ref<pjs::Str> version_s;
     pjs::Ref<pjs::Function> version_f;
     pjs::Ref<pjs::Function> ping_f;
+    bool shared = false;
     Options() {}
     Options(pjs::Object *options);
   };
 
+  class SharedSession;
+  class SharedStream;
+
   Mux();
   Mux(pjs::Function *session_selector);
   Mux(pjs::Function *session_selector, const Options &options);
@@ -388,11 +398,16 @@ public:
       friend class pjs::ObjectTemplate<VersionSelector>;
     };
 
+    auto open_shared_stream() -> EventFunction*;
+    void close_shared_stream(EventFunction *stream);
+
   private:
     virtual void mux_session_open(MuxSource *source) override;
     virtual auto mux_session_open_stream(MuxSource *source) -> EventFunction* override;
     virtual void mux_session_close_stream(EventFunction *stream) override;
     virtual void mux_session_close() override;
+    virtual auto mux_session_capacity() -> int override;
+    virtual void mux_session_prewarm() override;
 
     virtual void on_encode_request(RequestQueue::Request *req) override;
     virtual auto on_decode_response(ResponseHead *head) -> RequestQueue::Request* override;
@@ -409,12 +424,121 @@ public:
     pjs::Ref<VersionSelector> m_version_selector;
     pjs::Ref<Context> m_ping_context;
     pjs::Ref<pjs::Promise::Callback> m_ping_promise_cb;
+    pjs::Ref<SharedSession> m_shared_session;
     RequestQueue m_request_queue;
     bool m_http2 = false;
 
     bool select_protocol(Mux *muxer);
     bool select_protocol(Mux *muxer, const pjs::Value &version);
     void schedule_ping(Data *ack = nullptr);
+    void publish(Mux *muxer);
+    void unpublish();
+  };
+
+  //
+  // Mux::SharedSession
+  //
+  // An HTTP/2 session registered process-wide so that muxHTTP filters
+  // in other threads can open streams on it. Only the owner thread
+  // touches the session itself. Others only see the stream counter.
+  //
+
+  class SharedSession : public pjs::RefCountMT<SharedSession> {
+  public:
+    static auto make(const std::string &key, Session *session) -> SharedSession*;
+    static auto select(const std::string &key) -> SharedSession*;
+
+    auto net() const -> Net* { return m_net; }
+    auto session() const -> Session* { return m_session; }
+    void capacity(int n) { m_capacity.store(n, std::memory_order_relaxed); }
+    void open_stream() { m_streams.fetch_add(1, std::memory_order_relaxed); }
+    void close_stream() { m_streams.fetch_sub(1, std::memory_order_relaxed); }
+    void close();
+
+  private:
+    SharedSession(const std::string &key, Session *session)
+      : m_key(key)
+      , m_net(&Net::current())
+      , m_session(session) {}
+
+    std::string m_key;
+    Net* m_net;
+    Session* m_session;
+    std::atomic<int> m_streams{0};
+    std::atomic<int> m_capacity{0};
+
+    static std::mutex s_mutex;
+    static std::unordered_map<std::string, std::vector<SharedSession*>> s_sessions;
+
+    friend class pjs::RefCountMT<SharedSession>;
+  };
+
+  //
+  // Mux::SharedStream
+  //
+  // Relays a stream between a muxHTTP filter and a SharedSession
+  // living in another thread.
+  //
+
+  class SharedStream :
+    public pjs::Pooled<SharedStream>,
+    public pjs::RefCountMT<SharedStream>,
+    public EventTarget
+  {
+  public:
+    static auto make(SharedSession *shared_session, EventTarget::Input *output) -> SharedStream* {
+      return new SharedStream(shared_session, output);
+    }
+
+    void input(Event *evt);
+    void close();
+
+  private:
+    SharedStream(SharedSession *shared_session, EventTarget::Input *output);
+
+    struct OpenHandler : SelfHandlerMT<SharedStream> {
+      using SelfHandlerMT::SelfHandlerMT;
+      OpenHandler(const OpenHandler &r) : SelfHandlerMT(r) {}
+      void operator()() { self->on_open(); }
+    };
+
+    struct CloseHandler : SelfHandlerMT<SharedStream> {
+      using SelfHandlerMT::SelfHandlerMT;
+      CloseHandler(const CloseHandler &r) : SelfHandlerMT(r) {}
+      void operator()() { self->on_close(); }
+    };
+
+    struct InputHandler : SelfDataHandlerMT<SharedStream, SharedEvent> {
+      using SelfDataHandlerMT::SelfDataHandlerMT;
+      InputHandler(SharedStream *s, SharedEvent *d) : SelfDataHandlerMT(s, d) { d->retain(); }
+      InputHandler(const InputHandler &r) : SelfDataHandlerMT(r) { r.data->retain(); }
+      ~InputHandler() { data->release(); }
+      void operator()() { self->on_input(data); }
+    };
+
+    struct OutputHandler : SelfDataHandlerMT<SharedStream, SharedEvent> {
+      using SelfDataHandlerMT::SelfDataHandlerMT;
+      OutputHandler(SharedStream *s, SharedEvent *d) : SelfDataHandlerMT(s, d) { d->retain(); }
+      OutputHandler(const OutputHandler &r) : SelfDataHandlerMT(r) { r.data->retain(); }
+      ~OutputHandler() { data->release(); }
+      void operator()() { self->on_output(data); }
+    };
+
+    virtual void on_event(Event *evt) override;
+
+    void on_open();
+    void on_close();
+    void on_input(SharedEvent *se);
+    void on_output(SharedEvent *se);
+
+    Net* m_input_net;
+    Net* m_output_net;
+    pjs::Ref<SharedSession> m_shared_session;
+    pjs::Ref<Session> m_session;
+    EventFunction* m_stream = nullptr;
+    pjs::Ref<EventTarget::Input> m_output;
+
+    friend class pjs::RefCountMT<SharedStream>;
   };
 
 private:
@@ -423,13 +547,18 @@ private:
 
   Options m_options;
   EventBuffer m_waiting_events;
+  SharedStream* m_shared_stream = nullptr;
 
   virtual auto clone() -> Filter* override;
+  virtual void reset() override;
   virtual void dump(Dump &d) override;
   virtual auto on_mux_new_pool(pjs::Object *options) -> MuxSessionPool* override;
+  virtual bool on_mux_redirect(const pjs::Value &key) override;
+  virtual void on_mux_redirect(Event *evt) override;
 
   auto verify_http_version(int version) -> int;
   auto verify_http_version(pjs::Str *name) -> int;
+  bool shared_session_key(const pjs::Value &key, std::string &out);
 
   //
   // Mux::SessionPool
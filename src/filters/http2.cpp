@@ -569,7 +569,6 @@ FrameDecoder::FrameDecoder()
   : m_payload(Data::make())
 {
   Deframer::reset(STATE_HEADER);
-  Deframer::read(sizeof(m_header), m_header);
 }
 
 void FrameDecoder::deframe(Data *data) {
@@ -579,50 +578,65 @@ void FrameDecoder::deframe(Data *data) {
 auto FrameDecoder::on_state(int state, int c) -> int {
   switch (state) {
     case STATE_HEADER: {
-      const uint8_t *buf = m_header;
-      auto size = (
-        (uint32_t(buf[0]) << 16) |
-        (uint32_t(buf[1]) <<  8) |
-        (uint32_t(buf[2]) <<  0)
-      );
-      m_frame.type = buf[3];
-      m_frame.flags = buf[4];
-      m_frame.stream_id = (
-        (uint32_t(buf[5]) << 24) |
-        (uint32_t(buf[6]) << 16) |
-        (uint32_t(buf[7]) <<  8) |
-        (uint32_t(buf[8]) <<  0)
-      ) & 0x7fffffff;
-      if (size > m_max_frame_size) {
-        on_deframe_error(FRAME_SIZE_ERROR);
-        return -1;
-      } else if (size > 0) {
-        if (
-          (m_frame.type == Frame::RST_STREAM && size != 4) ||
-          (m_frame.type == Frame::PRIORITY && size != 5)
-        ) {
-          on_deframe_error(FRAME_SIZE_ERROR);
-          return -1;
-        }
-        Deframer::read(size, m_payload);
-        return STATE_PAYLOAD;
-      } else {
-        on_deframe(m_frame);
-        read(sizeof(m_header), m_header);
-        return STATE_HEADER;
-      }
+      m_header[m_header_length++] = c;
+      if (m_header_length < sizeof(m_header)) return STATE_HEADER;
+      m_header_length = 0;
+      return header(m_header);
     }
     case STATE_PAYLOAD: {
       m_frame.payload = std::move(*m_payload);
       on_deframe(m_frame);
       m_frame.payload.clear();
-      read(sizeof(m_header), m_header);
       return STATE_HEADER;
     }
   }
   return -1;
 }
 
+//
+// Frame headers are parsed right from the input chunk when
+// all 9 bytes are there, or collected byte by byte otherwise
+//
+
+auto FrameDecoder::on_span(int &state, const uint8_t *ptr, size_t len) -> size_t {
+  if (state != STATE_HEADER || m_header_length > 0 || len < sizeof(m_header)) return 0;
+  state = header(ptr);
+  return sizeof(m_header);
+}
+
+auto FrameDecoder::header(const uint8_t *buf) -> int {
+  auto size = (
+    (uint32_t(buf[0]) << 16) |
+    (uint32_t(buf[1]) <<  8) |
+    (uint32_t(buf[2]) <<  0)
+  );
+  m_frame.type = buf[3];
+  m_frame.flags = buf[4];
+  m_frame.stream_id = (
+    (uint32_t(buf[5]) << 24) |
+    (uint32_t(buf[6]) << 16) |
+    (uint32_t(buf[7]) <<  8) |
+    (uint32_t(buf[8]) <<  0)
+  ) & 0x7fffffff;
+  if (size > m_max_frame_size) {
+    on_deframe_error(FRAME_SIZE_ERROR);
+    return -1;
+  } else if (size > 0) {
+    if (
+      (m_frame.type == Frame::RST_STREAM && size != 4) ||
+      (m_frame.type == Frame::PRIORITY && size != 5)
+    ) {
+      on_deframe_error(FRAME_SIZE_ERROR);
+      return -1;
+    }
+    Deframer::read(size, m_payload);
+    return STATE_PAYLOAD;
+  } else {
+    on_deframe(m_frame);
+    return STATE_HEADER;
+  }
+}
+
 //
 // FrameEncoder
 //
@@ -1198,6 +1212,21 @@ void HeaderEncoder::encode(bool is_response, bool is_tail, pjs::Object *head, Da
   db.flush();
 }
 
+void HeaderEncoder::encode(bool is_response, MessageStart *start, Data &data) {
+  // No dynamic table is used, so header blocks of
+  // frozen messages can be encoded only once
+  if (auto eh = http::EncodedHead::get(start)) {
+    auto &b = eh->http2(is_response);
+    if (!b.encoded) {
+      encode(is_response, false, start->head(), b.data);
+      b.encoded = true;
+    }
+    data.push(b.data);
+  } else {
+    encode(is_response, false, start->head(), data);
+  }
+}
+
 void HeaderEncoder::encode_header_field(Data::Builder &db, pjs::Str *k, pjs::Str *v) {
   if (const auto *ent = m_static_table.find(k)) {
     auto i = ent->values.find(v);
@@ -1588,28 +1617,37 @@ void Endpoint::send_window_updates() {
   }
 }
 
-void Endpoint::frame(Frame &frm) {
+void Endpoint::preface() {
   if (m_has_gone_away) return;
+  if (m_has_sent_preface) return;
+  send_preface();
+  FlushTarget::need_flush();
+}
 
-  // Send preface if not yet
-  if (!m_has_sent_preface) {
-    m_has_sent_preface = true;
-    if (!m_is_server_side) {
-      thread_local static Data s_preface("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", &s_dp);
-      m_output_buffer.push(s_preface);
-    }
-    uint8_t buf[Settings::MAX_SIZE];
-    auto len = m_settings.encode(buf);
-    Frame frm;
-    frm.stream_id = 0;
-    frm.type = Frame::SETTINGS;
-    frm.flags = 0;
-    frm.payload.push(buf, len, &s_dp);
+void Endpoint::send_preface() {
+  m_has_sent_preface = true;
+  if (!m_is_server_side) {
+    thread_local static Data s_preface("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", &s_dp);
+    m_output_buffer.push(s_preface);
+  }
+  uint8_t buf[Settings::MAX_SIZE];
+  auto len = m_settings.encode(buf);
+  Frame frm;
+  frm.stream_id = 0;
+  frm.type = Frame::SETTINGS;
+  frm.flags = 0;
+  frm.payload.push(buf, len, &s_dp);
 #if DEBUG_HTTP2
-    debug_dump_o(frm);
+  debug_dump_o(frm);
 #endif
-    FrameEncoder::frame(frm, m_output_buffer);
-  }
+  FrameEncoder::frame(frm, m_output_buffer);
+}
+
+void Endpoint::frame(Frame &frm) {
+  if (m_has_gone_away) return;
+
+  // Send preface if not yet
+  if (!m_has_sent_preface) send_preface();
 
   // Send window updates
   send_window_updates();
@@ -1804,7 +1842,7 @@ void Endpoint::StreamBase::encoder_input(Event *evt) {
   if (auto start = evt->as<MessageStart>()) {
     if (!m_is_message_started) {
       Data buf;
-      m_header_encoder.encode(m_is_server_side, false, start->head(), buf);
+      m_header_encoder.encode(m_is_server_side, start, buf);
       write_header_block(buf);
       if (m_state == IDLE) {
         m_state = OPEN;
@@ -150,10 +150,14 @@ private:
 
   Frame m_frame;
   uint8_t m_header[9];
+  int m_header_length = 0;
   pjs::Ref<Data> m_payload;
   int m_max_frame_size = 0x4000;
 
   virtual auto on_state(int state, int c) -> int override;
+  virtual auto on_span(int &state, const uint8_t *ptr, size_t len) -> size_t override;
+
+  auto header(const uint8_t *buf) -> int;
 };
 
 //
@@ -320,6 +324,12 @@ public:
     Data &data
   );
 
+  void encode(
+    bool is_response,
+    MessageStart *start,
+    Data &data
+  );
+
 private:
   void encode_header_field(
     Data::Builder &db,
@@ -387,7 +397,9 @@ protected:
   void stream_error(int id, ErrorCode err);
   void connection_error(ErrorCode err);
   void ping(const Data &data);
+  void preface();
   void shutdown();
+  auto peer_settings() const -> const Settings& { return m_peer_settings; }
 
 private:
   enum {
@@ -429,6 +441,7 @@ private:
 
   bool for_each_stream(const std::function<bool(StreamBase*)> &cb);
   bool for_each_pending_stream(const std::function<bool(StreamBase*)> &cb);
+  void send_preface();
   void send_window_updates();
   void frame(Frame &frm);
   void flush();
@@ -80,6 +80,11 @@
 //   - mux_session_close_stream()
 //   - mux_session_close()
 //
+// and optionally:
+//
+//   - mux_session_capacity() : Max number of concurrent streams, or 0 for no limit
+//   - mux_session_prewarm() : Starts connecting an idle session opened for minSessions
+//
 // A MuxSessionPool needs to implement:
 //
 //   - session() : Creates a new MuxSession
@@ -96,6 +101,7 @@ MuxSession::Options::Options(pjs::Object *options) {
   thread_local static pjs::ConstStr s_max_idle("maxIdle");
   thread_local static pjs::ConstStr s_max_queue("maxQueue");
   thread_local static pjs::ConstStr s_max_messages("maxMessages");
+  thread_local static pjs::ConstStr s_min_sessions("minSessions");
   Value(options, s_max_idle)
     .get_seconds(max_idle)
     .check_nullable();
@@ -105,6 +111,9 @@ MuxSession::Options::Options(pjs::Object *options) {
   Value(options, s_max_messages)
     .get(max_messages)
     .check_nullable();
+  Value(options, s_min_sessions)
+    .get(min_sessions)
+    .check_nullable();
 }
 
 //
@@ -140,6 +149,11 @@ void MuxSession::end(StreamEnd *eos) {
   detach();
 }
 
+void MuxSession::share() {
+  m_share_count++;
+  if (m_pool) m_pool->sort(this);
+}
+
 void MuxSession::open(MuxSource *source, Pipeline *pipeline) {
   EventProxy::chain_forward(pipeline->input());
   pipeline->chain(EventSource::reply());
@@ -150,6 +164,16 @@ void MuxSession::open(MuxSource *source, Pipeline *pipeline) {
   pipeline->start(1, &arg);
 }
 
+//
+// Gets an idle session connected without any stream on it.
+// By default, an empty Data is enough to make the connect filter
+// in the session pipeline start connecting.
+//
+
+void MuxSession::mux_session_prewarm() {
+  EventProxy::forward(Data::make());
+}
+
 void MuxSession::close() {
   if (m_pipeline) {
     mux_session_close();
@@ -175,13 +199,18 @@ MuxSessionPool::MuxSessionPool(const MuxSession::Options &options) {
   m_max_idle = options.max_idle;
   m_max_queue = options.max_queue;
   m_max_messages = options.max_messages;
+  m_min_sessions = options.min_sessions;
 }
 
 auto MuxSessionPool::alloc() -> MuxSession* {
-  auto max_share_count = m_max_queue;
   auto max_message_count = m_max_messages;
   auto *s = m_sessions.head();
   while (s) {
+    auto max_share_count = m_max_queue;
+    auto capacity = s->mux_session_capacity();
+    if (capacity > 0 && (max_share_count <= 0 || capacity < max_share_count)) {
+      max_share_count = capacity;
+    }
     if ((max_share_count <= 0 || s->m_share_count < max_share_count) &&
         (max_message_count <= 0 || s->m_message_count < max_message_count)
       ) {
@@ -207,6 +236,27 @@ void MuxSessionPool::free(MuxSession *session) {
   sort(session);
 }
 
+//
+// Opens idle sessions up front until there are at least m_min_sessions in
+// the pool, so that later requests won't wait for connection setup.
+// Called right after a session has been opened for the given source.
+//
+
+void MuxSessionPool::prewarm(MuxSource *source) {
+  for (int n = m_min_sessions - int(m_sessions.size()); n > 0; n--) {
+    auto s = session();
+    s->retain();
+    s->m_pool = this;
+    s->m_share_count = 0;
+    s->m_free_time = utils::now();
+    m_sessions.unshift(s);
+    pjs::Ref<MuxSession> ref(s);
+    s->open(source, source->on_mux_new_pipeline());
+    if (!s->m_eos) s->mux_session_prewarm();
+  }
+  schedule_recycling();
+}
+
 void MuxSessionPool::detach(MuxSession *session) {
   m_sessions.remove(session);
   session->release();
@@ -272,9 +322,10 @@ void MuxSessionPool::recycle(double now) {
   while (s) {
     auto session = s; s = s->next();
     if (session->m_share_count > 0) break;
+    auto is_spare = int(m_sessions.size()) > m_min_sessions || m_map->m_has_shutdown;
     if (session->m_is_pending || m_weak_ptr_gone ||
        (m_max_messages > 0 && session->m_message_count >= m_max_messages) ||
-       (now - session->m_free_time >= max_idle))
+       (is_spare && now - session->m_free_time >= max_idle))
     {
       MuxSession::auto_release(session);
       session->forward(StreamEnd::make());
@@ -450,6 +501,9 @@ void MuxSource::alloc_stream() {
         m_output->input(eos);
         return;
       }
+      if (auto pool = session->m_pool) {
+        pool->prewarm(this);
+      }
     }
 
     if (session->is_pending()) {
@@ -691,6 +745,7 @@ void MuxBase::reset() {
   Filter::reset();
   MuxSource::reset();
   m_session_key_ready = false;
+  m_is_redirected = false;
 }
 
 void MuxBase::chain() {
@@ -712,9 +767,14 @@ void MuxBase::process(Event *evt) {
     if (m_session_selector && !Filter::eval(m_session_selector, key)) return;
     if (key.is_undefined()) key.set(Filter::context()->inbound());
     MuxSource::key(key);
+    m_is_redirected = on_mux_redirect(key);
   }
 
-  MuxSource::input(evt);
+  if (m_is_redirected) {
+    on_mux_redirect(evt);
+  } else {
+    MuxSource::input(evt);
+  }
 }
 
 auto MuxBase::on_mux_new_pool() -> MuxSessionPool* {
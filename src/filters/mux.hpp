@@ -63,6 +63,7 @@ public:
     double max_idle = 60;
     int max_queue = 0;
     int max_messages = 0;
+    int min_sessions = 0;
     Options() {}
     Options(pjs::Object *options);
   };
@@ -71,6 +72,8 @@ public:
   virtual auto mux_session_open_stream(MuxSource *source) -> EventFunction* = 0;
   virtual void mux_session_close_stream(EventFunction *stream) = 0;
   virtual void mux_session_close() = 0;
+  virtual auto mux_session_capacity() -> int { return 0; }
+  virtual void mux_session_prewarm();
 
 protected:
   auto pool() const -> MuxSessionPool* { return m_pool; }
@@ -81,6 +84,8 @@ protected:
   void set_pending(bool pending);
   void detach();
   void end(StreamEnd *eos);
+  void share();
+  void unshare() { free(); }
 
 private:
   void open(MuxSource *source, Pipeline *pipeline);
@@ -114,6 +119,9 @@ class MuxSessionPool :
   public pjs::Object::WeakPtr::Watcher,
   public List<MuxSessionPool>::Item
 {
+public:
+  auto key() const -> const pjs::Value& { return m_key; }
+
 protected:
   MuxSessionPool(const MuxSession::Options &options);
 
@@ -124,6 +132,7 @@ private:
   auto alloc() -> MuxSession*;
   void free(MuxSession *session);
   void detach(MuxSession *session);
+  void prewarm(MuxSource *source);
 
   pjs::Value m_key;
   pjs::Ref<pjs::Object::WeakPtr> m_weak_key;
@@ -132,6 +141,7 @@ private:
   double m_max_idle;
   int m_max_queue;
   int m_max_messages;
+  int m_min_sessions;
   bool m_weak_ptr_gone = false;
   bool m_recycle_scheduled = false;
 
@@ -208,6 +218,7 @@ private:
   void close_stream();
 
   friend class MuxSession;
+  friend class MuxSessionPool;
   friend class MuxSessionMap;
 };
 
@@ -306,10 +317,13 @@ protected:
   virtual auto on_mux_new_pool() -> MuxSessionPool* override;
   virtual auto on_mux_new_pool(pjs::Object *options) -> MuxSessionPool* = 0;
   virtual auto on_mux_new_pipeline() -> Pipeline* override;
+  virtual bool on_mux_redirect(const pjs::Value &key) { return false; }
+  virtual void on_mux_redirect(Event *evt) {}
 
   pjs::Ref<pjs::Function> m_session_selector;
   pjs::Ref<pjs::Function> m_options;
   bool m_session_key_ready = false;
+  bool m_is_redirected = false;
 };
 
 //
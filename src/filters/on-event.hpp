@@ -38,6 +38,8 @@ class OnEvent : public Handle {
 public:
   OnEvent(Event::Type type, pjs::Function *callback);
 
+  auto type() const -> Event::Type { return m_type; }
+
 private:
   OnEvent(const OnEvent &r);
   ~OnEvent();
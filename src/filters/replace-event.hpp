@@ -38,6 +38,8 @@ class ReplaceEvent : public Replace {
 public:
   ReplaceEvent(Event::Type type, pjs::Object *replacement);
 
+  auto type() const -> Event::Type { return m_type; }
+
 private:
   ReplaceEvent(const ReplaceEvent &r);
   ~ReplaceEvent();
@@ -38,6 +38,8 @@ class Replace : public Handle {
 public:
   Replace(pjs::Object *replacement);
 
+  auto replacement() const -> pjs::Object* { return m_replacement; }
+
 protected:
   Replace(const Replace &r);
   ~Replace();
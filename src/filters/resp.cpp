@@ -24,10 +24,18 @@
  */
 
 #include "resp.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <set>
 
 namespace pipy {
 namespace resp {
 
+static Data::Producer s_dp("muxRESP");
+
 //
 // Decoder
 //
@@ -132,5 +140,378 @@ void Encoder::process(Event *evt) {
   }
 }
 
+//
+// Mux::Options
+//
+
+Mux::Options::Options(pjs::Object *options) {
+  thread_local static pjs::ConstStr s_max_redirects("maxRedirects");
+  Value(options, s_max_redirects)
+    .get(max_redirects)
+    .check_nullable();
+}
+
+//
+// Mux
+//
+
+static auto value_to_string(const pjs::Value &v) -> std::string {
+  if (v.is_string()) return v.s()->str();
+  if (v.is<Data>()) return v.as<Data>()->to_string();
+  return std::string();
+}
+
+static auto crc16(const std::string &s, size_t pos, size_t len) -> uint16_t {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= uint16_t(uint8_t(s[pos + i])) << 8;
+    for (int j = 0; j < 8; j++) {
+      crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+Mux::Mux(const std::vector<std::string> &nodes, const Options &options)
+  : m_cluster(new Cluster(nodes, options))
+{
+}
+
+Mux::Mux(const Mux &r)
+  : Filter(r)
+  , m_cluster(r.m_cluster)
+{
+}
+
+Mux::~Mux()
+{
+  detach();
+}
+
+void Mux::dump(Dump &d) {
+  Filter::dump(d);
+  d.name = "muxRESP";
+  d.sub_type = Dump::MUX;
+}
+
+auto Mux::clone() -> Filter* {
+  return new Mux(*this);
+}
+
+void Mux::reset() {
+  Filter::reset();
+  detach();
+  m_eos = nullptr;
+  m_message_started = false;
+}
+
+void Mux::process(Event *evt) {
+  if (evt->is<MessageStart>()) {
+    m_message_started = true;
+
+  } else if (auto *end = evt->as<MessageEnd>()) {
+    if (m_message_started) {
+      m_message_started = false;
+      auto req = new Request(Request::COMMAND, this, end->payload());
+      req->retain();
+      m_requests.push(req);
+      m_cluster->send(this, req);
+    }
+
+  } else if (auto *eos = evt->as<StreamEnd>()) {
+    if (m_requests.empty()) {
+      Filter::output(eos);
+    } else {
+      m_eos = eos;
+    }
+  }
+}
+
+//
+// Computes the hash slot of the key a command operates on,
+// or returns -1 for commands that do not take a key
+//
+
+auto Mux::slot(const pjs::Value &command) -> int {
+  static const std::set<std::string> s_keyless = {
+    "auth", "client", "cluster", "command", "config", "dbsize",
+    "echo", "hello", "info", "ping", "publish", "quit", "readonly",
+    "readwrite", "script", "select", "time",
+  };
+
+  if (!command.is_array()) return -1;
+  auto *a = command.as<pjs::Array>();
+  if (a->length() < 2) return -1;
+
+  pjs::Value v;
+  a->get(0, v);
+  auto name = value_to_string(v);
+  for (auto &c : name) c = std::tolower(c);
+  if (s_keyless.count(name)) return -1;
+
+  int key_index = 1;
+  if (
+    name == "eval" || name == "evalsha" || name == "eval_ro" ||
+    name == "evalsha_ro" || name == "fcall" || name == "fcall_ro"
+  ) {
+    a->get(2, v);
+    if (std::atoi(value_to_string(v).c_str()) < 1) return -1;
+    key_index = 3;
+  } else if (name == "xread" || name == "xreadgroup") {
+    key_index = -1;
+    for (int i = 1, n = a->length(); i < n; i++) {
+      a->get(i, v);
+      auto arg = value_to_string(v);
+      for (auto &c : arg) c = std::tolower(c);
+      if (arg == "streams") {
+        key_index = i + 1;
+        break;
+      }
+    }
+  }
+
+  if (key_index < 0 || key_index >= a->length()) return -1;
+  a->get(key_index, v);
+  auto key = value_to_string(v);
+
+  // Only the part inside the first non-empty {...} is hashed if present
+  auto i = key.find('{');
+  if (i != std::string::npos) {
+    auto j = key.find('}', i + 1);
+    if (j != std::string::npos && j > i + 1) {
+      return crc16(key, i + 1, j - i - 1) & 16383;
+    }
+  }
+
+  return crc16(key, 0, key.length()) & 16383;
+}
+
+void Mux::flush() {
+  while (auto *req = m_requests.head()) {
+    if (!req->replied) break;
+    m_requests.remove(req);
+    req->mux = nullptr;
+    pjs::Value reply(req->reply);
+    req->release();
+    Filter::output(MessageStart::make());
+    Filter::output(MessageEnd::make(nullptr, reply));
+  }
+  if (m_eos && m_requests.empty()) {
+    pjs::Ref<StreamEnd> eos(m_eos);
+    m_eos = nullptr;
+    Filter::output(eos);
+  }
+}
+
+void Mux::detach() {
+  while (auto *req = m_requests.head()) {
+    m_requests.remove(req);
+    req->mux = nullptr;
+    req->release();
+  }
+}
+
+//
+// Mux::Node
+//
+
+void Mux::Node::send(Mux *opener, Request *req) {
+  if (!m_pipeline && opener) {
+    auto *p = opener->sub_pipeline(0, true, EventTarget::input());
+    m_pipeline = p;
+    pjs::Value arg(m_address.get());
+    p->start(1, &arg);
+  }
+  if (!m_pipeline) {
+    pjs::Value err(pjs::Error::make(pjs::Str::make("ERR cannot connect to " + m_address->str())));
+    m_cluster->on_reply(this, req, err);
+    return;
+  }
+  m_outgoing.push_back(req);
+  FlushTarget::need_flush();
+}
+
+void Mux::Node::close() {
+  EventTarget::close();
+  m_pipeline = nullptr;
+  m_outgoing.clear();
+  m_pending.clear();
+}
+
+void Mux::Node::on_flush() {
+  pjs::Ref<Node> ref(this);
+  std::deque<pjs::Ref<Request>> outgoing;
+  outgoing.swap(m_outgoing);
+  for (const auto &req : outgoing) {
+    if (m_pipeline) {
+      m_pending.push_back(req);
+      auto *i = m_pipeline->input();
+      i->input(MessageStart::make());
+      i->input(MessageEnd::make(nullptr, req->command));
+    } else {
+      pjs::Value err(pjs::Error::make(pjs::Str::make("ERR connection to " + m_address->str() + " closed")));
+      m_cluster->on_reply(this, req, err);
+    }
+  }
+}
+
+void Mux::Node::on_event(Event *evt) {
+  if (auto *end = evt->as<MessageEnd>()) {
+    if (!m_pending.empty()) {
+      pjs::Ref<Request> req(m_pending.front());
+      m_pending.pop_front();
+      m_cluster->on_reply(this, req, end->payload());
+    }
+
+  } else if (evt->is<StreamEnd>()) {
+    Pipeline::auto_release(m_pipeline);
+    m_pipeline = nullptr;
+    if (!m_pending.empty()) {
+      pjs::Ref<Node> ref(this);
+      std::deque<pjs::Ref<Request>> pending;
+      pending.swap(m_pending);
+      pjs::Value err(pjs::Error::make(pjs::Str::make("ERR connection to " + m_address->str() + " closed")));
+      for (const auto &req : pending) {
+        m_cluster->on_reply(this, req, err);
+      }
+    }
+  }
+}
+
+//
+// Mux::Cluster
+//
+
+Mux::Cluster::~Cluster() {
+  for (const auto &p : m_nodes) {
+    p.second->close();
+  }
+}
+
+void Mux::Cluster::send(Mux *mux, Request *req) {
+  if (!m_has_slots) refresh(mux, seed());
+  auto i = slot(req->command);
+  auto *n = (i >= 0 ? m_slots[i] : nullptr);
+  if (!n) n = seed();
+  n->send(mux, req);
+}
+
+void Mux::Cluster::on_reply(Node *node, Request *req, const pjs::Value &reply) {
+  switch (req->type) {
+    case Request::ASKING:
+      break;
+
+    case Request::CLUSTER_SLOTS:
+      m_is_refreshing = false;
+      update_slots(node, reply);
+      break;
+
+    case Request::COMMAND: {
+      auto *mux = req->mux;
+      if (!mux) break;
+      if (reply.is<pjs::Error>() && req->redirects < m_options.max_redirects) {
+        const auto &msg = reply.as<pjs::Error>()->message()->str();
+        bool is_moved = !msg.compare(0, 6, "MOVED ");
+        bool is_ask = !msg.compare(0, 4, "ASK ");
+        if (is_moved || is_ask) {
+          auto p = msg.find(' ');
+          auto q = msg.find(' ', p + 1);
+          if (q != std::string::npos) {
+            auto slot = std::atoi(msg.c_str() + p + 1);
+            auto *target = this->node(msg.substr(q + 1));
+            req->redirects++;
+            if (is_moved) {
+              if (0 <= slot && slot < 16384) m_slots[slot] = target;
+              refresh(mux, target);
+            } else {
+              auto *cmd = pjs::Array::make(1);
+              cmd->set(0, Data::make("ASKING", &s_dp));
+              pjs::Ref<Request> asking(new Request(Request::ASKING, nullptr, cmd));
+              target->send(mux, asking);
+            }
+            target->send(mux, req);
+            break;
+          }
+        }
+      }
+      req->reply = reply;
+      req->replied = true;
+      mux->flush();
+      break;
+    }
+  }
+}
+
+auto Mux::Cluster::node(const std::string &address) -> Node* {
+  auto &n = m_nodes[address];
+  if (!n) n = new Node(this, address);
+  return n;
+}
+
+auto Mux::Cluster::seed() -> Node* {
+  if (m_seeds.empty()) return node("localhost:6379");
+  return node(m_seeds.front());
+}
+
+void Mux::Cluster::refresh(Mux *opener, Node *node) {
+  if (m_is_refreshing) return;
+  if (m_refresh_delay > 0 && utils::now() < m_refresh_time) return;
+  auto *cmd = pjs::Array::make(2);
+  cmd->set(0, Data::make("CLUSTER", &s_dp));
+  cmd->set(1, Data::make("SLOTS", &s_dp));
+  m_is_refreshing = true;
+  pjs::Ref<Request> req(new Request(Request::CLUSTER_SLOTS, nullptr, cmd));
+  node->send(opener, req);
+}
+
+void Mux::Cluster::update_slots(Node *node, const pjs::Value &reply) {
+  if (reply.is<pjs::Error>()) {
+    const auto &msg = reply.as<pjs::Error>()->message()->str();
+    if (msg.find("cluster support disabled") != std::string::npos) {
+      for (auto &n : m_slots) n = node;
+      m_has_slots = true;
+      m_refresh_delay = 0;
+      return;
+    }
+  }
+
+  if (!reply.is_array()) {
+    m_refresh_delay = (
+      m_refresh_delay > 0
+        ? std::min(m_refresh_delay * 2, double(MAX_REFRESH_DELAY))
+        : double(MIN_REFRESH_DELAY)
+    );
+    m_refresh_time = utils::now() + m_refresh_delay;
+    return;
+  }
+
+  auto *ranges = reply.as<pjs::Array>();
+  ranges->iterate_all(
+    [&](pjs::Value &v, int) {
+      if (!v.is_array()) return;
+      auto *range = v.as<pjs::Array>();
+      pjs::Value start, end, master;
+      range->get(0, start);
+      range->get(1, end);
+      range->get(2, master);
+      if (!start.is_number() || !end.is_number() || !master.is_array()) return;
+      pjs::Value host, port;
+      master.as<pjs::Array>()->get(0, host);
+      master.as<pjs::Array>()->get(1, port);
+      if (!port.is_number()) return;
+      auto ip = value_to_string(host);
+      Node *target = node;
+      if (!ip.empty() && ip != "?") {
+        target = this->node(ip + ':' + std::to_string(int(port.n())));
+      }
+      auto i = std::max(0, int(start.n()));
+      auto j = std::min(16383, int(end.n()));
+      while (i <= j) m_slots[i++] = target;
+    }
+  );
+  m_has_slots = true;
+  m_refresh_delay = 0;
+}
+
 } // namespace resp
 } // namespace pipy
@@ -27,8 +27,17 @@
 #define RESP_HPP
 
 #include "filter.hpp"
+#include "pipeline.hpp"
+#include "input.hpp"
+#include "list.hpp"
+#include "options.hpp"
 #include "api/resp.hpp"
 
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace pipy {
 namespace resp {
 
@@ -74,6 +83,148 @@ private:
   bool m_message_started = false;
 };
 
+//
+// Mux
+//
+
+class Mux : public Filter {
+public:
+  struct Options : public pipy::Options {
+    int max_redirects = 5;
+    Options() {}
+    Options(pjs::Object *options);
+  };
+
+  Mux(const std::vector<std::string> &nodes, const Options &options);
+
+  static auto slot(const pjs::Value &command) -> int;
+
+private:
+  Mux(const Mux &r);
+  ~Mux();
+
+  virtual auto clone() -> Filter* override;
+  virtual void reset() override;
+  virtual void process(Event *evt) override;
+  virtual void dump(Dump &d) override;
+
+  class Cluster;
+
+  //
+  // Mux::Request
+  //
+
+  struct Request :
+    public pjs::Pooled<Request>,
+    public pjs::RefCount<Request>,
+    public List<Request>::Item
+  {
+    enum Type { COMMAND, ASKING, CLUSTER_SLOTS };
+
+    Request(Type t, Mux *m, const pjs::Value &c)
+      : type(t), mux(m), command(c) {}
+
+    Type type;
+    Mux* mux;
+    pjs::Value command;
+    pjs::Value reply;
+    int redirects = 0;
+    bool replied = false;
+  };
+
+  //
+  // Mux::Node
+  //
+
+  //
+  // Requests sent to a node are held until the end of the current
+  // input and then go out together, so that commands from all the
+  // clients sharing the node are pipelined in one batch
+  //
+
+  class Node :
+    public pjs::Pooled<Node>,
+    public pjs::RefCount<Node>,
+    public EventTarget,
+    public FlushTarget
+  {
+  public:
+    Node(Cluster *cluster, const std::string &address)
+      : m_cluster(cluster)
+      , m_address(pjs::Str::make(address)) {}
+
+    auto address() const -> pjs::Str* { return m_address; }
+    void send(Mux *opener, Request *req);
+    void close();
+
+  private:
+    ~Node() { close(); }
+
+    Cluster* m_cluster;
+    pjs::Ref<pjs::Str> m_address;
+    pjs::Ref<Pipeline> m_pipeline;
+    std::deque<pjs::Ref<Request>> m_outgoing;
+    std::deque<pjs::Ref<Request>> m_pending;
+
+    virtual void on_event(Event *evt) override;
+    virtual void on_flush() override;
+
+    friend class pjs::RefCount<Node>;
+  };
+
+  //
+  // Mux::Cluster
+  //
+
+  //
+  // A failed CLUSTER SLOTS is retried with an exponential backoff.
+  // In the meantime, commands go to the seed node and follow redirects.
+  //
+
+  class Cluster : public pjs::RefCount<Cluster> {
+  public:
+    Cluster(const std::vector<std::string> &seeds, const Options &options)
+      : m_seeds(seeds)
+      , m_options(options)
+      , m_slots(16384) {}
+
+    void send(Mux *mux, Request *req);
+    void on_reply(Node *node, Request *req, const pjs::Value &reply);
+
+  private:
+    ~Cluster();
+
+    std::vector<std::string> m_seeds;
+    Options m_options;
+    std::unordered_map<std::string, pjs::Ref<Node>> m_nodes;
+    std::vector<Node*> m_slots;
+    bool m_has_slots = false;
+    bool m_is_refreshing = false;
+    double m_refresh_delay = 0;
+    double m_refresh_time = 0;
+
+    enum {
+      MIN_REFRESH_DELAY = 100,
+      MAX_REFRESH_DELAY = 10000,
+    };
+
+    auto node(const std::string &address) -> Node*;
+    auto seed() -> Node*;
+    void refresh(Mux *opener, Node *node);
+    void update_slots(Node *node, const pjs::Value &reply);
+
+    friend class pjs::RefCount<Cluster>;
+  };
+
+  pjs::Ref<Cluster> m_cluster;
+  List<Request> m_requests;
+  pjs::Ref<StreamEnd> m_eos;
+  bool m_message_started = false;
+
+  void flush();
+  void detach();
+};
+
 } // namespace resp
 } // namespace pipy
 
@@ -28,6 +28,16 @@
 namespace pipy {
 namespace thrift {
 
+//
+// Options
+//
+
+Options::Options(pjs::Object *options) {
+  Value(options, "lazy")
+    .get(lazy)
+    .check_nullable();
+}
+
 //
 // Decoder
 //
@@ -36,8 +46,16 @@ Decoder::Decoder()
 {
 }
 
+Decoder::Decoder(const Options &options)
+  : Thrift::Parser(options.lazy)
+  , m_options(options)
+{
+}
+
 Decoder::Decoder(const Decoder &r)
   : Filter(r)
+  , Thrift::Parser(r.m_options.lazy)
+  , m_options(r.m_options)
 {
 }
 
@@ -76,8 +94,16 @@ void Decoder::on_message_start() {
   Filter::output(MessageStart::make());
 }
 
+void Decoder::on_message_head(Thrift::Message *msg) {
+  Filter::output(MessageStart::make(msg));
+}
+
 void Decoder::on_message_end(Thrift::Message *msg) {
-  Filter::output(MessageEnd::make(nullptr, msg));
+  if (m_options.lazy) {
+    Filter::output(MessageEnd::make());
+  } else {
+    Filter::output(MessageEnd::make(nullptr, msg));
+  }
 }
 
 //
@@ -109,28 +135,45 @@ auto Encoder::clone() -> Filter* {
 void Encoder::reset() {
   Filter::reset();
   m_message_started = false;
+  m_head = nullptr;
+  m_buffer.clear();
 }
 
 void Encoder::process(Event *evt) {
   if (evt->is<StreamEnd>()) {
     m_message_started = false;
     Filter::output(evt);
-  } else if (evt->is<MessageStart>()) {
+  } else if (auto start = evt->as<MessageStart>()) {
     if (!m_message_started) {
       m_message_started = true;
+      m_head = nullptr;
+      m_buffer.clear();
+      if (auto head = start->head()) {
+        if (head->is<Thrift::Message>()) {
+          m_head = head->as<Thrift::Message>();
+        }
+      }
       Filter::output(evt);
     }
+  } else if (auto data = evt->as<Data>()) {
+    if (m_message_started && m_head) {
+      m_buffer.push(*data);
+    }
   } else if (evt->is<MessageEnd>()) {
     if (m_message_started) {
       m_message_started = false;
       const auto &payload = evt->as<MessageEnd>()->payload();
-      if (payload.is_object()) {
-        if (auto *obj = payload.o()) {
-          Data buf;
-          Thrift::encode(obj, buf);
-          Filter::output(Data::make(std::move(buf)));
-        }
+      if (payload.is_object() && payload.o()) {
+        Data buf;
+        Thrift::encode(payload.o(), buf);
+        Filter::output(Data::make(std::move(buf)));
+      } else if (m_head) {
+        Data buf;
+        Thrift::encode(m_head, m_buffer, buf);
+        Filter::output(Data::make(std::move(buf)));
       }
+      m_head = nullptr;
+      m_buffer.clear();
       Filter::output(evt);
     }
   }
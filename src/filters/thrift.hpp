@@ -27,11 +27,22 @@
 #define THRIFT_HPP
 
 #include "filter.hpp"
+#include "options.hpp"
 #include "api/thrift.hpp"
 
 namespace pipy {
 namespace thrift {
 
+//
+// Options
+//
+
+struct Options : public pipy::Options {
+  bool lazy = false;
+  Options() {}
+  Options(pjs::Object *options);
+};
+
 //
 // Decoder
 //
@@ -39,6 +50,7 @@ namespace thrift {
 class Decoder : public Filter, public Thrift::Parser {
 public:
   Decoder();
+  Decoder(const Options &options);
 
 private:
   Decoder(const Decoder &r);
@@ -51,7 +63,10 @@ private:
 
   virtual void on_pass(Data &data) override;
   virtual void on_message_start() override;
+  virtual void on_message_head(Thrift::Message *msg) override;
   virtual void on_message_end(Thrift::Message *msg) override;
+
+  Options m_options;
 };
 
 //
@@ -72,6 +87,8 @@ private:
   virtual void dump(Dump &d) override;
 
   bool m_message_started = false;
+  pjs::Ref<Thrift::Message> m_head;
+  Data m_buffer;
 };
 
 } // namespace thrift
@@ -24,8 +24,21 @@
  */
 
 #include "websocket.hpp"
+#include "compressor.hpp"
 #include "log.hpp"
 
+#include <cctype>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace pipy {
 namespace websocket {
 
@@ -50,6 +63,177 @@ namespace websocket {
 
 static Data::Producer s_dp("WebSocket");
 
+//
+// Masking
+//
+
+#ifdef __SSE2__
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#define AVX2_ENABLED 1
+
+static bool has_avx2() {
+  static const bool b = __builtin_cpu_supports("avx2");
+  return b;
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_mask(uint8_t *dst, const uint8_t *src, size_t len, uint32_t key) {
+  const auto k = _mm256_set1_epi32(key);
+  size_t i = 0;
+  while (i + 32 <= len) {
+    auto v = _mm256_loadu_si256((const __m256i*)(src + i));
+    _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(v, k));
+    i += 32;
+  }
+  return i;
+}
+
+#endif // __GNUC__ && x86
+
+static size_t simd_mask(uint8_t *dst, const uint8_t *src, size_t len, uint32_t key) {
+  size_t i = 0;
+#ifdef AVX2_ENABLED
+  if (len >= 64 && has_avx2()) i = avx2_mask(dst, src, len, key);
+#endif
+  const auto k = _mm_set1_epi32(key);
+  while (i + 16 <= len) {
+    auto v = _mm_loadu_si128((const __m128i*)(src + i));
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(v, k));
+    i += 16;
+  }
+  return i;
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+static size_t simd_mask(uint8_t *dst, const uint8_t *src, size_t len, uint32_t key) {
+  const auto k = vreinterpretq_u8_u32(vdupq_n_u32(key));
+  size_t i = 0;
+  while (i + 32 <= len) {
+    auto a = vld1q_u8(src + i);
+    auto b = vld1q_u8(src + i + 16);
+    vst1q_u8(dst + i, veorq_u8(a, k));
+    vst1q_u8(dst + i + 16, veorq_u8(b, k));
+    i += 32;
+  }
+  while (i + 16 <= len) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), k));
+    i += 16;
+  }
+  return i;
+}
+
+#else
+
+static size_t simd_mask(uint8_t *, const uint8_t *, size_t, uint32_t) { return 0; }
+
+#endif
+
+//
+// XORs len bytes with the masking key starting at key[pos & 3], where
+// dst may be the same as src, and moves pos along for the next call
+//
+
+static void mask(uint8_t *dst, const uint8_t *src, size_t len, const uint8_t key[4], uint8_t &pos) {
+  uint8_t k[8];
+  for (int i = 0; i < 8; i++) k[i] = key[(pos + i) & 3];
+  uint32_t k32; std::memcpy(&k32, k, 4);
+  uint64_t k64; std::memcpy(&k64, k, 8);
+  auto i = simd_mask(dst, src, len, k32);
+  while (i + 8 <= len) {
+    uint64_t v; std::memcpy(&v, src + i, 8);
+    v ^= k64; std::memcpy(dst + i, &v, 8);
+    i += 8;
+  }
+  while (i < len) {
+    dst[i] = src[i] ^ k[i & 3];
+    i++;
+  }
+  pos = (pos + len) & 3;
+}
+
+//
+// DeflateParams
+//
+
+static auto trim(const char *s, const char *e) -> std::string {
+  while (s < e && std::isspace(*s)) s++;
+  while (e > s && std::isspace(e[-1])) e--;
+  if (e - s >= 2 && *s == '"' && e[-1] == '"') { s++; e--; }
+  return std::string(s, e - s);
+}
+
+bool DeflateParams::parse(const std::string &extensions) {
+  enabled = false;
+
+  //
+  // Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits,
+  //                           permessage-deflate; server_no_context_takeover
+  //
+  // Takes the first valid permessage-deflate in the list, like a server
+  // accepting an offer, or a client reading the accepted one
+  //
+
+  auto p = extensions.c_str();
+  auto end = p + extensions.length();
+  while (p < end) {
+    auto q = p; while (q < end && *q != ',') q++;
+    auto e = p; while (e < q && *e != ';') e++;
+    if (trim(p, e) == "permessage-deflate") {
+      DeflateParams params;
+      params.enabled = true;
+      while (e < q) {
+        auto s = e + 1;
+        e = s; while (e < q && *e != ';') e++;
+        auto t = s; while (t < e && *t != '=') t++;
+        auto name = trim(s, t);
+        auto value = (t < e ? trim(t + 1, e) : std::string());
+        auto bits = (value.empty() ? 15 : std::atoi(value.c_str()));
+        if (name == "server_no_context_takeover") {
+          params.server_no_context_takeover = true;
+        } else if (name == "client_no_context_takeover") {
+          params.client_no_context_takeover = true;
+        } else if (name == "server_max_window_bits" && bits >= 8 && bits <= 15) {
+          params.server_max_window_bits = bits;
+        } else if (name == "client_max_window_bits" && bits >= 8 && bits <= 15) {
+          params.client_max_window_bits = bits;
+        } else if (!name.empty()) {
+          params.enabled = false;
+          break;
+        }
+      }
+      if (params.enabled) {
+        *this = params;
+        return true;
+      }
+    }
+    p = q + 1;
+  }
+  return false;
+}
+
+bool DeflateParams::set(const pjs::Value &value) {
+  *this = DeflateParams();
+  if (value.is_nullish()) return true;
+  if (value.is_boolean()) { enabled = value.b(); return true; }
+  if (value.is_string()) { parse(value.s()->str()); return true; }
+  return false;
+}
+
+//
+// Options
+//
+
+Options::Options(pjs::Object *options) {
+  Value(options, "deflate")
+    .get(deflate)
+    .get(deflate_s)
+    .get(deflate_f)
+    .check_nullable();
+}
+
 //
 // Decoder
 //
@@ -58,13 +242,20 @@ Decoder::Decoder()
 {
 }
 
+Decoder::Decoder(const Options &options)
+  : m_options(options)
+{
+}
+
 Decoder::Decoder(const Decoder &r)
-  : Decoder()
+  : Filter(r)
+  , m_options(r.m_options)
 {
 }
 
 Decoder::~Decoder()
 {
+  if (m_decompressor) m_decompressor->finalize();
 }
 
 void Decoder::dump(Dump &d) {
@@ -79,10 +270,35 @@ auto Decoder::clone() -> Filter* {
 void Decoder::reset() {
   Filter::reset();
   Deframer::reset();
+  if (m_decompressor) {
+    m_decompressor->finalize();
+    m_decompressor = nullptr;
+  }
   m_started = false;
+  m_compressed = false;
+  m_deflate_ready = false;
+  m_error = false;
 }
 
 void Decoder::process(Event *evt) {
+  if (m_error) return;
+
+  if (!m_deflate_ready) {
+    m_deflate_ready = true;
+    if (m_options.deflate_f) {
+      pjs::Value ret;
+      if (!Filter::eval(m_options.deflate_f, ret)) return;
+      if (!m_deflate.set(ret)) {
+        Filter::error("deflate did not return a boolean or a string");
+        return;
+      }
+    } else if (m_options.deflate_s) {
+      m_deflate.parse(m_options.deflate_s->str());
+    } else {
+      m_deflate.enabled = m_options.deflate;
+    }
+  }
+
   if (evt->is<StreamEnd>()) {
     output(evt);
     Deframer::reset();
@@ -149,18 +365,53 @@ auto Decoder::on_state(int state, int c) -> int {
   return state;
 }
 
+//
+// Frame headers are parsed in one go when they are all in the same chunk
+//
+
+auto Decoder::on_span(int &state, const uint8_t *ptr, size_t len) -> size_t {
+  if (state != OPCODE || len < 2) return 0;
+
+  auto has_mask = bool(ptr[1] & 0x80);
+  uint64_t size = ptr[1] & 0x7f;
+  size_t n = 2;
+  if (size == 126) n += 2; else if (size == 127) n += 8;
+  if (has_mask) n += 4;
+  if (len < n) return 0;
+
+  auto p = ptr + 2;
+  if (size == 126) {
+    size = (uint64_t(p[0]) << 8) | p[1];
+    p += 2;
+  } else if (size == 127) {
+    size = 0;
+    for (int i = 0; i < 8; i++) size = (size << 8) | p[i];
+    p += 8;
+  }
+
+  m_opcode = ptr[0];
+  m_has_mask = has_mask;
+  m_payload_size = size;
+  if (has_mask) {
+    std::memcpy(m_mask, p, 4);
+    m_mask_pointer = 0;
+  }
+
+  state = message_start();
+  return n;
+}
+
 void Decoder::on_pass(Data &data) {
+  if (m_error) return;
   if (m_has_mask) {
-    uint8_t buf[DATA_CHUNK_SIZE];
-    auto output = Data::make();
-    auto &p = m_mask_pointer;
-    for (const auto c : data.chunks()) {
-      const auto ptr = std::get<0>(c);
-      const auto len = std::get<1>(c);
-      for (auto i = 0; i < len; i++) buf[i] = ptr[i] ^ m_mask[p++ & 3];
-      s_dp.push(output, buf, len);
-    }
-    Filter::output(output);
+    data.rewrite(
+      &s_dp, [this](uint8_t *dst, const uint8_t *src, int len) {
+        mask(dst, src, len, m_mask, m_mask_pointer);
+      }
+    );
+  }
+  if (m_compressed) {
+    inflate(data);
   } else {
     Filter::output(Data::make(std::move(data)));
   }
@@ -168,9 +419,11 @@ void Decoder::on_pass(Data &data) {
 
 auto Decoder::message_start() -> State {
   if (!m_started) {
+    m_compressed = (m_deflate.enabled && (m_opcode & 0x40) && !(m_opcode & 0x08));
     auto head = MessageHead::make();
     head->opcode = int(m_opcode & 0x0f);
     head->masked = m_has_mask;
+    head->compressed = m_compressed;
     Filter::output(MessageStart::make(head));
     m_started = true;
   }
@@ -186,11 +439,42 @@ auto Decoder::message_start() -> State {
 
 void Decoder::message_end() {
   if (m_opcode & 0x80) {
+    if (m_compressed) {
+      static const uint8_t tail[] = { 0x00, 0x00, 0xff, 0xff };
+      Data data(tail, sizeof(tail), &s_dp);
+      inflate(data);
+      if (m_error) return;
+      if (m_decompressor && m_deflate.no_context_takeover(m_has_mask)) {
+        m_decompressor->finalize();
+        m_decompressor = nullptr;
+      }
+      m_compressed = false;
+    }
     Filter::output(MessageEnd::make());
     m_started = false;
   }
 }
 
+void Decoder::inflate(const Data &data) {
+  if (!m_decompressor) {
+    m_decompressor = Decompressor::inflate_raw(
+      [this](Data &data) {
+        if (!data.empty()) {
+          Filter::output(Data::make(std::move(data)));
+        }
+      }
+    );
+  }
+  if (!m_decompressor->input(data)) {
+    protocol_error();
+  }
+}
+
+void Decoder::protocol_error() {
+  m_error = true;
+  Filter::error(StreamEnd::PROTOCOL_ERROR);
+}
+
 //
 // Encoder
 //
@@ -199,13 +483,20 @@ Encoder::Encoder()
 {
 }
 
+Encoder::Encoder(const Options &options)
+  : m_options(options)
+{
+}
+
 Encoder::Encoder(const Encoder &r)
-  : Encoder()
+  : Filter(r)
+  , m_options(r.m_options)
 {
 }
 
 Encoder::~Encoder()
 {
+  if (m_compressor) m_compressor->finalize();
 }
 
 void Encoder::dump(Dump &d) {
@@ -219,24 +510,57 @@ auto Encoder::clone() -> Filter* {
 
 void Encoder::reset() {
   Filter::reset();
+  if (m_compressor) {
+    m_compressor->finalize();
+    m_compressor = nullptr;
+  }
   m_buffer.clear();
   m_start = nullptr;
+  m_compressed = false;
+  m_deflate_ready = false;
 }
 
 void Encoder::process(Event *evt) {
+  if (!m_deflate_ready) {
+    m_deflate_ready = true;
+    if (m_options.deflate_f) {
+      pjs::Value ret;
+      if (!Filter::eval(m_options.deflate_f, ret)) return;
+      if (!m_deflate.set(ret)) {
+        Filter::error("deflate did not return a boolean or a string");
+        return;
+      }
+    } else if (m_options.deflate_s) {
+      m_deflate.parse(m_options.deflate_s->str());
+    } else {
+      m_deflate.enabled = m_options.deflate;
+    }
+  }
+
   if (auto start = evt->as<MessageStart>()) {
     if (!m_start) {
       m_start = start;
       pjs::Ref<MessageHead> head = pjs::coerce<MessageHead>(start->head());
       m_opcode = head->opcode;
       m_masked = head->masked;
+      m_compressed = (m_deflate.enabled && !(m_opcode & 0x08));
       m_continuation = false;
       m_buffer.clear();
+      if (m_compressed && !m_compressor) {
+        m_compressor = Compressor::deflate_raw(
+          [this](Data &data) { m_buffer.push(data); },
+          m_deflate.max_window_bits(m_masked)
+        );
+      }
       output(evt);
     }
 
   } else if (auto data = evt->as<Data>()) {
-    m_buffer.push(*data);
+    if (m_compressed) {
+      m_compressor->input(*data, false);
+    } else {
+      m_buffer.push(*data);
+    }
     while (m_buffer.size() >= DATA_CHUNK_SIZE) {
       Data buf;
       m_buffer.shift(DATA_CHUNK_SIZE, buf);
@@ -245,8 +569,20 @@ void Encoder::process(Event *evt) {
 
   } else if (evt->is<MessageEnd>()) {
     if (m_start) {
+      if (m_compressed) {
+        // The sync flush ends in 00 00 ff ff, which goes off the wire,
+        // except that an empty message is sent as a single 00
+        m_compressor->flush();
+        m_buffer.pop(std::min(4, m_buffer.size()));
+        if (m_buffer.empty()) m_buffer.push(char(0), &s_dp);
+        if (m_deflate.no_context_takeover(m_masked)) {
+          m_compressor->finalize();
+          m_compressor = nullptr;
+        }
+      }
       frame(m_buffer, true);
       m_buffer.clear();
+      m_compressed = false;
       m_continuation = false;
       m_start = nullptr;
       if (m_shutdown) {
@@ -261,13 +597,13 @@ void Encoder::process(Event *evt) {
   }
 }
 
-void Encoder::frame(const Data &data, bool final) {
+void Encoder::frame(Data &data, bool final) {
   int p = 0;
-  uint8_t head[12];
+  uint8_t head[14];
   if (m_continuation) {
     head[p++] = (final ? 0x80 : 0);
   } else {
-    head[p++] = (m_opcode & 0x0f) | (final ? 0x80 : 0);
+    head[p++] = (m_opcode & 0x0f) | (final ? 0x80 : 0) | (m_compressed ? 0x40 : 0);
     m_continuation = true;
   }
 
@@ -304,18 +640,15 @@ void Encoder::frame(const Data &data, bool final) {
   s_dp.push(out, head, p);
 
   if (m_masked) {
-    uint8_t buf[DATA_CHUNK_SIZE], p = 0;
-    for (const auto c : data.chunks()) {
-      auto ptr = std::get<0>(c);
-      auto len = std::get<1>(c);
-      for (int i = 0; i < len; i++) buf[i] = ptr[i] ^ mask[p++ & 3];
-      s_dp.push(out, buf, len);
-    }
-
-  } else {
-    out->push(data);
+    uint8_t pos = 0;
+    data.rewrite(
+      &s_dp, [&](uint8_t *dst, const uint8_t *src, int len) {
+        websocket::mask(dst, src, len, mask, pos);
+      }
+    );
   }
 
+  out->push(data);
   output(out);
 }
 
@@ -329,6 +662,7 @@ using namespace pipy::websocket;
 template<> void ClassDef<MessageHead>::init() {
   field<int>("opcode", [](MessageHead *obj) { return &obj->opcode; });
   field<bool>("masked", [](MessageHead *obj) { return &obj->masked; });
+  field<bool>("compressed", [](MessageHead *obj) { return &obj->compressed; });
 }
 
 } // namespace pjs
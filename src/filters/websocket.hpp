@@ -28,10 +28,15 @@
 
 #include "filter.hpp"
 #include "deframer.hpp"
+#include "options.hpp"
 
 #include <random>
 
 namespace pipy {
+
+class Compressor;
+class Decompressor;
+
 namespace websocket {
 
 //
@@ -42,6 +47,38 @@ class MessageHead : public pjs::ObjectTemplate<MessageHead> {
 public:
   int opcode = 1;
   bool masked = false;
+  bool compressed = false;
+};
+
+//
+// DeflateParams
+//
+
+struct DeflateParams {
+  bool enabled = false;
+  bool server_no_context_takeover = false;
+  bool client_no_context_takeover = false;
+  int server_max_window_bits = 15;
+  int client_max_window_bits = 15;
+
+  bool parse(const std::string &extensions);
+  bool set(const pjs::Value &value);
+
+  // Parameters applying to the compressor on the client or the server side
+  bool no_context_takeover(bool client) const { return client ? client_no_context_takeover : server_no_context_takeover; }
+  int max_window_bits(bool client) const { return client ? client_max_window_bits : server_max_window_bits; }
+};
+
+//
+// Options
+//
+
+struct Options : public pipy::Options {
+  bool deflate = false;
+  pjs::Ref<pjs::Str> deflate_s;
+  pjs::Ref<pjs::Function> deflate_f;
+  Options() {}
+  Options(pjs::Object *options);
 };
 
 //
@@ -51,6 +88,7 @@ public:
 class Decoder : public Filter, public Deframer {
 public:
   Decoder();
+  Decoder(const Options &options);
 
 private:
   Decoder(const Decoder &r);
@@ -71,6 +109,9 @@ private:
     PAYLOAD,
   };
 
+  Options m_options;
+  DeflateParams m_deflate;
+  Decompressor* m_decompressor = nullptr;
   uint8_t m_opcode;
   uint8_t m_buffer[8];
   uint64_t m_payload_size;
@@ -78,12 +119,18 @@ private:
   uint8_t m_mask_pointer;
   bool m_has_mask;
   bool m_started;
+  bool m_compressed = false;
+  bool m_deflate_ready = false;
+  bool m_error = false;
 
   virtual auto on_state(int state, int c) -> int override;
+  virtual auto on_span(int &state, const uint8_t *ptr, size_t len) -> size_t override;
   virtual void on_pass(Data &data) override;
 
   auto message_start() -> State;
   void message_end();
+  void inflate(const Data &data);
+  void protocol_error();
 };
 
 //
@@ -93,6 +140,7 @@ private:
 class Encoder : public Filter {
 public:
   Encoder();
+  Encoder(const Options &options);
 
 private:
   Encoder(const Encoder &r);
@@ -104,15 +152,20 @@ private:
   virtual void dump(Dump &d) override;
 
 private:
+  Options m_options;
+  DeflateParams m_deflate;
+  Compressor* m_compressor = nullptr;
   Data m_buffer;
   pjs::Ref<MessageStart> m_start;
   std::minstd_rand m_rand;
   uint8_t m_opcode;
   bool m_masked;
+  bool m_compressed = false;
   bool m_continuation;
   bool m_shutdown = false;
+  bool m_deflate_ready = false;
 
-  void frame(const Data &data, bool final);
+  void frame(Data &data, bool final);
 };
 
 } // namespace websocket
@@ -27,6 +27,7 @@
 #include "listener.hpp"
 #include "pipeline.hpp"
 #include "worker.hpp"
+#include "worker-thread.hpp"
 #include "constants.hpp"
 #include "log.hpp"
 
@@ -52,6 +53,8 @@ std::atomic<uint64_t> Inbound::s_inbound_id;
 thread_local pjs::Ref<stats::Gauge> Inbound::s_metric_concurrency;
 thread_local pjs::Ref<stats::Counter> Inbound::s_metric_traffic_in;
 thread_local pjs::Ref<stats::Counter> Inbound::s_metric_traffic_out;
+thread_local pjs::Ref<stats::Counter> Inbound::s_metric_accepted;
+thread_local pjs::Ref<pjs::Str> Inbound::s_thread_label;
 
 auto Inbound::count() -> int {
   int n = 0;
@@ -106,6 +109,31 @@ auto Inbound::remote_address() -> pjs::Str* {
   return m_str_remote_addr;
 }
 
+//
+// Writes out the remote address in binary without formatting it to text.
+// Returns 4 or 6 for the IP version, or 0 if the address is unknown.
+// IPv4-mapped IPv6 addresses are given as IPv4.
+//
+
+auto Inbound::remote_ip(uint8_t *bytes) -> int {
+  address();
+  auto ip = m_remote_ip;
+  if (ip.is_v6() && ip.to_v6().is_v4_mapped()) {
+    ip = asio::ip::make_address_v4(asio::ip::v4_mapped, ip.to_v6());
+  }
+  if (ip.is_unspecified()) {
+    return 0;
+  } else if (ip.is_v4()) {
+    auto b = ip.to_v4().to_bytes();
+    std::memcpy(bytes, b.data(), b.size());
+    return 4;
+  } else {
+    auto b = ip.to_v6().to_bytes();
+    std::memcpy(bytes, b.data(), b.size());
+    return 6;
+  }
+}
+
 auto Inbound::ori_dst_address() -> pjs::Str* {
   if (!m_str_ori_dst_addr) {
     address();
@@ -134,6 +162,9 @@ void Inbound::start() {
     m_metric_traffic_in = Inbound::s_metric_traffic_in->with_labels(labels, n);
     m_metric_traffic_out = Inbound::s_metric_traffic_out->with_labels(labels, n);
 
+    labels[1] = s_thread_label;
+    s_metric_accepted->with_labels(labels, 2)->increase();
+
     pjs::Value arg(InboundWrapper::make(this));
     p->start(1, &arg);
   }
@@ -236,6 +267,19 @@ void Inbound::init_metrics() {
         });
       }
     );
+
+    pjs::Ref<pjs::Array> accepted_label_names = pjs::Array::make();
+    accepted_label_names->length(2);
+    accepted_label_names->set(0, "listen");
+    accepted_label_names->set(1, "thread");
+
+    s_metric_accepted = stats::Counter::make(
+      pjs::Str::make("pipy_inbound_accepted"),
+      accepted_label_names
+    );
+
+    auto wt = WorkerThread::current();
+    s_thread_label = pjs::Str::make(std::to_string(wt ? wt->index() : 0));
   }
 }
 
@@ -309,10 +353,19 @@ void InboundTCP::on_get_address() {
     m_local_port = ep.port();
   }
 
-  m_remote_addr = m_peer.address().to_string();
+  m_remote_ip = m_peer.address();
+  m_remote_addr = m_remote_ip.to_string();
   m_remote_port = m_peer.port();
 
 #ifdef __linux__
+  if (s.is_open()) {
+    int cpu;
+    socklen_t len = sizeof(cpu);
+    if (!getsockopt(s.native_handle(), SOL_SOCKET, SO_INCOMING_CPU, &cpu, &len)) {
+      m_incoming_cpu = cpu;
+    }
+  }
+
   if (Inbound::m_options.transparent && s.is_open()) {
     struct sockaddr addr;
     socklen_t len = sizeof(addr);
@@ -402,7 +455,8 @@ void InboundUDP::on_get_address() {
     const auto &peer = SocketUDP::Peer::peer();
     m_local_addr = local.address().to_string();
     m_local_port = local.port();
-    m_remote_addr = peer.address().to_string();
+    m_remote_ip = peer.address();
+    m_remote_addr = m_remote_ip.to_string();
     m_remote_port = peer.port();
   }
 }
@@ -439,6 +493,7 @@ template<> void ClassDef<Inbound>::init() {
   accessor("remotePort"         , [](Object *obj, Value &ret) { ret.set(obj->as<Inbound>()->remote_port()); });
   accessor("destinationAddress" , [](Object *obj, Value &ret) { ret.set(obj->as<Inbound>()->ori_dst_address()); });
   accessor("destinationPort"    , [](Object *obj, Value &ret) { ret.set(obj->as<Inbound>()->ori_dst_port()); });
+  accessor("incomingCPU"        , [](Object *obj, Value &ret) { ret.set(obj->as<Inbound>()->incoming_cpu()); });
   accessor("socket"             , [](Object *obj, Value &ret) { ret.set(obj->as<Inbound>()->get_socket()); });
 }
 
@@ -458,6 +513,7 @@ template<> void ClassDef<InboundWrapper>::init() {
   accessor("remotePort"         , [](Object *obj, Value &ret) { if (auto i = obj->as<InboundWrapper>()->get()) ret.set(i->remote_port()); });
   accessor("destinationAddress" , [](Object *obj, Value &ret) { if (auto i = obj->as<InboundWrapper>()->get()) ret.set(i->ori_dst_address()); });
   accessor("destinationPort"    , [](Object *obj, Value &ret) { if (auto i = obj->as<InboundWrapper>()->get()) ret.set(i->ori_dst_port()); });
+  accessor("incomingCPU"        , [](Object *obj, Value &ret) { if (auto i = obj->as<InboundWrapper>()->get()) ret.set(i->incoming_cpu()); });
   accessor("socket"             , [](Object *obj, Value &ret) { if (auto i = obj->as<InboundWrapper>()->get()) ret.set(i->get_socket()); });
 }
 
@@ -66,8 +66,10 @@ public:
   auto local_port() -> int { address(); return m_local_port; }
   auto remote_address() -> pjs::Str*;
   auto remote_port() -> int { address(); return m_remote_port; }
+  auto remote_ip(uint8_t *bytes) -> int;
   auto ori_dst_address() -> pjs::Str*;
   auto ori_dst_port() -> int { address(); return m_ori_dst_port; }
+  auto incoming_cpu() -> int { address(); return m_incoming_cpu; }
   bool is_receiving() const { return m_receiving_state == RECEIVING; }
 
   virtual auto get_socket() -> Socket* = 0;
@@ -92,9 +94,11 @@ protected:
   std::string m_local_addr;
   std::string m_remote_addr;
   std::string m_ori_dst_addr;
+  asio::ip::address m_remote_ip;
   int m_local_port = 0;
   int m_remote_port = 0;
   int m_ori_dst_port = 0;
+  int m_incoming_cpu = -1;
   ReceivingState m_receiving_state = RECEIVING;
   pjs::Ref<EventTarget::Input> m_input;
 
@@ -108,6 +112,8 @@ protected:
   thread_local static pjs::Ref<stats::Gauge> s_metric_concurrency;
   thread_local static pjs::Ref<stats::Counter> s_metric_traffic_in;
   thread_local static pjs::Ref<stats::Counter> s_metric_traffic_out;
+  thread_local static pjs::Ref<stats::Counter> s_metric_accepted;
+  thread_local static pjs::Ref<pjs::Str> s_thread_label;
 
   pjs::Ref<stats::Counter> m_metric_traffic_in;
   pjs::Ref<stats::Counter> m_metric_traffic_out;
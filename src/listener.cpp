@@ -29,6 +29,10 @@
 #include "worker-thread.hpp"
 #include "log.hpp"
 
+#ifdef __linux__
+#include <linux/filter.h>
+#endif // __linux__
+
 namespace pipy {
 
 //
@@ -144,9 +148,11 @@ Listener::Options::Options(pjs::Object *options) {
 
 thread_local std::set<Listener*> Listener::s_listeners;
 bool Listener::s_reuse_port = false;
+bool Listener::s_reuse_port_by_cpu = false;
 
-void Listener::set_reuse_port(bool reuse) {
+void Listener::set_reuse_port(bool reuse, bool by_cpu) {
   s_reuse_port = reuse;
+  s_reuse_port_by_cpu = reuse && by_cpu;
 }
 
 void Listener::commit_all() {
@@ -438,6 +444,57 @@ void Listener::set_sock_opts(int sock) {
   }
 }
 
+//
+// Steers each new connection or datagram to the socket of the worker
+// pinned to the CPU that received it, or to socket CPU % N when workers
+// are not pinned. CPUs with no worker pinned there get an index out of
+// range, which makes the kernel fall back to its own hashing.
+//
+// Worker N owns socket N of the reuseport group only because workers
+// open their listening sockets in the order they start. The kernel
+// numbers sockets by when they join the group and fills the hole of a
+// closed socket with the last one, so the mapping only holds for ports
+// opened by all workers at startup. Ports opened or reopened later, by
+// a reload for example, still get every connection accepted, just not
+// necessarily by the worker on the receiving CPU.
+//
+
+void Listener::set_sock_steering(int sock) {
+#ifdef __linux__
+  if (s_reuse_port_by_cpu) {
+    auto &wm = WorkerManager::get();
+    auto &cpus = wm.cpus();
+    auto n = wm.concurrency();
+    if (n <= 1) return;
+
+    std::vector<sock_filter> code;
+    code.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, uint32_t(SKF_AD_OFF + SKF_AD_CPU)));
+    if (cpus.empty()) {
+      code.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, uint32_t(n)));
+      code.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+    } else {
+      std::set<int> mapped;
+      for (int i = 0; i < n; i++) {
+        auto cpu = cpus[i % cpus.size()];
+        if (!mapped.insert(cpu).second) continue;
+        code.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, uint32_t(cpu), 0, 1));
+        code.push_back(BPF_STMT(BPF_RET | BPF_K, uint32_t(i)));
+      }
+      code.push_back(BPF_STMT(BPF_RET | BPF_K, 0xffffffff));
+    }
+
+    sock_fprog prog;
+    prog.len = code.size();
+    prog.filter = code.data();
+    if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog))) {
+      char desc[200];
+      describe(desc, sizeof(desc));
+      Log::warn("[listener] Cannot attach CPU steering program to %s", desc);
+    }
+  }
+#endif // __linux__
+}
+
 auto Listener::find(Port::Protocol protocol, const std::string &ip, int port) -> Listener* {
   for (auto *l : s_listeners) {
     if (l->protocol() == protocol && l->ip() == ip && l->port() == port) {
@@ -469,6 +526,8 @@ void Listener::AcceptorTCP::start(const asio::ip::tcp::endpoint &endpoint) {
 
   m_acceptor.bind(endpoint);
   m_acceptor.listen(asio::socket_base::max_connections);
+
+  m_listener->set_sock_steering(m_acceptor.native_handle());
 }
 
 void Listener::AcceptorTCP::accept() {
@@ -518,6 +577,8 @@ void Listener::AcceptorUDP::start(const asio::ip::udp::endpoint &endpoint) {
   m_listener->set_sock_opts(s.native_handle());
 
   s.bind(endpoint);
+  m_listener->set_sock_steering(s.native_handle());
+
   const auto &ep = s.local_endpoint();
   m_local_addr = ep.address().to_string();
   m_local_port = ep.port();
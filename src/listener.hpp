@@ -109,7 +109,7 @@ public:
     Options(pjs::Object *options);
   };
 
-  static void set_reuse_port(bool reuse);
+  static void set_reuse_port(bool reuse, bool by_cpu = false);
 
   static auto get(Port::Protocol protocol, const std::string &ip, int port) -> Listener* {
     if (auto *l = find(protocol, ip, port)) return l;
@@ -230,6 +230,7 @@ private:
   void print_state(const char *msg);
   void describe(char *buf, size_t len);
   void set_sock_opts(int sock);
+  void set_sock_steering(int sock);
 
   Net& m_net;
   Options m_options;
@@ -249,6 +250,7 @@ private:
 
   thread_local static std::set<Listener*> s_listeners;
   static bool s_reuse_port;
+  static bool s_reuse_port_by_cpu;
 
   static auto find(Port::Protocol protocol, const std::string &ip, int port) -> Listener*;
 
@@ -66,6 +66,8 @@ void MainOptions::show_help() {
   std::cout << "  --, -args, --args                    Indicate the end of Pipy options and the start of script arguments" << std::endl;
   std::cout << "  --pipy-options                       Indicate the beginning of Pipy options while processing script arguments" << std::endl;
   std::cout << "  --threads=<number>                   Number of worker threads (1, 2, ... max)" << std::endl;
+  std::cout << "  --worker-cpus=<cpu-list>             Pin worker threads to CPUs in a list like 0-3,8 (one CPU per thread)" << std::endl;
+  std::cout << "  --main-cpus=<cpu-list>               Pin the main thread running administration service to CPUs in a list" << std::endl;
   std::cout << "  --log-file=<filename>                Set the pathname of the log file" << std::endl;
   std::cout << "  --log-level=<debug|info|warn|error>  Set the level of log output" << std::endl;
   std::cout << "  --log-history-limit=<size>           Set size limit of log history in bytes" << std::endl;
@@ -76,12 +78,15 @@ void MainOptions::show_help() {
   std::cout << "  --no-status                          Do not report current status to the repo" << std::endl;
   std::cout << "  --no-metrics                         Do not report metrics to the repo" << std::endl;
   std::cout << "  --trace-objects                      Enable tracing the locations of object construction" << std::endl;
+  std::cout << "  --filter-metrics[=<n>]               Report time and traffic of every filter, timing 1 in n events (default 16)" << std::endl;
+  std::cout << "  --no-filter-fusion                   Do not fuse adjacent handleXXX() and replaceXXX() filters" << std::endl;
+  std::cout << "  --no-bytecode                        Do not compile PipyJS expressions to bytecode" << std::endl;
   std::cout << "  --force-start                        Force to start even at failure of address/port binding" << std::endl;
   std::cout << "  --init-repo=<dirname>                Populate the repo with codebases under the specified directory" << std::endl;
   std::cout << "  --init-code=<codebase>               Start running the specified codebase after repo initialization" << std::endl;
   std::cout << "  --instance-uuid=<uuid>               Specify a UUID for this worker process" << std::endl;
   std::cout << "  --instance-name=<name>               Specify a name for this worker process" << std::endl;
-  std::cout << "  --reuse-port                         Enable kernel load balancing for all listening ports" << std::endl;
+  std::cout << "  --reuse-port[=cpu]                   Enable kernel load balancing for all listening ports (by receiving CPU for ports opened at startup)" << std::endl;
   std::cout << "  --admin-port=<[[ip]:]port>           Enable administration service on the specified port" << std::endl;
   std::cout << "  --admin-port-off                     Do not start administration service at startup" << std::endl;
   std::cout << "  --admin-gui=<dirname>                Specify the location of administration GUI front-end files" << std::endl;
@@ -253,6 +258,18 @@ void MainOptions::parse(const std::list<std::string> &args) {
         no_metrics = true;
       } else if (k == "--trace-objects") {
         trace_objects = true;
+      } else if (k == "--filter-metrics") {
+        if (v.empty()) {
+          filter_metrics = 16;
+        } else {
+          char *end;
+          filter_metrics = std::strtol(v.c_str(), &end, 10);
+          if (*end || filter_metrics <= 0) throw std::runtime_error("--filter-metrics expects a positive number");
+        }
+      } else if (k == "--no-filter-fusion") {
+        no_filter_fusion = true;
+      } else if (k == "--no-bytecode") {
+        no_bytecode = true;
       } else if (k == "--force-start") {
         force_start = true;
       } else if (k == "--init-repo") {
@@ -263,8 +280,14 @@ void MainOptions::parse(const std::list<std::string> &args) {
         instance_uuid = v;
       } else if (k == "--instance-name") {
         instance_name = v;
+      } else if (k == "--worker-cpus") {
+        if (!utils::get_cpu_list(v, worker_cpus)) throw std::runtime_error("invalid CPU list: " + v);
+      } else if (k == "--main-cpus") {
+        if (!utils::get_cpu_list(v, main_cpus)) throw std::runtime_error("invalid CPU list: " + v);
       } else if (k == "--reuse-port") {
         reuse_port = true;
+        if (v == "cpu") reuse_port_by_cpu = true;
+        else if (!v.empty()) throw std::runtime_error("unknown load balancing mode: " + v);
       } else if (k == "--admin-port-off") {
         admin_port_off = true;
       } else if (k == "--admin-port") {
@@ -343,6 +366,8 @@ auto MainOptions::to_string() -> std::string {
   std::string str;
 
   if (threads > 1) list.push_back("--threads=" + std::to_string(threads));
+  if (!worker_cpus.empty()) list.push_back("--worker-cpus=" + utils::make_cpu_list(worker_cpus));
+  if (!main_cpus.empty()) list.push_back("--main-cpus=" + utils::make_cpu_list(main_cpus));
   if (!log_file.empty()) list.push_back("--log-file=" + log_file);
   switch (log_level) {
     case Log::DEBUG: {
@@ -381,12 +406,15 @@ auto MainOptions::to_string() -> std::string {
   if (no_status) list.push_back("--no-status");
   if (no_metrics) list.push_back("--no-metrics");
   if (trace_objects) list.push_back("--trace-objects");
+  if (filter_metrics > 0) list.push_back("--filter-metrics=" + std::to_string(filter_metrics));
+  if (no_filter_fusion) list.push_back("--no-filter-fusion");
+  if (no_bytecode) list.push_back("--no-bytecode");
   if (force_start) list.push_back("--force-start");
   if (!init_repo.empty()) list.push_back("--init-repo=" + init_repo);
   if (!init_code.empty()) list.push_back("--init-code=" + init_code);
   if (!instance_uuid.empty()) list.push_back("--instance-uuid" + instance_uuid);
   if (!instance_name.empty()) list.push_back("--instance-name" + instance_name);
-  if (reuse_port) list.push_back("--reuse-port");
+  if (reuse_port) list.push_back(reuse_port_by_cpu ? "--reuse-port=cpu" : "--reuse-port");
   if (admin_port_off) list.push_back("--admin-port-off");
   if (!admin_port.empty()) list.push_back("--admin-port=" + admin_port);
   if (!admin_gui.empty()) list.push_back("--admin-gui=" + admin_gui);
@@ -56,9 +56,15 @@ public:
   bool        no_status = false;
   bool        no_metrics = false;
   bool        trace_objects = false;
+  bool        no_filter_fusion = false;
+  bool        no_bytecode = false;
   bool        force_start = false;
   bool        reuse_port = false;
+  bool        reuse_port_by_cpu = false;
+  int         filter_metrics = 0;
   int         threads = 1;
+  std::vector<int> worker_cpus;
+  std::vector<int> main_cpus;
   std::string log_file;
   Log::Level  log_level = Log::INFO;
   Log::Output log_local = Log::OUTPUT_STDERR;
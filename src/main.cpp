@@ -34,6 +34,8 @@
 #include "api/stats.hpp"
 #include "codebase.hpp"
 #include "fs.hpp"
+#include "filter.hpp"
+#include "filters/fused.hpp"
 #include "filters/tls.hpp"
 #include "input.hpp"
 #include "listener.hpp"
@@ -105,9 +107,9 @@ static void show_version() {
 static void reload_codebase(bool force) {
   if (auto *codebase = Codebase::current()) {
     codebase->sync(
-      force, [](bool ok) {
+      force, [=](bool ok) {
         if (ok) {
-          WorkerManager::get().reload();
+          WorkerManager::get().reload(force);
         }
       }
     );
@@ -429,8 +431,15 @@ int pipy_main(int argc, char *argv[]) {
     Log::set_local_only(opts.log_local_only);
     Log::init();
     logging::Logger::set_history_size(opts.log_history_limit);
-    Listener::set_reuse_port(opts.reuse_port);
+    Listener::set_reuse_port(opts.reuse_port, opts.reuse_port_by_cpu);
+
+    if (!opts.main_cpus.empty() && !os::set_thread_affinity(opts.main_cpus)) {
+      Log::warn("[main] Could not pin the main thread to CPUs %s", utils::make_cpu_list(opts.main_cpus).c_str());
+    }
     pjs::Class::set_tracing(opts.trace_objects);
+    if (opts.filter_metrics > 0) Filter::set_metrics(opts.filter_metrics);
+    if (opts.no_filter_fusion) Fused::set_enabled(false);
+    if (opts.no_bytecode) pjs::Bytecode::set_enabled(false);
     pjs::Math::init();
     crypto::Crypto::init(opts.openssl_engine);
     tls::TLSSession::init();
@@ -598,6 +607,7 @@ int pipy_main(int argc, char *argv[]) {
 
             auto &wm = WorkerManager::get();
             wm.argv(opts.arguments);
+            wm.cpus(opts.worker_cpus);
             wm.enable_graph(!opts.no_graph);
 
             if ((is_repo || is_remote) && !opts.no_reload) {
@@ -56,13 +56,7 @@ bool Message::to_events(pjs::Object *obj, const std::function<bool(Event*)> &cb)
   } else if (obj->is_instance_of<Event>()) {
     return cb(obj->as<Event>());
   } else if (obj->is_instance_of<Message>()) {
-    auto msg = obj->as<Message>();
-    pjs::Ref<MessageStart> start(MessageStart::make(msg->head()));
-    pjs::Ref<MessageEnd> end(MessageEnd::make(msg->tail(), msg->payload()));
-    if (!cb(start)) return false;
-    if (auto body = msg->body()) if (!cb(body)) return false;
-    if (!cb(end)) return false;
-    return true;
+    return obj->as<Message>()->to_events(cb);
   } else if (obj->is_array()) {
     auto *a = obj->as<pjs::Array>();
     bool ret = true;
@@ -73,12 +67,7 @@ bool Message::to_events(pjs::Object *obj, const std::function<bool(Event*)> &cb)
         if (!cb(v.as<Event>())) return (ret = false);
         return true;
       } else if (v.is_instance_of(pjs::class_of<Message>())) {
-        auto msg = obj->as<Message>();
-        pjs::Ref<MessageStart> start(MessageStart::make(msg->head()));
-        pjs::Ref<MessageEnd> end(MessageEnd::make(msg->tail(), msg->payload()));
-        if (!cb(start)) return (ret = false);
-        if (auto body = msg->body()) if (!cb(body)) return (ret = false);
-        if (!cb(end)) return (ret = false);
+        if (!v.as<Message>()->to_events(cb)) return (ret = false);
         return true;
       } else {
         return (ret = false);
@@ -142,10 +131,33 @@ bool Message::output(pjs::Object *events, EventTarget::Input *input) {
   }
 }
 
+auto Message::freeze() -> Message* {
+  if (!m_start) {
+    m_start = MessageStart::make(m_head, true);
+    m_end = MessageEnd::make(m_tail, m_payload);
+  }
+  return this;
+}
+
+bool Message::to_events(const std::function<bool(Event*)> &cb) {
+  pjs::Ref<MessageStart> start(m_start ? m_start.get() : MessageStart::make(m_head));
+  pjs::Ref<MessageEnd> end(m_end ? m_end.get() : MessageEnd::make(m_tail, m_payload));
+  if (!cb(start)) return false;
+  if (m_body) if (!cb(m_body)) return false;
+  if (!cb(end)) return false;
+  return true;
+}
+
 void Message::write(EventTarget::Input *input) {
-  input->input(MessageStart::make(m_head));
-  if (m_body && !m_body->empty()) input->input(m_body);
-  input->input(MessageEnd::make(m_tail, m_payload));
+  if (m_start) {
+    input->input(m_start);
+    if (m_body && !m_body->empty()) input->input(m_body);
+    input->input(m_end);
+  } else {
+    input->input(MessageStart::make(m_head));
+    if (m_body && !m_body->empty()) input->input(m_body);
+    input->input(MessageEnd::make(m_tail, m_payload));
+  }
 }
 
 //
@@ -244,6 +256,10 @@ template<> void ClassDef<pipy::Message>::init() {
   accessor("tail", [](Object *obj, Value &ret) { ret.set(obj->as<pipy::Message>()->tail()); });
   accessor("body", [](Object *obj, Value &ret) { ret.set(obj->as<pipy::Message>()->body()); });
   accessor("payload", [](Object *obj, Value &ret) { ret = obj->as<pipy::Message>()->payload(); });
+
+  method("freeze", [](Context &ctx, Object *obj, Value &ret) {
+    ret.set(obj->as<pipy::Message>()->freeze());
+  });
 }
 
 template<> void ClassDef<Constructor<pipy::Message>>::init() {
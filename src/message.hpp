@@ -57,11 +57,16 @@ public:
   auto tail() const -> pjs::Object* { return m_tail; }
   auto body() const -> Data* { return m_body; }
   auto payload() const -> const pjs::Value& { return m_payload; }
+  bool is_frozen() const { return m_start; }
 
   auto clone() const -> Message* {
-    return Message::make(m_head, m_body, m_tail, m_payload);
+    auto msg = Message::make(m_head, m_body, m_tail, m_payload);
+    msg->m_start = m_start;
+    msg->m_end = m_end;
+    return msg;
   }
 
+  auto freeze() -> Message*;
   void write(EventTarget::Input *input);
 
 private:
@@ -109,8 +114,12 @@ private:
   pjs::Ref<pjs::Object> m_tail;
   pjs::Ref<Data> m_body;
   pjs::Value m_payload;
+  pjs::Ref<MessageStart> m_start;
+  pjs::Ref<MessageEnd> m_end;
   bool m_in_buffer = false;
 
+  bool to_events(const std::function<bool(Event*)> &cb);
+
   static Data::Producer s_dp;
 
   friend class pjs::ObjectTemplate<Message>;
@@ -35,6 +35,19 @@
 #include <io.h>
 #include <vector>
 
+#else // !_WIN32
+
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif // __linux__
+
 #endif // _WIN32
 
 namespace pipy {
@@ -270,6 +283,26 @@ void kill(int pid, int sig) {
   // TODO
 }
 
+bool set_thread_affinity(const std::vector<int> &cpus) {
+  DWORD_PTR mask = 0;
+  for (auto i : cpus) {
+    if (i < 8 * sizeof(mask)) mask |= DWORD_PTR(1) << i;
+  }
+  if (!mask) return false;
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
+bool set_thread_local_memory() {
+  return false;
+}
+
+void get_thread_stats(ThreadStats &stats) {
+  stats.cpu = GetCurrentProcessorNumber();
+  stats.migrations = 0;
+  stats.switches = 0;
+  stats.affinity.clear();
+}
+
 auto FileHandle::std_input() -> FileHandle {
   if (!s_stdin_server) {
     char name[256];
@@ -456,6 +489,67 @@ void kill(int pid, int sig) {
   ::kill(pid, sig);
 }
 
+#ifdef __linux__
+
+bool set_thread_affinity(const std::vector<int> &cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto i : cpus) {
+    if (i < CPU_SETSIZE) CPU_SET(i, &set);
+  }
+  if (!CPU_COUNT(&set)) return false;
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool set_thread_local_memory() {
+  // Allocate on the node of the CPU that faults the page in,
+  // overriding any interleaving policy inherited from the process
+  return syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0) == 0;
+}
+
+void get_thread_stats(ThreadStats &stats) {
+  stats.cpu = sched_getcpu();
+
+  struct rusage ru;
+  if (!getrusage(RUSAGE_THREAD, &ru)) {
+    stats.switches = ru.ru_nivcsw;
+  }
+
+  // Only available with CONFIG_SCHED_DEBUG
+  std::ifstream fs("/proc/thread-self/sched");
+  std::string line;
+  while (std::getline(fs, line)) {
+    if (line.compare(0, 16, "se.nr_migrations") == 0) {
+      auto p = line.find(':');
+      if (p != std::string::npos) stats.migrations = std::strtoull(line.c_str() + p + 1, nullptr, 10);
+      break;
+    }
+  }
+
+  cpu_set_t set;
+  stats.affinity.clear();
+  if (!pthread_getaffinity_np(pthread_self(), sizeof(set), &set)) {
+    for (int i = 0; i < CPU_SETSIZE; i++) {
+      if (CPU_ISSET(i, &set)) stats.affinity.push_back(i);
+    }
+  }
+}
+
+#else // !__linux__
+
+bool set_thread_affinity(const std::vector<int> &cpus) {
+  return false;
+}
+
+bool set_thread_local_memory() {
+  return false;
+}
+
+void get_thread_stats(ThreadStats &stats) {
+}
+
+#endif // __linux__
+
 FileHandle::FileHandle(int fd, const char *mode) {
   m_file = fdopen(fd, mode);
 }
@@ -28,14 +28,39 @@
 
 #include "net.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace pipy {
 namespace os {
 
+struct ThreadStats {
+  int cpu = -1;
+  uint64_t migrations = 0;
+  uint64_t switches = 0;
+  std::vector<int> affinity;
+};
+
 void init();
 void cleanup();
 auto process_id() -> int;
 void kill(int pid, int sig = 0);
 
+//
+// Restricts the calling thread to the given CPUs
+//
+
+bool set_thread_affinity(const std::vector<int> &cpus);
+
+//
+// Makes the memory policy of the calling thread prefer the local NUMA
+// node, so that pages first touched by the thread (its pools, slabs and
+// buffers) stay local
+//
+
+bool set_thread_local_memory();
+void get_thread_stats(ThreadStats &stats);
+
 } // namespace os
 } // namespace pipy
 
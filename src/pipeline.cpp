@@ -25,6 +25,7 @@
 
 #include "pipeline.hpp"
 #include "filter.hpp"
+#include "filters/fused.hpp"
 #include "context.hpp"
 #include "message.hpp"
 #include "worker.hpp"
@@ -72,6 +73,16 @@ void PipelineLayout::bind() {
   for (const auto &f : m_filters) {
     f->bind();
   }
+  compile();
+}
+
+void PipelineLayout::compile() {
+  if (m_allocated > 0 || !Fused::enabled()) return;
+  Fused::compile(
+    m_filters, [this](Filter *f) {
+      f->m_pipeline_layout = this;
+    }
+  );
 }
 
 void PipelineLayout::shutdown() {
@@ -102,6 +113,19 @@ auto PipelineLayout::append(Filter *filter) -> Filter* {
   return filter;
 }
 
+auto PipelineLayout::filter(int i) const -> Filter* {
+  for (const auto &f : m_filters) {
+    if (!i--) return f.get();
+  }
+  return nullptr;
+}
+
+void PipelineLayout::for_each_filter(const std::function<void(Filter*)> &callback) const {
+  for (const auto &f : m_filters) {
+    callback(f.get());
+  }
+}
+
 auto PipelineLayout::alloc(Context *ctx) -> Pipeline* {
   retain();
   Pipeline *pipeline = nullptr;
@@ -165,10 +189,12 @@ Pipeline::Pipeline(PipelineLayout *layout)
   : m_layout(layout)
 {
   const auto &filters = layout->m_filters;
+  int index = 0;
   for (const auto &f : filters) {
     auto filter = f->clone();
     filter->m_pipeline_layout = layout;
     filter->m_pipeline = this;
+    filter->m_index = index++;
     m_filters.push(filter);
   }
   if (auto f = m_filters.head()) {
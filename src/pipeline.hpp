@@ -110,7 +110,10 @@ public:
   void on_start(pjs::Object *e) { m_on_start = e; }
   void on_end(pjs::Function *f) { m_on_end = f; }
   auto append(Filter *filter) -> Filter*;
+  auto filter(int i) const -> Filter*;
+  void for_each_filter(const std::function<void(Filter*)> &callback) const;
   void bind();
+  void compile();
   void shutdown();
 
   auto new_context() -> Context*;
@@ -0,0 +1,421 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bytecode.hpp"
+#include "expr.hpp"
+
+#include <limits>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PJS_BYTECODE_COMPUTED_GOTO
+#endif
+
+namespace pjs {
+
+//
+// Bytecode::Compiler
+//
+
+auto Bytecode::Compiler::reg() -> int {
+  if (m_top > std::numeric_limits<uint8_t>::max()) {
+    m_failed = true;
+    return 0;
+  }
+  auto r = m_top++;
+  if (m_top > m_code->m_registers) m_code->m_registers = m_top;
+  return r;
+}
+
+auto Bytecode::Compiler::emit(Op op, int a, int b, int c, int x, int y) -> int {
+  auto i = label();
+  if (b > std::numeric_limits<uint8_t>::max() || c > std::numeric_limits<uint8_t>::max()) {
+    m_failed = true;
+  }
+  Instruction inst;
+  inst.op = op;
+  inst.a = a;
+  inst.b = b;
+  inst.c = c;
+  inst.x = index(x);
+  inst.y = index(y);
+  m_code->m_code.push_back(inst);
+  return i;
+}
+
+void Bytecode::Compiler::patch(int jump) {
+  m_code->m_code[jump].x = index(label());
+}
+
+bool Bytecode::Compiler::eval(Expr *node, int dst) {
+  emit(Op::EVAL, dst, 0, 0, 0, this->node(node));
+  return !m_failed;
+}
+
+bool Bytecode::Compiler::assign(Expr *node, int src) {
+  emit(Op::ASSIGN, src, 0, 0, 0, this->node(node));
+  return !m_failed;
+}
+
+bool Bytecode::Compiler::constant(const Value &v, int dst) {
+  emit(Op::CONST, dst, 0, 0, constant(v));
+  return !m_failed;
+}
+
+bool Bytecode::Compiler::local(int i, int level, int dst) {
+  emit(Op::LOCAL, dst, level, 0, i);
+  return !m_failed;
+}
+
+bool Bytecode::Compiler::unary(Expr *x, Unary op, int dst) {
+  auto r = reg();
+  if (!x->compile(*this, r)) return false;
+  size_t i = 0;
+  auto &ops = m_code->m_unary;
+  while (i < ops.size() && ops[i] != op) i++;
+  if (i == ops.size()) ops.push_back(op);
+  emit(Op::UNARY, dst, r, 0, i);
+  release(r);
+  return !m_failed;
+}
+
+bool Bytecode::Compiler::binary(Op op, Expr *a, Expr *b, Binary fallback, int dst) {
+  auto ra = reg();
+  auto rb = reg();
+  if (!a->compile(*this, ra)) return false;
+  if (!b->compile(*this, rb)) return false;
+  size_t i = 0;
+  auto &ops = m_code->m_binary;
+  while (i < ops.size() && ops[i] != fallback) i++;
+  if (i == ops.size()) ops.push_back(fallback);
+  emit(op, dst, ra, rb, i);
+  release(ra);
+  return !m_failed;
+}
+
+bool Bytecode::Compiler::branch(Expr *cond, bool when, int &jump) {
+  auto r = reg();
+  if (!cond->compile(*this, r)) return false;
+  jump = emit(when ? Op::JUMP_IF : Op::JUMP_UNLESS, r);
+  release(r);
+  return !m_failed;
+}
+
+auto Bytecode::Compiler::node(Expr *node) -> int {
+  auto &nodes = m_code->m_nodes;
+  nodes.push_back(node);
+  return nodes.size() - 1;
+}
+
+auto Bytecode::Compiler::property(PropertyCache *cache, Expr *node) -> int {
+  auto &props = m_code->m_properties;
+  props.push_back({ cache, node });
+  return props.size() - 1;
+}
+
+auto Bytecode::Compiler::constant(const Value &v) -> int {
+  auto &consts = m_code->m_constants;
+  if (v.is_string()) {
+    for (size_t i = 0; i < consts.size(); i++) {
+      if (consts[i].is_string() && consts[i].s() == v.s()) return i;
+    }
+  }
+  consts.push_back(v);
+  return consts.size() - 1;
+}
+
+auto Bytecode::Compiler::index(size_t i) -> int {
+  if (i > std::numeric_limits<uint16_t>::max()) {
+    m_failed = true;
+    return 0;
+  }
+  return i;
+}
+
+//
+// Bytecode
+//
+
+bool Bytecode::s_enabled = true;
+
+auto Bytecode::compile(Expr *expr) -> Bytecode* {
+  if (!s_enabled) return nullptr;
+  auto code = new Bytecode;
+  Compiler c(code);
+  auto r = c.reg();
+  if (!expr->compile(c, r) || c.failed() || (
+    code->m_code.size() == 1 && code->m_code[0].op == Op::EVAL
+  )) {
+    delete code;
+    return nullptr;
+  }
+  c.emit(Op::END, r);
+  return code;
+}
+
+bool Bytecode::run(Context &ctx, Value &result) {
+  vl_array<Value, 16> regs(m_registers);
+  auto *R = regs.data();
+  auto *K = m_constants.data();
+  auto *code = m_code.data();
+  auto *ip = code;
+
+#ifdef PJS_BYTECODE_COMPUTED_GOTO
+  static const void* labels[] = {
+#define PJS_BYTECODE_OP_LABEL(name) &&op_##name,
+    PJS_BYTECODE_OPS(PJS_BYTECODE_OP_LABEL)
+#undef PJS_BYTECODE_OP_LABEL
+  };
+#define CASE(name) op_##name:
+#define NEXT() do { ip++; goto *labels[(int)ip->op]; } while (0)
+#define JUMP_TO(i) do { ip = code + (i); goto *labels[(int)ip->op]; } while (0)
+  goto *labels[(int)ip->op];
+#else
+#define CASE(name) case Op::name:
+#define NEXT() do { ip++; goto dispatch; } while (0)
+#define JUMP_TO(i) do { ip = code + (i); goto dispatch; } while (0)
+dispatch:
+  switch (ip->op) {
+#endif
+
+  CASE(END) {
+    result = R[ip->a];
+    return true;
+  }
+
+  CASE(EVAL) {
+    if (!m_nodes[ip->y]->eval(ctx, R[ip->a])) return false;
+    NEXT();
+  }
+
+  CASE(ASSIGN) {
+    if (!m_nodes[ip->y]->assign(ctx, R[ip->a])) return false;
+    NEXT();
+  }
+
+  CASE(CONST) {
+    R[ip->a] = K[ip->x];
+    NEXT();
+  }
+
+  CASE(LOCAL) {
+    R[ip->a] = ctx.local(ip->x, ip->b);
+    NEXT();
+  }
+
+  CASE(SET_LOCAL) {
+    ctx.local(ip->x, ip->b) = R[ip->a];
+    NEXT();
+  }
+
+  CASE(GET) {
+    auto node = static_cast<expr::Property*>(m_properties[ip->y].node);
+    if (!node->get(ctx, R[ip->b], R[ip->c], R[ip->a])) return false;
+    NEXT();
+  }
+
+  CASE(GET_NAME) {
+    auto &prop = m_properties[ip->y];
+    auto &obj = R[ip->b];
+    if (obj.is_object() && obj.o()) {
+      prop.cache->get(obj.o(), R[ip->a]);
+    } else if (!static_cast<expr::Property*>(prop.node)->get(ctx, obj, R[ip->a])) {
+      return false;
+    }
+    NEXT();
+  }
+
+  CASE(GET_NAME_OPT) {
+    auto &prop = m_properties[ip->y];
+    auto &obj = R[ip->b];
+    if (obj.is_object() && obj.o()) {
+      prop.cache->get(obj.o(), R[ip->a]);
+    } else if (!static_cast<expr::OptionalProperty*>(prop.node)->get(ctx, obj, R[ip->a])) {
+      return false;
+    }
+    NEXT();
+  }
+
+  CASE(GET_LOCAL_NAME) {
+    auto &prop = m_properties[ip->y];
+    auto &obj = ctx.local(ip->x, ip->b);
+    if (obj.is_object() && obj.o()) {
+      prop.cache->get(obj.o(), R[ip->a]);
+    } else if (!static_cast<expr::Property*>(prop.node)->get(ctx, obj, R[ip->a])) {
+      return false;
+    }
+    NEXT();
+  }
+
+  CASE(SET_NAME) {
+    auto &prop = m_properties[ip->y];
+    auto &obj = R[ip->b];
+    if (obj.is_object() && obj.o()) {
+      prop.cache->set(obj.o(), R[ip->a]);
+    } else if (!static_cast<expr::Property*>(prop.node)->set(ctx, obj, R[ip->a])) {
+      return false;
+    }
+    NEXT();
+  }
+
+  CASE(CHECK_FUNC) {
+    auto node = static_cast<expr::Invocation*>(m_nodes[ip->y]);
+    if (!node->check(ctx, R[ip->a])) return false;
+    NEXT();
+  }
+
+  CASE(CALL) {
+    auto node = static_cast<expr::Invocation*>(m_nodes[ip->y]);
+    if (!node->call(ctx, R[ip->b], ip->c, R + ip->b + 1, R[ip->a])) return false;
+    NEXT();
+  }
+
+  CASE(UNARY) {
+    m_unary[ip->x](R[ip->b], R[ip->a]);
+    NEXT();
+  }
+
+  CASE(BINARY) {
+    m_binary[ip->x](R[ip->b], R[ip->c], R[ip->a]);
+    NEXT();
+  }
+
+  CASE(NOT) {
+    R[ip->a].set(!R[ip->b].to_boolean());
+    NEXT();
+  }
+
+#define NUMERIC(name, type, expr) \
+  CASE(name) { \
+    auto &a = R[ip->b]; \
+    auto &b = R[ip->c]; \
+    if (a.is_number() && b.is_number()) { \
+      R[ip->a].set(type(expr)); \
+    } else { \
+      m_binary[ip->x](a, b, R[ip->a]); \
+    } \
+    NEXT(); \
+  }
+
+  NUMERIC(ADD, double, a.n() + b.n())
+  NUMERIC(SUB, double, a.n() - b.n())
+  NUMERIC(MUL, double, a.n() * b.n())
+  NUMERIC(DIV, double, a.n() / b.n())
+  NUMERIC(LT, bool, a.n() < b.n())
+  NUMERIC(LE, bool, a.n() <= b.n())
+  NUMERIC(GT, bool, a.n() > b.n())
+  NUMERIC(GE, bool, a.n() >= b.n())
+
+#undef NUMERIC
+
+  CASE(SAME) {
+    R[ip->a].set(Value::is_identical(R[ip->b], R[ip->c]));
+    NEXT();
+  }
+
+  CASE(DIFF) {
+    R[ip->a].set(!Value::is_identical(R[ip->b], R[ip->c]));
+    NEXT();
+  }
+
+  CASE(SAME_STR) {
+    auto &v = R[ip->b];
+    R[ip->a].set(v.is_string() && v.s() == K[ip->x].s());
+    NEXT();
+  }
+
+  CASE(DIFF_STR) {
+    auto &v = R[ip->b];
+    R[ip->a].set(!(v.is_string() && v.s() == K[ip->x].s()));
+    NEXT();
+  }
+
+  CASE(CONCAT) {
+    std::string str;
+    for (int i = 0; i < ip->c; i++) {
+      auto s = R[ip->b + i].to_string();
+      str += s->str();
+      s->release();
+    }
+    R[ip->a].set(str);
+    NEXT();
+  }
+
+  CASE(JUMP) {
+    JUMP_TO(ip->x);
+  }
+
+  CASE(JUMP_IF) {
+    if (R[ip->a].to_boolean()) JUMP_TO(ip->x);
+    NEXT();
+  }
+
+  CASE(JUMP_UNLESS) {
+    if (!R[ip->a].to_boolean()) JUMP_TO(ip->x);
+    NEXT();
+  }
+
+  CASE(JUMP_UNLESS_NULLISH) {
+    if (!R[ip->a].is_nullish()) JUMP_TO(ip->x);
+    NEXT();
+  }
+
+  CASE(JUMP_IF_SAME_STR) {
+    auto &v = R[ip->a];
+    if (v.is_string() && v.s() == K[ip->y].s()) JUMP_TO(ip->x);
+    NEXT();
+  }
+
+  CASE(JUMP_UNLESS_SAME_STR) {
+    auto &v = R[ip->a];
+    if (!(v.is_string() && v.s() == K[ip->y].s())) JUMP_TO(ip->x);
+    NEXT();
+  }
+
+#ifndef PJS_BYTECODE_COMPUTED_GOTO
+  }
+#endif
+
+  return false;
+
+#undef CASE
+#undef NEXT
+#undef JUMP_TO
+}
+
+void Bytecode::dump(std::ostream &out, const std::string &indent) {
+  static const char *names[] = {
+#define PJS_BYTECODE_OP_NAME(name) #name,
+    PJS_BYTECODE_OPS(PJS_BYTECODE_OP_NAME)
+#undef PJS_BYTECODE_OP_NAME
+  };
+  for (size_t i = 0; i < m_code.size(); i++) {
+    const auto &inst = m_code[i];
+    out << indent << i << ' ' << names[(int)inst.op]
+        << " a=" << int(inst.a) << " b=" << int(inst.b) << " c=" << int(inst.c)
+        << " x=" << inst.x << " y=" << inst.y << std::endl;
+  }
+}
+
+} // namespace pjs
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PJS_BYTECODE_HPP
+#define PJS_BYTECODE_HPP
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace pjs {
+
+class Expr;
+
+//
+// Bytecode
+//
+// An expression compiled into instructions on a small register file.
+// Nodes the compiler doesn't know are kept as EVAL instructions that
+// call back into the tree walker, so any expression can be compiled.
+// Slow paths and errors go through the same node methods the tree
+// walker uses, so results and error messages are the same.
+//
+
+#define PJS_BYTECODE_OPS(X) \
+  X(END)                  /* return R[a]                                       */ \
+  X(EVAL)                 /* R[a] = node[y] evaluated by the tree walker       */ \
+  X(ASSIGN)               /* node[y] = R[a] assigned by the tree walker        */ \
+  X(CONST)                /* R[a] = K[x]                                       */ \
+  X(LOCAL)                /* R[a] = variable x of the scope b levels up        */ \
+  X(SET_LOCAL)            /* variable x of the scope b levels up = R[a]        */ \
+  X(GET)                  /* R[a] = R[b][R[c]] at property y                   */ \
+  X(GET_NAME)             /* R[a] = R[b].name at property y                    */ \
+  X(GET_NAME_OPT)         /* R[a] = R[b]?.name at property y                   */ \
+  X(GET_LOCAL_NAME)       /* R[a] = (variable x, b levels up).name at prop y   */ \
+  X(SET_NAME)             /* R[b].name = R[a] at property y                    */ \
+  X(CHECK_FUNC)           /* fail at node y unless R[a] is a function          */ \
+  X(CALL)                 /* R[a] = R[b](R[b+1] ... R[b+c]) at node y          */ \
+  X(UNARY)                /* R[a] = unary operator x on R[b]                   */ \
+  X(BINARY)               /* R[a] = binary operator x on R[b] and R[c]         */ \
+  X(NOT)                  /* R[a] = !R[b]                                      */ \
+  X(ADD)                  /* R[a] = R[b] + R[c], operator x if not numbers     */ \
+  X(SUB)                  /* R[a] = R[b] - R[c], operator x if not numbers     */ \
+  X(MUL)                  /* R[a] = R[b] * R[c], operator x if not numbers     */ \
+  X(DIV)                  /* R[a] = R[b] / R[c], operator x if not numbers     */ \
+  X(LT)                   /* R[a] = R[b] < R[c], operator x if not numbers     */ \
+  X(LE)                   /* R[a] = R[b] <= R[c], operator x if not numbers    */ \
+  X(GT)                   /* R[a] = R[b] > R[c], operator x if not numbers     */ \
+  X(GE)                   /* R[a] = R[b] >= R[c], operator x if not numbers    */ \
+  X(SAME)                 /* R[a] = R[b] === R[c]                              */ \
+  X(DIFF)                 /* R[a] = R[b] !== R[c]                              */ \
+  X(SAME_STR)             /* R[a] = R[b] === K[x], K[x] being a string         */ \
+  X(DIFF_STR)             /* R[a] = R[b] !== K[x], K[x] being a string         */ \
+  X(CONCAT)               /* R[a] = R[b] + ... + R[b+c-1] as strings           */ \
+  X(JUMP)                 /* goto x                                            */ \
+  X(JUMP_IF)              /* goto x if R[a] is truthy                          */ \
+  X(JUMP_UNLESS)          /* goto x if R[a] is falsy                           */ \
+  X(JUMP_UNLESS_NULLISH)  /* goto x if R[a] is neither undefined nor null      */ \
+  X(JUMP_IF_SAME_STR)     /* goto x if R[a] === K[y], K[y] being a string      */ \
+  X(JUMP_UNLESS_SAME_STR) /* goto x if R[a] !== K[y], K[y] being a string      */
+
+class Bytecode {
+public:
+  enum class Op : uint8_t {
+#define PJS_BYTECODE_OP_ENUM(name) name,
+    PJS_BYTECODE_OPS(PJS_BYTECODE_OP_ENUM)
+#undef PJS_BYTECODE_OP_ENUM
+  };
+
+  typedef void (*Unary)(Value &x, Value &result);
+  typedef void (*Binary)(Value &a, Value &b, Value &result);
+
+  struct Instruction {
+    Op op;
+    uint8_t a, b, c;
+    uint16_t x, y;
+  };
+
+  //
+  // Bytecode::Compiler
+  //
+
+  class Compiler {
+  public:
+    Compiler(Bytecode *code) : m_code(code) {}
+
+    auto reg() -> int;
+    void release(int r) { m_top = r; }
+    auto label() const -> int { return m_code->m_code.size(); }
+    auto emit(Op op, int a = 0, int b = 0, int c = 0, int x = 0, int y = 0) -> int;
+    void patch(int jump);
+
+    bool eval(Expr *node, int dst);
+    bool assign(Expr *node, int src);
+    bool constant(const Value &v, int dst);
+    bool local(int i, int level, int dst);
+    bool unary(Expr *x, Unary op, int dst);
+    bool binary(Op op, Expr *a, Expr *b, Binary fallback, int dst);
+    bool branch(Expr *cond, bool when, int &jump);
+
+    auto node(Expr *node) -> int;
+    auto property(PropertyCache *cache, Expr *node) -> int;
+    auto constant(const Value &v) -> int;
+
+    bool failed() const { return m_failed; }
+
+  private:
+    Bytecode* m_code;
+    int m_top = 0;
+    bool m_failed = false;
+
+    auto index(size_t i) -> int;
+  };
+
+  static void set_enabled(bool enabled) { s_enabled = enabled; }
+  static bool enabled() { return s_enabled; }
+
+  static auto compile(Expr *expr) -> Bytecode*;
+
+  bool run(Context &ctx, Value &result);
+  void dump(std::ostream &out, const std::string &indent = "");
+
+private:
+  struct Property {
+    PropertyCache *cache;
+    Expr *node;
+  };
+
+  std::vector<Instruction> m_code;
+  std::vector<Value> m_constants;
+  std::vector<Expr*> m_nodes;
+  std::vector<Property> m_properties;
+  std::vector<Unary> m_unary;
+  std::vector<Binary> m_binary;
+  int m_registers = 0;
+
+  static bool s_enabled;
+};
+
+} // namespace pjs
+
+#endif // PJS_BYTECODE_HPP
@@ -66,6 +66,11 @@ bool Discard::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool Discard::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_x->compile(c, dst)) return false;
+  return c.constant(Value::undefined, dst);
+}
+
 bool Discard::declare(Module *module, Scope &scope, Error &error) {
   return m_x->declare(module, scope, error);
 }
@@ -102,6 +107,14 @@ bool Compound::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool Compound::compile(Bytecode::Compiler &c, int dst) {
+  if (m_exprs.empty()) return Expr::compile(c, dst);
+  for (const auto &p : m_exprs) {
+    if (!p->compile(c, dst)) return false;
+  }
+  return true;
+}
+
 auto Compound::reduce(Reducer &r) -> Reducer::Value* {
   size_t n = m_exprs.size();
   vl_array<Reducer::Value*> v(n);
@@ -149,6 +162,19 @@ bool Concatenation::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool Concatenation::compile(Bytecode::Compiler &c, int dst) {
+  if (m_exprs.empty()) return Expr::compile(c, dst);
+  auto first = c.reg();
+  for (int i = 1; i < m_exprs.size(); i++) c.reg();
+  auto r = first;
+  for (const auto &p : m_exprs) {
+    if (!p->compile(c, r++)) return false;
+  }
+  c.emit(Bytecode::Op::CONCAT, dst, first, m_exprs.size());
+  c.release(first);
+  return !c.failed();
+}
+
 bool Concatenation::declare(Module *module, Scope &scope, Error &error) {
   for (const auto &p : m_exprs) {
     if (!p->declare(module, scope, error)) return false;
@@ -178,6 +204,10 @@ bool Undefined::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool Undefined::compile(Bytecode::Compiler &c, int dst) {
+  return c.constant(Value::undefined, dst);
+}
+
 auto Undefined::reduce(Reducer &r) -> Reducer::Value* {
   return r.undefined();
 }
@@ -195,6 +225,10 @@ bool Null::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool Null::compile(Bytecode::Compiler &c, int dst) {
+  return c.constant(Value::null, dst);
+}
+
 auto Null::reduce(Reducer &r) -> Reducer::Value* {
   return r.null();
 }
@@ -212,6 +246,10 @@ bool BooleanLiteral::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool BooleanLiteral::compile(Bytecode::Compiler &c, int dst) {
+  return c.constant(Value(m_b), dst);
+}
+
 auto BooleanLiteral::reduce(Reducer &r) -> Reducer::Value* {
   return r.boolean(m_b);
 }
@@ -229,6 +267,10 @@ bool NumberLiteral::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool NumberLiteral::compile(Bytecode::Compiler &c, int dst) {
+  return c.constant(Value(m_n), dst);
+}
+
 auto NumberLiteral::reduce(Reducer &r) -> Reducer::Value* {
   return r.number(m_n);
 }
@@ -246,6 +288,10 @@ bool StringLiteral::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool StringLiteral::compile(Bytecode::Compiler &c, int dst) {
+  return c.constant(Value(m_s.get()), dst);
+}
+
 auto StringLiteral::reduce(Reducer &r) -> Reducer::Value* {
   return r.string(m_s->str());
 }
@@ -536,7 +582,7 @@ bool FunctionLiteral::eval(Context &ctx, Value &result) {
   return true;
 }
 
-bool FunctionLiteral::declare(Module *module, Scope &, Error &error) {
+bool FunctionLiteral::declare(Module *module, Scope &scope, Error &error) {
   auto check_name = [&](pjs::Str *s) {
     if (!s) return true;
     if (s->str()[0] != '$') return true;
@@ -547,6 +593,9 @@ bool FunctionLiteral::declare(Module *module, Scope &, Error &error) {
   };
   for (const auto &arg : m_scope.args()) if (!check_name(arg)) return false;
   for (const auto &var : m_scope.vars()) if (!check_name(var)) return false;
+  auto s = &scope;
+  while (!s->is_root()) s = s->parent();
+  s->require_scope(); // the enclosing function can be closed over
   for (auto &i : m_inputs) i->declare(module, m_scope, error);
   return m_output->declare(module, m_scope, error);
 }
@@ -556,18 +605,16 @@ void FunctionLiteral::resolve(Module *module, Context &ctx, int l, LegacyImports
   std::sprintf(name, "(anonymous function at line %d column %d)", line(), column());
   m_method = Method::make(
     name, [this](Context &ctx, Object*, Value &result) {
-      auto scope = m_scope.instantiate(ctx);
-      if (!scope) return;
-      Stmt::Result res;
-      m_output->execute(ctx, res);
-      if (ctx.ok()) {
-        if (res.is_return()) {
-          result = res.value;
-        } else {
-          result = Value::undefined;
-        }
+      if (m_scope.is_scope_required()) {
+        auto scope = m_scope.instantiate(ctx);
+        if (!scope) return;
+        execute(ctx, result);
+        scope->clear();
+      } else {
+        vl_array<Value, pjs::Scope::MAX_INLINE_SIZE> frame(m_scope.size());
+        if (!m_scope.instantiate(ctx, frame)) return;
+        execute(ctx, result);
       }
-      scope->clear();
     }
   );
 
@@ -576,6 +623,18 @@ void FunctionLiteral::resolve(Module *module, Context &ctx, int l, LegacyImports
   m_output->resolve(module, fctx, l, imports);
 }
 
+void FunctionLiteral::execute(Context &ctx, Value &result) {
+  Stmt::Result res;
+  m_output->execute(ctx, res);
+  if (ctx.ok()) {
+    if (res.is_return()) {
+      result = res.value;
+    } else {
+      result = Value::undefined;
+    }
+  }
+}
+
 auto FunctionLiteral::reduce(Reducer &r) -> Reducer::Value* {
   size_t argc = m_inputs.size();
   vl_array<Expr*> inputs(argc);
@@ -709,19 +768,24 @@ void LegacyLocal::dump(std::ostream &out, const std::string &indent) {
 bool LocalVariable::is_left_value() const { return true; }
 
 bool LocalVariable::eval(Context &ctx, Value &result) {
-  auto *scope = ctx.scope();
-  for (int i = 0; i < m_level; i++) scope = scope->parent();
-  result = scope->value(m_i);
+  result = ctx.local(m_i, m_level);
   return true;
 }
 
 bool LocalVariable::assign(Context &ctx, Value &value) {
-  auto *scope = ctx.scope();
-  for (int i = 0; i < m_level; i++) scope = scope->parent();
-  scope->value(m_i) = value;
+  ctx.local(m_i, m_level) = value;
   return true;
 }
 
+bool LocalVariable::compile(Bytecode::Compiler &c, int dst) {
+  return c.local(m_i, m_level, dst);
+}
+
+bool LocalVariable::compile_assign(Bytecode::Compiler &c, int src) {
+  c.emit(Bytecode::Op::SET_LOCAL, src, m_level, 0, m_i);
+  return !c.failed();
+}
+
 bool LocalVariable::clear(Context &ctx, Value &result) {
   return error(ctx, "cannot delete a local variable");
 }
@@ -774,7 +838,7 @@ void Identifier::to_arguments(std::vector<Ref<Str>> &args, std::vector<Ref<Str>>
 void Identifier::unpack(std::vector<Ref<Str>> &vars) const { vars.push_back(m_key); }
 
 bool Identifier::unpack(Context &ctx, Value &arg, int &var) {
-  ctx.scope()->value(var++) = arg;
+  ctx.local(var++, 0) = arg;
   return true;
 }
 
@@ -796,6 +860,16 @@ bool Identifier::clear(Context &ctx, Value &result) {
   return m_resolved->clear(ctx, result);
 }
 
+bool Identifier::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_resolved) return Expr::compile(c, dst);
+  return m_resolved->compile(c, dst);
+}
+
+bool Identifier::compile_assign(Bytecode::Compiler &c, int src) {
+  if (!m_resolved) return Expr::compile_assign(c, src);
+  return m_resolved->compile_assign(c, src);
+}
+
 void Identifier::resolve(Module *module, Context &ctx, int l, LegacyImports *imports) {
   m_l = l;
   m_imports = imports;
@@ -805,7 +879,7 @@ void Identifier::resolve(Module *module, Context &ctx, int l, LegacyImports *imp
 
 void Identifier::resolve(Context &ctx) {
   auto *scope = ctx.scope();
-  for (int level = 0; scope; scope = scope->parent(), level++) {
+  for (int level = (ctx.frame() ? 1 : 0); scope; scope = scope->parent(), level++) {
     auto &variables = scope->variables();
     for (size_t i = 0, n = variables.size(); i < n; i++) {
       auto &v = variables[i];
@@ -814,7 +888,7 @@ void Identifier::resolve(Context &ctx) {
           m_resolved.reset(locate(new FiberVariable(v.index, m_module)));
         } else {
           m_resolved.reset(locate(new LocalVariable(i, level)));
-          if (scope != ctx.scope()) {
+          if (level > 0) {
             v.is_closure = true;
           }
         }
@@ -872,73 +946,149 @@ void Identifier::dump(std::ostream &out, const std::string &indent) {
 // Property
 //
 
+// A string literal key that can never be taken as an array index
+static auto property_name(Expr *key) -> Str* {
+  if (auto *s = dynamic_cast<StringLiteral*>(key)) {
+    if (!std::isfinite(Value(s->s()).to_number())) {
+      return s->s();
+    }
+  }
+  return nullptr;
+}
+
+Property::Property(Expr *obj, Expr *key)
+  : m_obj(obj)
+  , m_key(key)
+  , m_cache(property_name(key))
+  , m_is_name(property_name(key)) {}
+
 bool Property::is_left_value() const { return true; }
 
 bool Property::eval(Context &ctx, Value &result) {
   Value obj, key;
   if (!m_obj->eval(ctx, obj)) return false;
+  if (m_is_name && obj.is_object() && obj.o()) {
+    m_cache.get(obj.o(), result);
+    return true;
+  }
   if (!m_key->eval(ctx, key)) return false;
-  if (obj.is_undefined()) return error(ctx, "cannot read property of undefined");
-  if (obj.is_null()) return error(ctx, "cannot read property of null");
+  return get(ctx, obj, key, result);
+}
+
+bool Property::assign(Context &ctx, Value &value) {
+  Value obj, key;
+  if (!m_obj->eval(ctx, obj)) return false;
+  if (m_is_name && obj.is_object() && obj.o()) {
+    m_cache.set(obj.o(), value);
+    return true;
+  }
+  if (!m_key->eval(ctx, key)) return false;
+  return set(ctx, obj, key, value);
+}
+
+bool Property::clear(Context &ctx, Value &result) {
+  Value obj, key;
+  if (!m_obj->eval(ctx, obj)) return false;
+  if (!m_key->eval(ctx, key)) return false;
+  if (obj.is_undefined()) return error(ctx, "cannot delete property of undefined");
+  if (obj.is_null()) return error(ctx, "cannot delete property of null");
   auto o = obj.to_object();
   auto c = o->type();
   if (c->has_seti()) {
     auto i = key.to_number();
     if (std::isfinite(i)) {
-      c->geti(o, i, result);
+      c->seti(o, i, Value::empty);
       o->release();
+      result.set(true);
       return true;
     }
   }
   auto k = key.to_string();
-  m_cache.get(o, k, result);
+  result.set(m_cache.del(o, k));
   k->release();
   o->release();
   return true;
 }
 
-bool Property::assign(Context &ctx, Value &value) {
-  Value obj, key;
-  if (!m_obj->eval(ctx, obj)) return false;
+bool Property::compile(Bytecode::Compiler &c, int dst) {
+  if (m_is_name) {
+    if (auto id = dynamic_cast<Identifier*>(m_obj.get())) {
+      if (auto var = dynamic_cast<LocalVariable*>(id->resolved())) {
+        c.emit(Bytecode::Op::GET_LOCAL_NAME, dst, var->level(), 0, var->index(), c.property(&m_cache, this));
+        return !c.failed();
+      }
+    }
+    auto obj = c.reg();
+    if (!m_obj->compile(c, obj)) return false;
+    c.emit(Bytecode::Op::GET_NAME, dst, obj, 0, 0, c.property(&m_cache, this));
+    c.release(obj);
+    return !c.failed();
+  }
+  auto obj = c.reg();
+  auto key = c.reg();
+  if (!m_obj->compile(c, obj)) return false;
+  if (!m_key->compile(c, key)) return false;
+  c.emit(Bytecode::Op::GET, dst, obj, key, 0, c.property(&m_cache, this));
+  c.release(obj);
+  return !c.failed();
+}
+
+bool Property::compile_assign(Bytecode::Compiler &c, int src) {
+  if (!m_is_name) return Expr::compile_assign(c, src);
+  auto obj = c.reg();
+  if (!m_obj->compile(c, obj)) return false;
+  c.emit(Bytecode::Op::SET_NAME, src, obj, 0, 0, c.property(&m_cache, this));
+  c.release(obj);
+  return !c.failed();
+}
+
+bool Property::get(Context &ctx, Value &obj, Value &result) {
+  Value key;
   if (!m_key->eval(ctx, key)) return false;
-  if (obj.is_undefined()) return error(ctx, "cannot set property of undefined");
-  if (obj.is_null()) return error(ctx, "cannot set property of null");
+  return get(ctx, obj, key, result);
+}
+
+bool Property::get(Context &ctx, Value &obj, Value &key, Value &result) {
+  if (obj.is_undefined()) return error(ctx, "cannot read property of undefined");
+  if (obj.is_null()) return error(ctx, "cannot read property of null");
   auto o = obj.to_object();
   auto c = o->type();
   if (c->has_seti()) {
     auto i = key.to_number();
     if (std::isfinite(i)) {
-      c->seti(o, i, value);
+      c->geti(o, i, result);
       o->release();
       return true;
     }
   }
   auto k = key.to_string();
-  m_cache.set(o, k, value);
+  m_cache.get(o, k, result);
   k->release();
   o->release();
   return true;
 }
 
-bool Property::clear(Context &ctx, Value &result) {
-  Value obj, key;
-  if (!m_obj->eval(ctx, obj)) return false;
+bool Property::set(Context &ctx, Value &obj, Value &value) {
+  Value key;
   if (!m_key->eval(ctx, key)) return false;
-  if (obj.is_undefined()) return error(ctx, "cannot delete property of undefined");
-  if (obj.is_null()) return error(ctx, "cannot delete property of null");
+  return set(ctx, obj, key, value);
+}
+
+bool Property::set(Context &ctx, Value &obj, Value &key, Value &value) {
+  if (obj.is_undefined()) return error(ctx, "cannot set property of undefined");
+  if (obj.is_null()) return error(ctx, "cannot set property of null");
   auto o = obj.to_object();
   auto c = o->type();
   if (c->has_seti()) {
     auto i = key.to_number();
     if (std::isfinite(i)) {
-      c->seti(o, i, Value::empty);
+      c->seti(o, i, value);
       o->release();
-      result.set(true);
       return true;
     }
   }
   auto k = key.to_string();
-  result.set(m_cache.del(o, k));
+  m_cache.set(o, k, value);
   k->release();
   o->release();
   return true;
@@ -969,9 +1119,33 @@ void Property::dump(std::ostream &out, const std::string &indent) {
 // OptionalProperty
 //
 
+OptionalProperty::OptionalProperty(Expr *obj, Expr *key)
+  : m_obj(obj)
+  , m_key(key)
+  , m_cache(property_name(key))
+  , m_is_name(property_name(key)) {}
+
 bool OptionalProperty::eval(Context &ctx, Value &result) {
-  Value obj, key;
+  Value obj;
   if (!m_obj->eval(ctx, obj)) return false;
+  if (m_is_name && obj.is_object() && obj.o()) {
+    m_cache.get(obj.o(), result);
+    return true;
+  }
+  return get(ctx, obj, result);
+}
+
+bool OptionalProperty::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_is_name) return Expr::compile(c, dst);
+  auto obj = c.reg();
+  if (!m_obj->compile(c, obj)) return false;
+  c.emit(Bytecode::Op::GET_NAME_OPT, dst, obj, 0, 0, c.property(&m_cache, this));
+  c.release(obj);
+  return !c.failed();
+}
+
+bool OptionalProperty::get(Context &ctx, Value &obj, Value &result) {
+  Value key;
   if (!m_key->eval(ctx, key)) return false;
   if (obj.is_undefined() || obj.is_null()) {
     result = Value::undefined;
@@ -1060,10 +1234,32 @@ bool Invocation::eval(Context &ctx, Value &result) {
   vl_array<Value> argv(argc);
   Value f;
   if (!m_func->eval(ctx, f)) return false;
-  if (!f.is_function()) return error(ctx, "not a function");
+  if (!check(ctx, f)) return false;
   for (size_t i = 0; i < argc; i++) {
     if (!m_argv[i]->eval(ctx, argv[i])) return false;
   }
+  return call(ctx, f, argc, argv, result);
+}
+
+bool Invocation::compile(Bytecode::Compiler &c, int dst) {
+  auto f = c.reg();
+  if (!m_func->compile(c, f)) return false;
+  auto node = c.node(this);
+  c.emit(Bytecode::Op::CHECK_FUNC, f, 0, 0, 0, node);
+  for (const auto &p : m_argv) {
+    if (!p->compile(c, c.reg())) return false;
+  }
+  c.emit(Bytecode::Op::CALL, dst, f, m_argv.size(), 0, node);
+  c.release(f);
+  return !c.failed();
+}
+
+bool Invocation::check(Context &ctx, Value &f) {
+  if (!f.is_function()) return error(ctx, "not a function");
+  return true;
+}
+
+bool Invocation::call(Context &ctx, Value &f, int argc, Value *argv, Value &result) {
   ctx.trace(m_module, line(), column());
   (*f.as<Function>())(ctx, argc, argv, result);
   if (ctx.ok()) return true;
@@ -1153,10 +1349,18 @@ void OptionalInvocation::dump(std::ostream &out, const std::string &indent) {
 bool Plus::eval(Context &ctx, Value &result) {
   Value x;
   if (!m_x->eval(ctx, x)) return false;
-  result.set(x.to_number());
+  operate(x, result);
   return true;
 }
 
+bool Plus::compile(Bytecode::Compiler &c, int dst) {
+  return c.unary(m_x.get(), operate, dst);
+}
+
+void Plus::operate(Value &x, Value &result) {
+  result.set(x.to_number());
+}
+
 bool Plus::declare(Module *module, Scope &scope, Error &error) {
   return m_x->declare(module, scope, error);
 }
@@ -1177,12 +1381,20 @@ void Plus::dump(std::ostream &out, const std::string &indent) {
 bool Negation::eval(Context &ctx, Value &result) {
   Value x;
   if (!m_x->eval(ctx, x)) return false;
+  operate(x, result);
+  return true;
+}
+
+bool Negation::compile(Bytecode::Compiler &c, int dst) {
+  return c.unary(m_x.get(), operate, dst);
+}
+
+void Negation::operate(Value &x, Value &result) {
   if (x.is<Int>()) {
     result.set(x.as<Int>()->neg());
-    return true;
+    return;
   }
   result.set(-x.to_number());
-  return true;
 }
 
 bool Negation::declare(Module *module, Scope &scope, Error &error) {
@@ -1206,13 +1418,22 @@ bool Addition::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Addition::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::ADD, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Addition::operate(Value &a, Value &b, Value &result) {
   if (a.is_string() || b.is_string()) {
     auto sa = a.to_string();
     auto sb = b.to_string();
     result.set(sa->str() + sb->str());
     sa->release();
     sb->release();
-    return true;
+    return;
   }
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
@@ -1220,12 +1441,11 @@ bool Addition::eval(Context &ctx, Value &result) {
     result.set(ia->add(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   auto na = a.to_number();
   auto nb = b.to_number();
   result.set(na + nb);
-  return true;
 }
 
 bool Addition::declare(Module *module, Scope &scope, Error &error) {
@@ -1253,18 +1473,26 @@ bool Subtraction::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Subtraction::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::SUB, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Subtraction::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->sub(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   auto na = a.to_number();
   auto nb = b.to_number();
   result.set(na - nb);
-  return true;
 }
 
 bool Subtraction::declare(Module *module, Scope &scope, Error &error) {
@@ -1292,18 +1520,26 @@ bool Multiplication::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Multiplication::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::MUL, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Multiplication::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->mul(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   auto na = a.to_number();
   auto nb = b.to_number();
   result.set(na * nb);
-  return true;
 }
 
 bool Multiplication::declare(Module *module, Scope &scope, Error &error) {
@@ -1331,18 +1567,26 @@ bool Division::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Division::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::DIV, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Division::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->div(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   auto na = a.to_number();
   auto nb = b.to_number();
   result.set(na / nb);
-  return true;
 }
 
 bool Division::declare(Module *module, Scope &scope, Error &error) {
@@ -1370,18 +1614,26 @@ bool Remainder::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Remainder::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Remainder::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->mod(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   auto na = a.to_number();
   auto nb = b.to_number();
   result.set(std::fmod(na, nb));
-  return true;
 }
 
 bool Remainder::declare(Module *module, Scope &scope, Error &error) {
@@ -1409,10 +1661,18 @@ bool Exponentiation::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Exponentiation::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Exponentiation::operate(Value &a, Value &b, Value &result) {
   auto na = a.to_number();
   auto nb = b.to_number();
   result.set(std::pow(na, nb));
-  return true;
 }
 
 bool Exponentiation::declare(Module *module, Scope &scope, Error &error) {
@@ -1440,14 +1700,22 @@ bool ShiftLeft::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool ShiftLeft::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void ShiftLeft::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>()) {
     result.set(a.as<Int>()->shl(b.to_int32()));
-    return true;
+    return;
   }
   int32_t na = a.to_int32();
   int32_t nb = b.to_int32();
   result.set(na << nb);
-  return true;
 }
 
 bool ShiftLeft::declare(Module *module, Scope &scope, Error &error) {
@@ -1475,14 +1743,22 @@ bool ShiftRight::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool ShiftRight::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void ShiftRight::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>()) {
     result.set(a.as<Int>()->shr(b.to_int32()));
-    return true;
+    return;
   }
   int32_t na = a.to_int32();
   int32_t nb = b.to_int32();
   result.set(na >> nb);
-  return true;
 }
 
 bool ShiftRight::declare(Module *module, Scope &scope, Error &error) {
@@ -1510,14 +1786,22 @@ bool UnsignedShiftRight::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool UnsignedShiftRight::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void UnsignedShiftRight::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>()) {
     result.set(a.as<Int>()->bitwise_shr(b.to_int32()));
-    return true;
+    return;
   }
   int32_t na = a.to_int32();
   int32_t nb = b.to_int32();
   result.set((uint32_t)na >> nb);
-  return true;
 }
 
 bool UnsignedShiftRight::declare(Module *module, Scope &scope, Error &error) {
@@ -1544,12 +1828,20 @@ void UnsignedShiftRight::dump(std::ostream &out, const std::string &indent) {
 bool BitwiseNot::eval(Context &ctx, Value &result) {
   Value x;
   if (!m_x->eval(ctx, x)) return false;
+  operate(x, result);
+  return true;
+}
+
+bool BitwiseNot::compile(Bytecode::Compiler &c, int dst) {
+  return c.unary(m_x.get(), operate, dst);
+}
+
+void BitwiseNot::operate(Value &x, Value &result) {
   if (x.is<Int>()) {
     result.set(x.as<Int>()->bitwise_not());
-    return true;
+    return;
   }
   result.set(~x.to_int32());
-  return true;
 }
 
 bool BitwiseNot::declare(Module *module, Scope &scope, Error &error) {
@@ -1573,18 +1865,26 @@ bool BitwiseAnd::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool BitwiseAnd::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void BitwiseAnd::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->bitwise_and(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   int32_t na = a.to_int32();
   int32_t nb = b.to_int32();
   result.set(na & nb);
-  return true;
 }
 
 bool BitwiseAnd::declare(Module *module, Scope &scope, Error &error) {
@@ -1612,18 +1912,26 @@ bool BitwiseOr::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool BitwiseOr::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void BitwiseOr::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->bitwise_or(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   int32_t na = a.to_int32();
   int32_t nb = b.to_int32();
   result.set(na | nb);
-  return true;
 }
 
 bool BitwiseOr::declare(Module *module, Scope &scope, Error &error) {
@@ -1651,18 +1959,26 @@ bool BitwiseXor::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool BitwiseXor::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void BitwiseXor::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->bitwise_xor(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   int32_t na = a.to_int32();
   int32_t nb = b.to_int32();
   result.set(na ^ nb);
-  return true;
 }
 
 bool BitwiseXor::declare(Module *module, Scope &scope, Error &error) {
@@ -1693,6 +2009,18 @@ bool LogicalNot::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool LogicalNot::compile(Bytecode::Compiler &c, int dst) {
+  auto x = c.reg();
+  if (!m_x->compile(c, x)) return false;
+  c.emit(Bytecode::Op::NOT, dst, x);
+  c.release(x);
+  return !c.failed();
+}
+
+bool LogicalNot::compile_branch(Bytecode::Compiler &c, bool when, int &jump) {
+  return m_x->compile_branch(c, !when, jump);
+}
+
 bool LogicalNot::declare(Module *module, Scope &scope, Error &error) {
   return m_x->declare(module, scope, error);
 }
@@ -1717,6 +2045,14 @@ bool LogicalAnd::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool LogicalAnd::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_a->compile(c, dst)) return false;
+  auto jump = c.emit(Bytecode::Op::JUMP_UNLESS, dst);
+  if (!m_b->compile(c, dst)) return false;
+  c.patch(jump);
+  return !c.failed();
+}
+
 bool LogicalAnd::declare(Module *module, Scope &scope, Error &error) {
   if (!m_a->declare(module, scope, error)) return false;
   if (!m_b->declare(module, scope, error)) return false;
@@ -1745,6 +2081,14 @@ bool LogicalOr::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool LogicalOr::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_a->compile(c, dst)) return false;
+  auto jump = c.emit(Bytecode::Op::JUMP_IF, dst);
+  if (!m_b->compile(c, dst)) return false;
+  c.patch(jump);
+  return !c.failed();
+}
+
 bool LogicalOr::declare(Module *module, Scope &scope, Error &error) {
   if (!m_a->declare(module, scope, error)) return false;
   if (!m_b->declare(module, scope, error)) return false;
@@ -1773,6 +2117,14 @@ bool NullishCoalescing::eval(Context &ctx, Value &result) {
   return true;
 }
 
+bool NullishCoalescing::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_a->compile(c, dst)) return false;
+  auto jump = c.emit(Bytecode::Op::JUMP_UNLESS_NULLISH, dst);
+  if (!m_b->compile(c, dst)) return false;
+  c.patch(jump);
+  return !c.failed();
+}
+
 bool NullishCoalescing::declare(Module *module, Scope &scope, Error &error) {
   if (!m_a->declare(module, scope, error)) return false;
   if (!m_b->declare(module, scope, error)) return false;
@@ -1798,16 +2150,24 @@ bool Equality::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Equality::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Equality::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(ia->eql(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   result.set(Value::is_equal(a, b));
-  return true;
 }
 
 bool Equality::declare(Module *module, Scope &scope, Error &error) {
@@ -1835,16 +2195,24 @@ bool Inequality::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool Inequality::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::BINARY, m_a.get(), m_b.get(), operate, dst);
+}
+
+void Inequality::operate(Value &a, Value &b, Value &result) {
   if (a.is<Int>() || b.is<Int>()) {
     auto ia = a.to_int();
     auto ib = b.to_int();
     result.set(!ia->eql(ib));
     ia->release();
     ib->release();
-    return true;
+    return;
   }
   result.set(!Value::is_equal(a, b));
-  return true;
 }
 
 bool Inequality::declare(Module *module, Scope &scope, Error &error) {
@@ -1868,14 +2236,46 @@ void Inequality::dump(std::ostream &out, const std::string &indent) {
 // Identity
 //
 
+Identity::Identity(Expr *a, Expr *b) : m_a(a), m_b(b) {
+  if (auto *s = dynamic_cast<StringLiteral*>(b)) m_s = s->s();
+}
+
 bool Identity::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
+  if (m_s) {
+    result.set((a.is_string() && a.s() == m_s));
+    return true;
+  }
   if (!m_b->eval(ctx, b)) return false;
   result.set(Value::is_identical(a, b));
   return true;
 }
 
+bool Identity::compile(Bytecode::Compiler &c, int dst) {
+  auto a = c.reg();
+  if (!m_a->compile(c, a)) return false;
+  if (m_s) {
+    c.emit(Bytecode::Op::SAME_STR, dst, a, 0, c.constant(Value(m_s.get())));
+  } else {
+    auto b = c.reg();
+    if (!m_b->compile(c, b)) return false;
+    c.emit(Bytecode::Op::SAME, dst, a, b);
+  }
+  c.release(a);
+  return !c.failed();
+}
+
+bool Identity::compile_branch(Bytecode::Compiler &c, bool when, int &jump) {
+  if (!m_s) return Expr::compile_branch(c, when, jump);
+  auto a = c.reg();
+  if (!m_a->compile(c, a)) return false;
+  auto op = (when ? Bytecode::Op::JUMP_IF_SAME_STR : Bytecode::Op::JUMP_UNLESS_SAME_STR);
+  jump = c.emit(op, a, 0, 0, 0, c.constant(Value(m_s.get())));
+  c.release(a);
+  return !c.failed();
+}
+
 bool Identity::declare(Module *module, Scope &scope, Error &error) {
   if (!m_a->declare(module, scope, error)) return false;
   if (!m_b->declare(module, scope, error)) return false;
@@ -1897,14 +2297,46 @@ void Identity::dump(std::ostream &out, const std::string &indent) {
 // Nonidentity
 //
 
+Nonidentity::Nonidentity(Expr *a, Expr *b) : m_a(a), m_b(b) {
+  if (auto *s = dynamic_cast<StringLiteral*>(b)) m_s = s->s();
+}
+
 bool Nonidentity::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
+  if (m_s) {
+    result.set(!(a.is_string() && a.s() == m_s));
+    return true;
+  }
   if (!m_b->eval(ctx, b)) return false;
   result.set(!Value::is_identical(a, b));
   return true;
 }
 
+bool Nonidentity::compile(Bytecode::Compiler &c, int dst) {
+  auto a = c.reg();
+  if (!m_a->compile(c, a)) return false;
+  if (m_s) {
+    c.emit(Bytecode::Op::DIFF_STR, dst, a, 0, c.constant(Value(m_s.get())));
+  } else {
+    auto b = c.reg();
+    if (!m_b->compile(c, b)) return false;
+    c.emit(Bytecode::Op::DIFF, dst, a, b);
+  }
+  c.release(a);
+  return !c.failed();
+}
+
+bool Nonidentity::compile_branch(Bytecode::Compiler &c, bool when, int &jump) {
+  if (!m_s) return Expr::compile_branch(c, when, jump);
+  auto a = c.reg();
+  if (!m_a->compile(c, a)) return false;
+  auto op = (!when ? Bytecode::Op::JUMP_IF_SAME_STR : Bytecode::Op::JUMP_UNLESS_SAME_STR);
+  jump = c.emit(op, a, 0, 0, 0, c.constant(Value(m_s.get())));
+  c.release(a);
+  return !c.failed();
+}
+
 bool Nonidentity::declare(Module *module, Scope &scope, Error &error) {
   if (!m_a->declare(module, scope, error)) return false;
   if (!m_b->declare(module, scope, error)) return false;
@@ -1930,6 +2362,15 @@ bool GreaterThan::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool GreaterThan::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::GT, m_a.get(), m_b.get(), operate, dst);
+}
+
+void GreaterThan::operate(Value &a, Value &b, Value &result) {
   if (a.is_undefined() || b.is_undefined()) {
     result.set(false);
   } else if (a.is_string() && b.is_string()) {
@@ -1945,7 +2386,6 @@ bool GreaterThan::eval(Context &ctx, Value &result) {
     auto nb = b.to_number();
     result.set(na > nb);
   }
-  return true;
 }
 
 bool GreaterThan::declare(Module *module, Scope &scope, Error &error) {
@@ -1973,6 +2413,15 @@ bool GreaterThanOrEqual::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool GreaterThanOrEqual::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::GE, m_a.get(), m_b.get(), operate, dst);
+}
+
+void GreaterThanOrEqual::operate(Value &a, Value &b, Value &result) {
   if (a.is_undefined() || b.is_undefined()) {
     result.set(false);
   } else if (a.is_string() && b.is_string()) {
@@ -1988,7 +2437,6 @@ bool GreaterThanOrEqual::eval(Context &ctx, Value &result) {
     auto nb = b.to_number();
     result.set(na >= nb);
   }
-  return true;
 }
 
 bool GreaterThanOrEqual::declare(Module *module, Scope &scope, Error &error) {
@@ -2016,6 +2464,15 @@ bool LessThan::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool LessThan::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::LT, m_a.get(), m_b.get(), operate, dst);
+}
+
+void LessThan::operate(Value &a, Value &b, Value &result) {
   if (a.is_undefined() || b.is_undefined()) {
     result.set(false);
   } else if (a.is_string() && b.is_string()) {
@@ -2031,7 +2488,6 @@ bool LessThan::eval(Context &ctx, Value &result) {
     auto nb = b.to_number();
     result.set(na < nb);
   }
-  return true;
 }
 
 bool LessThan::declare(Module *module, Scope &scope, Error &error) {
@@ -2059,6 +2515,15 @@ bool LessThanOrEqual::eval(Context &ctx, Value &result) {
   Value a, b;
   if (!m_a->eval(ctx, a)) return false;
   if (!m_b->eval(ctx, b)) return false;
+  operate(a, b, result);
+  return true;
+}
+
+bool LessThanOrEqual::compile(Bytecode::Compiler &c, int dst) {
+  return c.binary(Bytecode::Op::LE, m_a.get(), m_b.get(), operate, dst);
+}
+
+void LessThanOrEqual::operate(Value &a, Value &b, Value &result) {
   if (a.is_undefined() || b.is_undefined()) {
     result.set(false);
   } else if (a.is_string() && b.is_string()) {
@@ -2074,7 +2539,6 @@ bool LessThanOrEqual::eval(Context &ctx, Value &result) {
     auto nb = b.to_number();
     result.set(na <= nb);
   }
-  return true;
 }
 
 bool LessThanOrEqual::declare(Module *module, Scope &scope, Error &error) {
@@ -2356,6 +2820,11 @@ bool Assignment::eval(Context &ctx, Value &result) {
   return m_l->assign(ctx, result);
 }
 
+bool Assignment::compile(Bytecode::Compiler &c, int dst) {
+  if (!m_r->compile(c, dst)) return false;
+  return m_l->compile_assign(c, dst);
+}
+
 bool Assignment::declare(Module *module, Scope &scope, Error &error) {
   if (!m_l->declare(module, scope, error)) return false;
   if (!m_r->declare(module, scope, error)) return false;
@@ -2929,6 +3398,17 @@ bool Conditional::eval(Context &ctx, Value &result) {
   }
 }
 
+bool Conditional::compile(Bytecode::Compiler &c, int dst) {
+  int jump_else;
+  if (!m_a->compile_branch(c, false, jump_else)) return false;
+  if (!m_b->compile(c, dst)) return false;
+  auto jump_end = c.emit(Bytecode::Op::JUMP);
+  c.patch(jump_else);
+  if (!m_c->compile(c, dst)) return false;
+  c.patch(jump_end);
+  return !c.failed();
+}
+
 bool Conditional::declare(Module *module, Scope &scope, Error &error) {
   if (!m_a->declare(module, scope, error)) return false;
   if (!m_b->declare(module, scope, error)) return false;
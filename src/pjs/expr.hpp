@@ -29,6 +29,7 @@
 #include "types.hpp"
 #include "tree.hpp"
 #include "builtin.hpp"
+#include "bytecode.hpp"
 
 #include <cmath>
 #include <string>
@@ -161,6 +162,9 @@ public:
   virtual bool eval(Context &ctx, Value &result) = 0;
   virtual bool assign(Context &ctx, Value &value) { return error(ctx, "cannot assign to a right-value"); }
   virtual bool clear(Context &ctx, Value &result) { return error(ctx, "cannot delete a value"); }
+  virtual bool compile(Bytecode::Compiler &c, int dst) { return c.eval(this, dst); }
+  virtual bool compile_assign(Bytecode::Compiler &c, int src) { return c.assign(this, src); }
+  virtual bool compile_branch(Bytecode::Compiler &c, bool when, int &jump) { return c.branch(this, when, jump); }
   virtual auto reduce(Reducer &r) -> Reducer::Value* { return r.undefined(); }
   virtual auto reduce_lval(Reducer &r, Reducer::Value *rval) -> Reducer::Value* { return r.undefined(); }
   virtual void dump(std::ostream &out, const std::string &indent = "") = 0;
@@ -184,6 +188,7 @@ public:
   Discard(Expr *x) : m_x(x) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -219,6 +224,7 @@ public:
   virtual bool is_argument_list() const override;
   virtual bool is_comma_ended() const override { return m_is_comma_ended; }
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
@@ -239,6 +245,7 @@ public:
     : m_exprs(std::move(exprs)) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -254,6 +261,7 @@ private:
 class Undefined : public Expr {
 public:
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 };
@@ -265,6 +273,7 @@ public:
 class Null : public Expr {
 public:
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 };
@@ -278,6 +287,7 @@ public:
   BooleanLiteral(bool b) : m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
@@ -294,6 +304,7 @@ public:
   NumberLiteral(double n) : m_n(n) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
@@ -312,6 +323,7 @@ public:
   auto s() const -> Str* { return m_s; }
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
@@ -408,6 +420,8 @@ private:
   std::unique_ptr<Stmt> m_output;
   Scope m_scope;
   Ref<Method> m_method;
+
+  void execute(Context &ctx, Value &result);
 };
 
 //
@@ -496,8 +510,13 @@ class LocalVariable : public Expr {
 public:
   LocalVariable(int i, int level) : m_i(i), m_level(level) {}
 
+  auto index() const -> int { return m_i; }
+  auto level() const -> int { return m_level; }
+
   virtual bool is_left_value() const override;
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
+  virtual bool compile_assign(Bytecode::Compiler &c, int src) override;
   virtual bool assign(Context &ctx, Value &value) override;
   virtual bool clear(Context &ctx, Value &result) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -535,6 +554,7 @@ public:
   Identifier(const std::string &key) : m_key(Str::make(key)) {}
 
   auto name() const -> Str* { return m_key; }
+  auto resolved() const -> Expr* { return m_resolved.get(); }
 
   virtual bool is_left_value() const override;
   virtual bool is_argument() const override;
@@ -542,6 +562,8 @@ public:
   virtual void unpack(std::vector<Ref<Str>> &vars) const override;
   virtual bool unpack(Context &ctx, Value &arg, int &var) override;
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
+  virtual bool compile_assign(Bytecode::Compiler &c, int src) override;
   virtual bool assign(Context &ctx, Value &value) override;
   virtual bool clear(Context &ctx, Value &result) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
@@ -569,10 +591,12 @@ private:
 
 class Property : public Expr {
 public:
-  Property(Expr *obj, Expr *key) : m_obj(obj), m_key(key) {}
+  Property(Expr *obj, Expr *key);
 
   virtual bool is_left_value() const override;
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
+  virtual bool compile_assign(Bytecode::Compiler &c, int src) override;
   virtual bool assign(Context &ctx, Value &value) override;
   virtual bool clear(Context &ctx, Value &result) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
@@ -580,10 +604,16 @@ public:
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  bool get(Context &ctx, Value &obj, Value &result);
+  bool get(Context &ctx, Value &obj, Value &key, Value &result);
+  bool set(Context &ctx, Value &obj, Value &value);
+  bool set(Context &ctx, Value &obj, Value &key, Value &value);
+
 private:
   std::unique_ptr<Expr> m_obj;
   std::unique_ptr<Expr> m_key;
   PropertyCache m_cache;
+  bool m_is_name;
 };
 
 //
@@ -592,17 +622,21 @@ private:
 
 class OptionalProperty : public Expr {
 public:
-  OptionalProperty(Expr *obj, Expr *key) : m_obj(obj), m_key(key) {}
+  OptionalProperty(Expr *obj, Expr *key);
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  bool get(Context &ctx, Value &obj, Value &result);
+
 private:
   std::unique_ptr<Expr> m_obj;
   std::unique_ptr<Expr> m_key;
   PropertyCache m_cache;
+  bool m_is_name;
 };
 
 //
@@ -633,11 +667,15 @@ public:
   Invocation(Expr *func, std::vector<std::unique_ptr<Expr>> &&argv) : m_func(func), m_argv(std::move(argv)) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual auto reduce(Reducer &r) -> Reducer::Value* override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  bool check(Context &ctx, Value &f);
+  bool call(Context &ctx, Value &f, int argc, Value *argv, Value &result);
+
 private:
   Module* m_module = nullptr;
   std::unique_ptr<Expr> m_func;
@@ -671,10 +709,13 @@ public:
   Plus(Expr *x) : m_x(x) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &x, Value &result);
+
 private:
   std::unique_ptr<Expr> m_x;
 };
@@ -688,10 +729,13 @@ public:
   Negation(Expr *x) : m_x(x) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &x, Value &result);
+
 private:
   std::unique_ptr<Expr> m_x;
 };
@@ -705,10 +749,13 @@ public:
   Addition(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -723,10 +770,13 @@ public:
   Subtraction(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -741,10 +791,13 @@ public:
   Multiplication(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -759,10 +812,13 @@ public:
   Division(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -777,10 +833,13 @@ public:
   Remainder(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -795,10 +854,13 @@ public:
   Exponentiation(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -813,10 +875,13 @@ public:
   ShiftLeft(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -831,10 +896,13 @@ public:
   ShiftRight(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -849,10 +917,13 @@ public:
   UnsignedShiftRight(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -867,10 +938,13 @@ public:
   BitwiseNot(Expr *x) : m_x(x) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &x, Value &result);
+
 private:
   std::unique_ptr<Expr> m_x;
 };
@@ -884,10 +958,13 @@ public:
   BitwiseAnd(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -902,10 +979,13 @@ public:
   BitwiseOr(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -920,10 +1000,13 @@ public:
   BitwiseXor(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -938,6 +1021,8 @@ public:
   LogicalNot(Expr *x) : m_x(x) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
+  virtual bool compile_branch(Bytecode::Compiler &c, bool when, int &jump) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -955,6 +1040,7 @@ public:
   LogicalAnd(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -973,6 +1059,7 @@ public:
   LogicalOr(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -991,6 +1078,7 @@ public:
   NullishCoalescing(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -1009,10 +1097,13 @@ public:
   Equality(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -1027,10 +1118,13 @@ public:
   Inequality(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -1042,9 +1136,11 @@ private:
 
 class Identity : public Expr {
 public:
-  Identity(Expr *a, Expr *b) : m_a(a), m_b(b) {}
+  Identity(Expr *a, Expr *b);
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
+  virtual bool compile_branch(Bytecode::Compiler &c, bool when, int &jump) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -1052,6 +1148,7 @@ public:
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
+  Ref<Str> m_s;
 };
 
 //
@@ -1060,9 +1157,11 @@ private:
 
 class Nonidentity : public Expr {
 public:
-  Nonidentity(Expr *a, Expr *b) : m_a(a), m_b(b) {}
+  Nonidentity(Expr *a, Expr *b);
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
+  virtual bool compile_branch(Bytecode::Compiler &c, bool when, int &jump) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -1070,6 +1169,7 @@ public:
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
+  Ref<Str> m_s;
 };
 
 //
@@ -1081,10 +1181,13 @@ public:
   GreaterThan(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -1099,10 +1202,13 @@ public:
   GreaterThanOrEqual(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -1117,10 +1223,13 @@ public:
   LessThan(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -1135,10 +1244,13 @@ public:
   LessThanOrEqual(Expr *a, Expr *b) : m_a(a), m_b(b) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
 
+  static void operate(Value &a, Value &b, Value &result);
+
 private:
   std::unique_ptr<Expr> m_a;
   std::unique_ptr<Expr> m_b;
@@ -1305,6 +1417,7 @@ public:
   virtual bool is_argument() const override;
   virtual void to_arguments(std::vector<Ref<Str>> &args, std::vector<Ref<Str>> &vars) const override;
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual bool unpack(Context &ctx, Value &arg, int &var) override;
@@ -1596,6 +1709,7 @@ public:
   Conditional(Expr *a, Expr *b, Expr *c) : m_a(a), m_b(b), m_c(c) {}
 
   virtual bool eval(Context &ctx, Value &result) override;
+  virtual bool compile(Bytecode::Compiler &c, int dst) override;
   virtual bool declare(Module *module, Scope &scope, Error &error) override;
   virtual void resolve(Module *module, Context &ctx, int l, LegacyImports *imports) override;
   virtual void dump(std::ostream &out, const std::string &indent) override;
@@ -27,6 +27,7 @@
 #define PJS_HPP
 
 #include "types.hpp"
+#include "bytecode.hpp"
 #include "expr.hpp"
 #include "stmt.hpp"
 #include "module.hpp"
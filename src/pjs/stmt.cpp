@@ -132,10 +132,11 @@ bool Evaluate::declare(Module *module, Tree::Scope &scope, Error &error) {
 
 void Evaluate::resolve(Module *module, Context &ctx, int l, Tree::LegacyImports *imports) {
   m_expr->resolve(module, ctx, l, imports);
+  compile(m_expr.get(), m_code);
 }
 
 void Evaluate::execute(Context &ctx, Result &result) {
-  if (m_expr->eval(ctx, result.value)) {
+  if (eval(ctx, m_expr.get(), m_code.get(), result.value)) {
     result.set_done();
     if (m_export) {
       auto obj = m_module->exports_object();
@@ -177,13 +178,14 @@ void Var::resolve(Module *module, Context &ctx, int l, Tree::LegacyImports *impo
   if (m_expr) {
     m_identifier->resolve(module, ctx, l, imports);
     m_expr->resolve(module, ctx, l, imports);
+    compile(m_expr.get(), m_code);
   }
 }
 
 void Var::execute(Context &ctx, Result &result) {
   if (m_expr) {
     Value val;
-    if (m_expr->eval(ctx, val) && m_identifier->assign(ctx, val)) {
+    if (eval(ctx, m_expr.get(), m_code.get(), val) && m_identifier->assign(ctx, val)) {
       result.set_done();
     }
   }
@@ -296,13 +298,14 @@ bool If::declare(Module *module, Tree::Scope &scope, Error &error) {
 
 void If::resolve(Module *module, Context &ctx, int l, Tree::LegacyImports *imports) {
   m_cond->resolve(module, ctx, l, imports);
+  compile(m_cond.get(), m_code);
   m_then->resolve(module, ctx, l, imports);
   if (m_else) m_else->resolve(module, ctx, l, imports);
 }
 
 void If::execute(Context &ctx, Result &result) {
   Value val;
-  if (!m_cond->eval(ctx, val)) return;
+  if (!eval(ctx, m_cond.get(), m_code.get(), val)) return;
 
   if (val.to_boolean()) {
     m_then->execute(ctx, result);
@@ -441,11 +444,12 @@ bool Return::declare(Module *module, Tree::Scope &scope, Error &error) {
 
 void Return::resolve(Module *module, Context &ctx, int l, Tree::LegacyImports *imports) {
   if (m_expr) m_expr->resolve(module, ctx, l, imports);
+  compile(m_expr.get(), m_code);
 }
 
 void Return::execute(Context &ctx, Result &result) {
   if (m_expr) {
-    if (m_expr->eval(ctx, result.value)) {
+    if (eval(ctx, m_expr.get(), m_code.get(), result.value)) {
       result.set_return();
     }
   } else {
@@ -507,6 +511,9 @@ Try::Try(Stmt *try_clause, Stmt *catch_clause, Stmt *finally_clause, Expr *excep
 bool Try::declare(Module *module, Tree::Scope &scope, Error &error) {
   if (!m_try->declare(module, scope, error)) return false;
   if (m_catch) {
+    auto s = &scope;
+    while (!s->is_root()) s = s->parent();
+    s->require_scope(); // the catch scope is chained onto it
     m_catch_scope.parent(&scope);
     if (!m_catch->declare(module, m_catch_scope, error)) return false;
   }
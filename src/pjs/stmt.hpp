@@ -76,6 +76,20 @@ public:
   //
 
   void execute(Context &ctx, Value &result);
+
+protected:
+
+  //
+  // Expressions run as bytecode when they could be compiled
+  //
+
+  static void compile(Expr *expr, std::unique_ptr<Bytecode> &code) {
+    code.reset(expr ? Bytecode::compile(expr) : nullptr);
+  }
+
+  static bool eval(Context &ctx, Expr *expr, Bytecode *code, Value &result) {
+    return code ? code->run(ctx, result) : expr->eval(ctx, result);
+  }
 };
 
 //
@@ -145,6 +159,7 @@ private:
   Module* m_module = nullptr;
   Export* m_export = nullptr;
   std::unique_ptr<Expr> m_expr;
+  std::unique_ptr<Bytecode> m_code;
 };
 
 //
@@ -166,6 +181,7 @@ private:
   std::unique_ptr<expr::Identifier> m_identifier;
   std::unique_ptr<Expr> m_resolved;
   std::unique_ptr<Expr> m_expr;
+  std::unique_ptr<Bytecode> m_code;
 
   bool check_reserved(const std::string &name, Error &error);
 
@@ -210,6 +226,7 @@ public:
 
 private:
   std::unique_ptr<Expr> m_cond;
+  std::unique_ptr<Bytecode> m_code;
   std::unique_ptr<Stmt> m_then;
   std::unique_ptr<Stmt> m_else;
 };
@@ -267,6 +284,7 @@ public:
 
 private:
   std::unique_ptr<Expr> m_expr;
+  std::unique_ptr<Bytecode> m_code;
 };
 
 //
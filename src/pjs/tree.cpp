@@ -117,41 +117,50 @@ void Tree::Scope::declare_fiber_var(Str *name, Module *module) {
 
 auto Tree::Scope::instantiate(Context &ctx) -> pjs::Scope* {
   init_variables();
-
   auto *scope = ctx.new_scope(m_args.size(), m_size, m_variables);
+  if (!init_values(ctx, scope->values())) return nullptr;
+  return scope;
+}
+
+bool Tree::Scope::instantiate(Context &ctx, Value *frame) {
+  init_variables();
+  ctx.new_frame(m_args.size(), frame);
+  return init_values(ctx, frame);
+}
 
+bool Tree::Scope::init_values(Context &ctx, Value *values) {
   // Initialize arguments
   for (const auto &init : m_init_args) {
-    auto &arg = scope->value(init.index);
+    auto &arg = values[init.index];
     if (auto v = init.value) { // Initialize locals
       if (!v->eval(ctx, arg)) {
-        return nullptr;
+        return false;
       }
     } else if (arg.is_undefined()) { // Populate default values
       if (auto v = init.default_value) {
         if (!v->eval(ctx, arg)) {
-          return nullptr;
+          return false;
         }
       }
     }
     if (auto v = init.unpack) { // Unpack objects
       auto index = init.unpack_index;
       if (!v->unpack(ctx, arg, index)) {
-        return nullptr;
+        return false;
       }
     }
   }
 
   // Initialize variables
   for (const auto &init : m_init_vars) {
-    auto &var = scope->value(init.index);
+    auto &var = values[init.index];
     if (auto v = init.value) {
       if (!v->eval(ctx, var)) { // Initialize locals
-        return nullptr;
+        return false;
       }
     }
   }
-  return scope;
+  return true;
 }
 
 void Tree::Scope::init_variables() {
@@ -127,7 +127,10 @@ public:
     auto args() const -> const std::vector<Ref<Str>> & { return m_args; }
     auto vars() const -> const std::vector<Ref<Str>> & { return m_vars; }
     auto variables() -> std::vector<pjs::Scope::Variable>& { init_variables(); return m_variables; }
+    void require_scope() { m_scope_required = true; }
+    bool is_scope_required() const { return m_scope_required; }
     auto instantiate(Context &ctx) -> pjs::Scope*;
+    bool instantiate(Context &ctx, Value *frame);
 
   private:
     struct InitArg {
@@ -153,8 +156,10 @@ public:
     std::list<InitVar> m_init_vars;
     size_t m_size = 0;
     bool m_initialized = false;
+    bool m_scope_required = false;
 
     void init_variables();
+    bool init_values(Context &ctx, Value *values);
   };
 
   //
@@ -30,6 +30,12 @@
 #include <cstring>
 #include <cmath>
 
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
 namespace pjs {
 
 //
@@ -41,14 +47,44 @@ auto Pool::all() -> std::map<std::string, Pool*> & {
   return a;
 }
 
+#ifdef _WIN32
+
+static auto slab_map(size_t size) -> char* {
+  return (char*)_aligned_malloc(size, 0x1000);
+}
+
+static void slab_unmap(char *base, size_t size) {
+  _aligned_free(base);
+}
+
+#else // !_WIN32
+
+static auto slab_map(size_t size) -> char* {
+  auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return p == MAP_FAILED ? nullptr : (char*)p;
+}
+
+static void slab_unmap(char *base, size_t size) {
+  munmap(base, size);
+}
+
+static void slab_release(char *base, size_t size) {
+  madvise(base, size, MADV_DONTNEED);
+}
+
+#endif // _WIN32
+
 Pool::Pool(const std::string &name, size_t size)
   : m_name(name)
   , m_size(std::max(size, sizeof(void*)))
-  , m_free_list(nullptr)
   , m_return_list(nullptr)
   , m_allocated(0)
   , m_pooled(0)
 {
+  m_stride = (sizeof(Head) + m_size + 15) & ~size_t(15);
+  m_slab_size = std::max(size_t(SLAB_SIZE), m_stride * SLAB_MIN_OBJECTS);
+  m_slab_size = (m_slab_size + 0xfff) & ~size_t(0xfff);
+  m_slab_capacity = m_slab_size / m_stride;
   retain();
   if (!name.empty()) {
     all()[name] = this;
@@ -56,31 +92,30 @@ Pool::Pool(const std::string &name, size_t size)
 }
 
 Pool::~Pool() {
-  for (auto *p = m_free_list; p; ) {
-    auto h = p; p = p->next;
-    std::free(h);
-  }
-  for (auto *p = m_return_list.load(); p; ) {
-    auto h = p; p = p->next;
-    std::free(h);
+  for (auto *s : m_slabs) {
+    slab_unmap(s->base, m_slab_size);
+    delete s;
   }
 }
 
 auto Pool::alloc() -> void* {
   accept_returns();
-  m_allocated++;
-  if (auto *h = m_free_list) {
-    m_free_list = h->next;
+  auto *s = m_current;
+  if (!s || (!s->free_list && s->carved == m_slab_capacity)) {
+    s = m_current = next_slab();
+  }
+  Head *h = s->free_list;
+  if (h) {
+    s->free_list = h->next;
     m_pooled--;
-    retain();
-    return (char*)h + sizeof(Head);
   } else {
-    h = (Head*)std::malloc(sizeof(Head) + m_size);
-    h->pool = this;
-    h->next = nullptr;
-    retain();
-    return (char*)h + sizeof(Head);
+    h = (Head*)(s->base + m_stride * s->carved++);
+    h->slab = s;
   }
+  s->used++;
+  m_allocated++;
+  retain();
+  return (char*)h + sizeof(Head);
 }
 
 void Pool::free(void *p) {
@@ -88,14 +123,107 @@ void Pool::free(void *p) {
   std::memset(p, 0xfe, m_size);
 #endif
   auto *h = (Head*)((char*)p - sizeof(Head));
-  if (h->pool == this) {
-    h->next = m_free_list;
-    m_free_list = h;
-    m_allocated--;
-    m_pooled++;
+  auto *pool = h->slab->pool;
+  if (pool == this) {
+    free_to_slab(h);
     release();
   } else {
-    h->pool->add_return(h);
+    pool->add_return(h);
+  }
+}
+
+//
+// Takes the slab at the front of the partial list, which is one that has
+// most recently got room after being full, then a released slab, and
+// maps a new one only when there is neither
+//
+
+auto Pool::next_slab() -> Slab* {
+  if (auto *s = m_partial_head) {
+    unlink_partial(s);
+    return s;
+  }
+
+  if (auto *s = m_released) {
+    m_released = s->next;
+    m_released_count--;
+    s->next = nullptr;
+    s->released = false;
+    m_slab_count++;
+    return s;
+  }
+
+  auto base = slab_map(m_slab_size);
+  if (!base) throw std::bad_alloc();
+  auto *s = new Slab;
+  s->pool = this;
+  s->base = base;
+  m_slabs.push_back(s);
+  m_slab_count++;
+  return s;
+}
+
+void Pool::release_slab(Slab *slab) {
+  if (slab == m_current) m_current = nullptr; else unlink_partial(slab);
+  m_pooled -= slab->carved;
+  m_slab_count--;
+  slab->free_list = nullptr;
+  slab->carved = 0;
+
+#ifndef _WIN32
+  if (m_released_count < SLAB_MAX_RELEASED) {
+    slab_release(slab->base, m_slab_size);
+    slab->released = true;
+    slab->next = m_released;
+    m_released = slab;
+    m_released_count++;
+    return;
+  }
+#endif
+
+  slab_unmap(slab->base, m_slab_size);
+  m_slabs.erase(std::find(m_slabs.begin(), m_slabs.end(), slab));
+  delete slab;
+}
+
+void Pool::link_partial(Slab *slab, bool front) {
+  slab->partial = true;
+  if (front) {
+    slab->prev = nullptr;
+    slab->next = m_partial_head;
+    if (m_partial_head) m_partial_head->prev = slab; else m_partial_tail = slab;
+    m_partial_head = slab;
+  } else {
+    slab->prev = m_partial_tail;
+    slab->next = nullptr;
+    if (m_partial_tail) m_partial_tail->next = slab; else m_partial_head = slab;
+    m_partial_tail = slab;
+  }
+}
+
+void Pool::unlink_partial(Slab *slab) {
+  if (!slab->partial) return;
+  if (slab->prev) slab->prev->next = slab->next; else m_partial_head = slab->next;
+  if (slab->next) slab->next->prev = slab->prev; else m_partial_tail = slab->prev;
+  slab->prev = slab->next = nullptr;
+  slab->partial = false;
+}
+
+void Pool::free_to_slab(Head *h) {
+  auto *s = h->slab;
+  auto was_full = (s->used == m_slab_capacity);
+  h->next = s->free_list;
+  s->free_list = h;
+  s->used--;
+  m_allocated--;
+  m_pooled++;
+  if (s != m_current) {
+    if (was_full) {
+      link_partial(s, true);
+    } else if (!s->used) {
+      unlink_partial(s);
+      link_partial(s, false);
+    }
   }
 }
 
@@ -118,17 +246,16 @@ void Pool::accept_returns() {
       std::memory_order_acquire,
       std::memory_order_relaxed
     )) {}
-    int n = 1;
-    auto *p = h;
-    while (p->next) {p = p->next; n++; }
-    p->next = m_free_list;
-    m_free_list = h;
-    m_allocated -= n;
-    m_pooled += n;
+    while (h) {
+      auto *next = h->next;
+      free_to_slab(h);
+      h = next;
+    }
   }
 }
 
 void Pool::clean() {
+  accept_returns();
   int max = 0;
   for (int i = 0; i < CURVE_LENGTH; i++) {
     if (m_curve[i] > max) max = m_curve[i];
@@ -136,10 +263,12 @@ void Pool::clean() {
   int room = max + (max >> 2) - m_allocated;
   if (room >= 0) {
     while (m_pooled > room) {
-      auto *h = m_free_list;
-      m_free_list = h->next;
-      std::free(h);
-      m_pooled--;
+      auto *s = m_partial_tail;
+      if (!s || s->used > 0) break;
+      release_slab(s);
+    }
+    if (m_pooled > room && m_current && !m_current->used && m_current->carved > 0) {
+      release_slab(m_current);
     }
   }
   m_curve[m_curve_pointer++ % CURVE_LENGTH] = m_allocated;
@@ -2032,6 +2161,7 @@ auto String::fill(char *buf, size_t size, Str *str, int n) -> size_t {
   auto l = str->length();
   auto s = str->size();
   size_t p = 0;
+  if (!s) return 0;
   while (p + s <= size) {
     if (n >= l) {
       std::memcpy(buf + p, str->c_str(), s);
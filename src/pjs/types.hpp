@@ -172,28 +172,78 @@ public:
   auto size() const -> size_t { return m_size; }
   auto allocated() const -> int { return m_allocated; }
   auto pooled() const -> int { return m_pooled; }
+  auto slabs() const -> int { return m_slab_count; }
+  auto released() const -> int { return m_released_count; }
+  auto capacity() const -> int { return m_slab_count * m_slab_capacity; }
 
   auto alloc() -> void*;
   void free(void *p);
   void clean();
 
 private:
-  enum { CURVE_LENGTH = 3 };
+  enum {
+    CURVE_LENGTH = 3,
+    SLAB_SIZE = 0x10000,
+    SLAB_MIN_OBJECTS = 8,
+    SLAB_MAX_RELEASED = 16,
+  };
+
+  struct Slab;
 
   struct Head {
-    Pool* pool;
+    Slab* slab;
     Head* next;
   };
 
+  //
+  // Pool::Slab
+  //
+  // A page-aligned block of memory carved into objects of the same size.
+  // Objects are carved on demand so that untouched pages are never faulted in.
+  //
+  // Apart from the current one, a slab with room left is on the partial
+  // list, and a released slab is on the released list. Full slabs are on
+  // neither. Slabs that have just got room are put at the front of the
+  // partial list and those that have become empty at the back, so that
+  // allocation packs objects into the fuller slabs and lets empty ones be
+  // released from the back.
+  //
+
+  struct Slab {
+    Pool* pool;
+    char* base;
+    Head* free_list = nullptr;
+    Slab* prev = nullptr;
+    Slab* next = nullptr;
+    int used = 0;
+    int carved = 0;
+    bool partial = false;
+    bool released = false;
+  };
+
   std::string m_name;
   size_t m_size;
-  Head* m_free_list;
+  size_t m_stride;
+  size_t m_slab_size;
+  int m_slab_capacity;
+  std::vector<Slab*> m_slabs;
+  Slab* m_current = nullptr;
+  Slab* m_partial_head = nullptr;
+  Slab* m_partial_tail = nullptr;
+  Slab* m_released = nullptr;
   std::atomic<Head*> m_return_list;
   int m_allocated;
   int m_pooled;
+  int m_slab_count = 0;
+  int m_released_count = 0;
   int m_curve[CURVE_LENGTH] = { 0 };
   size_t m_curve_pointer = 0;
 
+  auto next_slab() -> Slab*;
+  void release_slab(Slab *slab);
+  void link_partial(Slab *slab, bool front);
+  void unlink_partial(Slab *slab);
+  void free_to_slab(Head *h);
   void add_return(Head *h);
   void accept_returns();
 
@@ -2198,26 +2248,32 @@ public:
     bool is_closure = false;
   };
 
+  //
+  // Scopes with no more variables than this keep their values inline
+  //
+
+  static const size_t MAX_INLINE_SIZE = 8;
+
   static auto make(Instance *instance, Scope *parent, size_t size, std::vector<Variable> &variables) -> Scope* {
     return new Scope(instance, parent, size, variables);
   }
 
   auto parent() const -> Scope* { return m_parent; }
-  auto size() const -> size_t { return m_data->size(); }
-  auto value(int i) -> Value& { return m_data->at(i); }
-  auto values() -> Value* { return m_data->elements(); }
+  auto size() const -> size_t { return m_size; }
+  auto value(int i) -> Value& { return m_values[i]; }
+  auto values() -> Value* { return m_values; }
   auto variables() const -> std::vector<Variable>& { return m_variables; }
 
   void init(int argc, const Value *args) {
-    auto data = m_data->elements();
-    auto size = m_data->size();
+    auto data = m_values;
+    auto size = m_size;
     for (int i = 0; i < argc; i++) data[i] = args[i];
     for (int i = argc; i < size; i++) data[i] = Value::undefined;
   }
 
   void clear(bool all = false) {
-    auto values = m_data->elements();
-    for (size_t i = 0, n = m_data->size(); i < n; i++) {
+    auto values = m_values;
+    for (size_t i = 0, n = m_size; i < n; i++) {
       if (all || !m_variables[i].is_closure) {
         values[i] = Value::undefined;
       }
@@ -2228,11 +2284,21 @@ private:
   Scope(Instance *instance, Scope *parent, size_t size, std::vector<Variable> &variables)
     : m_instance(instance)
     , m_parent(parent)
-    , m_data(Data::make(size))
-    , m_variables(variables) { if (instance) instance->add(this); }
+    , m_size(size)
+    , m_data(size > MAX_INLINE_SIZE ? Data::make(size) : nullptr)
+    , m_values(m_data ? m_data->elements() : reinterpret_cast<Value*>(m_inline))
+    , m_variables(variables)
+  {
+    if (!m_data) for (size_t i = 0; i < size; i++) new (m_values + i) Value();
+    if (instance) instance->add(this);
+  }
 
   ~Scope() {
-    m_data->free();
+    if (m_data) {
+      m_data->free();
+    } else {
+      for (size_t i = 0; i < m_size; i++) m_values[i].~Value();
+    }
     if (m_instance) m_instance->remove(this);
   }
 
@@ -2240,8 +2306,11 @@ private:
   Scope* m_prev;
   Scope* m_next;
   Ref<Scope> m_parent;
+  size_t m_size;
   Data* m_data;
+  Value* m_values;
   std::vector<Variable> &m_variables;
+  std::aligned_storage<sizeof(Value), alignof(Value)>::type m_inline[MAX_INLINE_SIZE];
 
   friend class RefCount<Scope>;
   friend class Instance;
@@ -2276,7 +2345,7 @@ public:
     , m_argv(nullptr)
     , m_error(std::make_shared<Error>()) {}
 
-  Context(Context &ctx, int argc, Value *argv, Scope *scope)
+  Context(Context &ctx, int argc, Value *argv, Scope *scope, Method *callee = nullptr)
     : m_instance(ctx.m_instance)
     , m_parent(s_current)
     , m_root(ctx.m_root)
@@ -2287,6 +2356,7 @@ public:
     , m_level(ctx.m_level + 1)
     , m_argc(argc)
     , m_argv(argv)
+    , m_callee(callee)
     , m_error(ctx.m_error) { s_current = this; }
 
   ~Context() { if (s_current == this) s_current = m_parent; }
@@ -2294,11 +2364,13 @@ public:
   auto instance() const -> Instance* { return m_instance; }
   auto root() const -> Context* { return m_root; }
   auto caller() const -> Context* { return m_caller; }
+  auto callee() const -> Method* { return m_callee; }
   auto g() const -> Object* { return m_g; }
   auto l(int i) const -> Object* { return i >= 0 && m_l ? m_l[i].get() : nullptr; }
   auto fiber() const -> Fiber* { return m_fiber; }
   auto scope() const -> Scope* { return m_scope; }
   void scope(Scope *scope) { m_scope = scope; }
+  auto frame() const -> Value* { return m_frame; }
   auto level() const -> int { return m_level; }
   auto argc() const -> int { return m_argc; }
   auto argv() const -> Value* { return m_argv; }
@@ -2330,6 +2402,28 @@ public:
     return scope;
   }
 
+  //
+  // A function that no closure or catch clause can refer back to keeps
+  // its variables in a frame owned by the caller rather than in a Scope.
+  // The scope of such a context is then the one its function closed over.
+  //
+
+  void new_frame(int argc, Value *values) {
+    auto n = std::min(m_argc, argc);
+    for (int i = 0; i < n; i++) values[i] = m_argv[i];
+    m_frame = values;
+  }
+
+  auto local(int i, int level) -> Value& {
+    Scope *scope = m_scope;
+    if (m_frame) {
+      if (!level) return m_frame[i];
+      level--;
+    }
+    while (level-- > 0) scope = scope->parent();
+    return scope->value(i);
+  }
+
   bool is_undefined(int i) const { return i >= argc() || arg(i).is_undefined(); }
   bool is_null(int i) const { return i < argc() && arg(i).is_null(); }
   bool is_nullish(int i) const { return i < argc() && arg(i).is_nullish(); }
@@ -2533,9 +2627,11 @@ private:
   Ref<Object> m_g, *m_l;
   Ref<Fiber> m_fiber;
   Ref<Scope> m_scope;
+  Value* m_frame = nullptr;
   int m_level;
   int m_argc;
   Value* m_argv;
+  Method* m_callee = nullptr;
   Location m_call_site;
   bool m_has_error = false;
   std::shared_ptr<Error> m_error;
@@ -2777,7 +2873,7 @@ public:
   auto constructor_class() const -> Class* { return m_constructor_class; }
 
   void invoke(Context &ctx, Scope *scope, Object *thiz, int argc, Value argv[], Value &retv) {
-    Context fctx(ctx, argc, argv, scope);
+    Context fctx(ctx, argc, argv, scope, this);
     retv = Value::undefined;
     if (fctx.level() > 100) {
       fctx.error("call stack overflow");
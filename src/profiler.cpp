@@ -0,0 +1,611 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "profiler.hpp"
+#include "filter.hpp"
+#include "pipeline.hpp"
+#include "module.hpp"
+#include "api/zlib.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <set>
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <mutex>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif // __linux__
+
+namespace pipy {
+
+static Data::Producer s_dp("Profiler");
+
+//
+// Profiler::Profile
+//
+
+void Profiler::Profile::merge(const Profile &other) {
+  frequency = other.frequency;
+  duration = std::max(duration, other.duration);
+  samples += other.samples;
+  dropped += other.dropped;
+  for (const auto &p : other.stacks) {
+    stacks[p.first] += p.second;
+  }
+}
+
+static auto frame_label(const Profiler::Frame &f) -> std::string {
+  auto label = f.name;
+  if (!f.file.empty()) {
+    label += " (";
+    label += f.file;
+    if (f.line > 0) {
+      label += ':';
+      label += std::to_string(f.line);
+    }
+    label += ')';
+  }
+  for (auto &c : label) if (c == ';' || c == '\n') c = ':';
+  return label;
+}
+
+void Profiler::Profile::to_folded(Data &out) const {
+  Data::Builder db(out, &s_dp);
+  for (const auto &p : stacks) {
+    bool first = true;
+    for (const auto &f : p.first) {
+      if (!first) db.push(';');
+      db.push(frame_label(f));
+      first = false;
+    }
+    db.push(' ');
+    db.push(std::to_string(p.second));
+    db.push('\n');
+  }
+  db.flush();
+}
+
+//
+// Minimal protobuf writer for profile.proto
+//
+
+class ProtobufWriter {
+public:
+  auto str() const -> const std::string& { return m_buf; }
+
+  void varint(int field, uint64_t v) {
+    key(field, 0);
+    raw_varint(v);
+  }
+
+  void bytes(int field, const std::string &s) {
+    key(field, 2);
+    raw_varint(s.size());
+    m_buf += s;
+  }
+
+  void packed(int field, const std::vector<uint64_t> &values) {
+    ProtobufWriter w;
+    for (auto v : values) w.raw_varint(v);
+    bytes(field, w.str());
+  }
+
+private:
+  std::string m_buf;
+
+  void key(int field, int type) {
+    raw_varint((uint64_t(field) << 3) | type);
+  }
+
+  void raw_varint(uint64_t v) {
+    while (v >= 0x80) {
+      m_buf += char(v | 0x80);
+      v >>= 7;
+    }
+    m_buf += char(v);
+  }
+};
+
+void Profiler::Profile::to_pprof(Data &out) const {
+  std::vector<std::string> strings;
+  std::map<std::string, uint64_t> string_ids;
+  std::map<Frame, uint64_t> frame_ids;
+
+  auto string_id = [&](const std::string &s) -> uint64_t {
+    auto i = string_ids.find(s);
+    if (i != string_ids.end()) return i->second;
+    auto id = strings.size();
+    strings.push_back(s);
+    string_ids[s] = id;
+    return id;
+  };
+
+  string_id("");
+
+  auto value_type = [&](const std::string &type, const std::string &unit) {
+    ProtobufWriter w;
+    w.varint(1, string_id(type));
+    w.varint(2, string_id(unit));
+    return w.str();
+  };
+
+  ProtobufWriter profile;
+  profile.bytes(1, value_type("samples", "count"));
+  profile.bytes(1, value_type("cpu", "nanoseconds"));
+
+  uint64_t period = frequency > 0 ? 1000000000 / frequency : 0;
+
+  for (const auto &p : stacks) {
+    std::vector<uint64_t> locations;
+    for (auto i = p.first.rbegin(); i != p.first.rend(); ++i) {
+      auto &id = frame_ids[*i];
+      if (!id) id = frame_ids.size();
+      locations.push_back(id);
+    }
+    ProtobufWriter sample;
+    sample.packed(1, locations);
+    sample.packed(2, { p.second, p.second * period });
+    profile.bytes(2, sample.str());
+  }
+
+  for (const auto &p : frame_ids) {
+    const auto &f = p.first;
+    ProtobufWriter line;
+    line.varint(1, p.second);
+    line.varint(2, f.line);
+    ProtobufWriter location;
+    location.varint(1, p.second);
+    location.bytes(4, line.str());
+    profile.bytes(4, location.str());
+  }
+
+  for (const auto &p : frame_ids) {
+    const auto &f = p.first;
+    ProtobufWriter function;
+    function.varint(1, p.second);
+    function.varint(2, string_id(f.name));
+    function.varint(3, string_id(f.name));
+    function.varint(4, string_id(f.file));
+    profile.bytes(5, function.str());
+  }
+
+  auto period_type = value_type("cpu", "nanoseconds");
+
+  for (const auto &s : strings) profile.bytes(6, s);
+
+  profile.varint(9, uint64_t(utils::now() - duration * 1000) * 1000000);
+  profile.varint(10, uint64_t(duration * 1000000000));
+  profile.bytes(11, period_type);
+  profile.varint(12, period);
+
+  Data raw(profile.str(), &s_dp);
+  ZLib::gzip(raw, out);
+}
+
+#ifdef __linux__
+
+//
+// Sampling state
+//
+// Everything written by the signal handler is preallocated and lives in
+// plain thread-local storage, so that the handler never allocates.
+//
+
+static const int MAX_NATIVE_FRAMES = 48;
+static const int MAX_SCRIPT_FRAMES = 8;
+static const int MAX_NAME_LENGTH = 48;
+
+struct ScriptFrame {
+  char name[MAX_NAME_LENGTH];
+  char file[MAX_NAME_LENGTH];
+  int line;
+};
+
+struct Sample {
+  void* pcs[MAX_NATIVE_FRAMES];
+  ScriptFrame scripts[MAX_SCRIPT_FRAMES];
+  PipelineLayout* layout;
+  int filter;
+  int pc_count;
+  int script_count;
+};
+
+struct SamplingState {
+  Sample* samples;
+  size_t capacity;
+  size_t count;
+  uint64_t dropped;
+  timer_t timer;
+  int frequency;
+  double start_time;
+  volatile sig_atomic_t running;
+};
+
+static thread_local SamplingState s_state;
+
+static void copy_name(char *dst, const char *src) {
+  int i = 0;
+  if (src) while (i < MAX_NAME_LENGTH - 1 && src[i]) { dst[i] = src[i]; i++; }
+  dst[i] = 0;
+}
+
+static void on_sigprof(int, siginfo_t*, void*) {
+  auto &s = s_state;
+  if (!s.running) return;
+  if (s.count >= s.capacity) {
+    s.dropped++;
+    return;
+  }
+
+  auto saved_errno = errno;
+  auto &sample = s.samples[s.count];
+  sample.pc_count = backtrace(sample.pcs, MAX_NATIVE_FRAMES);
+
+  int n = 0;
+  for (auto ctx = pjs::Context::current(); ctx && n < MAX_SCRIPT_FRAMES; ctx = ctx->caller()) {
+    if (auto m = ctx->callee()) {
+      auto &f = sample.scripts[n++];
+      auto &l = ctx->call_site();
+      copy_name(f.name, m->name()->c_str());
+      copy_name(f.file, l.source ? l.source->filename.c_str() : nullptr);
+      f.line = l.line;
+    }
+  }
+  sample.script_count = n;
+
+  if (auto f = Filter::current()) {
+    sample.layout = f->pipeline_layout();
+    sample.filter = f->index();
+  } else {
+    sample.layout = nullptr;
+    sample.filter = -1;
+  }
+
+  std::atomic_signal_fence(std::memory_order_release);
+  s.count++;
+  errno = saved_errno;
+}
+
+//
+// Native frames where PipyJS code is entered
+//
+
+static bool is_script_entry(const std::string &name) {
+  static const std::string prefix("std::_Function_handler<void (pjs::Context&, pjs::Object*, pjs::Value&)");
+  return name.compare(0, prefix.length(), prefix) == 0;
+}
+
+static bool is_filter_callback(const std::string &name) {
+  return (
+    name.compare(0, 23, "pipy::Filter::callback(") == 0 ||
+    name.compare(0, 19, "pipy::Filter::eval(") == 0
+  );
+}
+
+//
+// Native symbols
+//
+// Looked up from the symbol table of the executable so that internal
+// functions are named as well, falling back to dladdr() for shared
+// libraries and to module+offset when nothing is found.
+//
+
+class SymbolTable {
+public:
+  static auto get() -> SymbolTable& {
+    static SymbolTable s_table;
+    return s_table;
+  }
+
+  auto lookup(void *pc) const -> Profiler::Frame {
+    Profiler::Frame frame;
+    auto addr = uintptr_t(pc);
+    auto i = std::upper_bound(
+      m_symbols.begin(), m_symbols.end(), addr,
+      [](uintptr_t a, const Symbol &s) { return a < s.addr; }
+    );
+    if (i != m_symbols.begin()) {
+      --i;
+      if (addr < i->addr + std::max<size_t>(i->size, 1)) {
+        frame.name = demangle(i->name.c_str());
+        return frame;
+      }
+    }
+    Dl_info info;
+    if (dladdr(pc, &info) && info.dli_fname) {
+      if (info.dli_sname) {
+        frame.name = demangle(info.dli_sname);
+      } else {
+        char str[32];
+        std::snprintf(str, sizeof(str), "+0x%zx", size_t(addr - uintptr_t(info.dli_fbase)));
+        auto path = std::string(info.dli_fname);
+        auto p = path.find_last_of('/');
+        frame.name = (p == std::string::npos ? path : path.substr(p + 1)) + str;
+      }
+    } else {
+      char str[32];
+      std::snprintf(str, sizeof(str), "0x%zx", size_t(addr));
+      frame.name = str;
+    }
+    return frame;
+  }
+
+private:
+  struct Symbol {
+    uintptr_t addr;
+    size_t size;
+    std::string name;
+    bool operator<(const Symbol &r) const { return addr < r.addr; }
+  };
+
+  std::vector<Symbol> m_symbols;
+
+  SymbolTable() {
+    auto fd = open("/proc/self/exe", O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (!fstat(fd, &st) && size_t(st.st_size) > sizeof(ElfW(Ehdr))) {
+      map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) return;
+    load((const uint8_t *)map, st.st_size);
+    munmap(map, st.st_size);
+    std::sort(m_symbols.begin(), m_symbols.end());
+  }
+
+  void load(const uint8_t *data, size_t size) {
+    auto &hdr = *(const ElfW(Ehdr) *)data;
+    if (std::memcmp(hdr.e_ident, ELFMAG, SELFMAG)) return;
+    if (hdr.e_shoff + hdr.e_shnum * sizeof(ElfW(Shdr)) > size) return;
+
+    uintptr_t base = 0;
+    if (hdr.e_type == ET_DYN) {
+      dl_iterate_phdr(
+        [](struct dl_phdr_info *info, size_t, void *data) {
+          *(uintptr_t *)data = info->dlpi_addr;
+          return 1;
+        },
+        &base
+      );
+    }
+
+    auto sections = (const ElfW(Shdr) *)(data + hdr.e_shoff);
+    for (int i = 0; i < hdr.e_shnum; i++) {
+      auto &sec = sections[i];
+      if (sec.sh_type != SHT_SYMTAB || sec.sh_link >= hdr.e_shnum) continue;
+      auto &str = sections[sec.sh_link];
+      if (sec.sh_offset + sec.sh_size > size) continue;
+      if (str.sh_offset + str.sh_size > size) continue;
+      auto syms = (const ElfW(Sym) *)(data + sec.sh_offset);
+      auto strs = (const char *)(data + str.sh_offset);
+      auto n = sec.sh_size / sizeof(ElfW(Sym));
+      for (size_t j = 0; j < n; j++) {
+        auto &sym = syms[j];
+        if (ELF64_ST_TYPE(sym.st_info) != STT_FUNC) continue;
+        if (!sym.st_value || sym.st_name >= str.sh_size) continue;
+        m_symbols.push_back({ base + sym.st_value, sym.st_size, strs + sym.st_name });
+      }
+    }
+  }
+
+  static auto demangle(const char *name) -> std::string {
+    int status = 0;
+    auto s = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (!s) return name;
+    std::string str(s);
+    std::free(s);
+    return str;
+  }
+};
+
+bool Profiler::supported() {
+  return true;
+}
+
+bool Profiler::start(int frequency, double duration) {
+  static std::once_flag s_once;
+  std::call_once(s_once, []() {
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = on_sigprof;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGPROF, &sa, nullptr);
+  });
+
+  auto &s = s_state;
+  if (s.samples) return false;
+
+  // Let backtrace() load what it needs before any signal arrives
+  void *pcs[2];
+  backtrace(pcs, 2);
+
+  s.capacity = std::min<size_t>(size_t(frequency * duration) + 16, MAX_SAMPLES);
+  s.samples = new Sample[s.capacity];
+  s.count = 0;
+  s.dropped = 0;
+  s.frequency = frequency;
+  s.start_time = utils::now();
+
+  struct sigevent sev;
+  std::memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_THREAD_ID;
+  sev.sigev_signo = SIGPROF;
+  sev.sigev_notify_thread_id = syscall(SYS_gettid);
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &s.timer)) {
+    delete [] s.samples;
+    s.samples = nullptr;
+    return false;
+  }
+
+  auto interval = 1000000000L / frequency;
+  struct itimerspec its;
+  its.it_interval.tv_sec = interval / 1000000000L;
+  its.it_interval.tv_nsec = interval % 1000000000L;
+  its.it_value = its.it_interval;
+  s.running = 1;
+  Filter::track_current(true);
+  timer_settime(s.timer, 0, &its, nullptr);
+  return true;
+}
+
+void Profiler::stop(Profile &profile) {
+  auto &s = s_state;
+  if (!s.samples) return;
+
+  s.running = 0;
+  timer_delete(s.timer);
+  Filter::track_current(false);
+  std::atomic_signal_fence(std::memory_order_acquire);
+
+  std::set<PipelineLayout*> layouts;
+  PipelineLayout::for_each([&](PipelineLayout *p) { layouts.insert(p); });
+
+  auto &symbols = SymbolTable::get();
+  std::map<void*, Frame> natives;
+
+  profile.frequency = s.frequency;
+  profile.duration = (utils::now() - s.start_time) / 1000;
+  profile.samples = s.count;
+  profile.dropped = s.dropped;
+
+  std::vector<Frame> stack;
+  for (size_t i = 0; i < s.count; i++) {
+    auto &sample = s.samples[i];
+    stack.clear();
+
+    Filter *filter = nullptr;
+    if (layouts.count(sample.layout)) {
+      auto layout = sample.layout;
+      Frame f;
+      f.name = "[pipeline] " + layout->name_or_label()->str();
+      if (auto mod = dynamic_cast<Module*>(layout->module())) {
+        if (auto name = mod->filename()) f.file = name->str();
+      }
+      stack.push_back(std::move(f));
+      if ((filter = layout->filter(sample.filter))) {
+        Filter::Dump d;
+        filter->dump(d);
+        Frame f;
+        f.name = "[filter] " + d.name;
+        if (auto src = filter->location().source) {
+          f.file = src->filename;
+          f.line = filter->location().line;
+        }
+        stack.push_back(std::move(f));
+      }
+    }
+
+    // Skip the signal handler and the signal trampoline
+    int top = sample.pc_count;
+    int bottom = std::min(2, top);
+    std::vector<const Frame*> frames;
+    for (int j = bottom; j < top; j++) {
+      auto pc = sample.pcs[j];
+      auto it = natives.find(pc);
+      if (it == natives.end()) it = natives.emplace(pc, symbols.lookup(pc)).first;
+      if (filter && it->second.name.compare(0, 23, "pipy::Filter::on_event(") == 0) break;
+      frames.push_back(&it->second);
+    }
+
+    // Every PipyJS call goes through one std::function call in Method::invoke(),
+    // so script frames are matched with those from the innermost outwards, each
+    // going right above the native frame that entered it. Script frames left
+    // unmatched go above the outermost frame where a filter called into script,
+    // or right below the native frames when there is no such frame.
+    std::vector<int> entries(sample.script_count, -1);
+    int entry_from_filter = -1;
+    for (int j = 0, k = 0; j < int(frames.size()); j++) {
+      const auto &name = frames[j]->name;
+      if (k < sample.script_count && is_script_entry(name)) entries[k++] = j;
+      if (is_filter_callback(name)) entry_from_filter = j;
+    }
+
+    auto push_script = [&](int k) {
+      auto &sf = sample.scripts[k];
+      Frame f;
+      f.name = sf.name;
+      f.file = sf.file;
+      f.line = sf.line;
+      stack.push_back(std::move(f));
+    };
+
+    int k = sample.script_count - 1;
+    if (entry_from_filter < 0) {
+      while (k >= 0 && entries[k] < 0) push_script(k--);
+    }
+    for (int j = int(frames.size()) - 1; j >= 0; j--) {
+      stack.push_back(*frames[j]);
+      if (j == entry_from_filter) {
+        while (k >= 0 && entries[k] < 0) push_script(k--);
+      }
+      while (k >= 0 && entries[k] == j) push_script(k--);
+    }
+    while (k >= 0) push_script(k--);
+
+    profile.stacks[stack]++;
+  }
+
+  delete [] s.samples;
+  s.samples = nullptr;
+  s.count = 0;
+}
+
+#else // !__linux__
+
+bool Profiler::supported() {
+  return false;
+}
+
+bool Profiler::start(int frequency, double duration) {
+  return false;
+}
+
+void Profiler::stop(Profile &profile) {
+}
+
+#endif // __linux__
+
+} // namespace pipy
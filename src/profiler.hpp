@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 by flomesh.io
+ *
+ *  Unless prior written consent has been obtained from the copyright
+ *  owner, the following shall not be allowed.
+ *
+ *  1. The distribution of any source codes, header files, make files,
+ *     or libraries of the software.
+ *
+ *  2. Disclosure of any source codes pertaining to the software to any
+ *     additional parties.
+ *
+ *  3. Alteration or removal of any notices in or on the software or
+ *     within the documentation included within the software.
+ *
+ *  ALL SOURCE CODE AS WELL AS ALL DOCUMENTATION INCLUDED WITH THIS
+ *  SOFTWARE IS PROVIDED IN AN “AS IS” CONDITION, WITHOUT WARRANTY OF ANY
+ *  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ *  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ *  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ *  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "data.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace pipy {
+
+//
+// Profiler
+//
+// Samples the calling thread at a fixed rate of its own CPU time. Each
+// sample records the native stack, the PipyJS call stack and the filter
+// that was running. Nothing is done per event while no profiling is
+// going on, except that Filter keeps track of the current filter.
+//
+
+class Profiler {
+public:
+  enum {
+    MAX_FREQUENCY = 1000,
+    MAX_DURATION = 60,
+    MAX_SAMPLES = 20000,
+  };
+
+  //
+  // Profiler::Frame
+  //
+
+  struct Frame {
+    std::string name;
+    std::string file;
+    int line = 0;
+
+    bool operator<(const Frame &r) const {
+      if (name != r.name) return name < r.name;
+      if (file != r.file) return file < r.file;
+      return line < r.line;
+    }
+  };
+
+  //
+  // Profiler::Profile
+  //
+
+  struct Profile {
+    int frequency = 0;
+    double duration = 0;
+    uint64_t samples = 0;
+    uint64_t dropped = 0;
+    std::map<std::vector<Frame>, uint64_t> stacks; // root frames first
+
+    void merge(const Profile &other);
+    void to_folded(Data &out) const;
+    void to_pprof(Data &out) const;
+  };
+
+  static bool supported();
+
+  // Both are called on the thread being profiled
+  static bool start(int frequency, double duration);
+  static void stop(Profile &profile);
+};
+
+} // namespace pipy
+
+#endif // PROFILER_HPP
@@ -275,6 +275,7 @@ void SocketTCP::on_receive(const std::error_code &ec, std::size_t n) {
   if (ec != asio::error::operation_aborted && m_state != CLOSED) {
     if (n > 0) {
       m_buffer_receive.pop(m_buffer_receive.size() - n);
+      m_buffer_receive.compact(&s_dp);
       auto size = m_buffer_receive.size();
       m_traffic_read += size;
 
@@ -533,6 +534,7 @@ void SocketUDP::on_receive(Data *data, const std::error_code &ec, std::size_t n)
   if (ec != asio::error::operation_aborted && !m_closing) {
     if (n > 0) {
       data->pop(data->size() - n);
+      data->compact(&s_dp);
       auto size = data->size();
       m_traffic_read += size;
 
@@ -782,6 +784,7 @@ void SocketNetlink::on_receive(Data *data, const std::error_code &ec, std::size_
   if (ec != asio::error::operation_aborted && !m_closing) {
     if (n > 0) {
       data->pop(data->size() - n);
+      data->compact(&s_dp);
       auto size = data->size();
       m_traffic_read += size;
 
@@ -28,6 +28,7 @@
 #include "worker.hpp"
 #include "worker-thread.hpp"
 #include "module.hpp"
+#include "os-platform.hpp"
 #include "pipeline.hpp"
 #include "graph.hpp"
 #include "listener.hpp"
@@ -297,6 +298,11 @@ void Status::update_global() {
     }
   );
   timestamp = utils::now();
+
+  os::ThreadStats ts;
+  os::get_thread_stats(ts);
+  threads.erase({ -1 });
+  threads.insert({ -1, ts.cpu, ts.migrations, ts.switches, utils::make_cpu_list(ts.affinity) });
 }
 
 void Status::update_local() {
@@ -308,6 +314,7 @@ void Status::update_local() {
   buffers.clear();
   inbounds.clear();
   outbounds.clear();
+  threads.clear();
 
   std::map<std::string, std::set<PipelineLayout*>> all_modules;
   PipelineLayout::for_each([&](PipelineLayout *p) {
@@ -336,6 +343,8 @@ void Status::update_local() {
         (size_t)c->size(),
         (size_t)c->allocated(),
         (size_t)c->pooled(),
+        (size_t)c->slabs(),
+        (size_t)c->capacity(),
       });
     }
   }
@@ -350,10 +359,9 @@ void Status::update_local() {
 
   if (WorkerThread::current()->index() == 0) {
     Data::Producer::for_each([&](Data::Producer *producer) {
-      chunks.insert({
-        producer->name(),
-        producer->count(),
-      });
+      ChunkInfo ci{ producer->name(), producer->size() };
+      for (int i = 0; i < DATA_CHUNK_CLASSES; i++) ci.counts[i] = producer->count(i);
+      chunks.insert(ci);
     });
   }
 
@@ -440,6 +448,16 @@ void Status::update_local() {
   for (auto &p : outbound_tcp) outbounds.insert(p.second);
   for (auto &p : outbound_udp) outbounds.insert(p.second);
   for (auto &p : outbound_netlink) outbounds.insert(p.second);
+
+  os::ThreadStats ts;
+  os::get_thread_stats(ts);
+  threads.insert({
+    WorkerThread::current()->index(),
+    ts.cpu,
+    ts.migrations,
+    ts.switches,
+    utils::make_cpu_list(ts.affinity),
+  });
 }
 
 template<class T>
@@ -463,6 +481,7 @@ void Status::merge(const Status &other) {
   merge_sets(buffers, other.buffers);
   merge_sets(inbounds, other.inbounds);
   merge_sets(outbounds, other.outbounds);
+  threads.insert(other.threads.begin(), other.threads.end()); // one per thread, nothing to add up
 }
 
 bool Status::from_json(const Data &data, Data *metrics) {
@@ -567,16 +586,18 @@ static void print_table(Data::Builder &db, const T &header, const std::list<T> &
 }
 
 void Status::dump_pools(Data::Builder &db) {
-  std::list<std::array<std::string, 4>> rows;
+  std::list<std::array<std::string, 6>> rows;
   for (const auto &i : pools) {
     rows.push_back({
       i.name,
       std::to_string(i.size * (i.allocated + i.pooled)),
       std::to_string(i.allocated),
       std::to_string(i.pooled),
+      std::to_string(i.slabs),
+      std::to_string(i.capacity > 0 ? i.allocated * 100 / i.capacity : 0) + '%',
     });
   }
-  print_table(db, { "POOL", "SIZE", "#USED", "#SPARE" }, rows);
+  print_table(db, { "POOL", "SIZE", "#USED", "#SPARE", "#SLABS", "OCCUPANCY" }, rows);
 }
 
 void Status::dump_objects(Data::Builder &db) {
@@ -588,14 +609,22 @@ void Status::dump_objects(Data::Builder &db) {
 }
 
 void Status::dump_chunks(Data::Builder &db) {
-  std::list<std::array<std::string, 2>> rows;
+  std::array<std::string, 2 + DATA_CHUNK_CLASSES> header;
+  header[0] = "DATA";
+  header[1] = "SIZE(KB)";
+  for (int i = 0; i < DATA_CHUNK_CLASSES; i++) {
+    auto size = DATA_CHUNK_CLASS_SIZES[i];
+    header[2 + i] = '#' + (size < 1024 ? std::to_string(size) + 'B' : std::to_string(size / 1024) + "KB");
+  }
+  std::list<std::array<std::string, 2 + DATA_CHUNK_CLASSES>> rows;
   for (const auto &i : chunks) {
-    rows.push_back({
-      i.name,
-      std::to_string(DATA_CHUNK_SIZE * i.count / 1024),
-    });
+    std::array<std::string, 2 + DATA_CHUNK_CLASSES> row;
+    row[0] = i.name;
+    row[1] = std::to_string(i.size / 1024);
+    for (int j = 0; j < DATA_CHUNK_CLASSES; j++) row[2 + j] = std::to_string(i.counts[j]);
+    rows.push_back(row);
   }
-  print_table(db, { "DATA", "SIZE(KB)" }, rows);
+  print_table(db, header, rows);
 }
 
 void Status::dump_buffers(Data::Builder &db) {
@@ -670,6 +699,21 @@ void Status::dump_outbound(Data::Builder &db) {
   print_table(db, { "OUTBOUND", "PORT", "#CONNECTIONS", "BUFFERED(KB)" }, rows);
 }
 
+void Status::dump_threads(Data::Builder &db) {
+  static const std::string s_main("main");
+  std::list<std::array<std::string, 5>> rows;
+  for (const auto &i : threads) {
+    rows.push_back({
+      i.index < 0 ? s_main : std::to_string(i.index),
+      i.cpu < 0 ? "?" : std::to_string(i.cpu),
+      i.affinity,
+      std::to_string(i.migrations),
+      std::to_string(i.switches),
+    });
+  }
+  print_table(db, { "THREAD", "CPU", "AFFINITY", "#MIGRATIONS", "#PREEMPTIONS" }, rows);
+}
+
 void Status::dump_json(Data::Builder &db) {
   bool first;
   db.push('{');
@@ -685,6 +729,10 @@ void Status::dump_json(Data::Builder &db) {
     db.push(std::to_string(i.allocated));
     db.push(",\"pooled\":");
     db.push(std::to_string(i.pooled));
+    db.push(",\"slabs\":");
+    db.push(std::to_string(i.slabs));
+    db.push(",\"capacity\":");
+    db.push(std::to_string(i.capacity));
     db.push('}');
   }
   db.push("},\"chunks\":{");
@@ -694,7 +742,7 @@ void Status::dump_json(Data::Builder &db) {
     db.push('"');
     db.push(i.name);
     db.push("\":");
-    db.push(std::to_string(DATA_CHUNK_SIZE * i.count / 1024));
+    db.push(std::to_string(i.size / 1024));
   }
   db.push("},\"buffers\":{");
   first = true;
@@ -768,6 +816,22 @@ void Status::dump_json(Data::Builder &db) {
     db.push(std::to_string(i.buffered/1024));
     db.push('}');
   }
+  db.push("],\"threads\":[");
+  first = true;
+  for (const auto &i : threads) {
+    if (first) first = false; else db.push(',');
+    db.push("{\"index\":");
+    db.push(std::to_string(i.index));
+    db.push(",\"cpu\":");
+    db.push(std::to_string(i.cpu));
+    db.push(",\"affinity\":\"");
+    db.push(i.affinity);
+    db.push("\",\"migrations\":");
+    db.push(std::to_string(i.migrations));
+    db.push(",\"preemptions\":");
+    db.push(std::to_string(i.switches));
+    db.push('}');
+  }
   db.push(']');
   db.push('}');
 }
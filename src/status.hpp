@@ -70,6 +70,8 @@ public:
     size_t size;
     mutable size_t allocated;
     mutable size_t pooled;
+    mutable size_t slabs;
+    mutable size_t capacity;
 
     bool operator<(const PoolInfo &r) const {
       return name < r.name;
@@ -78,6 +80,8 @@ public:
     auto operator+=(const PoolInfo &r) const -> const PoolInfo& {
       allocated += r.allocated;
       pooled += r.pooled;
+      slabs += r.slabs;
+      capacity += r.capacity;
       return *this;
     }
   };
@@ -98,14 +102,16 @@ public:
 
   struct ChunkInfo {
     std::string name;
-    mutable size_t count;
+    mutable size_t size;
+    mutable size_t counts[DATA_CHUNK_CLASSES];
 
     bool operator<(const ChunkInfo &r) const {
       return name < r.name;
     }
 
     auto operator+=(const ChunkInfo &r) const -> const ChunkInfo& {
-      count += r.count;
+      size += r.size;
+      for (int i = 0; i < DATA_CHUNK_CLASSES; i++) counts[i] += r.counts[i];
       return *this;
     }
   };
@@ -187,6 +193,18 @@ public:
     }
   };
 
+  struct ThreadInfo {
+    int index; // -1 for the main thread
+    int cpu;
+    uint64_t migrations;
+    uint64_t switches;
+    std::string affinity;
+
+    bool operator<(const ThreadInfo &r) const {
+      return index < r.index;
+    }
+  };
+
   double since = 0;
   double timestamp = 0;
   std::string uuid;
@@ -201,6 +219,7 @@ public:
   std::set<BufferInfo> buffers;
   std::set<InboundInfo> inbounds;
   std::set<OutboundInfo> outbounds;
+  std::set<ThreadInfo> threads;
   std::set<std::string> log_names;
 
   void update_global();
@@ -215,6 +234,7 @@ public:
   void dump_pipelines(Data::Builder &db);
   void dump_inbound(Data::Builder &db);
   void dump_outbound(Data::Builder &db);
+  void dump_threads(Data::Builder &db);
   void dump_json(Data::Builder &db);
 };
 
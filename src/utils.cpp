@@ -31,6 +31,15 @@
 #include <random>
 #include <limits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <tmmintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace pipy {
 namespace utils {
 
@@ -294,6 +303,42 @@ auto get_binary_size(const std::string &str) -> double {
   return get_size(str, 1024);
 }
 
+bool get_cpu_list(const std::string &str, std::vector<int> &cpus) {
+  cpus.clear();
+  for (const auto &s : split(str, ',')) {
+    auto t = trim(s);
+    char *end;
+    auto first = std::strtol(t.c_str(), &end, 10);
+    auto last = first;
+    if (end == t.c_str()) return false;
+    if (*end == '-') {
+      auto p = end + 1;
+      last = std::strtol(p, &end, 10);
+      if (end == p) return false;
+    }
+    if (*end || first < 0 || last < first || last >= 1024) return false;
+    for (auto i = first; i <= last; i++) cpus.push_back(i);
+  }
+  return !cpus.empty();
+}
+
+auto make_cpu_list(const std::vector<int> &cpus) -> std::string {
+  std::string str;
+  size_t i = 0, n = cpus.size();
+  while (i < n) {
+    auto j = i;
+    while (j + 1 < n && cpus[j + 1] == cpus[j] + 1) j++;
+    if (!str.empty()) str += ',';
+    str += std::to_string(cpus[i]);
+    if (j > i) {
+      str += '-';
+      str += std::to_string(cpus[j]);
+    }
+    i = j + 1;
+  }
+  return str;
+}
+
 auto get_byte_size(const std::string &str) -> size_t {
   if (str.empty()) return 0;
   size_t n = std::atoi(str.c_str());
@@ -615,95 +660,519 @@ auto encode_uri(const std::string &str) -> std::string {
   return out;
 }
 
-auto encode_hex(char *out, const void *inp, int len) -> int {
-  int n = 0;
-  HexEncoder encoder(
-    [&](char c) {
-      out[n++] = c;
+//
+// Bulk hex and Base64 codecs
+//
+// Whole buffers are converted at once instead of going through the
+// byte-at-a-time classes further down. Blocks are done with SIMD where
+// available: SSE2 (plus SSSE3, detected at runtime) on x86 and NEON on
+// AArch64. Whatever is left, including padding and anything invalid,
+// goes through the table-driven scalar loops.
+//
+
+static const char s_hex_chars[] = "0123456789abcdef";
+
+static const char s_base64_chars[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const char s_base64url_chars[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+struct DecodeTable {
+  int8_t hex[256];
+  int8_t base64[256];
+  int8_t base64url[256];
+
+  DecodeTable() {
+    std::memset(hex, -1, sizeof(hex));
+    std::memset(base64, -1, sizeof(base64));
+    std::memset(base64url, -1, sizeof(base64url));
+    for (int i = 0; i < 16; i++) {
+      hex[(uint8_t)s_hex_chars[i]] = i;
+      hex[std::toupper(s_hex_chars[i])] = i;
+    }
+    for (int i = 0; i < 64; i++) {
+      base64[(uint8_t)s_base64_chars[i]] = i;
+      base64url[(uint8_t)s_base64url_chars[i]] = i;
     }
-  );
-  const auto *buf = (const uint8_t *)inp;
-  for (int i = 0; i < len; i++) {
-    encoder.input(buf[i]);
   }
-  return n;
+};
+
+static const DecodeTable s_decode_table;
+
+#ifdef __SSE2__
+
+//
+// Maps 16 Base64 characters to their 6-bit values,
+// clearing all bits in 'valid' for any character out of the alphabet
+//
+
+static inline auto sse2_base64_decode(__m128i c, bool url, int &valid) -> __m128i {
+  auto in_range = [&](char a, char b) {
+    return _mm_and_si128(
+      _mm_cmpgt_epi8(c, _mm_set1_epi8(a - 1)),
+      _mm_cmpgt_epi8(_mm_set1_epi8(b + 1), c)
+    );
+  };
+  auto upper = in_range('A', 'Z');
+  auto lower = in_range('a', 'z');
+  auto digit = in_range('0', '9');
+  auto c62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(url ? '-' : '+'));
+  auto c63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(url ? '_' : '/'));
+  auto offset = _mm_or_si128(
+    _mm_or_si128(
+      _mm_and_si128(upper, _mm_set1_epi8(-'A')),
+      _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))
+    ),
+    _mm_or_si128(
+      _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+      _mm_or_si128(
+        _mm_and_si128(c62, _mm_set1_epi8(62 - (url ? '-' : '+'))),
+        _mm_and_si128(c63, _mm_set1_epi8(63 - (url ? '_' : '/')))
+      )
+    )
+  );
+  valid = _mm_movemask_epi8(
+    _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(c62, c63)))
+  );
+  return _mm_add_epi8(c, offset);
 }
 
-auto decode_hex(void *out, const char *inp, int len) -> int {
-  if (len % 2) return -1;
-  auto *buf = (uint8_t *)out;
-  int n = 0;
-  HexDecoder decoder(
-    [&](uint8_t b) {
-      buf[n++] = b;
-    }
+//
+// Maps 16 6-bit values to Base64 characters
+//
+
+static inline auto sse2_base64_encode(__m128i v, bool url) -> __m128i {
+  auto gt25 = _mm_cmpgt_epi8(v, _mm_set1_epi8(25));
+  auto gt51 = _mm_cmpgt_epi8(v, _mm_set1_epi8(51));
+  auto eq62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(62));
+  auto eq63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(63));
+  auto offset = _mm_add_epi8(
+    _mm_add_epi8(
+      _mm_set1_epi8('A'),
+      _mm_and_si128(gt25, _mm_set1_epi8('a' - 26 - 'A'))
+    ),
+    _mm_add_epi8(
+      _mm_and_si128(gt51, _mm_set1_epi8('0' - 52 - ('a' - 26))),
+      _mm_add_epi8(
+        _mm_and_si128(eq62, _mm_set1_epi8((url ? '-' : '+') - 62 - ('0' - 52))),
+        _mm_and_si128(eq63, _mm_set1_epi8((url ? '_' : '/') - 63 - ('0' - 52)))
+      )
+    )
+  );
+  return _mm_add_epi8(v, offset);
+}
+
+//
+// Merges 16 6-bit values into 4 24-bit values, one in each 32-bit lane
+//
+
+static inline auto sse2_base64_merge(__m128i v) -> __m128i {
+  auto t = _mm_or_si128(
+    _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00ff)), 6),
+    _mm_srli_epi16(v, 8)
   );
-  for (int i = 0; i < len; i++) {
-    decoder.input(inp[i]);
+  return _mm_or_si128(
+    _mm_slli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x0000ffff)), 12),
+    _mm_srli_epi32(t, 16)
+  );
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#define SSSE3_ENABLED 1
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+
+static bool has_ssse3() {
+  static const bool b = __builtin_cpu_supports("ssse3");
+  return b;
+}
+
+SSSE3_TARGET
+static int ssse3_encode_base64(char *out, const uint8_t *inp, int len, bool url) {
+  const auto shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  int i = 0, n = 0;
+  while (i + 16 <= len) {
+    auto v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(inp + i)), shuffle);
+    auto a = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    auto b = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    _mm_storeu_si128((__m128i*)(out + n), sse2_base64_encode(_mm_or_si128(a, b), url));
+    i += 12;
+    n += 16;
   }
-  return n;
+  return i;
+}
+
+SSSE3_TARGET
+static int ssse3_decode_base64(uint8_t *out, const char *inp, int len, bool url) {
+  const auto shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  int i = 0, n = 0;
+  while (i + 16 <= len) {
+    int valid;
+    auto v = sse2_base64_decode(_mm_loadu_si128((const __m128i*)(inp + i)), url, valid);
+    if (valid != 0xffff) break;
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    v = _mm_shuffle_epi8(v, shuffle);
+    _mm_storel_epi64((__m128i*)(out + n), v);
+    auto w = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+    std::memcpy(out + n + 8, &w, 4);
+    i += 16;
+    n += 12;
+  }
+  return i;
 }
 
-auto encode_base64(char *out, const void *inp, int len) -> int {
-  int n = 0;
-  Base64Encoder encoder(
-    [&](char c) {
-      out[n++] = c;
+#endif // __GNUC__ && x86
+
+//
+// The rest of the SIMD block loops: each returns the number of input
+// bytes consumed, always a multiple of the block's input size
+//
+
+static int simd_encode_base64(char *out, const uint8_t *inp, int len, bool url) {
+#ifdef SSSE3_ENABLED
+  if (has_ssse3()) return ssse3_encode_base64(out, inp, len, url);
+#endif
+  int i = 0, n = 0;
+  while (i + 12 <= len) {
+    uint32_t t[4];
+    for (int k = 0; k < 4; k++) {
+      auto p = inp + i + k * 3;
+      t[k] = (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | p[2];
+    }
+    auto v = _mm_loadu_si128((const __m128i*)t);
+    v = _mm_or_si128(
+      _mm_or_si128(
+        _mm_and_si128(_mm_srli_epi32(v, 18), _mm_set1_epi32(0x0000003f)),
+        _mm_and_si128(_mm_srli_epi32(v, 4), _mm_set1_epi32(0x00003f00))
+      ),
+      _mm_or_si128(
+        _mm_and_si128(_mm_slli_epi32(v, 10), _mm_set1_epi32(0x003f0000)),
+        _mm_and_si128(_mm_slli_epi32(v, 24), _mm_set1_epi32(0x3f000000))
+      )
+    );
+    _mm_storeu_si128((__m128i*)(out + n), sse2_base64_encode(v, url));
+    i += 12;
+    n += 16;
+  }
+  return i;
+}
+
+static int simd_decode_base64(uint8_t *out, const char *inp, int len, bool url) {
+#ifdef SSSE3_ENABLED
+  if (has_ssse3()) return ssse3_decode_base64(out, inp, len, url);
+#endif
+  int i = 0, n = 0;
+  while (i + 16 <= len) {
+    int valid;
+    auto v = sse2_base64_decode(_mm_loadu_si128((const __m128i*)(inp + i)), url, valid);
+    if (valid != 0xffff) break;
+    uint32_t t[4];
+    _mm_storeu_si128((__m128i*)t, sse2_base64_merge(v));
+    for (int k = 0; k < 4; k++) {
+      auto p = out + n + k * 3;
+      p[0] = t[k] >> 16;
+      p[1] = t[k] >> 8;
+      p[2] = t[k] >> 0;
     }
+    i += 16;
+    n += 12;
+  }
+  return i;
+}
+
+static int simd_encode_hex(char *out, const uint8_t *inp, int len) {
+  int i = 0;
+  while (i + 16 <= len) {
+    auto v = _mm_loadu_si128((const __m128i*)(inp + i));
+    auto hi = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+    auto lo = _mm_and_si128(v, _mm_set1_epi8(0x0f));
+    auto a = _mm_unpacklo_epi8(hi, lo);
+    auto b = _mm_unpackhi_epi8(hi, lo);
+    auto to_char = [](__m128i n) {
+      auto alpha = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+      return _mm_add_epi8(n, _mm_add_epi8(alpha, _mm_set1_epi8('0')));
+    };
+    _mm_storeu_si128((__m128i*)(out + i * 2), to_char(a));
+    _mm_storeu_si128((__m128i*)(out + i * 2 + 16), to_char(b));
+    i += 16;
+  }
+  return i;
+}
+
+static int simd_decode_hex(uint8_t *out, const char *inp, int len) {
+  auto to_nibble = [](__m128i c, int &valid) {
+    auto in_range = [&](char a, char b) {
+      return _mm_and_si128(
+        _mm_cmpgt_epi8(c, _mm_set1_epi8(a - 1)),
+        _mm_cmpgt_epi8(_mm_set1_epi8(b + 1), c)
+      );
+    };
+    auto digit = in_range('0', '9');
+    auto lower = in_range('a', 'f');
+    auto upper = in_range('A', 'F');
+    valid = _mm_movemask_epi8(_mm_or_si128(digit, _mm_or_si128(lower, upper)));
+    auto offset = _mm_or_si128(
+      _mm_and_si128(digit, _mm_set1_epi8(-'0')),
+      _mm_or_si128(
+        _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')),
+        _mm_and_si128(upper, _mm_set1_epi8(10 - 'A'))
+      )
+    );
+    return _mm_add_epi8(c, offset);
+  };
+  auto merge = [](__m128i n) {
+    return _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00ff)), 4),
+      _mm_srli_epi16(n, 8)
+    );
+  };
+  int i = 0;
+  while (i + 32 <= len) {
+    int valid_a, valid_b;
+    auto a = to_nibble(_mm_loadu_si128((const __m128i*)(inp + i)), valid_a);
+    auto b = to_nibble(_mm_loadu_si128((const __m128i*)(inp + i + 16)), valid_b);
+    if ((valid_a & valid_b) != 0xffff) break;
+    _mm_storeu_si128((__m128i*)(out + i / 2), _mm_packus_epi16(merge(a), merge(b)));
+    i += 32;
+  }
+  return i;
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+static inline auto neon_base64_decode(uint8x16_t c, bool url, uint8x16_t &invalid) -> uint8x16_t {
+  auto in_range = [&](uint8_t a, uint8_t b) {
+    return vandq_u8(vcgeq_u8(c, vdupq_n_u8(a)), vcleq_u8(c, vdupq_n_u8(b)));
+  };
+  auto upper = in_range('A', 'Z');
+  auto lower = in_range('a', 'z');
+  auto digit = in_range('0', '9');
+  auto c62 = vceqq_u8(c, vdupq_n_u8(url ? '-' : '+'));
+  auto c63 = vceqq_u8(c, vdupq_n_u8(url ? '_' : '/'));
+  auto offset = vorrq_u8(
+    vorrq_u8(
+      vandq_u8(upper, vdupq_n_u8(uint8_t(-'A'))),
+      vandq_u8(lower, vdupq_n_u8(uint8_t(26 - 'a')))
+    ),
+    vorrq_u8(
+      vandq_u8(digit, vdupq_n_u8(uint8_t(52 - '0'))),
+      vorrq_u8(
+        vandq_u8(c62, vdupq_n_u8(uint8_t(62 - (url ? '-' : '+')))),
+        vandq_u8(c63, vdupq_n_u8(uint8_t(63 - (url ? '_' : '/'))))
+      )
+    )
   );
+  auto valid = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(c62, c63)));
+  invalid = vorrq_u8(invalid, vmvnq_u8(valid));
+  return vaddq_u8(c, offset);
+}
+
+static int simd_encode_base64(char *out, const uint8_t *inp, int len, bool url) {
+  auto chars = (const uint8_t *)(url ? s_base64url_chars : s_base64_chars);
+  uint8x16x4_t table = { vld1q_u8(chars), vld1q_u8(chars + 16), vld1q_u8(chars + 32), vld1q_u8(chars + 48) };
+  auto mask = vdupq_n_u8(0x3f);
+  int i = 0, n = 0;
+  while (i + 48 <= len) {
+    auto v = vld3q_u8(inp + i);
+    uint8x16x4_t r;
+    r.val[0] = vshrq_n_u8(v.val[0], 2);
+    r.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[0], 4), vshrq_n_u8(v.val[1], 4)), mask);
+    r.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[1], 2), vshrq_n_u8(v.val[2], 6)), mask);
+    r.val[3] = vandq_u8(v.val[2], mask);
+    for (int k = 0; k < 4; k++) r.val[k] = vqtbl4q_u8(table, r.val[k]);
+    vst4q_u8((uint8_t *)out + n, r);
+    i += 48;
+    n += 64;
+  }
+  return i;
+}
+
+static int simd_decode_base64(uint8_t *out, const char *inp, int len, bool url) {
+  int i = 0, n = 0;
+  while (i + 64 <= len) {
+    auto v = vld4q_u8((const uint8_t *)inp + i);
+    auto invalid = vdupq_n_u8(0);
+    for (int k = 0; k < 4; k++) v.val[k] = neon_base64_decode(v.val[k], url, invalid);
+    if (vmaxvq_u8(invalid)) break;
+    uint8x16x3_t r;
+    r.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+    r.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+    r.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+    vst3q_u8(out + n, r);
+    i += 64;
+    n += 48;
+  }
+  return i;
+}
+
+static int simd_encode_hex(char *out, const uint8_t *inp, int len) {
+  auto table = vld1q_u8((const uint8_t *)s_hex_chars);
+  int i = 0;
+  while (i + 16 <= len) {
+    auto v = vld1q_u8(inp + i);
+    uint8x16x2_t r;
+    r.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+    r.val[1] = vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0x0f)));
+    vst2q_u8((uint8_t *)out + i * 2, r);
+    i += 16;
+  }
+  return i;
+}
+
+static int simd_decode_hex(uint8_t *out, const char *inp, int len) {
+  auto to_nibble = [](uint8x16_t c, uint8x16_t &invalid) {
+    auto in_range = [&](uint8_t a, uint8_t b) {
+      return vandq_u8(vcgeq_u8(c, vdupq_n_u8(a)), vcleq_u8(c, vdupq_n_u8(b)));
+    };
+    auto digit = in_range('0', '9');
+    auto lower = in_range('a', 'f');
+    auto upper = in_range('A', 'F');
+    invalid = vorrq_u8(invalid, vmvnq_u8(vorrq_u8(digit, vorrq_u8(lower, upper))));
+    auto offset = vorrq_u8(
+      vandq_u8(digit, vdupq_n_u8(uint8_t(-'0'))),
+      vorrq_u8(
+        vandq_u8(lower, vdupq_n_u8(uint8_t(10 - 'a'))),
+        vandq_u8(upper, vdupq_n_u8(uint8_t(10 - 'A')))
+      )
+    );
+    return vaddq_u8(c, offset);
+  };
+  int i = 0;
+  while (i + 32 <= len) {
+    auto v = vld2q_u8((const uint8_t *)inp + i);
+    auto invalid = vdupq_n_u8(0);
+    auto hi = to_nibble(v.val[0], invalid);
+    auto lo = to_nibble(v.val[1], invalid);
+    if (vmaxvq_u8(invalid)) break;
+    vst1q_u8(out + i / 2, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    i += 32;
+  }
+  return i;
+}
+
+#else
+
+static int simd_encode_base64(char *, const uint8_t *, int, bool) { return 0; }
+static int simd_decode_base64(uint8_t *, const char *, int, bool) { return 0; }
+static int simd_encode_hex(char *, const uint8_t *, int) { return 0; }
+static int simd_decode_hex(uint8_t *, const char *, int) { return 0; }
+
+#endif
+
+static int encode_base64(char *out, const void *inp, int len, bool url) {
   const auto *buf = (const uint8_t *)inp;
-  for (int i = 0; i < len; i++) {
-    encoder.input(buf[i]);
+  const auto *tab = url ? s_base64url_chars : s_base64_chars;
+  int i = simd_encode_base64(out, buf, len, url);
+  int n = i / 3 * 4;
+  for (; i + 3 <= len; i += 3, n += 4) {
+    uint32_t t = (uint32_t(buf[i]) << 16) | (uint32_t(buf[i+1]) << 8) | buf[i+2];
+    out[n+0] = tab[(t >> 18) & 63];
+    out[n+1] = tab[(t >> 12) & 63];
+    out[n+2] = tab[(t >>  6) & 63];
+    out[n+3] = tab[(t >>  0) & 63];
+  }
+  switch (len - i) {
+    case 1: {
+      uint32_t t = uint32_t(buf[i]) << 16;
+      out[n++] = tab[(t >> 18) & 63];
+      out[n++] = tab[(t >> 12) & 63];
+      if (!url) {
+        out[n++] = '=';
+        out[n++] = '=';
+      }
+      break;
+    }
+    case 2: {
+      uint32_t t = (uint32_t(buf[i]) << 16) | (uint32_t(buf[i+1]) << 8);
+      out[n++] = tab[(t >> 18) & 63];
+      out[n++] = tab[(t >> 12) & 63];
+      out[n++] = tab[(t >>  6) & 63];
+      if (!url) out[n++] = '=';
+      break;
+    }
   }
-  encoder.flush();
   return n;
 }
 
-auto decode_base64(void *out, const char *inp, int len) -> int {
-  if (len % 4 > 0) return -1;
+static int decode_base64(void *out, const char *inp, int len, bool url) {
   auto *buf = (uint8_t *)out;
-  int n = 0;
-  Base64Decoder decoder(
-    [&](uint8_t b) {
-      buf[n++] = b;
-    }
-  );
-  for (int i = 0; i < len; i++) {
-    int c = inp[i];
-    if (!decoder.input(c)) return -1;
+  const auto *tab = url ? s_decode_table.base64url : s_decode_table.base64;
+  int i = simd_decode_base64(buf, inp, len, url);
+  int n = i / 4 * 3;
+  for (; i + 4 <= len; i += 4, n += 3) {
+    int a = tab[(uint8_t)inp[i+0]];
+    int b = tab[(uint8_t)inp[i+1]];
+    int c = tab[(uint8_t)inp[i+2]];
+    int d = tab[(uint8_t)inp[i+3]];
+    if ((a | b | c | d) < 0) break;
+    uint32_t t = (a << 18) | (b << 12) | (c << 6) | d;
+    buf[n+0] = t >> 16;
+    buf[n+1] = t >> 8;
+    buf[n+2] = t >> 0;
   }
-  return decoder.complete() ? n : -1;
+  int rest = len - i;
+  if (rest == 0) return n;
+  if (rest > 4) return -1;
+  int a = tab[(uint8_t)inp[i]];
+  int b = rest > 1 ? tab[(uint8_t)inp[i+1]] : -1;
+  if (a < 0 || b < 0) return -1;
+  int c = -1, d = -1;
+  if (url) {
+    // No padding: 2 or 3 characters are left over
+    if (rest == 4) return -1;
+    if (rest == 3 && (c = tab[(uint8_t)inp[i+2]]) < 0) return -1;
+  } else {
+    // Padding: exactly one quartet with 1 or 2 '=' at its end
+    if (rest != 4) return -1;
+    if (inp[i+3] != '=') return -1;
+    if (inp[i+2] != '=' && (c = tab[(uint8_t)inp[i+2]]) < 0) return -1;
+  }
+  uint32_t t = (a << 18) | (b << 12) | ((c < 0 ? 0 : c) << 6) | (d < 0 ? 0 : d);
+  buf[n++] = t >> 16;
+  if (c >= 0) buf[n++] = t >> 8;
+  return n;
 }
 
-auto encode_base64url(char *out, const void *inp, int len) -> int {
-  int n = 0;
-  Base64UrlEncoder encoder(
-    [&](char c) {
-      out[n++] = c;
-    }
-  );
+auto encode_hex(char *out, const void *inp, int len) -> int {
   const auto *buf = (const uint8_t *)inp;
-  for (int i = 0; i < len; i++) {
-    encoder.input(buf[i]);
+  for (int i = simd_encode_hex(out, buf, len); i < len; i++) {
+    auto b = buf[i];
+    out[i*2+0] = s_hex_chars[b >> 4];
+    out[i*2+1] = s_hex_chars[b & 15];
   }
-  encoder.flush();
-  return n;
+  return len * 2;
 }
 
-auto decode_base64url(void *out, const char *inp, int len) -> int {
+auto decode_hex(void *out, const char *inp, int len) -> int {
+  if (len % 2) return -1;
   auto *buf = (uint8_t *)out;
-  int n = 0;
-  Base64UrlDecoder decoder(
-    [&](uint8_t b) {
-      buf[n++] = b;
-    }
-  );
-  for (int i = 0; i < len; i++) {
-    if (!decoder.input(inp[i])) {
-      return -1;
-    }
+  const auto *tab = s_decode_table.hex;
+  for (int i = simd_decode_hex(buf, inp, len); i < len; i += 2) {
+    int h = tab[(uint8_t)inp[i+0]];
+    int l = tab[(uint8_t)inp[i+1]];
+    if ((h | l) < 0) return -1;
+    buf[i/2] = (h << 4) | l;
   }
-  return decoder.flush() ? n : -1;
+  return len / 2;
+}
+
+auto encode_base64(char *out, const void *inp, int len) -> int {
+  return encode_base64(out, inp, len, false);
+}
+
+auto decode_base64(void *out, const char *inp, int len) -> int {
+  if (len % 4 > 0) return -1;
+  return decode_base64(out, inp, len, false);
+}
+
+auto encode_base64url(char *out, const void *inp, int len) -> int {
+  return encode_base64(out, inp, len, true);
+}
+
+auto decode_base64url(void *out, const char *inp, int len) -> int {
+  return decode_base64(out, inp, len, true);
 }
 
 auto path_join(const std::string &base, const std::string &path) -> std::string {
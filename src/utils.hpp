@@ -33,6 +33,7 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace pipy {
 namespace utils {
@@ -54,6 +55,8 @@ bool get_ip_v4(const char *str, uint8_t ip[]);
 bool get_ip_v6(const char *str, uint8_t ip[]);
 bool get_ip_v6(const char *str, uint16_t ip[]);
 bool get_cidr(const std::string &str, uint8_t ip[], int &mask);
+bool get_cpu_list(const std::string &str, std::vector<int> &cpus);
+auto make_cpu_list(const std::vector<int> &cpus) -> std::string;
 auto get_size(const std::string &str, int thousand = 1000) -> double;
 auto get_binary_size(const std::string &str) -> double;
 auto get_byte_size(const std::string &str) -> size_t;
@@ -26,12 +26,14 @@
 #include "worker-thread.hpp"
 #include "worker.hpp"
 #include "codebase.hpp"
+#include "filter.hpp"
 #include "pipeline-lb.hpp"
 #include "timer.hpp"
 #include "api/configuration.hpp"
 #include "api/console.hpp"
 #include "api/pipy.hpp"
 #include "net.hpp"
+#include "os-platform.hpp"
 #include "log.hpp"
 #include "utils.hpp"
 
@@ -64,6 +66,7 @@ bool WorkerThread::start(bool force) {
   m_thread = std::thread(
     [this]() {
       s_current = this;
+      pin();
       main();
       m_ended.store(true);
       m_manager->on_thread_ended(m_index);
@@ -154,6 +157,24 @@ void WorkerThread::dump_objects(const std::string &class_name, std::map<std::str
   );
 }
 
+void WorkerThread::profile_start(int frequency, double duration) {
+  m_net->post(
+    [=]() {
+      Profiler::start(frequency, duration);
+    }
+  );
+}
+
+void WorkerThread::profile_stop(const std::function<void(Profiler::Profile&)> &cb) {
+  m_net->post(
+    [=]() {
+      m_profile = Profiler::Profile();
+      Profiler::stop(m_profile);
+      cb(m_profile);
+    }
+  );
+}
+
 void WorkerThread::recycle() {
   if (m_working && !m_recycling) {
     m_recycling = true;
@@ -168,6 +189,32 @@ void WorkerThread::recycle() {
   }
 }
 
+//
+// An automatic reload is skipped altogether when none of the files read
+// while loading the running worker has changed, e.g. when a codebase
+// update only touches files that no loaded module imports or reads.
+// Otherwise, even if only one leaf module has changed, every module is
+// loaded again into a new worker.
+//
+
+void WorkerThread::reload_check(const std::function<void(bool)> &cb) {
+  m_net->post(
+    [=]() {
+      cb(!m_working || m_dependencies.size() == 0 || m_dependencies.changed());
+    }
+  );
+}
+
+void WorkerThread::reload_skip(const std::string &version) {
+  m_net->post(
+    [=]() {
+      m_version = version;
+      m_reload_skipped++;
+      Log::info("[restart] No loaded files changed on thread %d, reloading skipped", m_index);
+    }
+  );
+}
+
 void WorkerThread::reload(const std::function<void(bool)> &cb) {
   m_net->post(
     [=]() {
@@ -182,6 +229,8 @@ void WorkerThread::reload(const std::function<void(bool)> &cb) {
 
       Log::info("[restart] Reloading codebase on thread %d...", m_index);
 
+      auto t = utils::now();
+
       m_new_version = codebase->version();
       m_new_period = pjs::Promise::Period::make();
       m_new_worker = Worker::make(m_new_period, m_manager->loading_pipeline_lb());
@@ -192,10 +241,15 @@ void WorkerThread::reload(const std::function<void(bool)> &cb) {
       m_new_period->pause();
       m_new_period->set_current();
 
-      cb(
+      Codebase::record(&m_new_dependencies);
+      auto ok = (
         m_new_worker->load_js_module(entry) &&
         m_new_worker->bind()
       );
+      Codebase::record(nullptr);
+
+      m_reload_time = utils::now() - t;
+      cb(ok);
 
       old_period->set_current();
       old_period->resume();
@@ -219,6 +273,8 @@ void WorkerThread::reload_done(bool ok) {
           m_new_period = nullptr;
           m_new_worker = nullptr;
           m_version = m_new_version;
+          m_dependencies = std::move(m_new_dependencies);
+          m_reload_count++;
           m_working = true;
           if (m_workload_signal) m_workload_signal->fire();
           Log::info("[restart] Codebase reloaded on thread %d", m_index);
@@ -235,6 +291,7 @@ void WorkerThread::reload_done(bool ok) {
           m_new_period = nullptr;
           m_new_worker = nullptr;
           m_new_version.clear();
+          m_new_dependencies.clear();
           Log::error("[restart] Failed reloading codebase %d", m_index);
         }
       }
@@ -301,6 +358,44 @@ bool WorkerThread::stop(bool force) {
   }
 }
 
+//
+// Rebuilt from the living layouts on every collection, so that
+// filters of the layouts freed since the last one, e.g. by a reload,
+// no longer show up
+//
+
+static void collect_filter_metric(stats::Gauge *gauge, const std::function<double(Filter*)> &get) {
+  double total = 0;
+  gauge->clear();
+  PipelineLayout::for_each(
+    [&](PipelineLayout *p) {
+      if (auto mod = dynamic_cast<JSModule*>(p->module())) {
+        int index = 0;
+        p->for_each_filter(
+          [&](Filter *f) {
+            auto i = index++;
+            auto s = f->stats();
+            if (!s) return;
+            if (!s->label) {
+              Filter::Dump d;
+              f->dump(d);
+              s->label = pjs::Str::make('#' + std::to_string(i) + ' ' + d.name);
+            }
+            pjs::Str *labels[3];
+            labels[0] = mod->filename() ? mod->filename() : pjs::Str::empty.get();
+            labels[1] = p->name_or_label();
+            labels[2] = s->label;
+            auto n = get(f);
+            gauge->with_labels(labels, 3)->set(n);
+            total += n;
+          }
+        );
+      }
+    }
+  );
+  gauge->set(total);
+}
+
 void WorkerThread::init_metrics() {
   pjs::Ref<pjs::Array> label_names = pjs::Array::make();
 
@@ -442,6 +537,100 @@ void WorkerThread::init_metrics() {
       gauge->set(total);
     }
   );
+
+  //
+  // Stats - per-filter traffic and time (--filter-metrics)
+  //
+
+  if (Filter::metrics_enabled()) {
+    label_names->length(3);
+    label_names->set(0, "module");
+    label_names->set(1, "pipeline");
+    label_names->set(2, "filter");
+
+    stats::Gauge::make(
+      pjs::Str::make("pipy_filter_event_count"),
+      label_names,
+      [](stats::Gauge *gauge) {
+        collect_filter_metric(gauge, [](Filter *f) { return f->stats()->events; });
+      }
+    );
+
+    stats::Gauge::make(
+      pjs::Str::make("pipy_filter_message_count"),
+      label_names,
+      [](stats::Gauge *gauge) {
+        collect_filter_metric(gauge, [](Filter *f) { return f->stats()->messages; });
+      }
+    );
+
+    stats::Gauge::make(
+      pjs::Str::make("pipy_filter_data_size"),
+      label_names,
+      [](stats::Gauge *gauge) {
+        collect_filter_metric(gauge, [](Filter *f) { return f->stats()->bytes; });
+      }
+    );
+
+    stats::Gauge::make(
+      pjs::Str::make("pipy_filter_cpu_time"),
+      label_names,
+      [](stats::Gauge *gauge) {
+        collect_filter_metric(gauge, [](Filter *f) { return f->stats()->cpu_time(); });
+      }
+    );
+
+    stats::Gauge::make(
+      pjs::Str::make("pipy_filter_queued_size"),
+      label_names,
+      [](stats::Gauge *gauge) {
+        collect_filter_metric(gauge, [](Filter *f) { return f->buffer_stats()->queued_size; });
+      }
+    );
+
+    stats::Gauge::make(
+      pjs::Str::make("pipy_filter_queued_time"),
+      label_names,
+      [](stats::Gauge *gauge) {
+        collect_filter_metric(gauge, [](Filter *f) { return f->buffer_stats()->queued_time; });
+      }
+    );
+  }
+
+  //
+  // Stats - codebase reloading
+  //
+
+  label_names->length(1);
+  label_names->set(0, "type");
+
+  stats::Gauge::make(
+    pjs::Str::make("pipy_reload_count"),
+    label_names,
+    [](stats::Gauge *gauge) {
+      auto wt = WorkerThread::current();
+      pjs::Ref<pjs::Str> full(pjs::Str::make("full"));
+      pjs::Ref<pjs::Str> skipped(pjs::Str::make("skipped"));
+      pjs::Str *type;
+      type = full; gauge->with_labels(&type, 1)->set(wt->m_reload_count);
+      type = skipped; gauge->with_labels(&type, 1)->set(wt->m_reload_skipped);
+      gauge->set(wt->m_reload_count + wt->m_reload_skipped);
+    }
+  );
+
+  //
+  // Stats - time spent loading modules in the last reload
+  //
+
+  label_names->length(0);
+
+  stats::Gauge::make(
+    pjs::Str::make("pipy_reload_time"),
+    label_names,
+    [](stats::Gauge *gauge) {
+      gauge->set(WorkerThread::current()->m_reload_time);
+    }
+  );
 }
 
 void WorkerThread::shutdown_all(bool force) {
@@ -450,8 +639,35 @@ void WorkerThread::shutdown_all(bool force) {
   Listener::for_each([&](Listener *l) { l->pipeline_layout(nullptr); return true; });
 }
 
+//
+// Pinning goes first so that everything the thread allocates from
+// here on is first touched on the NUMA node it stays on. Without
+// --worker-cpus, the thread keeps the affinity and memory policy
+// inherited from the main thread.
+//
+
+void WorkerThread::pin() {
+  const auto &cpus = m_manager->m_cpus;
+  if (cpus.empty()) return;
+  auto cpu = cpus[m_index % cpus.size()];
+  if (os::set_thread_affinity({ cpu })) {
+    m_cpu = cpu;
+    m_local_memory = os::set_thread_local_memory();
+  }
+}
+
 void WorkerThread::main() {
   Log::init();
+
+  if (!m_manager->m_cpus.empty()) {
+    if (m_cpu < 0) {
+      Log::warn("[thread] Thread %d could not be pinned to a CPU", m_index);
+    } else if (!m_local_memory) {
+      Log::warn("[thread] Thread %d pinned to CPU %d but could not set its memory policy to local", m_index, m_cpu);
+    } else {
+      Log::debug(Log::THREAD, "[thread] Thread %d pinned to CPU %d", m_index, m_cpu);
+    }
+  }
   Pipy::argv(m_manager->m_argv);
 
   pjs::Promise::Period::set_uncaught_exception_handler(
@@ -474,10 +690,13 @@ void WorkerThread::main() {
 
   auto &entry = Codebase::current()->entry();
   auto result = pjs::Value::empty;
+  Codebase::record(&m_dependencies);
   auto mod = m_new_worker->load_js_module(entry, result);
+  auto bound = (mod && m_new_worker->bind());
+  Codebase::record(nullptr);
   bool failed = false;
 
-  if (mod && m_new_worker->bind() && m_new_worker->start(m_force_start)) {
+  if (bound && m_new_worker->start(m_force_start)) {
     Listener::commit_all();
   } else {
     Listener::rollback_all();
@@ -783,18 +1002,58 @@ auto WorkerManager::dump_objects(const std::string &class_name) -> std::map<std:
   return all;
 }
 
+bool WorkerManager::profile(int frequency, double duration, const std::function<void(Profiler::Profile&)> &cb) {
+  if (m_profiling || m_stopping) return false;
+  if (m_worker_threads.empty()) return false;
+
+  m_profiling = true;
+
+  for (auto *wt : m_worker_threads) {
+    wt->profile_start(frequency, duration);
+  }
+
+  m_profile_timer.reset(new Timer);
+  m_profile_timer->schedule(
+    duration,
+    [=]() {
+      auto &main = Net::current();
+      m_profile = Profiler::Profile();
+      m_profile_counter = 0;
+
+      for (auto *wt : m_worker_threads) {
+        wt->profile_stop(
+          [&, cb](Profiler::Profile &p) {
+            main.post(
+              [&, cb]() {
+                m_profile.merge(p);
+                if (++m_profile_counter == m_worker_threads.size()) {
+                  cb(m_profile);
+                  m_profiling = false;
+                }
+              }
+            );
+          }
+        );
+      }
+    }
+  );
+
+  return true;
+}
+
 void WorkerManager::recycle() {
   for (auto *wt : m_worker_threads) {
     wt->recycle();
   }
 }
 
-void WorkerManager::reload() {
+void WorkerManager::reload(bool force) {
   if (m_stopping) return;
   if (m_reloading || m_querying_status || m_querying_stats || !m_admin_requests.empty()) {
     m_reloading_requested = true;
+    m_reloading_forced = m_reloading_forced || force;
   } else {
-    start_reloading();
+    start_reloading(force);
   }
 }
 
@@ -808,18 +1067,52 @@ bool WorkerManager::admin(pjs::Str *path, const Data &request, const std::functi
 
 void WorkerManager::check_reloading() {
   if (m_reloading_requested) {
+    auto force = m_reloading_forced;
     m_reloading_requested = false;
-    start_reloading();
+    m_reloading_forced = false;
+    start_reloading(force);
   }
 }
 
-void WorkerManager::start_reloading() {
+void WorkerManager::start_reloading(bool force) {
   if (auto n = m_worker_threads.size()) {
     m_reloading = true;
-    m_loading_pipeline_lb = PipelineLoadBalancer::make();
 
     std::mutex m;
     std::condition_variable cv;
+
+    // Only automatic reloads are skipped, never the ones
+    // explicitly requested by pipy.restart(), SIGHUP or admin
+    if (!force) {
+      bool changed = false;
+
+      for (auto *wt : m_worker_threads) {
+        wt->reload_check(
+          [&](bool c) {
+            std::lock_guard<std::mutex> lock(m);
+            if (c) changed = true;
+            n--;
+            cv.notify_one();
+          }
+        );
+      }
+
+      {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&]{ return n == 0; });
+      }
+
+      if (!changed) {
+        auto &version = Codebase::current()->version();
+        for (auto *wt : m_worker_threads) wt->reload_skip(version);
+        m_reloading = false;
+        return;
+      }
+
+      n = m_worker_threads.size();
+    }
+
+    m_loading_pipeline_lb = PipelineLoadBalancer::make();
     bool all_ok = true;
 
     for (auto *wt : m_worker_threads) {
@@ -27,8 +27,11 @@
 #define WORKER_THREAD_HPP
 
 #include "net.hpp"
+#include "codebase.hpp"
 #include "list.hpp"
+#include "profiler.hpp"
 #include "status.hpp"
+#include "timer.hpp"
 #include "api/stats.hpp"
 #include "signal.hpp"
 
@@ -72,7 +75,11 @@ public:
   void stats(const std::function<void(stats::MetricData&)> &cb);
   void stats(const std::vector<std::string> &names, const std::function<void(stats::MetricData&)> &cb);
   void dump_objects(const std::string &class_name, std::map<std::string, size_t> &counts, const std::function<void()> &cb);
+  void profile_start(int frequency, double duration);
+  void profile_stop(const std::function<void(Profiler::Profile&)> &cb);
   void recycle();
+  void reload_check(const std::function<void(bool)> &cb);
+  void reload_skip(const std::string &version);
   void reload(const std::function<void(bool)> &cb);
   void reload_done(bool ok);
   void admin(pjs::Str *path, SharedData *request, const std::function<void(SharedData*)> &respond);
@@ -86,8 +93,14 @@ private:
   std::string m_version;
   std::string m_new_version;
   pjs::Ref<Worker> m_new_worker;
+  Codebase::Dependencies m_dependencies;
+  Codebase::Dependencies m_new_dependencies;
+  double m_reload_time = 0;
+  int m_reload_count = 0;
+  int m_reload_skipped = 0;
   Status m_status;
   stats::MetricData m_metric_data;
+  Profiler::Profile m_profile;
   std::atomic<bool> m_working;
   std::atomic<bool> m_recycling;
   std::atomic<bool> m_shutdown;
@@ -101,10 +114,13 @@ private:
   bool m_force_start = false;
   bool m_started = false;
   bool m_failed = false;
+  int m_cpu = -1;
+  bool m_local_memory = false;
 
   static void init_metrics();
   static void shutdown_all(bool force);
 
+  void pin();
   void main();
 
   thread_local static WorkerThread* s_current;
@@ -125,6 +141,8 @@ public:
   void on_done(const std::function<void()> &cb) { m_on_done = cb; }
   void on_ended(const std::function<void()> &cb) { m_on_ended = cb; }
   void argv(const std::vector<std::string> &argv);
+  auto cpus() const -> const std::vector<int>& { return m_cpus; }
+  void cpus(const std::vector<int> &cpus) { m_cpus = cpus; }
   bool started() const { return !m_worker_threads.empty(); }
   bool start(int concurrency = 1, bool force = false);
   auto status() -> Status&;
@@ -133,8 +151,9 @@ public:
   bool stats(const std::function<void(stats::MetricDataSum&)> &cb);
   void stats(const std::function<void(stats::MetricDataSum&)> &cb, const std::vector<std::string> &names);
   auto dump_objects(const std::string &class_name) -> std::map<std::string, size_t>;
+  bool profile(int frequency, double duration, const std::function<void(Profiler::Profile&)> &cb);
   void recycle();
-  void reload();
+  void reload(bool force = false);
   bool admin(pjs::Str *path, const Data &request, const std::function<void(const Data *)> &respond);
   auto concurrency() const -> int { return m_concurrency; }
   bool stop(bool force = false);
@@ -182,18 +201,24 @@ private:
 
   std::vector<WorkerThread*> m_worker_threads;
   std::vector<std::string> m_argv;
+  std::vector<int> m_cpus;
   pjs::Ref<PipelineLoadBalancer> m_running_pipeline_lb;
   pjs::Ref<PipelineLoadBalancer> m_loading_pipeline_lb;
   Status m_status;
   int m_status_counter = -1;
   stats::MetricDataSum m_metric_data_sum;
   int m_metric_data_sum_counter = -1;
+  Profiler::Profile m_profile;
+  int m_profile_counter = -1;
+  std::unique_ptr<Timer> m_profile_timer;
   int m_concurrency = 0;
   bool m_graph_enabled = false;
   bool m_reloading_requested = false;
+  bool m_reloading_forced = false;
   bool m_reloading = false;
   bool m_querying_status = false;
   bool m_querying_stats = false;
+  bool m_profiling = false;
   bool m_stopping = false;
   bool m_stopped = false;
   List<AdminRequest> m_admin_requests;
@@ -202,7 +227,7 @@ private:
   std::function<void()> m_on_ended;
 
   void check_reloading();
-  void start_reloading();
+  void start_reloading(bool force);
   void next_admin_request();
   void on_thread_done(int index);
   void on_thread_ended(int index);
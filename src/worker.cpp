@@ -125,6 +125,9 @@ template<> void ClassDef<pipy::Global>::init() {
   // IPMask
   variable("IPMask", class_of<Constructor<IPMask>>());
 
+  // IPMap
+  variable("IPMap", class_of<Constructor<IPMap>>());
+
   // IPEndpoint
   variable("IPEndpoint", class_of<Constructor<IPEndpoint>>());
 
@@ -0,0 +1,23 @@
+var payload = new Data(
+  JSON.stringify(
+    new Array(100).fill().map(
+      (_, i) => ({
+        id: i,
+        name: `user-${i}`,
+        email: `user-${i}@example.com`,
+        active: i % 2 === 0,
+        score: i * 0.37,
+        tags: [ 'alpha', 'beta', 'gamma' ],
+        address: { city: 'Beijing', street: '中关村大街', zip: '100080' },
+        bio: 'Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.',
+      })
+    )
+  )
+)
+
+pipy()
+
+.listen(os.env.LISTEN || 8000)
+.serveHTTP(
+  () => new Message(JSON.decode(payload)[99].name)
+)
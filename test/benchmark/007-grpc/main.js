@@ -0,0 +1,44 @@
+var message = new Data('x'.repeat(200))
+
+var prefix = new Data([
+  0,
+  (message.size >> 24) & 255,
+  (message.size >> 16) & 255,
+  (message.size >> 8) & 255,
+  (message.size >> 0) & 255,
+])
+
+var stream = new Data
+new Array(16).fill().forEach(() => {
+  stream.push(prefix)
+  stream.push(message)
+})
+
+var request = new Message(
+  {
+    method: 'POST',
+    path: '/echo.Echo/Stream',
+    headers: {
+      'content-type': 'application/grpc',
+      'te': 'trailers',
+    },
+  },
+  stream
+)
+
+pipy.listen(os.env.LISTEN || 8000, $=>$
+  .demuxHTTP().to($=>$
+    .replaceMessage(request)
+    .muxHTTP(() => 1, { version: 2 }).to($=>$
+      .connect('localhost:8001')
+    )
+  )
+)
+
+pipy.listen(8001, $=>$
+  .demuxHTTP().to($=>$
+    .decodeGRPC()
+    .replaceMessageEnd(() => new MessageEnd({ status: 0 }))
+    .encodeGRPC()
+  )
+)
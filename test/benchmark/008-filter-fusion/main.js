@@ -0,0 +1,21 @@
+var $host
+var $path
+var $status
+
+pipy.listen(os.env.LISTEN || 8000, $=>$
+  .demuxHTTP().to($=>$
+    .handleMessageStart(msg => $host = msg.head.headers.host)
+    .handleMessageStart(msg => $path = msg.head.path)
+    .handleMessageStart(msg => msg.head.headers['x-forwarded-host'] = $host)
+    .handleMessageStart(msg => msg.head.headers['x-forwarded-proto'] = 'http')
+    .replaceMessageStart(evt => evt)
+    .muxHTTP().to($=>$
+      .connect('localhost:8080')
+    )
+    .handleMessageStart(msg => $status = msg.head.status)
+    .handleMessageStart(msg => msg.head.headers['x-proxied-by'] = 'pipy')
+    .handleMessageStart(msg => msg.head.headers['x-original-path'] = $path)
+    .handleMessageEnd(() => $status > 0)
+    .replaceMessageEnd(evt => evt)
+  )
+)
@@ -0,0 +1,23 @@
+var notFound = new Message(
+  {
+    status: 404,
+    headers: { 'content-type': 'text/plain' },
+  },
+  'Not found'
+).freeze()
+
+var health = new Message(
+  {
+    status: 200,
+    headers: { 'content-type': 'application/json' },
+  },
+  JSON.stringify({ status: 'UP' })
+).freeze()
+
+pipy.listen(os.env.LISTEN || 8000, $=>$
+  .demuxHTTP().to($=>$
+    .replaceMessage(
+      msg => msg.head.path === '/health' ? health : notFound
+    )
+  )
+)
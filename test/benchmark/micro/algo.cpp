@@ -0,0 +1,64 @@
+#include "bench.hpp"
+
+#include "api/algo.hpp"
+
+using namespace pipy;
+
+static auto make_targets(int n) -> pjs::Array* {
+  auto a = pjs::Array::make();
+  for (int i = 0; i < n; i++) {
+    a->push(pjs::Str::make("10.0.0." + std::to_string(i + 1) + ":8080"));
+  }
+  return a;
+}
+
+static void balance(algo::LoadBalancer::Algorithm algorithm, size_t n) {
+  pjs::Context ctx(nullptr);
+  algo::LoadBalancer::Options options;
+  options.algorithm = algorithm;
+  pjs::Ref<algo::LoadBalancer> lb = algo::LoadBalancer::make(options);
+  pjs::Ref<pjs::Array> targets = make_targets(16);
+  lb->provision(ctx, targets);
+  for (size_t i = 0; i < n; i++) {
+    pjs::Ref<algo::LoadBalancer::Resource> r = lb->allocate(ctx);
+    if (r) r->free();
+  }
+  bench::keep(lb);
+}
+
+static bench::Benchmark lb_round_robin("algo/load-balancer-round-robin", [](size_t n) {
+  balance(algo::LoadBalancer::ROUND_ROBIN, n);
+});
+
+static bench::Benchmark lb_least_load("algo/load-balancer-least-load", [](size_t n) {
+  balance(algo::LoadBalancer::LEAST_LOAD, n);
+});
+
+static bench::Benchmark cache_hit("algo/cache-get-hit", [](size_t n) {
+  algo::Cache::Options options;
+  pjs::Ref<algo::Cache> cache = algo::Cache::make(options);
+  pjs::Value keys[256];
+  for (int i = 0; i < 256; i++) {
+    keys[i].set(pjs::Str::make("key-" + std::to_string(i)));
+    cache->set(keys[i], i);
+  }
+  pjs::Value v;
+  for (size_t i = 0; i < n; i++) {
+    cache->get(keys[i & 255], v);
+  }
+  bench::keep(v);
+});
+
+static bench::Benchmark cache_set_evict("algo/cache-set-evict", [](size_t n) {
+  algo::Cache::Options options;
+  options.size = 128;
+  pjs::Ref<algo::Cache> cache = algo::Cache::make(options);
+  pjs::Value keys[256];
+  for (int i = 0; i < 256; i++) {
+    keys[i].set(pjs::Str::make("key-" + std::to_string(i)));
+  }
+  for (size_t i = 0; i < n; i++) {
+    cache->set(keys[i & 255], int(i));
+  }
+  bench::keep(cache);
+});
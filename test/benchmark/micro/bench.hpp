@@ -0,0 +1,79 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+//
+// Benchmark
+//
+// A benchmark is a function that performs a given number of
+// operations. Setup that is not part of the measurement should be
+// done once, outside the function or in static variables.
+//
+
+class Benchmark {
+public:
+  Benchmark(const std::string &name, const std::function<void(size_t)> &run)
+    : m_name(name), m_run(run) { all().push_back(this); }
+
+  static auto all() -> std::vector<Benchmark*>& {
+    static std::vector<Benchmark*> s_all;
+    return s_all;
+  }
+
+  auto name() const -> const std::string& { return m_name; }
+  void run(size_t n) const { m_run(n); }
+
+private:
+  std::string m_name;
+  std::function<void(size_t)> m_run;
+};
+
+//
+// Check
+//
+// A check asserts invariants of a primitive that benchmarks cannot
+// see, such as memory being released and reused. It fails by throwing
+// std::runtime_error. Checks are run with --check.
+//
+
+class Check {
+public:
+  Check(const std::string &name, const std::function<void()> &run)
+    : m_name(name), m_run(run) { all().push_back(this); }
+
+  static auto all() -> std::vector<Check*>& {
+    static std::vector<Check*> s_all;
+    return s_all;
+  }
+
+  auto name() const -> const std::string& { return m_name; }
+  void run() const { m_run(); }
+
+private:
+  std::string m_name;
+  std::function<void()> m_run;
+};
+
+//
+// Keeps the compiler from optimizing a result away
+//
+
+template<class T>
+inline void keep(T &&value) {
+#ifdef _MSC_VER
+  static const void* volatile s_sink;
+  s_sink = &value;
+#else
+  asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+} // namespace bench
+
+#endif // BENCH_HPP
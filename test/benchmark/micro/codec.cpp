@@ -0,0 +1,102 @@
+#include "bench.hpp"
+
+#include "api/json.hpp"
+#include "api/resp.hpp"
+#include "api/thrift.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace pipy;
+
+static Data::Producer s_dp("Microbench Codec");
+
+static const char s_resp[] =
+  "*3\r\n$3\r\nSET\r\n$16\r\nsession:12345678\r\n$40\r\n"
+  "0123456789abcdef0123456789abcdef01234567\r\n";
+
+// Binary protocol call to ping(1: i32 id = 42, 2: string msg = "hello")
+static const uint8_t s_thrift[] = {
+  0x80, 0x01, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x04, 'p', 'i', 'n', 'g',
+  0x00, 0x00, 0x00, 0x01,
+  0x08, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2a,
+  0x0b, 0x00, 0x02, 0x00, 0x00, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o',
+  0x00,
+};
+
+static const char s_json[] =
+  "{\"id\":12345,\"name\":\"Alice\",\"email\":\"alice@example.com\","
+  "\"active\":true,\"score\":98.6,\"tags\":[\"admin\",\"ops\",\"dev\"],"
+  "\"address\":{\"city\":\"Springfield\",\"zip\":\"12345\"}}";
+
+static auto decode_json() -> pjs::Value {
+  pjs::Value val;
+  Data data(s_json, sizeof(s_json) - 1, &s_dp);
+  if (!JSON::decode(data, nullptr, val)) {
+    std::cerr << "Invalid JSON in benchmark" << std::endl;
+    std::abort();
+  }
+  return val;
+}
+
+static bench::Benchmark resp_decode("codec/resp-decode", [](size_t n) {
+  Data data(s_resp, sizeof(s_resp) - 1, &s_dp);
+  for (size_t i = 0; i < n; i++) {
+    pjs::Ref<pjs::Array> a = RESP::decode(data);
+    bench::keep(a);
+  }
+});
+
+static bench::Benchmark resp_encode("codec/resp-encode", [](size_t n) {
+  Data data(s_resp, sizeof(s_resp) - 1, &s_dp);
+  pjs::Ref<pjs::Array> a = RESP::decode(data);
+  pjs::Value val;
+  a->get(0, val);
+  Data out;
+  for (size_t i = 0; i < n; i++) {
+    RESP::encode(val, out);
+    out.clear();
+  }
+  bench::keep(out);
+});
+
+static bench::Benchmark thrift_decode("codec/thrift-decode", [](size_t n) {
+  Data data(s_thrift, sizeof(s_thrift), &s_dp);
+  for (size_t i = 0; i < n; i++) {
+    pjs::Ref<pjs::Array> a = Thrift::decode(data);
+    bench::keep(a);
+  }
+});
+
+static bench::Benchmark thrift_encode("codec/thrift-encode", [](size_t n) {
+  Data data(s_thrift, sizeof(s_thrift), &s_dp);
+  pjs::Ref<pjs::Array> a = Thrift::decode(data);
+  pjs::Value msg;
+  a->get(0, msg);
+  Data out;
+  for (size_t i = 0; i < n; i++) {
+    Thrift::encode(msg.is_object() ? msg.o() : nullptr, out);
+    out.clear();
+  }
+  bench::keep(out);
+});
+
+static bench::Benchmark json_decode("codec/json-decode", [](size_t n) {
+  Data data(s_json, sizeof(s_json) - 1, &s_dp);
+  pjs::Value val;
+  for (size_t i = 0; i < n; i++) {
+    JSON::decode(data, nullptr, val);
+  }
+  bench::keep(val);
+});
+
+static bench::Benchmark json_encode("codec/json-encode", [](size_t n) {
+  auto val = decode_json();
+  Data out;
+  for (size_t i = 0; i < n; i++) {
+    JSON::encode(val, nullptr, 0, out);
+    out.clear();
+  }
+  bench::keep(out);
+});
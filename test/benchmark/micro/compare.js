@@ -0,0 +1,84 @@
+#!/usr/bin/env node
+
+//
+// Compares two result files written by pipy-microbench --json=<filename>
+// and exits with a non-zero code if any benchmark has regressed.
+//
+// A change only counts when it is larger than both the threshold and
+// the spread between the fastest and slowest samples of either run.
+//
+
+import fs from 'fs';
+import chalk from 'chalk';
+
+import { program } from 'commander';
+
+const log = console.log;
+const error = (...args) => log.apply(this, [chalk.bgRed('ERROR')].concat(args.map(a => chalk.red(a))));
+
+function load(filename) {
+  const results = JSON.parse(fs.readFileSync(filename, 'utf8'));
+  if (results.suite !== 'pipy-microbench') {
+    throw new Error(`${filename} is not a result file of pipy-microbench`);
+  }
+  return Object.fromEntries(results.benchmarks.map(b => [b.name, b]));
+}
+
+function noise(b) {
+  return (b.max_ns - b.min_ns) / b.median_ns * 100;
+}
+
+function compare(baseFilename, testFilename, threshold) {
+  const base = load(baseFilename);
+  const test = load(testFilename);
+  const names = [...new Set([...Object.keys(base), ...Object.keys(test)])].sort();
+  const width = Math.max(...names.map(n => n.length));
+
+  let regressions = 0;
+
+  names.forEach(name => {
+    const a = base[name];
+    const b = test[name];
+    const label = name.padEnd(width);
+    if (!a || !b) {
+      log(label, chalk.gray(a ? 'removed' : 'added'));
+      return;
+    }
+
+    const change = (b.median_ns - a.median_ns) / a.median_ns * 100;
+    const limit = Math.max(threshold, noise(a), noise(b));
+    const text = (change > 0 ? '+' : '') + change.toFixed(2) + '%';
+    const times = `${a.median_ns.toFixed(1)} -> ${b.median_ns.toFixed(1)} ns/op`;
+
+    if (change > limit) {
+      regressions++;
+      log(label, chalk.red(text.padStart(9)), times, chalk.bgRed('REGRESSION'));
+    } else if (-change > limit) {
+      log(label, chalk.green(text.padStart(9)), times);
+    } else {
+      log(label, chalk.gray(text.padStart(9)), times);
+    }
+  });
+
+  log();
+  if (regressions > 0) {
+    log(chalk.red(`${regressions} regression(s) beyond ${threshold}% or noise`));
+    process.exit(1);
+  } else {
+    log(chalk.green('No regressions'));
+  }
+}
+
+program
+  .argument('<base>', 'results of the baseline build')
+  .argument('<test>', 'results of the build under test')
+  .option('-t, --threshold <percent>', 'smallest slowdown to report', '5')
+  .action((base, test, options) => {
+    try {
+      compare(base, test, Number.parseFloat(options.threshold));
+    } catch (e) {
+      error(e.message);
+      process.exit(1);
+    }
+  })
+  .parse(process.argv);
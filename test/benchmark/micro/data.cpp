@@ -0,0 +1,86 @@
+#include "bench.hpp"
+
+#include "data.hpp"
+
+using namespace pipy;
+
+static Data::Producer s_dp("Microbench");
+
+static char s_bytes[64*1024];
+
+static bench::Benchmark push_small("data/push-16", [](size_t n) {
+  Data data;
+  for (size_t i = 0; i < n; i++) {
+    data.push(s_bytes, 16, &s_dp);
+    if (data.size() >= 64*1024) data.clear();
+  }
+  bench::keep(data);
+});
+
+static bench::Benchmark push_large("data/push-16k", [](size_t n) {
+  Data data;
+  for (size_t i = 0; i < n; i++) {
+    data.push(s_bytes, 16*1024, &s_dp);
+    data.clear();
+  }
+  bench::keep(data);
+});
+
+static bench::Benchmark shift_bytes("data/shift-16", [](size_t n) {
+  Data data;
+  uint8_t buf[16];
+  for (size_t i = 0; i < n; i++) {
+    if (data.size() < 16) data.push(s_bytes, sizeof(s_bytes), &s_dp);
+    data.shift(16, buf);
+  }
+  bench::keep(buf);
+});
+
+static bench::Benchmark shift_data("data/shift-100-to-data", [](size_t n) {
+  Data data, out;
+  for (size_t i = 0; i < n; i++) {
+    if (data.size() < 100) data.push(s_bytes, sizeof(s_bytes), &s_dp);
+    data.shift(100, out);
+    out.clear();
+  }
+  bench::keep(out);
+});
+
+static bench::Benchmark pack("data/pack-100", [](size_t n) {
+  Data data, piece(s_bytes, 100, &s_dp);
+  for (size_t i = 0; i < n; i++) {
+    data.pack(piece, &s_dp);
+    if (data.size() >= 64*1024) data.clear();
+  }
+  bench::keep(data);
+});
+
+static bench::Benchmark builder("data/builder-push-char", [](size_t n) {
+  Data data;
+  Data::Builder db(data, &s_dp);
+  for (size_t i = 0; i < n; i++) {
+    db.push(char(i));
+    if (db.size() >= 64*1024) {
+      db.flush();
+      data.clear();
+      db.reset();
+    }
+  }
+  db.flush();
+  bench::keep(data);
+});
+
+static bench::Benchmark builder_str("data/builder-push-str", [](size_t n) {
+  Data data;
+  Data::Builder db(data, &s_dp);
+  for (size_t i = 0; i < n; i++) {
+    db.push("content-length: ", 16);
+    if (db.size() >= 64*1024) {
+      db.flush();
+      data.clear();
+      db.reset();
+    }
+  }
+  db.flush();
+  bench::keep(data);
+});
@@ -0,0 +1,40 @@
+#include "bench.hpp"
+
+#include "event-queue.hpp"
+#include "input.hpp"
+
+using namespace pipy;
+
+static Data::Producer s_dp("Microbench EventQueue");
+
+static void transfer(Event *evt, int batch, size_t n) {
+  InputContext ic;
+  EventQueue queue;
+  pjs::Ref<Event> ref(evt);
+  for (size_t i = 0; i < n; i += batch) {
+    for (int j = 0; j < batch; j++) queue.enqueue(evt);
+    for (int j = 0; j < batch; j++) {
+      pjs::Ref<Event> e = queue.dequeue();
+      bench::keep(e);
+    }
+  }
+}
+
+static bench::Benchmark data_single("event-queue/data-1k", [](size_t n) {
+  transfer(Data::make(1024, 'x', &s_dp), 1, n);
+});
+
+static bench::Benchmark data_batch("event-queue/data-1k-batch-64", [](size_t n) {
+  transfer(Data::make(1024, 'x', &s_dp), 64, n);
+});
+
+static bench::Benchmark message_start("event-queue/message-start", [](size_t n) {
+  auto head = pjs::Object::make();
+  head->set("method", pjs::Str::make("GET"));
+  head->set("path", pjs::Str::make("/"));
+  transfer(MessageStart::make(head), 1, n);
+});
+
+static bench::Benchmark stream_end("event-queue/stream-end", [](size_t n) {
+  transfer(StreamEnd::make(), 1, n);
+});
@@ -0,0 +1,150 @@
+#include "bench.hpp"
+
+#include "filters/http.hpp"
+#include "filters/http2.hpp"
+#include "input.hpp"
+#include "message.hpp"
+
+using namespace pipy;
+
+static Data::Producer s_dp("Microbench HTTP");
+
+//
+// Counts what comes out of a codec
+//
+
+class Sink : public EventTarget {
+public:
+  size_t size = 0;
+  size_t messages = 0;
+
+private:
+  virtual void on_event(Event *evt) override {
+    if (auto *data = evt->as<Data>()) {
+      size += data->size();
+    } else if (evt->is<MessageEnd>()) {
+      messages++;
+    }
+  }
+};
+
+static const char s_request[] =
+  "GET /api/v1/users/12345?fields=name,email HTTP/1.1\r\n"
+  "Host: example.com\r\n"
+  "User-Agent: Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101 Firefox/115.0\r\n"
+  "Accept: application/json\r\n"
+  "Accept-Encoding: gzip, deflate, br\r\n"
+  "Accept-Language: en-US,en;q=0.5\r\n"
+  "Cookie: session=0123456789abcdef; theme=dark\r\n"
+  "Connection: keep-alive\r\n"
+  "\r\n";
+
+static const char s_response[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: application/json\r\n"
+  "Content-Length: 27\r\n"
+  "Cache-Control: no-cache\r\n"
+  "Date: Mon, 19 Oct 2026 00:00:00 GMT\r\n"
+  "Server: pipy\r\n"
+  "\r\n"
+  "{\"id\":12345,\"name\":\"Alice\"}";
+
+static auto make_headers() -> pjs::Object* {
+  auto headers = pjs::Object::make();
+  headers->set("content-type", pjs::Str::make("application/json"));
+  headers->set("cache-control", pjs::Str::make("no-cache"));
+  headers->set("server", pjs::Str::make("pipy"));
+  headers->set("x-request-id", pjs::Str::make("0123456789abcdef"));
+  return headers;
+}
+
+static auto make_response() -> Message* {
+  auto head = http::ResponseHead::make();
+  head->status = 200;
+  head->headers = make_headers();
+  return Message::make(head, Data::make("{\"id\":12345,\"name\":\"Alice\"}", &s_dp));
+}
+
+static auto make_request() -> Message* {
+  auto head = http::RequestHead::make();
+  head->method = pjs::Str::make("GET");
+  head->path = pjs::Str::make("/api/v1/users/12345?fields=name,email");
+  head->headers = make_headers();
+  return Message::make(head, nullptr);
+}
+
+static void decode(bool is_response, const char *text, size_t len, size_t n) {
+  InputContext ic;
+  Sink sink;
+  http::Decoder decoder(is_response);
+  decoder.chain(sink.input());
+  pjs::Ref<Data> data = Data::make(text, len, &s_dp);
+  for (size_t i = 0; i < n; i++) {
+    pjs::Ref<Data> buf = Data::make(*data);
+    decoder.input()->input(buf);
+  }
+  bench::keep(sink.messages);
+}
+
+static void encode(bool is_response, Message *msg, size_t n) {
+  InputContext ic;
+  Sink sink;
+  http::Encoder encoder(is_response);
+  encoder.chain(sink.input());
+  for (size_t i = 0; i < n; i++) {
+    msg->write(encoder.input());
+  }
+  bench::keep(sink.size);
+}
+
+static bench::Benchmark decode_request("http/decode-request", [](size_t n) {
+  decode(false, s_request, sizeof(s_request) - 1, n);
+});
+
+static bench::Benchmark decode_response("http/decode-response", [](size_t n) {
+  decode(true, s_response, sizeof(s_response) - 1, n);
+});
+
+static bench::Benchmark encode_request("http/encode-request", [](size_t n) {
+  pjs::Ref<Message> msg = make_request();
+  encode(false, msg, n);
+});
+
+static bench::Benchmark encode_response("http/encode-response", [](size_t n) {
+  pjs::Ref<Message> msg = make_response();
+  encode(true, msg, n);
+});
+
+static bench::Benchmark encode_response_frozen("http/encode-response-frozen", [](size_t n) {
+  pjs::Ref<Message> msg = make_response();
+  msg->freeze();
+  encode(true, msg, n);
+});
+
+static bench::Benchmark hpack_encode("http2/hpack-encode", [](size_t n) {
+  http2::HeaderEncoder encoder;
+  pjs::Ref<Message> msg = make_response();
+  Data data;
+  for (size_t i = 0; i < n; i++) {
+    encoder.encode(true, false, msg->head(), data);
+    data.clear();
+  }
+  bench::keep(data);
+});
+
+static bench::Benchmark hpack_decode("http2/hpack-decode", [](size_t n) {
+  http2::Settings settings;
+  http2::HeaderEncoder encoder;
+  http2::HeaderDecoder decoder(settings);
+  pjs::Ref<Message> msg = make_response();
+  Data block;
+  encoder.encode(true, false, msg->head(), block);
+  pjs::Ref<http::MessageHead> head;
+  for (size_t i = 0; i < n; i++) {
+    Data data(block);
+    decoder.start(true, false);
+    decoder.decode(data);
+    decoder.end(head);
+  }
+  bench::keep(head);
+});
@@ -0,0 +1,197 @@
+//
+// Microbenchmarks of core primitives
+//
+// Usage: pipy-microbench [--filter=<substring>] [--time=<ms>] [--repeat=<n>] [--json=<filename>] [--list] [--check]
+//
+// Each benchmark is calibrated to run for about --time milliseconds
+// per sample, and the median of --repeat samples is reported. With
+// --json, results are also written in a form that compare.js reads
+// to flag regressions between two builds. With --check, the checks
+// are run instead and the exit code is non-zero if any fails.
+//
+
+#include "bench.hpp"
+
+#include "log.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace pipy;
+
+struct Result {
+  std::string name;
+  size_t iterations;
+  std::vector<double> samples; // nanoseconds per operation
+};
+
+static auto measure(const bench::Benchmark *b, size_t n) -> double {
+  auto t0 = std::chrono::steady_clock::now();
+  b->run(n);
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+static auto run(const bench::Benchmark *b, double time_ms, int repeat) -> Result {
+  Result r;
+  r.name = b->name();
+
+  // Grow the iteration count until a run takes a tenth of the sample time
+  size_t n = 1;
+  double ns = 0;
+  for (;;) {
+    ns = measure(b, n);
+    if (ns >= time_ms * 1e5 || n >= (size_t(1) << 40)) break;
+    n *= (ns < time_ms * 1e4 ? 10 : 2);
+  }
+
+  n = std::max<size_t>(1, size_t(n * (time_ms * 1e6) / std::max(ns, 1.0)));
+  r.iterations = n;
+
+  for (int i = 0; i < repeat; i++) {
+    r.samples.push_back(measure(b, n) / n);
+  }
+
+  std::sort(r.samples.begin(), r.samples.end());
+  return r;
+}
+
+static auto median(const std::vector<double> &v) -> double {
+  auto n = v.size();
+  return n % 2 ? v[n/2] : (v[n/2-1] + v[n/2]) / 2;
+}
+
+static auto run_checks(const std::string &filter) -> int {
+  auto checks = bench::Check::all();
+  std::sort(
+    checks.begin(), checks.end(),
+    [](const bench::Check *a, const bench::Check *b) {
+      return a->name() < b->name();
+    }
+  );
+
+  int failed = 0;
+  for (const auto *c : checks) {
+    if (!filter.empty() && c->name().find(filter) == std::string::npos) continue;
+    try {
+      c->run();
+      std::printf("%-36s ok\n", c->name().c_str());
+    } catch (std::runtime_error &err) {
+      std::printf("%-36s FAILED: %s\n", c->name().c_str(), err.what());
+      failed++;
+    }
+    std::fflush(stdout);
+  }
+  return failed ? -1 : 0;
+}
+
+static void write_json(std::ostream &os, const std::vector<Result> &results, double time_ms, int repeat) {
+  char buf[100];
+  os << "{\"suite\":\"pipy-microbench\"";
+  os << ",\"timestamp\":" << (unsigned long long)utils::now();
+  os << ",\"time\":" << time_ms;
+  os << ",\"repeat\":" << repeat;
+  os << ",\"benchmarks\":[";
+  bool first = true;
+  for (const auto &r : results) {
+    if (first) first = false; else os << ',';
+    os << "\n  {\"name\":\"" << utils::escape(r.name) << '"';
+    os << ",\"iterations\":" << r.iterations;
+    std::snprintf(buf, sizeof(buf), "%.3f", median(r.samples)); os << ",\"median_ns\":" << buf;
+    std::snprintf(buf, sizeof(buf), "%.3f", r.samples.front()); os << ",\"min_ns\":" << buf;
+    std::snprintf(buf, sizeof(buf), "%.3f", r.samples.back()); os << ",\"max_ns\":" << buf;
+    os << ",\"samples\":[";
+    for (size_t i = 0; i < r.samples.size(); i++) {
+      std::snprintf(buf, sizeof(buf), "%.3f", r.samples[i]);
+      if (i > 0) os << ',';
+      os << buf;
+    }
+    os << "]}";
+  }
+  os << "\n]}\n";
+}
+
+int main(int argc, char *argv[]) {
+  std::string filter;
+  std::string json_filename;
+  double time_ms = 100;
+  int repeat = 5;
+  bool list = false;
+  bool check = false;
+
+  for (int i = 1; i < argc; i++) {
+    std::string term(argv[i]);
+    auto p = term.find('=');
+    auto k = term.substr(0, p);
+    auto v = (p == std::string::npos ? std::string() : term.substr(p + 1));
+    if (k == "--filter") {
+      filter = v;
+    } else if (k == "--time") {
+      time_ms = std::atof(v.c_str());
+    } else if (k == "--repeat") {
+      repeat = std::atoi(v.c_str());
+    } else if (k == "--json") {
+      json_filename = v;
+    } else if (k == "--list") {
+      list = true;
+    } else if (k == "--check") {
+      check = true;
+    } else {
+      std::cerr << "unknown option: " << k << std::endl;
+      return -1;
+    }
+  }
+
+  if (time_ms <= 0 || repeat <= 0) {
+    std::cerr << "invalid --time or --repeat" << std::endl;
+    return -1;
+  }
+
+  Log::init();
+
+  if (check) return run_checks(filter);
+
+  auto benchmarks = bench::Benchmark::all();
+  std::sort(
+    benchmarks.begin(), benchmarks.end(),
+    [](const bench::Benchmark *a, const bench::Benchmark *b) {
+      return a->name() < b->name();
+    }
+  );
+
+  std::vector<Result> results;
+
+  for (const auto *b : benchmarks) {
+    if (!filter.empty() && b->name().find(filter) == std::string::npos) continue;
+    if (list) {
+      std::cout << b->name() << std::endl;
+      continue;
+    }
+    auto r = run(b, time_ms, repeat);
+    std::printf(
+      "%-36s %12.1f ns/op  (min %.1f, max %.1f, %zu iterations)\n",
+      r.name.c_str(), median(r.samples), r.samples.front(), r.samples.back(), r.iterations
+    );
+    std::fflush(stdout);
+    results.push_back(std::move(r));
+  }
+
+  if (!json_filename.empty()) {
+    std::ofstream fs(json_filename);
+    if (!fs.is_open()) {
+      std::cerr << "cannot open " << json_filename << std::endl;
+      return -1;
+    }
+    write_json(fs, results, time_ms, repeat);
+  }
+
+  return 0;
+}
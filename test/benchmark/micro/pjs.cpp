@@ -0,0 +1,133 @@
+#include "bench.hpp"
+
+#include "pjs/pjs.hpp"
+
+#include <iostream>
+
+using namespace pjs;
+
+//
+// Evaluates a script to a function within a shared instance
+//
+
+static auto instance() -> Instance* {
+  static Instance *s_instance = new Instance(Global::make());
+  return s_instance;
+}
+
+static auto script(const char *source) -> Function* {
+  static Context ctx(instance());
+  auto mod = new Module(instance());
+  std::string error;
+  int error_line, error_column;
+  mod->load("microbench", source);
+  if (!mod->compile(error, error_line, error_column)) {
+    std::cerr << "Syntax error at line " << error_line << " column " << error_column << ": " << error << std::endl;
+    std::abort();
+  }
+  Value result;
+  mod->execute(ctx, -1, nullptr, result);
+  if (!ctx.ok() || !result.is_function()) {
+    std::cerr << "Script did not evaluate to a function: " << source << std::endl;
+    std::abort();
+  }
+  result.f()->retain();
+  return result.f();
+}
+
+static auto make_object() -> Object* {
+  auto obj = Object::make();
+  obj->set("a", 1);
+  obj->set("b", 2);
+  obj->set("c", 3);
+  obj->set("d", 4);
+  obj->set("e", 5);
+  obj->set("f", 6);
+  obj->set("g", 7);
+  obj->set("h", 8);
+  obj->retain();
+  return obj;
+}
+
+static bench::Benchmark object_get("pjs/object-get", [](size_t n) {
+  static auto obj = make_object();
+  static auto key = Str::make("h")->retain();
+  Value v;
+  for (size_t i = 0; i < n; i++) {
+    obj->get(key, v);
+  }
+  bench::keep(v);
+});
+
+static bench::Benchmark object_set("pjs/object-set", [](size_t n) {
+  static auto obj = make_object();
+  static auto key = Str::make("h")->retain();
+  Value v(0);
+  for (size_t i = 0; i < n; i++) {
+    obj->set(key, v);
+  }
+  bench::keep(obj);
+});
+
+static bench::Benchmark native_call("pjs/native-call", [](size_t n) {
+  static Context ctx(instance());
+  static Ref<Function> f = Function::make(
+    Method::make(
+      "add", [](Context &ctx, Object*, Value &ret) {
+        ret.set(ctx.arg(0).n() + ctx.arg(1).n());
+      }
+    )
+  );
+  Value args[2], ret;
+  args[0].set(1);
+  args[1].set(2);
+  for (size_t i = 0; i < n; i++) {
+    (*f)(ctx, 2, args, ret);
+  }
+  bench::keep(ret);
+});
+
+static bench::Benchmark script_call("pjs/script-call", [](size_t n) {
+  static Context ctx(instance());
+  static auto f = script("(a, b) => a + b");
+  Value args[2], ret;
+  args[0].set(1);
+  args[1].set(2);
+  for (size_t i = 0; i < n; i++) {
+    (*f)(ctx, 2, args, ret);
+  }
+  bench::keep(ret);
+});
+
+static bench::Benchmark script_property("pjs/script-property", [](size_t n) {
+  static Context ctx(instance());
+  static auto f = script("o => o.a + o.h");
+  static auto obj = make_object();
+  Value arg(obj), ret;
+  for (size_t i = 0; i < n; i++) {
+    (*f)(ctx, 1, &arg, ret);
+  }
+  bench::keep(ret);
+});
+
+static bench::Benchmark script_closure("pjs/script-closure", [](size_t n) {
+  static Context ctx(instance());
+  static auto f = script("(s => (x => s + x))(1)");
+  Value arg(2), ret;
+  for (size_t i = 0; i < n; i++) {
+    (*f)(ctx, 1, &arg, ret);
+  }
+  bench::keep(ret);
+});
+
+static bench::Benchmark script_object("pjs/script-object-literal", [](size_t n) {
+  static Context ctx(instance());
+  static auto f = script("(a, b) => ({ a, b, sum: a + b })");
+  Value args[2], ret;
+  args[0].set(1);
+  args[1].set(2);
+  for (size_t i = 0; i < n; i++) {
+    (*f)(ctx, 2, args, ret);
+  }
+  bench::keep(ret);
+});
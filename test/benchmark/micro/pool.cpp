@@ -0,0 +1,121 @@
+#include "bench.hpp"
+
+#include "pjs/types.hpp"
+
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace pjs;
+
+static void expect(bool cond, const std::string &what) {
+  if (!cond) throw std::runtime_error(what);
+}
+
+static auto alloc_n(Pool *pool, int n) -> std::vector<void*> {
+  std::vector<void*> v;
+  for (int i = 0; i < n; i++) v.push_back(pool->alloc());
+  return v;
+}
+
+static void free_all(Pool *pool, std::vector<void*> &v) {
+  for (auto *p : v) pool->free(p);
+  v.clear();
+}
+
+//
+// The pool and its live objects are set up once, outside the measurement
+//
+
+static Pool *s_pool = new Pool("", 48);
+static std::vector<void*> s_live = alloc_n(s_pool, 0x10000);
+
+static bench::Benchmark alloc_free("pool/alloc-free", [](size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    auto *p = s_pool->alloc();
+    bench::keep(p);
+    s_pool->free(p);
+  }
+});
+
+static bench::Benchmark alloc_free_spread("pool/alloc-free-spread-64k", [](size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    auto &p = s_live[(i * 40503) & 0xffff];
+    s_pool->free(p);
+    p = s_pool->alloc();
+  }
+});
+
+//
+// A 48-byte object takes 64 bytes with its head, so a 64KB slab holds 1024
+//
+
+static bench::Check slab_size("pool/slab-size", []() {
+  auto *pool = new Pool("", 48);
+  auto v = alloc_n(pool, 1);
+  expect(pool->slabs() == 1, "one slab after the first allocation");
+  expect(pool->capacity() == 1024, "64KB slab holding 1024 objects");
+  v.push_back(pool->alloc());
+  for (int i = 2; i < 1024; i++) v.push_back(pool->alloc());
+  expect(pool->slabs() == 1, "one slab until it is full");
+  v.push_back(pool->alloc());
+  expect(pool->slabs() == 2, "a second slab when the first is full");
+  free_all(pool, v);
+  pool->release();
+
+  pool = new Pool("", 20000);
+  v = alloc_n(pool, 1);
+  expect(pool->capacity() == 8, "at least 8 large objects per slab");
+  free_all(pool, v);
+  pool->release();
+});
+
+static bench::Check release_reuse("pool/release-reuse", []() {
+  auto *pool = new Pool("", 48);
+  auto v = alloc_n(pool, 3 * 1024);
+  std::set<void*> addresses(v.begin(), v.end());
+  expect(pool->slabs() == 3, "three slabs in use");
+  free_all(pool, v);
+  expect(pool->slabs() == 3, "slabs kept until cleaned");
+  pool->clean();
+  expect(pool->slabs() == 0, "empty slabs released when cleaned");
+  expect(pool->released() == 3, "released slabs kept for reuse");
+  expect(pool->pooled() == 0, "no objects pooled in released slabs");
+  v = alloc_n(pool, 3 * 1024);
+  expect(pool->slabs() == 3, "three slabs in use again");
+  expect(pool->released() == 0, "released slabs all reused");
+  for (auto *p : v) expect(addresses.count(p) > 0, "objects allocated from reused slabs");
+  free_all(pool, v);
+  pool->release();
+});
+
+static bench::Check max_released("pool/max-released", []() {
+  auto *pool = new Pool("", 48);
+  auto v = alloc_n(pool, 20 * 1024);
+  expect(pool->slabs() == 20, "twenty slabs in use");
+  free_all(pool, v);
+  pool->clean();
+  expect(pool->slabs() == 0, "empty slabs released when cleaned");
+  expect(pool->released() == 16, "at most 16 released slabs kept");
+  v = alloc_n(pool, 20 * 1024);
+  expect(pool->slabs() == 20, "twenty slabs in use again");
+  expect(pool->released() == 0, "released slabs reused before mapping new ones");
+  free_all(pool, v);
+  pool->release();
+});
+
+static bench::Check packing("pool/packing", []() {
+  auto *pool = new Pool("", 48);
+  auto v = alloc_n(pool, 3 * 1024);
+  std::vector<void*> a(v.begin(), v.begin() + 1024);
+  std::vector<void*> b(v.begin() + 1024, v.begin() + 2048);
+  std::vector<void*> c(v.begin() + 2048, v.end());
+  auto *p = b.back(); b.pop_back();
+  free_all(pool, a);
+  pool->free(p);
+  expect(pool->alloc() == p, "room in a fuller slab taken before an empty slab");
+  b.push_back(p);
+  free_all(pool, b);
+  free_all(pool, c);
+  pool->release();
+});
@@ -0,0 +1,105 @@
+//
+// Fuzz test for hex, Base64 and Base64URL codecs of Data
+//
+// - Encodes random bytes split into random chunks and compares with
+//   reference encoders written in JavaScript
+// - Decodes the results back and compares with the original bytes
+// - Decodes truncated or corrupted strings and expects them to fail
+// - Decodes hex strings with a non-hex character inside or after the first
+//   vectorized block and expects them to fail rather than skip it
+//
+
+((
+  HEX_CHARS = '0123456789abcdef',
+  BASE64_CHARS = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/',
+  BASE64URL_CHARS = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_',
+
+  rng = { seed: 12345 },
+  random = n => (rng.seed = rng.seed * 48271 % 2147483647) % n,
+
+  encodeHex = bytes => bytes.map(b => HEX_CHARS.charAt(b >> 4) + HEX_CHARS.charAt(b & 15)).join(''),
+
+  encodeBase64 = (bytes, chars, pad) => (
+    new Array(Math.ceil(bytes.length / 3)).fill().map(
+      (_, i) => ((
+        n = Math.min(3, bytes.length - i * 3),
+        t = (bytes[i*3] << 16) | ((bytes[i*3+1] || 0) << 8) | (bytes[i*3+2] || 0),
+      ) => (
+        [18, 12, 6, 0].slice(0, n + 1).map(s => chars.charAt((t >> s) & 63)).join('') +
+        (pad ? '='.repeat(3 - n) : '')
+      ))()
+    ).join('')
+  ),
+
+  codecs = [
+    {
+      name: 'hex',
+      encode: bytes => encodeHex(bytes),
+      truncate: s => s + '0',
+    },
+    {
+      name: 'base64',
+      encode: bytes => encodeBase64(bytes, BASE64_CHARS, true),
+      truncate: s => s + 'A',
+    },
+    {
+      name: 'base64url',
+      encode: bytes => encodeBase64(bytes, BASE64URL_CHARS, false),
+      truncate: s => s.substring(0, s.length - s.length % 4) + 'A',
+    },
+  ],
+
+  randomBytes = n => new Array(n).fill().map(() => random(256)),
+
+  replaceAt = (s, i, c) => s.substring(0, i) + c + s.substring(i + 1),
+
+  // Builds a Data out of many small chunks
+  chunked = (bytes, data, state = { n: 1 + random(40), chunk: [] }) => (
+    bytes.forEach(b => (
+      state.chunk.push(b),
+      state.chunk.length >= state.n && (
+        data.push(new Data(state.chunk)),
+        state.chunk = [],
+        state.n = 1 + random(40)
+      )
+    )),
+    state.chunk.length > 0 && data.push(new Data(state.chunk)),
+    data
+  ),
+
+  check = (codec, bytes) => ((
+    s = chunked(bytes, new Data).toString(codec.name),
+  ) => (
+    s === codec.encode(bytes) &&
+    Data.from(s, codec.name).toArray().join() === bytes.join() &&
+    Data.from(codec.truncate(s), codec.name) === null &&
+    (s.length === 0 || (
+      Data.from(replaceAt(s, random(s.length), '!'), codec.name) === null &&
+      Data.from(replaceAt(s, random(Math.max(1, s.length - 4)), '='), codec.name) === null
+    ))
+  ))(),
+
+  nonHex = (
+    s = '00112233445566778899aabbccddeeff0123456789',
+  ) => [0, 1, 17, 31, 32, 40, 41].map(
+    i => ['g', ' ', '\n', '\0'].filter(
+      c => Data.from(replaceAt(s, i, c), 'hex') === null
+    ).length
+  ).reduce((a, b) => a + b) + '/28 rejected',
+
+  report = text => codecs.map(
+    codec => ((
+      passed = new Array(1000).fill().filter(
+        (_, i) => check(codec, randomBytes(i % 10 === 0 ? random(4000) : random(100)))
+      ).length,
+    ) => (
+      `${codec.name} ${text.toString(codec.name)}\n` +
+      `${codec.name} ${passed}/1000 passed\n`
+    ))()
+  ).join('') + `hex non-hex ${nonHex()}\n`,
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(data => new Data(report(data)))
+  .tee('-')
+))()
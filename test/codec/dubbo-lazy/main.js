@@ -0,0 +1,63 @@
+//
+// Test for decodeDubbo() in lazy mode
+//
+// - Requests are built here with Hessian2 bodies of several sizes,
+//   along with a response and a heartbeat that are not decoded lazily
+// - Each message is printed, encoded again and compared with the bytes
+//   it was decoded from
+// - The messages are fed to the decoder one byte at a time
+// - Each line of the input gives the options of a decodeDubbo() run
+// - With a small maxBodySize, the stream ends with a protocol error
+//   at the first request with a body larger than that
+//
+
+((
+  int32 = n => [(n >> 24) & 255, (n >> 16) & 255, (n >> 8) & 255, n & 255],
+
+  frame = (flags, id, body) => ((
+    b = body.toArray(),
+  ) => [0xda, 0xbb, flags, flags & 0x80 ? 0 : 20, 0, 0, 0, 0, ...int32(id), ...int32(b.length), ...b])(),
+
+  invocation = (method, arg) => Hessian.encode([
+    '2.0.2', 'org.apache.dubbo.sample.UserProvider', '1.0.0', method, 'Ljava/lang/String;',
+    arg, { path: 'org.apache.dubbo.sample.UserProvider', timeout: '3000' },
+  ]),
+
+  messages = [
+    ['small request', frame(0xc2, 1, invocation('GetUser', 'A001'))],
+    ['response', frame(0x02, 1, Hessian.encode([0x91, 'ok']))],
+    ['heartbeat', frame(0xe2, 2, Hessian.encode([null]))],
+    ['large request', frame(0xc2, 70000, invocation('SetUser', 'x'.repeat(1000)))],
+    ['oneway request', frame(0x82, 70001, invocation('Notify', 'é'.repeat(40)))],
+  ],
+
+  all = messages.flatMap(([_, b]) => b),
+
+  print = (msg, i) => `${messages[i][0]}: requestID ${msg.head.requestID} head ${JSON.stringify(msg.head)} body ${msg.body.size}`,
+
+  check = (msg, i) => `${messages[i][0]}: ${msg.body.toString('hex') === new Data(messages[i][1]).toString('hex') ? 'same' : 'DIFFERENT'}`,
+
+  run = options => ((
+    lines = [`decodeDubbo(${JSON.stringify(options)})`],
+    decoded = 0,
+    encoded = 0,
+    layout = pipeline($=>$
+      .decodeDubbo(options)
+      .handleMessage(msg => lines.push(print(msg, decoded++)))
+      .handleStreamEnd(evt => evt.error && lines.push(`stream end ${evt.error}`))
+      .encodeDubbo()
+      .handleMessage(msg => lines.push(check(msg, encoded++)))
+    ),
+  ) => layout.process([...all.map(b => new Data([b])), new StreamEnd]).then(() => lines))(),
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => Promise.all(
+      data.toString().split('\n').filter(l => l).map(l => run(JSON.parse(l)))
+    ).then(
+      results => new Data(results.flat().join('\n') + '\n')
+    )
+  )
+  .tee('-')
+))()
@@ -0,0 +1,86 @@
+//
+// Differential test for fusing adjacent handleXXX() and replaceXXX() filters
+//
+// - Builds random chains of handle and replace filters, some of them
+//   waiting on promises, and runs each chain twice on the same events
+// - The first run is fused, the second has each filter separated by an
+//   identity replaceStreamStart() that is never fused
+// - Prints one line per chain telling whether the unfused run made the
+//   same callbacks and output in the same order, with the number of
+//   trace lines, followed by the full traces of the first few chains
+//
+
+((
+  rng = { seed: 20240611 },
+  random = n => (rng.seed = rng.seed * 48271 % 2147483647) % n,
+
+  stages = [
+    ($, k, t) => $.handleMessageStart(msg => t.push(`${k} handleMessageStart ${msg.head.n}`)),
+    ($, k, t) => $.handleData((data, i) => t.push(`${k} handleData ${i} ${data.toString()}`)),
+    ($, k, t) => $.handleMessageEnd(() => t.push(`${k} handleMessageEnd`)),
+    ($, k, t) => $.handleStreamEnd(evt => t.push(`${k} handleStreamEnd ${evt.error}`)),
+    ($, k, t) => $.replaceMessageStart(msg => (t.push(`${k} replaceMessageStart`), new MessageStart({ n: msg.head.n * 10 + k }))),
+    ($, k, t) => $.replaceData(data => (t.push(`${k} replaceData`), [data, new Data(`+${k}`)])),
+    ($, k, t) => $.replaceData(data => (t.push(`${k} replaceData drop`), data.toString().indexOf('e') >= 0 ? [] : data)),
+    ($, k, t) => $.replaceMessageEnd(evt => (t.push(`${k} replaceMessageEnd`), [new Data(`<${k}>`), evt])),
+    ($, k, t) => $.replaceStreamEnd(evt => (t.push(`${k} replaceStreamEnd`), [new MessageStart({ n: 900 + k }), new MessageEnd, evt])),
+    ($, k, t) => $.handleMessageStart(() => (t.push(`${k} handleMessageStart wait`), Promise.resolve().then(() => t.push(`${k} handleMessageStart resumed`)))),
+    ($, k, t) => $.replaceData(data => (t.push(`${k} replaceData wait`), Promise.resolve().then(() => [new Data('~'), data]))),
+    ($, k, t) => $.handleMessageEnd(() => (t.push(`${k} handleMessageEnd resolved`), Promise.resolve())),
+  ],
+
+  output = [
+    ($, k, t) => $.handleMessageStart(msg => t.push(`out MessageStart ${msg.head.n}`)),
+    ($, k, t) => $.handleData(data => t.push(`out Data ${data.toString()}`)),
+    ($, k, t) => $.handleMessageEnd(() => t.push('out MessageEnd')),
+    ($, k, t) => $.handleStreamEnd(evt => t.push(`out StreamEnd ${evt.error}`)),
+  ],
+
+  chains = new Array(150).fill().map(
+    () => new Array(2 + random(7)).fill().map(() => random(stages.length))
+  ),
+
+  run = (chain, events, fused) => ((
+    trace = [],
+    filters = chain.map(i => stages[i]).concat(output),
+    layout = pipeline($ => filters.forEach(
+      (f, k) => (fused || $.replaceStreamStart(evt => evt), f($, k, trace))
+    )),
+  ) => layout.process(events).then(() => trace))(),
+
+  SHOWN_TRACES = 3,
+
+  test = (chain, events) => (
+    run(chain, events, true).then(
+      fused => run(chain, events, false).then(
+        unfused => ({
+          line: `chain ${chain.join(',')} ${fused.join('\n') === unfused.join('\n') ? 'same' : 'DIFFERENT'} ${fused.length}`,
+          trace: fused,
+        })
+      )
+    )
+  ),
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => ((
+      lines = data.toString().split('\n').filter(l => l),
+      events = [
+        ...lines.flatMap((line, i) => [
+          new MessageStart({ n: i + 1 }),
+          new Data(line.substring(0, 3)),
+          new Data(line.substring(3)),
+          new MessageEnd,
+        ]),
+        new StreamEnd,
+      ],
+    ) => Promise.all(chains.map(chain => test(chain, events))).then(
+      results => new Data([
+        ...results.map(r => r.line),
+        ...results.slice(0, SHOWN_TRACES).flatMap(r => ['', r.line, ...r.trace]),
+      ].join('\n') + '\n')
+    ))()
+  )
+  .tee('-')
+))()
@@ -0,0 +1,54 @@
+//
+// Round-trip test for encodeGRPC() and decodeGRPC()
+//
+// - Each line of the input is a gRPC message, every other one compressed
+// - Messages are encoded into one HTTP message body with gzip encoding,
+//   followed by a trailer carrying the gRPC status
+// - The encoded stream is fed to the decoder one byte at a time
+// - A second HTTP message ends in the middle of a gRPC message, whose
+//   partial body is output when the HTTP message ends
+// - A third HTTP message carries a compressed gRPC message that is not
+//   valid gzip, which fails the stream with a protocol error
+//
+
+((
+  print = (name, body) => new Data(`${name} ${body}\n`),
+
+) => pipy()
+
+.task()
+  .onStart(new Data)
+  .read('input')
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessage(
+    msg => ((lines = msg.body.toString().split('\n')) => [
+      ...lines.slice(0, lines.length - 1).map(
+        (line, i) => new Message({ compressed: i % 2 === 1 }, line)
+      ),
+      new MessageEnd({ status: 5, message: 'not found: /a b' }),
+      new StreamEnd,
+    ])()
+  )
+  .encodeGRPC({ status: 200, headers: { 'content-type': 'application/grpc', 'grpc-encoding': 'gzip' } })
+  .replaceStreamEnd(
+    evt => [
+      new MessageStart, new Data([0, 0, 0, 0, 9, 65, 66]), new MessageEnd,
+      new MessageStart({ headers: { 'grpc-encoding': 'gzip' } }), new Data([1, 0, 0, 0, 4, 1, 2, 3, 4]), new MessageEnd,
+      evt,
+    ]
+  )
+  .replaceData(
+    data => data.toArray().map(b => new Data([b]))
+  )
+  .decodeGRPC()
+  .replaceMessage(
+    msg => print(`message compressed=${msg.head.compressed}`, `[${msg.body.toString()}]`)
+  )
+  .replaceMessageEnd(
+    evt => print('status', `${evt.tail.status} ${evt.tail.message}`)
+  )
+  .replaceStreamEnd(
+    evt => [print('end', evt.error), evt]
+  )
+  .tee('-')
+)()
@@ -0,0 +1,48 @@
+//
+// Test for modifying the head of a frozen message between outputs
+//
+// - Each line of the input modifies the head of a frozen response,
+//   which is then encoded along with an unfrozen copy of it
+// - Prints the wire bytes of the frozen response and whether they
+//   match the bytes of the unfrozen copy
+//
+
+((
+  msg = new Message({ status: 200, headers: { 'x-a': '1', 'set-cookie': ['s=0'] } }, 'hello').freeze(),
+
+  modify = (cmd, arg) => (
+    (cmd === 'status') && (msg.head.status = +arg) ||
+    (cmd === 'statusText') && (msg.head.statusText = arg) ||
+    (cmd === 'header') && (msg.head.headers[arg.split(' ')[0]] = arg.split(' ')[1]) ||
+    (cmd === 'drop') && (msg.head.headers = Object.fromEntries(Object.entries(msg.head.headers).filter(([k]) => k !== arg))) ||
+    (cmd === 'cookie') && msg.head.headers['set-cookie'].push(arg) ||
+    (cmd === 'replace-headers') && (msg.head.headers = { 'x-new': 'yes' })
+  ),
+
+  state = { cmd: '', frozen: '' },
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .split('\n')
+  .replaceMessage(
+    line => ((
+      cmd = state.cmd = line.body.toString(),
+      i = cmd.indexOf(' '),
+    ) => (
+      i > 0 ? modify(cmd.substring(0, i), cmd.substring(i + 1)) : modify(cmd),
+      [msg, new Message(JSON.parse(JSON.stringify(msg.head)), msg.body)]
+    ))()
+  )
+  .encodeHTTPResponse()
+  .replaceMessage(
+    (encoded, i) => i % 2 === 0 ? (
+      state.frozen = encoded.body.toString(),
+      []
+    ) : new Data([
+      state.cmd,
+      state.frozen.split('\r\n').join('|'),
+      state.frozen === encoded.body.toString() ? 'same as unfrozen' : 'DIFFERENT from unfrozen',
+    ].join('\n') + '\n')
+  )
+  .tee('-')
+))()
@@ -0,0 +1,70 @@
+//
+// Longest-prefix-match test for IPMap
+//
+// - Each line of the input is an address looked up in every step
+// - Steps add and remove overlapping IPv4 and IPv6 blocks one at a time,
+//   including /0 and full-length host routes
+// - Lookups by IP objects must agree with lookups by strings
+//
+
+((
+  steps = [
+    ['load', [['10.0.0.0/8', 'v4/8'], ['2001:db8::/32', 'v6/32']]],
+    ['set', '10.1.0.0/16', 'v4/16'],
+    ['set', '192.168.1.1/32', 'v4/32'],
+    ['set', '0.0.0.0/0', 'v4/0'],
+    ['set', '2001:db8:1::/48', 'v6/48'],
+    ['set', '2001:db8:1:2::1/128', 'v6/128'],
+    ['set', '::/0', 'v6/0'],
+    ['set', '10.1.0.0/16', 'v4/16 again'],
+    ['delete', '10.1.0.0/16'],
+    ['delete', '0.0.0.0/0'],
+    ['delete', '2001:db8:1::/48'],
+    ['delete', '::/0'],
+    ['delete', '2001:db8::/64'],
+    ['set', new Netmask('192.168.1.0/24'), 'v4/24'],
+    ['delete', '192.168.1.1/32'],
+    ['clear'],
+    ['load', { '255.255.255.255/32': 'all ones', '::1/128': 'loopback', 'fe80::/10': 'link-local' }],
+  ],
+
+  map = new IPMap,
+
+  apply = ([op, key, val]) => (
+    op === 'load' ? (map.load(key), '') :
+    op === 'set' ? (map.set(key, val), '') :
+    op === 'delete' ? ` -> ${map.delete(key)}` :
+    (map.clear(), '')
+  ),
+
+  label = key => (
+    key === undefined ? '' :
+    key instanceof Netmask ? `Netmask(${key.base}/${key.bitmask})` :
+    typeof key === 'string' ? key : JSON.stringify(key)
+  ),
+
+  lookup = addr => ((
+    v = map.find(addr),
+    ip = IP.isV4(addr) || IP.isV6(addr) ? new IP(addr) : null,
+  ) => (
+    ip && map.find(ip) !== v ? `  ${addr} MISMATCH\n` : `  ${addr} ${v === undefined ? '-' : v}\n`
+  ))(),
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => ((
+      addrs = data.toString().split('\n').filter(l => l),
+    ) => new Data(
+      steps.map(
+        step => ((
+          result = apply(step),
+        ) => (
+          `${step[0]} ${label(step[1])}${result} (size ${map.size})\n` +
+          addrs.map(lookup).join('')
+        ))()
+      ).join('')
+    ))()
+  )
+  .tee('-')
+))()
@@ -0,0 +1,46 @@
+//
+// Golden test for JSON.stringify() and JSON.Template
+//
+// - Every control character, alone and in the middle of long strings
+// - Lines of the input, some with raw control characters
+// - Numbers, nesting, indentation and values that are left out
+// - Templates with missing, extra, nested and escaped keys
+//
+
+((
+  controls = new Array(32).fill().map((_, i) => String.fromCharCode(i)),
+
+  values = [
+    0, -0, 1, -1.5, 0.1, 1/3, 5e-7, 1e21, 123456789012345680000, NaN, Infinity, -Infinity,
+    true, false, null, undefined, '',
+    [], {}, [undefined, () => 0, null], { a: undefined, b: () => 0, c: null },
+    { a: [1, { b: [2, { c: 'd' }] }], e: {} },
+  ],
+
+  template = new JSON.Template({ id: 0, 'quote"key': '', user: { name: '', tags: [] }, extra: null }),
+
+  objects = [
+    { id: 1, 'quote"key': 'q', user: { name: 'n', tags: ['a', 'b'] }, extra: { x: 1 } },
+    { 'quote"key': 'first key missing', user: { name: 'n\n', other: 1 } },
+    { id: 2, user: null, extra: [1, 2] },
+    { id: 3, user: 'not an object', unknown: 'left out' },
+    { id: undefined, user: { name: undefined, tags: undefined } },
+    {},
+  ],
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => new Data([
+      ...controls.map((c, i) => `control ${i} ${JSON.stringify(c)}`),
+      `controls long ${JSON.stringify('x'.repeat(40) + controls.join('') + 'y'.repeat(40))}`,
+      `quotes long ${JSON.stringify('"\\'.repeat(20) + 'z'.repeat(100) + '"')}`,
+      ...data.toString().split('\n').filter(l => l).map(line => `line ${JSON.stringify(line)}`),
+      ...values.map(v => `value ${JSON.stringify(v)}`),
+      `indent ${JSON.stringify(values[values.length - 1], null, 2)}`,
+      ...objects.map(o => `template ${template.stringify(o)}`),
+      `template encode ${template.encode(objects[0]).toString() === template.stringify(objects[0])}`,
+    ].join('\n') + '\n')
+  )
+  .tee('-')
+))()
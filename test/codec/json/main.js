@@ -0,0 +1,81 @@
+//
+// Golden test for JSON.parse() and JSON.decode()
+//
+// - Each line of the input is parsed as one JSON text
+// - Each is also decoded from a Data split into 1-byte chunks,
+//   which should give the same result as parsing the whole string
+// - Generated cases cover deep nesting and invalid UTF-8 bytes
+//
+
+((
+  parse = text => {
+    try {
+      return 'ok ' + JSON.stringify(JSON.parse(text));
+    } catch (e) {
+      return 'error ' + e.message;
+    }
+  },
+
+  decode = data => {
+    try {
+      return 'ok ' + JSON.stringify(JSON.decode(data));
+    } catch (e) {
+      return 'error ' + e.message;
+    }
+  },
+
+  chunked = bytes => bytes.reduce((data, b) => data.push(new Data([b])), new Data),
+
+  check = (name, text, data) => ((
+    result = parse(text),
+  ) => (
+    result === decode(chunked(data.toArray())) ? `${name} ${result}\n` : `${name} MISMATCH\n`
+  ))(),
+
+  nested = (depth, open, close, inner) => open.repeat(depth) + inner + close.repeat(depth),
+
+  // Walks down 'depth' levels without recursion and expects to find 1 there
+  deep = (text, depth, step) => {
+    try {
+      return [JSON.parse(text), JSON.decode(new Data(text))].map(
+        root => new Array(depth).fill().reduce(step, root) === 1 ? 'ok' : 'WRONG'
+      ).join(' ');
+    } catch (e) {
+      return 'error ' + e.message;
+    }
+  },
+
+  generated = [
+    ['array x 10000', nested(10000, '[', ']', '1'), 10000, v => v[0]],
+    ['object x 10000', nested(10000, '{"a":', '}', '1'), 10000, v => v.a],
+    ['mixed x 5000', nested(5000, '[{"a":', '}]', '1'), 5000, v => v[0].a],
+    ['unclosed x 10000', nested(10000, '[', '', '1'), 10000, v => v[0]],
+  ],
+
+  bytes = [
+    ['utf8 2-byte', [0x22, 0xc3, 0xa9, 0x22]],
+    ['utf8 4-byte', [0x22, 0xf0, 0x9f, 0x98, 0x80, 0x22]],
+    ['utf8 lone continuation', [0x22, 0x80, 0x22]],
+    ['utf8 truncated', [0x22, 0xe4, 0xb8, 0x22]],
+    ['utf8 invalid lead', [0x22, 0xff, 0x22]],
+  ],
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => new Data(
+      ((lines = data.toString().split('\n')) => (
+        lines.slice(0, lines.length - 1).map(
+          (line, i) => check(`#${i + 1}`, line, new Data(line))
+        ).join('')
+      ))() +
+      generated.map(
+        ([name, text, depth, step]) => `${name} ${deep(text, depth, step)}\n`
+      ).join('') +
+      bytes.map(
+        ([name, b]) => `${name} ${decode(chunked(b))}\n`
+      ).join('')
+    )
+  )
+  .tee('-')
+))()
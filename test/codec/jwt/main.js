@@ -0,0 +1,83 @@
+//
+// Test for the per-thread cache of verified JWTs
+//
+// - Verifying the same token again with the same key hits the cache
+// - A different key never hits the cache of another key, whether it is
+//   given as a string, as Data, as a JWK or picked from a JWKS
+// - Failed verifications are not cached
+// - Tokens with an "exp" in the past or without "exp" still verify
+//
+
+((
+  encode = obj => new Data(JSON.stringify(obj)).toString('base64url'),
+
+  sign = (payload, key) => ((
+    head = encode({ alg: 'HS256', typ: 'JWT' }) + '.' + encode(payload),
+    hmac = new crypto.Hmac('sha256', key),
+  ) => (
+    hmac.update(head),
+    head + '.' + hmac.digest().toString('base64url')
+  ))(),
+
+  tokens = {
+    future: sign({ sub: 'alice', exp: 4102444800 }, 'secret'),
+    past: sign({ sub: 'bob', exp: 1000000000 }, 'secret'),
+    noExp: sign({ sub: 'carol' }, 'secret'),
+    other: sign({ sub: 'dave' }, 'another secret'),
+  },
+
+  tampered = tokens.future.split('.').map((s, i) => i === 1 ? encode({ sub: 'mallory', exp: 4102444800 }) : s).join('.'),
+
+  hmacCases = [
+    ['future', 'secret'],
+    ['future', 'secret'],
+    ['future', new Data('secret')],
+    ['future', 'Secret'],
+    ['future', 'secret '],
+    ['future', ''],
+    ['future', 'secret'],
+    ['past', 'secret'],
+    ['past', 'secret'],
+    ['past', 'Secret'],
+    ['noExp', 'secret'],
+    ['noExp', 'secret'],
+    ['noExp', 'another secret'],
+    ['other', 'secret'],
+    ['other', 'another secret'],
+    ['other', 'secret'],
+    ['other', 'another secret'],
+  ],
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => ((
+      input = JSON.decode(data),
+      jwkA = new crypto.JWK(input.keys[0]),
+      jwkB = new crypto.JWK(input.keys[1]),
+      jwks = new crypto.JWKS(input.keys),
+      rsaCases = [
+        ['signedByA', 'jwkA', jwkA],
+        ['signedByA', 'jwkA', jwkA],
+        ['signedByA', 'jwkB', jwkB],
+        ['signedByA', 'jwks', jwks],
+        ['signedByA', 'jwkA copy', new crypto.JWK(input.keys[0])],
+        ['signedByB', 'jwkA', jwkA],
+        ['signedByB', 'jwks', jwks],
+        ['signedByB', 'jwkB', jwkB],
+        ['signedByB', 'jwkA', jwkA],
+        ['signedByB', 'jwkB', jwkB],
+      ],
+    ) => new Data([
+      ...hmacCases.map(
+        ([name, key]) => `${name} ${JSON.stringify(key.toString())}${key instanceof Data ? ' (Data)' : ''} ${new crypto.JWT(tokens[name]).verify(key)}`
+      ),
+      `tampered "secret" ${new crypto.JWT(tampered).verify('secret')}`,
+      `tampered "secret" ${new crypto.JWT(tampered).verify('secret')}`,
+      ...rsaCases.map(
+        ([name, keyName, key]) => `${name} ${keyName} ${new crypto.JWT(input.tokens[name]).verify(key)}`
+      ),
+    ].join('\n') + '\n'))()
+  )
+  .tee('-')
+))()
@@ -0,0 +1,70 @@
+//
+// Test for protobuf.Schema
+//
+// - Fields in the input are not in field number order, so a message
+//   that is re-encoded comes out different from the original bytes
+// - Messages that are only read should keep their original bytes
+// - Changes made anywhere in the tree, including in place in repeated
+//   fields, should be re-encoded
+// - Malformed sub-messages are only found when accessed, where they read
+//   as null, while untouched ones still re-encode to their original bytes
+//
+
+((
+  schema = new protobuf.Schema(
+    os.readFile('../protobuf/addressbook.proto').toString() + `
+      package google.protobuf;
+      message Timestamp {
+        int64 seconds = 1;
+        int32 nanos = 2;
+      }
+    `
+  ),
+
+  summary = book => book.people.map(
+    p => `${p.name}/${p.id}/${p.email}/` + p.phones.map(ph => `${ph.number}:${ph.type}`).join(',')
+  ).join(' | '),
+
+  cases = [
+    ['untouched', book => book],
+    ['read all', book => (summary(book), book)],
+    ['set name', book => (book.people[0].name = 'Pipy!', book)],
+    ['set phone type', book => (book.people[1].phones[0].type = 2, book)],
+    ['push phone', book => (book.people[1].phones.push({ number: '86-21-12345678', type: 0 }), book)],
+    ['pop person', book => (book.people.pop(), book)],
+    ['replace person', book => (book.people[0] = book.people[1], book)],
+    ['set same person', book => (book.people[0] = book.people[0], book)],
+    ['set people', book => (book.people = [book.people[1]], book)],
+  ],
+
+  malformed = [
+    // people[0] ends in a truncated varint
+    ['malformed person', new Data([0x0a, 0x02, 0x10, 0xff]), book => `${book.people.length} ${book.people[0].id} ${book.people[0].name}`],
+    // people[0].last_updated ends in a tag without a value
+    ['malformed timestamp', new Data([0x0a, 0x06, 0x0a, 0x01, 0x78, 0x2a, 0x01, 0x08]), book => `${book.people[0].name} ${book.people[0].last_updated}`],
+  ],
+
+  checkMalformed = (name, data, f) => ((
+    book = schema.decode('tutorial.AddressBook', data),
+  ) => (
+    `${name}: ${f(book)} ` +
+    `${schema.encode('tutorial.AddressBook', book).toString('hex') === data.toString('hex') ? 'same bytes' : 'reencoded'}\n`
+  ))(),
+
+  check = (data, name, f) => ((
+    out = schema.encode('tutorial.AddressBook', f(schema.decode('tutorial.AddressBook', data))),
+  ) => (
+    `${name}: ${out.toString('hex') === data.toString('hex') ? 'same bytes' : 'reencoded'}` +
+    ` ${summary(schema.decode('tutorial.AddressBook', out))}\n`
+  ))(),
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => new Data(
+      cases.map(([name, f]) => check(data, name, f)).join('') +
+      malformed.map(([name, data, f]) => checkMalformed(name, data, f)).join('')
+    )
+  )
+  .tee('-')
+))()
@@ -0,0 +1,80 @@
+//
+// Test for decodeThrift() in full and lazy modes
+//
+// - Messages are built here in the compact, strict binary and old binary
+//   protocols, using varints of several bytes for sequence IDs, lengths,
+//   list sizes and values, including consecutive ones in a list
+// - Each message is decoded, printed, encoded again and compared
+//   with the bytes it was decoded from
+// - The messages are fed to the decoder one byte at a time
+// - Each line of the input gives the options of a decodeThrift() run
+//
+
+((
+  varint = n => n < 128 ? [n] : [n % 128 + 128, ...varint(Math.floor(n / 128))],
+  zigzag = n => n < 0 ? -n * 2 - 1 : n * 2,
+  int16 = n => [(n >> 8) & 255, n & 255],
+  int32 = n => [(n >> 24) & 255, (n >> 16) & 255, (n >> 8) & 255, n & 255],
+  bytes = s => new Data(s).toArray(),
+
+  messages = [
+    ['compact', [
+      0x82, 0x21, ...varint(300), ...varint(4), ...bytes('calc'),
+      0x15, ...varint(zigzag(1000000)),
+      0x19, 0x45, ...[1, 300, -70000, 5].flatMap(n => varint(zigzag(n))),
+      0x18, ...varint(200), ...bytes('x'.repeat(200)),
+      0x16, ...varint(zigzag(1099511627776)),
+      0x00,
+    ]],
+    ['compact long list', [
+      0x82, 0x41, ...varint(70000), ...varint(5), ...bytes('reply'),
+      0x19, 0xf5, ...varint(20), ...new Array(20).fill().flatMap((_, i) => varint(zigzag(i * 1000 - 7))),
+      0x00,
+    ]],
+    ['binary', [
+      0x80, 0x01, 0x00, 0x01, ...int32(4), ...bytes('ping'), ...int32(70000),
+      0x08, ...int16(1), ...int32(-2),
+      0x0b, ...int16(2), ...int32(3), ...bytes('abc'),
+      0x00,
+    ]],
+    ['old binary', [
+      ...int32(3), ...bytes('add'), 0x01, ...int32(70000),
+      0x08, ...int16(1), ...int32(12345678),
+      0x08, ...int16(2), ...int32(-1),
+      0x00,
+    ]],
+    ['old binary oneway', [
+      ...int32(6), ...bytes('notify'), 0x04, ...int32(1),
+      0x00,
+    ]],
+  ],
+
+  all = messages.flatMap(([_, b]) => b),
+
+  print = (msg, i) => `${messages[i][0]}: head ${JSON.stringify(msg.head)} payload ${JSON.stringify(msg.payload)}`,
+
+  check = (msg, i) => `${messages[i][0]}: ${msg.body.toString('hex') === new Data(messages[i][1]).toString('hex') ? 'same' : 'DIFFERENT'}`,
+
+  run = options => ((
+    lines = [`decodeThrift(${JSON.stringify(options)})`],
+    decoded = 0,
+    encoded = 0,
+    layout = pipeline($=>$
+      .decodeThrift(options)
+      .handleMessage(msg => lines.push(print(msg, decoded++)))
+      .encodeThrift()
+      .handleMessage(msg => lines.push(check(msg, encoded++)))
+    ),
+  ) => layout.process([...all.map(b => new Data([b])), new StreamEnd]).then(() => lines))(),
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => Promise.all(
+      data.toString().split('\n').filter(l => l).map(l => run(JSON.parse(l)))
+    ).then(
+      results => new Data(results.flat().join('\n') + '\n')
+    )
+  )
+  .tee('-')
+))()
@@ -0,0 +1,38 @@
+//
+// Test for algo.TopicTrie
+//
+// Each line of the input is a command:
+//
+//   sub <filter> <key>       - subscribes with the key as the value
+//   unsub <filter> <key>     - unsubscribes and prints if it existed
+//   match <topic>            - prints the values a topic is delivered to
+//   retain <topic> [<msg>]   - sets or clears a retained message
+//   retained <filter>        - prints the retained messages for a filter
+//   size                     - prints the number of subscriptions
+//
+
+((
+  trie = new algo.TopicTrie,
+
+  sorted = values => `[${values.sort().join(',')}]`,
+
+  run = ([cmd, arg, value]) => (
+    cmd === 'sub' ? (trie.subscribe(arg, value), '') :
+    cmd === 'unsub' ? `unsub ${arg} ${value} -> ${trie.unsubscribe(arg, value)}\n` :
+    cmd === 'match' ? `match ${arg} -> ${sorted(trie.match(arg))}\n` :
+    cmd === 'retain' ? (trie.retain(arg, value || null), '') :
+    cmd === 'retained' ? `retained ${arg} -> ${sorted(trie.retained(arg))}\n` :
+    cmd === 'size' ? `size -> ${trie.size}\n` : ''
+  ),
+
+) => pipy.read('input', $=>$
+  .replaceStreamStart(evt => [new MessageStart, evt])
+  .replaceMessageBody(
+    data => new Data(
+      data.toString().split('\n').filter(line => line).map(
+        line => run(line.split(' '))
+      ).join('')
+    )
+  )
+  .tee('-')
+))()
@@ -0,0 +1,94 @@
+//
+// Round-trip test for decodeWebSocket() and encodeWebSocket()
+//
+// - Masked client frames are built here for a list of messages of
+//   different sizes, some of them fragmented
+// - They are decoded, encoded again with permessage-deflate and masking,
+//   decoded with deflate, encoded without masking and decoded once more
+// - Each message coming out is printed with its opcode and size, whether
+//   it was compressed in the middle and whether its payload is the same
+//   as the original one
+// - The raw frames are fed 1000 bytes at a time, so that headers, masks
+//   and payloads are broken across chunks
+//
+
+((
+  rng = { seed: 20240611 },
+  random = n => (rng.seed = rng.seed * 48271 % 2147483647) % n,
+
+  text = n => new Array(n).fill().map((_, i) => 'Pipy WebSocket '.charCodeAt(i % 15)),
+  noise = n => new Array(n).fill().map(() => random(256)),
+
+  // [opcode, payload bytes, number of fragments]
+  messages = [
+    [1, text(5), 1],
+    [1, [], 1],
+    [9, text(4), 1],
+    [2, noise(125), 1],
+    [2, noise(126), 1],
+    [1, text(65535), 1],
+    [1, text(65536), 1],
+    [2, noise(70000), 1],
+    [1, text(3000), 3],
+    [2, noise(20000), 4],
+    [10, [], 1],
+    [1, text(100000), 2],
+  ],
+
+  frame = (opcode, fin, payload) => ((
+    mask = noise(4),
+    n = payload.length,
+  ) => [
+    (fin ? 0x80 : 0) | opcode,
+    ...(
+      n < 126 ? [0x80 | n] :
+      n < 65536 ? [0x80 | 126, n >> 8, n & 255] :
+      [0x80 | 127, 0, 0, 0, 0, (n >> 24) & 255, (n >> 16) & 255, (n >> 8) & 255, n & 255]
+    ),
+    ...mask,
+    ...payload.map((b, i) => b ^ mask[i % 4]),
+  ])(),
+
+  frames = ([opcode, payload, count]) => ((
+    size = Math.ceil(payload.length / count),
+  ) => new Array(count).fill().flatMap(
+    (_, i) => frame(i === 0 ? opcode : 0, i === count - 1, payload.slice(i * size, (i + 1) * size))
+  ))(),
+
+  input = ((
+    bytes = messages.flatMap(frames),
+  ) => new Array(Math.ceil(bytes.length / 1000)).fill().map(
+    (_, i) => new Data(bytes.slice(i * 1000, (i + 1) * 1000))
+  ))(),
+
+  deflated = [],
+  count = { n: 0 },
+
+  describe = (msg, i) => ((
+    want = messages[i] || [],
+    got = msg.body.toArray(),
+  ) => new Data(
+    `message ${i} opcode=${msg.head.opcode} size=${got.length} deflated=${deflated[i]} ` +
+    `${msg.head.opcode === want[0] && got.join() === (want[1] || []).join() ? 'same' : 'DIFFERENT'}\n`
+  ))(),
+
+) => pipy()
+
+.task()
+  .onStart(() => [...input, new StreamEnd])
+  .decodeWebSocket()
+  .handleMessageStart(msg => msg.head.masked = true)
+  .encodeWebSocket({ deflate: () => 'permessage-deflate; client_no_context_takeover; client_max_window_bits=10' })
+  .decodeWebSocket({ deflate: 'permessage-deflate; client_max_window_bits' })
+  .handleMessageStart(msg => (deflated.push(msg.head.compressed), msg.head.masked = false))
+  .encodeWebSocket()
+  .decodeWebSocket({ deflate: true })
+  .replaceMessage(
+    msg => describe(msg, count.n++)
+  )
+  .replaceStreamEnd(
+    () => [new Data(`total ${deflated.length} expected ${messages.length}\n`), new StreamEnd]
+  )
+  .tee('-')
+
+)()
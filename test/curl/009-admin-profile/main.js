@@ -0,0 +1,40 @@
+//
+// Target of CPU profiling on the admin port
+//
+// - Port 8000 responds from a script function that keeps the CPU busy
+//   for a while, so that profiles taken under load have it in them
+// - Port 8001 takes a pprof profile in a POST body, gunzips it, decodes
+//   it as protobuf and tells what it has found in it
+//
+
+((
+  busy = n => new Array(n).fill().map((_, i) => i * i).reduce((a, b) => a + b, 0),
+
+  decodeProfile = data => ((
+    profile = protobuf.decode(zlib.gunzip(data)),
+  ) => ({
+    samples: profile.getMessageArray(2).length,
+    strings: profile.getStringArray(6),
+  }))(),
+
+) => pipy()
+
+.listen(8000)
+.serveHTTP(
+  req => new Message(`hello ${busy(10000)}\n`)
+)
+
+.listen(8001)
+.serveHTTP(
+  req => ((
+    p = decodeProfile(req.body),
+    has = s => p.strings.some(t => t.indexOf(s) >= 0),
+  ) => new Message([
+    `samples ${p.samples > 0}`,
+    `pipeline ${has('[pipeline]')}`,
+    `filter ${has('[filter] serveHTTP')}`,
+    `script ${has('(anonymous function at line')}`,
+  ].join('\n') + '\n'))()
+)
+
+)()
@@ -0,0 +1,56 @@
+@echo off
+
+echo Invalid parameters
+call :profile "?seconds=0"
+call :profile "?seconds=-1"
+call :profile "?seconds=61"
+call :profile "?seconds=abc"
+call :profile "?hz=0"
+call :profile "?hz=1001"
+call :profile "?hz=abc"
+call :profile "?format=svg"
+call :profile "?seconds=1&format="
+
+echo Valid parameters
+call :profile "?seconds=0.5"
+call :profile "?seconds=0.5&hz=1000"
+call :profile "?seconds=0.5&hz=1&format=folded"
+call :profile "?seconds=0.5&format=pprof"
+
+echo Concurrent profiling
+start /b curl -s -o nul -w "?seconds=2 %%{http_code} %%{content_type}\n" "http://localhost:6060/profile?seconds=2" > "%TEMP%\pipy-profile-concurrent.out"
+timeout /t 1 /nobreak > nul
+call :profile "?seconds=0.5"
+timeout /t 2 /nobreak > nul
+type "%TEMP%\pipy-profile-concurrent.out"
+del "%TEMP%\pipy-profile-concurrent.out"
+
+echo Profiling under load
+start /b cmd /c "for /l %%i in (1,1,2000) do @curl -s -o nul http://localhost:8000/"
+timeout /t 1 /nobreak > nul
+curl -s -o "%TEMP%\pipy-profile.folded" "http://localhost:6060/profile?seconds=1&hz=1000"
+call :has "[pipeline]"
+call :has "[filter] serveHTTP"
+call :has "(anonymous function at line"
+findstr /r /c:"\[filter\] serveHTTP.*;pipy::Filter::callback(.*;(anonymous function at line" "%TEMP%\pipy-profile.folded" > nul && (
+  echo folded has script frames above Filter::callback^(^)
+) || (
+  echo folded lacks script frames above Filter::callback^(^)
+)
+del "%TEMP%\pipy-profile.folded"
+curl -s -o "%TEMP%\pipy-profile.pprof" "http://localhost:6060/profile?seconds=1&hz=1000&format=pprof"
+curl -s --data-binary "@%TEMP%\pipy-profile.pprof" http://localhost:8001/
+del "%TEMP%\pipy-profile.pprof"
+goto :eof
+
+:has
+findstr /l /c:"%~1" "%TEMP%\pipy-profile.folded" > nul && (
+  echo folded has %~1
+) || (
+  echo folded lacks %~1
+)
+goto :eof
+
+:profile
+curl -s -o nul -w "%~1 %%{http_code} %%{content_type}\n" "http://localhost:6060/profile%~1"
+goto :eof
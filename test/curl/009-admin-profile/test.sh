@@ -0,0 +1,54 @@
+#!/bin/bash
+
+profile() {
+  curl -s -o /dev/null -w "$1 %{http_code} %{content_type}\n" "http://localhost:6060/profile$1"
+}
+
+echo 'Invalid parameters'
+profile '?seconds=0'
+profile '?seconds=-1'
+profile '?seconds=61'
+profile '?seconds=abc'
+profile '?hz=0'
+profile '?hz=1001'
+profile '?hz=abc'
+profile '?format=svg'
+profile '?seconds=1&format='
+
+echo 'Valid parameters'
+profile '?seconds=0.5'
+profile '?seconds=0.5&hz=1000'
+profile '?seconds=0.5&hz=1&format=folded'
+profile '?seconds=0.5&format=pprof'
+
+echo 'Concurrent profiling'
+concurrent=$(mktemp)
+profile '?seconds=2' > $concurrent &
+sleep 0.5
+profile '?seconds=0.5'
+wait
+cat $concurrent
+rm $concurrent
+
+load() {
+  local end=$((SECONDS + 4))
+  while [ $SECONDS -lt $end ]; do curl -s -o /dev/null http://localhost:8000/; done
+}
+
+has() {
+  grep -qF -- "$2" <<< "$1" && echo "$3 has $2" || echo "$3 lacks $2"
+}
+
+echo 'Profiling under load'
+load &
+sleep 0.5
+folded=$(curl -s 'http://localhost:6060/profile?seconds=1&hz=1000')
+has "$folded" '[pipeline]' folded
+has "$folded" '[filter] serveHTTP' folded
+has "$folded" '(anonymous function at line' folded
+grep -qE '\[filter\] serveHTTP.*;pipy::Filter::callback\(.*;\(anonymous function at line' <<< "$folded" &&
+  echo 'folded has script frames above Filter::callback()' ||
+  echo 'folded lacks script frames above Filter::callback()'
+curl -s 'http://localhost:6060/profile?seconds=1&hz=1000&format=pprof' |
+  curl -s --data-binary @- http://localhost:8001/
+wait
@@ -0,0 +1,29 @@
+//
+// Per-filter metrics across a reload
+//
+// - Each load of this module names its pipeline after the number of times
+//   it has been loaded, so the filters of each load are told apart
+// - GET /restart --> calls pipy.restart() to reload the codebase
+//
+
+((
+  loads = new algo.SharedMap('loads'),
+  initialized = loads.get('n') !== undefined || loads.set('n', 0),
+  gen = `gen-${loads.add('n', 1)}`,
+
+) => pipy()
+
+.listen(8000)
+.demuxHTTP().to(gen)
+
+.pipeline(gen)
+.replaceMessage(
+  req => req.head.path === '/restart' ? (
+    pipy.restart(),
+    new Message('restarting\n')
+  ) : (
+    new Message(`${gen}\n`)
+  )
+)
+
+)()
@@ -0,0 +1,18 @@
+@echo off
+
+curl -s http://localhost:8000/
+curl -s http://localhost:8000/
+timeout /t 2 /nobreak > nul
+call :metrics
+
+curl -s http://localhost:8000/restart
+timeout /t 2 /nobreak > nul
+curl -s http://localhost:8000/
+curl -s http://localhost:8000/
+timeout /t 2 /nobreak > nul
+call :metrics
+goto :eof
+
+:metrics
+curl -s http://localhost:6060/metrics | findstr /b /c:"pipy_filter_message_count{" | findstr /c:"pipeline=\"gen-"
+goto :eof
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+metrics() {
+  curl -s http://localhost:6060/metrics |
+  grep '^pipy_filter_message_count{' |
+  grep 'pipeline="gen-'
+}
+
+curl -s http://localhost:8000/
+curl -s http://localhost:8000/
+sleep 2
+metrics
+
+curl -s http://localhost:8000/restart
+sleep 2
+curl -s http://localhost:8000/
+curl -s http://localhost:8000/
+sleep 2
+metrics
@@ -62,7 +62,9 @@ async function start(id) {
 
 async function test(name) {
   log('Testing', chalk.cyan(name), '...');
-  const pipyProc = await startPipy(join(currentDir, name, 'main.js'));
+  const optionsPath = join(currentDir, name, 'options');
+  const options = fs.existsSync(optionsPath) ? fs.readFileSync(optionsPath).toString().split(/\s+/).filter(s => s) : [];
+  const pipyProc = await startPipy(join(currentDir, name, 'main.js'), options);
   if (pipyProc) {
     try {
       let output, expected;
@@ -115,10 +117,10 @@ async function test(name) {
   }
 }
 
-async function startPipy(filename) {
+async function startPipy(filename, options) {
   log('Starting Pipy...');
-  log(pipyBinPath, filename);
-  const proc = spawn(pipyBinPath, [filename, '--log-level=debug:thread']);
+  log(pipyBinPath, filename, ...options);
+  const proc = spawn(pipyBinPath, [filename, '--log-level=debug:thread', ...options]);
   const lineBuffer = [];
   let started = false;
   return await Promise.race([
@@ -0,0 +1,78 @@
+//
+// Redis Cluster routing test
+//
+// - localhost:6391 serves slots 0-8191
+// - localhost:6392 serves slots 8192-16383
+// - GET /<key> --> GET <key> on the node serving its slot --> "<port>:<key>"
+// - Keys starting with "moving" are migrating from 6392 to 6391,
+//   where they are only served after ASKING
+//
+
+((
+  crc16 = s => new Array(s.length).fill().reduce(
+    (crc, _, i) => new Array(8).fill().reduce(
+      c => ((c & 0x8000) ? ((c << 1) ^ 0x1021) : (c << 1)) & 0xffff,
+      crc ^ (s.charCodeAt(i) << 8)
+    ),
+    0
+  ),
+
+  slotOf = (key, i = key.indexOf('{'), j = i < 0 ? -1 : key.indexOf('}', i + 1)) => (
+    crc16(j > i + 1 ? key.substring(i + 1, j) : key) & 16383
+  ),
+
+  ownerOf = key => key.startsWith('moving') ? 6392 : (slotOf(key) < 8192 ? 6391 : 6392),
+
+  serve = (port, cmd) => {
+    switch (cmd[0].toString().toUpperCase()) {
+      case 'ASKING':
+        _asking = true;
+        return 'OK';
+      case 'CLUSTER':
+        return [
+          [0, 8191, ['127.0.0.1', 6391]],
+          [8192, 16383, ['127.0.0.1', 6392]],
+        ];
+      case 'GET': {
+        var key = cmd[1].toString();
+        var asking = _asking;
+        _asking = false;
+        if (key.startsWith('moving')) {
+          if (port === 6392) return new Error(`ASK ${slotOf(key)} 127.0.0.1:6391`);
+          if (!asking) return new Error(`MOVED ${slotOf(key)} 127.0.0.1:6392`);
+        } else if (ownerOf(key) !== port) {
+          return new Error(`MOVED ${slotOf(key)} 127.0.0.1:${ownerOf(key)}`);
+        }
+        return new Data(`${port}:${key}`);
+      }
+      default: return new Error('ERR unknown command');
+    }
+  },
+
+) => pipy({
+  _asking: false,
+  _node: undefined,
+})
+
+.listen(6391).decodeRESP().replaceMessage(msg => [new MessageStart, new MessageEnd(null, serve(6391, msg.payload))]).encodeRESP()
+.listen(6392).decodeRESP().replaceMessage(msg => [new MessageStart, new MessageEnd(null, serve(6392, msg.payload))]).encodeRESP()
+
+.listen(8000)
+.demuxHTTP().to(
+  $=>$
+  .replaceMessage(
+    msg => [new MessageStart, new MessageEnd(null, [new Data('GET'), new Data(msg.head.path.substring(1))])]
+  )
+  .muxRESP('127.0.0.1:6392').to(
+    $=>$
+    .onStart(addr => void (_node = addr))
+    .encodeRESP()
+    .connect(() => _node)
+    .decodeRESP()
+  )
+  .replaceMessage(
+    msg => new Message(msg.payload instanceof Error ? msg.payload.message : msg.payload.toString())
+  )
+)
+
+)()
@@ -0,0 +1,48 @@
+export default function({ session, http, split, repeat }) {
+
+  const keys = [
+    'foo', 'bar', 'baz', '{user1}.name', '{user1}.mail',
+    'moving1', 'moving2', 'a', 'b', 'c',
+  ];
+
+  function crc16(s) {
+    let crc = 0;
+    for (let i = 0; i < s.length; i++) {
+      crc ^= s.charCodeAt(i) << 8;
+      for (let j = 0; j < 8; j++) {
+        crc = ((crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1)) & 0xffff;
+      }
+    }
+    return crc;
+  }
+
+  function expected(key) {
+    if (key.startsWith('moving')) return `6391:${key}`;
+    const i = key.indexOf('{');
+    const j = i < 0 ? -1 : key.indexOf('}', i + 1);
+    const slot = crc16(j > i + 1 ? key.substring(i + 1, j) : key) & 16383;
+    return `${slot < 8192 ? 6391 : 6392}:${key}`;
+  }
+
+  function verify(msg, i) {
+    if (msg.status !== 200) {
+      throw new Error(`Unexpected status code ${msg.status}`);
+    }
+    const key = keys[i % keys.length];
+    if (msg.body !== expected(key)) {
+      throw new Error(`Unexpected body in response ${i}: ${msg.body}`);
+    }
+  }
+
+  session({
+    delay: 0,
+    messages: repeat(50, keys.map(k => http('GET', '/' + k))),
+    verify,
+  });
+
+  session({
+    delay: 5,
+    messages: repeat(20, keys.map(k => split(2, http('GET', '/' + k)))),
+    verify,
+  });
+}
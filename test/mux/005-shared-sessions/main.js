@@ -0,0 +1,32 @@
+//
+// Shared HTTP/2 sessions with minSessions
+//
+// - localhost:8080 is an HTTP/2 upstream that replies with the number of
+//   connections it has accepted so far across all threads
+// - muxHTTP keeps 2 sessions open per key and shares them among threads,
+//   so no matter how many threads handle the requests, the upstream should
+//   see exactly 2 connections, the spare one being connected ahead of time
+//
+
+((
+  connections = new algo.SharedMap('connections'),
+  initialized = connections.get('upstream') !== undefined || connections.set('upstream', 0),
+
+) => pipy()
+
+.listen(8080)
+.onStart(() => void connections.add('upstream', 1))
+.demuxHTTP().to(
+  $=>$.replaceMessage(
+    () => new Message(connections.get('upstream').toString())
+  )
+)
+
+.listen(8000)
+.demuxHTTP().to(
+  $=>$.muxHTTP(() => 'upstream', { version: 2, shared: true, minSessions: 2 }).to(
+    $=>$.connect('localhost:8080')
+  )
+)
+
+)()
@@ -0,0 +1,39 @@
+export const options = ['--threads=2'];
+
+export default function({ session, http, repeat }) {
+
+  function verify(msg, i) {
+    if (msg.status !== 200) {
+      throw new Error(`Unexpected status code ${msg.status}`);
+    }
+    const n = parseInt(msg.body);
+    if (!(n > 0 && n <= 2)) {
+      throw new Error(`Unexpected number of upstream connections in response ${i}: ${msg.body}`);
+    }
+  }
+
+  function verifyPrewarmed(msg, i) {
+    verify(msg, i);
+    if (msg.body !== '2') {
+      throw new Error(`Spare session not connected in response ${i}: ${msg.body}`);
+    }
+  }
+
+  session({
+    delay: 0,
+    messages: repeat(50, [http('GET', '/')]),
+    verify,
+  });
+
+  session({
+    delay: 10,
+    messages: repeat(50, [http('GET', '/')]),
+    verify: verifyPrewarmed,
+  });
+
+  session({
+    delay: 20,
+    messages: repeat(50, [http('GET', '/')]),
+    verify: verifyPrewarmed,
+  });
+}
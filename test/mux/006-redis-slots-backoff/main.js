@@ -0,0 +1,43 @@
+//
+// Redis Cluster slot map refresh backoff test
+//
+// - localhost:6393 fails every CLUSTER SLOTS with an error other than
+//   "cluster support disabled", so the slot map never gets loaded
+// - Commands should still be served by the seed node in the meantime
+// - GET /<key> --> "<key>:<number of CLUSTER SLOTS received so far>",
+//   which should stay small as failed refreshes are retried with backoff
+//
+
+((
+  stats = { clusterSlots: 0 },
+
+  serve = cmd => {
+    switch (cmd[0].toString().toUpperCase()) {
+      case 'CLUSTER':
+        stats.clusterSlots++;
+        return new Error('LOADING Redis is loading the dataset in memory');
+      case 'GET':
+        return new Data(`${cmd[1].toString()}:${stats.clusterSlots}`);
+      default: return new Error('ERR unknown command');
+    }
+  },
+
+) => pipy()
+
+.listen(6393).decodeRESP().replaceMessage(msg => [new MessageStart, new MessageEnd(null, serve(msg.payload))]).encodeRESP()
+
+.listen(8000)
+.demuxHTTP().to(
+  $=>$
+  .replaceMessage(
+    msg => [new MessageStart, new MessageEnd(null, [new Data('GET'), new Data(msg.head.path.substring(1))])]
+  )
+  .muxRESP('127.0.0.1:6393').to(
+    $=>$.encodeRESP().connect('127.0.0.1:6393').decodeRESP()
+  )
+  .replaceMessage(
+    msg => new Message(msg.payload instanceof Error ? msg.payload.message : msg.payload.toString())
+  )
+)
+
+)()
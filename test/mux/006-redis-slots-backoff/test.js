@@ -0,0 +1,27 @@
+export default function({ session, http, repeat }) {
+
+  function verify(msg, i) {
+    if (msg.status !== 200) {
+      throw new Error(`Unexpected status code ${msg.status}`);
+    }
+    const [key, count] = msg.body.split(':');
+    if (key !== 'foo') {
+      throw new Error(`Unexpected body in response ${i}: ${msg.body}`);
+    }
+    if (!(parseInt(count) <= 10)) {
+      throw new Error(`Too many CLUSTER SLOTS by response ${i}: ${count}`);
+    }
+  }
+
+  session({
+    delay: 0,
+    messages: repeat(200, [http('GET', '/foo')]),
+    verify,
+  });
+
+  session({
+    delay: 10,
+    messages: repeat(200, [http('GET', '/foo')]),
+    verify,
+  });
+}
@@ -0,0 +1,46 @@
+//
+// Steering connections by receiving CPU with --reuse-port=cpu
+//
+// - Runs 2 threads without --worker-cpus, so a connection received on
+//   CPU n should be accepted by thread n % 2
+// - GET /cpu --> "<incomingCPU> <thread index>"
+// - GET /accepted --> "<thread index>:<count> ..." for port 8000, taken
+//   from pipy_inbound_accepted on the admin service of this instance
+//
+
+((
+  accepted = new RegExp('^pipy_inbound_accepted\\{listen="[^"]*:8000/TCP",thread="(\\d+)"\\} (\\d+)$'),
+
+) => pipy({
+  _path: '',
+})
+
+.listen(8000)
+.demuxHTTP().to(
+  $=>$
+  .handleMessageStart(
+    msg => _path = msg.head.path
+  )
+  .branch(
+    () => _path === '/accepted', (
+      $=>$
+      .replaceMessage(new Message({ method: 'GET', path: '/metrics' }))
+      .muxHTTP().to($=>$.connect('localhost:6061'))
+      .replaceMessage(
+        res => new Message(
+          res.body.toString().split('\n')
+            .map(line => line.match(accepted))
+            .filter(m => m)
+            .map(m => `${m[1]}:${m[2]}`)
+            .join(' ')
+        )
+      )
+    ), (
+      $=>$.replaceMessage(
+        () => new Message(`${__inbound.incomingCPU} ${__thread.id}`)
+      )
+    )
+  )
+)
+
+)()
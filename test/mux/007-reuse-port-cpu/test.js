@@ -0,0 +1,58 @@
+import os from 'os';
+
+export const options = ['--threads=2', '--reuse-port=cpu', '--admin-port=6061'];
+
+export default function({ session, http }) {
+  const cpus = os.cpus().length;
+  const threads = [0, 0];
+  let steered = 0;
+
+  function verifyCPU(msg) {
+    if (msg.status !== 200) {
+      throw new Error(`Unexpected status code ${msg.status}`);
+    }
+    const [cpu, thread] = msg.body.split(' ').map(s => parseInt(s));
+    if (!(0 <= cpu && cpu < cpus)) {
+      throw new Error(`Invalid incomingCPU: ${msg.body}`);
+    }
+    if (!(0 <= thread && thread < 2)) {
+      throw new Error(`Invalid thread index: ${msg.body}`);
+    }
+    threads[thread]++;
+    if (thread === cpu % 2) steered++;
+  }
+
+  function verifyAccepted(msg) {
+    if (msg.status !== 200) {
+      throw new Error(`Unexpected status code ${msg.status}`);
+    }
+    const counts = [0, 0];
+    msg.body.split(' ').forEach(s => {
+      const [thread, count] = s.split(':').map(s => parseInt(s));
+      counts[thread] = count;
+    });
+    for (let i = 0; i < 2; i++) {
+      if (!(counts[i] >= threads[i])) {
+        throw new Error(`pipy_inbound_accepted of thread ${i} is ${counts[i]} while ${threads[i]} were seen`);
+      }
+    }
+    // The receiving CPU can change after the SYN, so allow a few misses
+    if (steered < (threads[0] + threads[1]) * 0.8) {
+      throw new Error(`Only ${steered} of ${threads[0] + threads[1]} connections accepted on the receiving CPU`);
+    }
+  }
+
+  for (let i = 0; i < 50; i++) {
+    session({
+      delay: i % 10,
+      messages: [http('GET', '/cpu')],
+      verify: verifyCPU,
+    });
+  }
+
+  session({
+    delay: 30,
+    messages: [http('GET', '/accepted')],
+    verify: verifyAccepted,
+  });
+}
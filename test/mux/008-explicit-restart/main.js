@@ -0,0 +1,28 @@
+//
+// Explicit restart of an unchanged codebase
+//
+// - Each time this module is loaded, a counter shared by all threads
+//   goes up, so it only goes up on a full reload
+// - GET /loads --> number of times the module has been loaded
+// - GET /restart --> calls pipy.restart(), which should reload the
+//   codebase even though none of its files has changed
+//
+
+((
+  loads = new algo.SharedMap('loads'),
+  initialized = loads.get('n') !== undefined || loads.set('n', 0),
+  loaded = loads.add('n', 1),
+
+) => pipy()
+
+.listen(8000)
+.serveHTTP(
+  req => req.head.path === '/restart' ? (
+    pipy.restart(),
+    new Message('restarting')
+  ) : (
+    new Message(loads.get('n').toString())
+  )
+)
+
+)()
@@ -0,0 +1,35 @@
+export default function({ session, http }) {
+  let before = 0;
+
+  function verify(msg) {
+    if (msg.status !== 200) {
+      throw new Error(`Unexpected status code ${msg.status}`);
+    }
+  }
+
+  session({
+    delay: 0,
+    messages: [http('GET', '/loads')],
+    verify: (msg, i) => {
+      verify(msg, i);
+      before = parseInt(msg.body);
+      if (!(before >= 1)) throw new Error(`Invalid number of loads: ${msg.body}`);
+    },
+  });
+
+  session({
+    delay: 5,
+    messages: [http('GET', '/restart')],
+    verify,
+  });
+
+  session({
+    delay: 30,
+    messages: [http('GET', '/loads')],
+    verify: (msg, i) => {
+      verify(msg, i);
+      const after = parseInt(msg.body);
+      if (!(after > before)) throw new Error(`Not reloaded by pipy.restart(): ${before} loads before and ${after} after`);
+    },
+  });
+}
@@ -439,11 +439,13 @@ async function runTest(name, options) {
 
   let worker;
   try {
+    const f = await import(url.pathToFileURL(join(currentDir, name, 'test.js')));
+
     if (options.pipy) {
       log('Uploading codebase', chalk.magenta(name), '...');
       await uploadCodebase(`test/${name}`, basePath);
       log('Starting codebase...');
-      worker = await startCodebase(`http://localhost:6060/repo/test/${name}/`, { silent: true });
+      worker = await startCodebase(`http://localhost:6060/repo/test/${name}/`, { silent: true, options: f.options });
       log('Codebase', chalk.magenta(name), 'started');
     }
 
@@ -473,7 +475,6 @@ async function runTest(name, options) {
     }
 
     const { session, reload, run } = createSessions(worker, 8000, options);
-    const f = await import(url.pathToFileURL(join(currentDir, name, 'test.js')));
     f.default({ session, http, split, repeat, reload });
 
     log('Running...');